@@ -0,0 +1,141 @@
+#pragma once
+
+#include "maya/core/skinning.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace maya {
+
+/// Uncompressed clip as authored or imported: every joint's local transform at a fixed rate.
+struct RawAnimationClip {
+    float sample_rate = 30.0f;
+    uint32_t joint_count = 0;
+    /// Frame-major: frame `f`, joint `j` is `samples[f * joint_count + j]`.
+    std::vector<JointTransform> samples;
+
+    uint32_t frame_count() const { return joint_count == 0 ? 0 : static_cast<uint32_t>(samples.size() / joint_count); }
+    float duration() const { return frame_count() < 2 ? 0.0f : static_cast<float>(frame_count() - 1) / sample_rate; }
+    size_t memory_bytes() const { return samples.size() * sizeof(JointTransform); }
+};
+
+/// Largest interpolation error key reduction in `compress_clip` may leave per track, measured
+/// against the raw samples. Quantization error comes on top (see `QuantizedQuat`, `QuantizedVec3`).
+struct AnimationCompressionSettings {
+    /// Per quaternion component (about radians / 2 for small angles).
+    float rotation_tolerance = 0.0005f;
+    /// In the joint's parent space units.
+    float translation_tolerance = 0.0005f;
+    float scale_tolerance = 0.0005f;
+};
+
+/// Smallest-three quaternion in 48 bits: the three smallest components in 15 bits each, and
+/// the largest component's index in the spare top bits of `packed[0]` and `packed[1]`.
+struct QuantizedQuat {
+    uint16_t packed[3];
+
+    static QuantizedQuat encode(const math::Quat& q);
+    math::Quat decode() const;
+};
+
+/// Vector as 16-bit fractions of its track's range.
+struct QuantizedVec3 {
+    uint16_t packed[3];
+};
+
+/// Compressed clip: one rotation, translation and scale track per joint. Each track keeps only
+/// the keys linear interpolation cannot reproduce within tolerance (constant tracks keep one),
+/// stores key times as frame numbers and values quantized as above.
+///
+/// `sample` evaluates four joints at once: keys are located and decoded per lane, then
+/// interpolated, renormalized and written with `math::simd::Float4`.
+class AnimationClip {
+public:
+    float duration() const { return m_duration; }
+    float sample_rate() const { return m_sample_rate; }
+    uint32_t joint_count() const { return m_joint_count; }
+    uint32_t key_count() const { return static_cast<uint32_t>(m_rotation_keys.size() + m_vector_keys.size()); }
+    /// Bytes of key, frame and track data.
+    size_t memory_bytes() const;
+
+    /// Local pose at `time` (clamped to the clip), `joint_count()` transforms.
+    void sample(float time, JointTransform* out) const;
+
+private:
+    friend AnimationClip compress_clip(const RawAnimationClip&, const AnimationCompressionSettings&);
+
+    struct Track {
+        uint32_t first_key = 0;
+        uint32_t key_count = 0;
+    };
+    /// Dequantization for a vector track: `min + packed * extent / 65535`.
+    struct VectorRange {
+        math::Vec3 min;
+        math::Vec3 extent;
+    };
+
+    /// Index of the last key at or before `frame` in `frames[first, first + count)`.
+    static uint32_t find_key(const std::vector<uint16_t>& frames, const Track& track, float frame);
+    /// Rotations of joints `[first_joint, first_joint + lanes)`, `lanes <= 4`.
+    void sample_rotations(uint32_t first_joint, uint32_t lanes, float frame, JointTransform* out) const;
+    /// Vector tracks `[first_track, first_track + lanes)` into `out[0, lanes)`.
+    void sample_vectors(uint32_t first_track, uint32_t lanes, float frame, math::Vec3* out) const;
+
+    float m_duration = 0.0f;
+    float m_sample_rate = 30.0f;
+    uint32_t m_joint_count = 0;
+    /// `m_joint_count` rotation tracks.
+    std::vector<Track> m_rotation_tracks;
+    std::vector<uint16_t> m_rotation_frames;
+    std::vector<QuantizedQuat> m_rotation_keys;
+    /// Translation tracks for every joint, then scale tracks; same indices into `m_vector_ranges`.
+    std::vector<Track> m_vector_tracks;
+    std::vector<VectorRange> m_vector_ranges;
+    std::vector<uint16_t> m_vector_frames;
+    std::vector<QuantizedVec3> m_vector_keys;
+};
+
+/// Quantizes `raw` and drops keys within `settings` of the interpolation of their neighbors.
+/// Frames past the 65536th are ignored.
+AnimationClip compress_clip(const RawAnimationClip& raw, const AnimationCompressionSettings& settings = {});
+
+/// `out = a * (1 - weight) + b * weight` per joint; rotations take the shortest path and are
+/// renormalized (nlerp). Four joints per SIMD step; `out` may alias `a` or `b`.
+void blend_poses(const JointTransform* a, const JointTransform* b, float weight, uint32_t joint_count,
+    JointTransform* out);
+
+/// Plays one clip at a time and cross-fades to the next over a given duration.
+class AnimationPlayer {
+public:
+    explicit AnimationPlayer(uint32_t joint_count);
+
+    /// Starts `clip` (borrowed). With `fade_duration > 0` the current clip keeps playing
+    /// and is blended out over that time. Returns false and keeps the current playback if
+    /// `clip` animates a different number of joints than the player.
+    bool play(const AnimationClip* clip, float fade_duration = 0.0f, bool loop = true);
+    void advance(float delta_time);
+    /// Writes the blended local pose, `joint_count` transforms.
+    void evaluate(JointTransform* out);
+
+    float time() const { return m_current.time; }
+    /// 1 once the current clip has fully faded in.
+    float blend_weight() const { return m_fade_duration > 0.0f ? m_fade_time / m_fade_duration : 1.0f; }
+
+private:
+    struct Layer {
+        const AnimationClip* clip = nullptr;
+        float time = 0.0f;
+        bool loop = true;
+    };
+
+    static void advance(Layer& layer, float delta_time);
+
+    Layer m_current;
+    Layer m_previous;
+    float m_fade_time = 0.0f;
+    float m_fade_duration = 0.0f;
+    uint32_t m_joint_count;
+    std::vector<JointTransform> m_scratch;
+};
+
+} // namespace maya
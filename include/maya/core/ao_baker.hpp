@@ -0,0 +1,38 @@
+#pragma once
+
+#include "maya/core/model_loader.hpp"
+#include "maya/math/matrix.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+struct AoBakeSettings {
+    /// Cosine-weighted rays per vertex, rounded up to a multiple of four (one ray packet).
+    uint32_t rays_per_vertex = 64;
+    /// Occluders farther than this do not darken a vertex, so open scenes are not uniformly dim.
+    float max_distance = 2.0f;
+    /// Ray origins are pushed this far along the vertex normal to avoid hitting their own faces.
+    float bias = 1e-3f;
+    /// Off: `color.rgb` is multiplied by the AO. On: `color.rgb` holds the object-space bent
+    /// normal (encoded `n * 0.5 + 0.5`) and `color.a` the AO, for shaders that read them.
+    bool bent_normals = false;
+};
+
+/// A static mesh to bake, placed in the world by `model_matrix`.
+struct AoBakeTarget {
+    MeshData* mesh = nullptr;
+    math::Mat4 model_matrix = math::Mat4::identity();
+};
+
+/// Bakes per-vertex ambient occlusion for static meshes (e.g. read with `ModelLoader::read_obj`
+/// before their GPU meshes are created). Every target both receives and casts occlusion: their
+/// world-space triangles go into one `TriangleBvh`, then each vertex casts cosine-weighted
+/// hemisphere rays in packets of four (`TriangleBvh::occluded4`), vertices spread over `jobs`.
+/// AO is the unoccluded fraction of rays. Sample directions are a Fibonacci spiral rotated per
+/// vertex, so results are deterministic. Vertices with a zero normal are left untouched.
+void bake_vertex_ao(const std::vector<AoBakeTarget>& targets, const AoBakeSettings& settings, JobSystem& jobs);
+
+} // namespace maya
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "maya/math/bounds.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace maya {
+
+class Mesh;
+
+/// World-space triangle with a caller-chosen id (e.g. the index of the object it came from).
+struct BvhTriangle {
+    math::Vec3 v0;
+    math::Vec3 v1;
+    math::Vec3 v2;
+    uint32_t id = 0;
+};
+
+struct RayHit {
+    /// Hit point is `origin + direction * t` (direction need not be normalized).
+    float t = 0.0f;
+    /// Index into `TriangleBvh::triangles()`.
+    uint32_t triangle = 0;
+    /// Barycentric weights of `v1` and `v2`.
+    float u = 0.0f;
+    float v = 0.0f;
+};
+
+/// Four rays in structure-of-arrays layout for `TriangleBvh::intersect4` and `occluded4`; lane `i` of every
+/// array belongs to ray `i`.
+struct RayPacket4 {
+    float origin[3][4] = {};
+    float direction[3][4] = {};
+    float t_min[4] = {};
+    float t_max[4] = {};
+};
+
+/// Appends the triangles of `mesh` transformed by `model`, tagged with `id`.
+void append_mesh_triangles(const Mesh& mesh, const math::Mat4& model, uint32_t id, std::vector<BvhTriangle>& out);
+
+/// Bounding volume hierarchy over static triangles for CPU ray casts (visibility and lighting
+/// bakes). Built top-down with binned SAH; siblings are stored next to each other so inner nodes
+/// only keep the first child. Triangles are double-sided. Queries are const and thread-safe.
+class TriangleBvh {
+public:
+    /// Replaces the contents; `triangles` is reordered into leaf order.
+    void build(std::vector<BvhTriangle> triangles);
+
+    /// Closest hit with `t` in `[t_min, t_max]`.
+    bool intersect(const math::Vec3& origin, const math::Vec3& direction, float t_min, float t_max,
+        RayHit& hit) const;
+    /// Whether anything is hit with `t` in `[t_min, t_max]` (stops at the first hit found).
+    bool occluded(const math::Vec3& origin, const math::Vec3& direction, float t_min, float t_max) const;
+    /// `occluded` for four rays at once: bit `i` is set when ray `i` hits anything. The rays share
+    /// one traversal with SIMD box and triangle tests, so coherent rays (e.g. hemisphere samples
+    /// from one point) visit few more nodes than a single ray. Lanes with `t_max < t_min` are off.
+    uint32_t occluded4(const RayPacket4& rays) const;
+    /// `intersect` for four rays at once: bit `i` is set when ray `i` hit, with its closest hit
+    /// in `hits[i]` (other entries are left as they were). Lanes with `t_max < t_min` are off.
+    uint32_t intersect4(const RayPacket4& rays, RayHit hits[4]) const;
+
+    bool empty() const { return m_triangles.empty(); }
+    const std::vector<BvhTriangle>& triangles() const { return m_triangles; }
+    const math::Aabb& bounds() const;
+    uint32_t node_count() const { return static_cast<uint32_t>(m_nodes.size()); }
+
+private:
+    struct Node {
+        math::Aabb bounds;
+        /// Leaf: first triangle. Inner: first child (the second follows it).
+        uint32_t first = 0;
+        /// Triangles in a leaf; 0 for inner nodes.
+        uint32_t count = 0;
+    };
+
+    template <bool AnyHit>
+    bool traverse(const math::Vec3& origin, const math::Vec3& direction, float t_min, float t_max,
+        RayHit* hit) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<BvhTriangle> m_triangles;
+};
+
+} // namespace maya
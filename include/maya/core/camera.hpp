@@ -2,28 +2,47 @@
 
 #include "maya/math/vector.hpp"
 #include "maya/math/matrix.hpp"
+#include "maya/math/frustum.hpp"
+#include <cstdint>
 
 namespace maya {
 
+/// Free-fly camera. View, projection, their product, inverses and frustum planes are cached and
+/// rebuilt lazily on first access after a change; `version` advances on every change so callers
+/// can skip dependent work. Getters refresh the cache, so call them from one thread at a time.
 class Camera {
 public:
     Camera(float fov, float aspect_ratio, float near_clip, float far_clip);
 
     void update(float delta_time);
 
-    void set_position(const math::Vec3& position) { m_position = position; }
+    void set_position(const math::Vec3& position);
     const math::Vec3& get_position() const { return m_position; }
 
-    void set_aspect_ratio(float aspect_ratio) { m_aspect_ratio = aspect_ratio; }
+    void set_aspect_ratio(float aspect_ratio);
+    /// Vertical field of view in degrees.
+    void set_fov(float fov);
+    float get_fov() const { return m_fov; }
 
-    math::Mat4 get_view_matrix() const;
-    math::Mat4 get_projection_matrix() const;
-    math::Mat4 get_view_projection_matrix() const;
+    const math::Mat4& get_view_matrix() const;
+    const math::Mat4& get_projection_matrix() const;
+    const math::Mat4& get_view_projection_matrix() const;
+    const math::Mat4& get_inverse_view_matrix() const;
+    const math::Mat4& get_inverse_projection_matrix() const;
+    const math::Mat4& get_inverse_view_projection_matrix() const;
+    const math::Frustum& get_frustum() const;
+
+    /// Incremented whenever position, orientation, FOV or aspect ratio change.
+    uint64_t version() const { return m_version; }
 
 private:
     void process_keyboard(float delta_time);
     void process_mouse();
 
+    void mark_view_dirty();
+    void mark_projection_dirty();
+    void refresh() const;
+
     // Camera Attributes
     math::Vec3 m_position;
     math::Vec3 m_front;
@@ -49,6 +68,18 @@ private:
     bool m_first_mouse;
     float m_last_x;
     float m_last_y;
+
+    // Cached matrices (rebuilt by `refresh`)
+    mutable math::Mat4 m_view;
+    mutable math::Mat4 m_projection;
+    mutable math::Mat4 m_view_projection;
+    mutable math::Mat4 m_inverse_view;
+    mutable math::Mat4 m_inverse_projection;
+    mutable math::Mat4 m_inverse_view_projection;
+    mutable math::Frustum m_frustum;
+    mutable bool m_view_dirty = true;
+    mutable bool m_projection_dirty = true;
+    uint64_t m_version = 0;
 };
 
 } // namespace maya
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "maya/core/streaming_buffer.hpp"
+#include "maya/math/bounds.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace maya {
+
+/// RGBA8 packed little-endian (`r` in the low byte), as unpacked by `vertexDebug`.
+constexpr uint32_t pack_debug_color(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) {
+    return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(b) << 16)
+        | (static_cast<uint32_t>(a) << 24);
+}
+
+constexpr uint32_t kDebugWhite = pack_debug_color(255, 255, 255);
+constexpr uint32_t kDebugRed = pack_debug_color(255, 64, 64);
+constexpr uint32_t kDebugGreen = pack_debug_color(64, 255, 64);
+constexpr uint32_t kDebugBlue = pack_debug_color(64, 128, 255);
+constexpr uint32_t kDebugYellow = pack_debug_color(255, 230, 64);
+
+/// GPU layout of debug geometry (must match `DebugVertex` in `triangle.metal`).
+struct DebugVertex {
+    math::Vec3 position;
+    uint32_t color = kDebugWhite;
+};
+
+static_assert(sizeof(DebugVertex) == 16, "DebugVertex must match the Metal debug vertex layout");
+
+/// One frame of expanded debug geometry: line-list and triangle-list vertices.
+struct DebugGeometry {
+    std::vector<DebugVertex> lines;
+    std::vector<DebugVertex> triangles;
+};
+
+/// Immediate-mode debug shapes (lines, boxes, spheres, frusta) recorded from any thread.
+///
+/// Each recording thread appends compact shape records to its own buffer, found through a
+/// thread-local slot cache, so recording takes no lock and costs a branch plus a push_back;
+/// `set_enabled(false)` reduces it to the branch. Once per frame, with no recording in flight,
+/// `expand` turns every record into line/triangle vertices and clears the buffers.
+class DebugDraw {
+public:
+    /// Recording threads per instance; shapes from further threads are counted in `dropped`.
+    static constexpr uint32_t kMaxThreads = 64;
+    /// Segments per circle of a sphere.
+    static constexpr uint32_t kSphereSegments = 24;
+
+    DebugDraw();
+    ~DebugDraw();
+
+    DebugDraw(const DebugDraw&) = delete;
+    DebugDraw& operator=(const DebugDraw&) = delete;
+
+    /// Process-wide recorder the engine renders every frame.
+    static DebugDraw& instance() {
+        static DebugDraw s_instance;
+        return s_instance;
+    }
+
+    void set_enabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void line(const math::Vec3& a, const math::Vec3& b, uint32_t color = kDebugWhite);
+    void box(const math::Aabb& box, uint32_t color = kDebugWhite);
+    /// `local` transformed by `transform` (oriented box).
+    void box(const math::Aabb& local, const math::Mat4& transform, uint32_t color = kDebugWhite);
+    /// Three great circles.
+    void sphere(const math::Vec3& center, float radius, uint32_t color = kDebugWhite);
+    /// Edges of the volume `view_projection` maps to clip space (Metal depth, 0..1).
+    void frustum(const math::Mat4& view_projection, uint32_t color = kDebugWhite);
+    /// Filled, double-sided.
+    void triangle(const math::Vec3& a, const math::Vec3& b, const math::Vec3& c, uint32_t color = kDebugWhite);
+
+    /// Appends every recorded shape to `out` as vertices and clears the recordings. Must not
+    /// run concurrently with recording.
+    void expand(DebugGeometry& out);
+    /// Drops recorded shapes without expanding them.
+    void clear();
+
+    /// Shapes recorded since the last `expand`/`clear` (not thread-safe with recording).
+    uint32_t shape_count() const;
+    /// Shapes lost because more than `kMaxThreads` threads recorded.
+    uint32_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    enum class Kind : uint8_t { Line, Box, OrientedBox, Sphere, Frustum, Triangle };
+
+    /// Large enough for a matrix; the kind decides how `data` is read.
+    struct Shape {
+        float data[16];
+        uint32_t color;
+        Kind kind;
+    };
+
+    struct alignas(64) ThreadBuffer {
+        std::vector<Shape> shapes;
+    };
+
+    /// This thread's buffer, claiming a slot on first use; null if none are left.
+    ThreadBuffer* thread_buffer();
+    void record(Kind kind, const float* data, uint32_t count, uint32_t color);
+
+    /// Never reused, so thread-local slot caches of destroyed instances cannot match.
+    uint64_t m_id;
+    std::atomic<bool> m_enabled{true};
+    std::atomic<uint32_t> m_thread_count{0};
+    std::atomic<uint32_t> m_dropped{0};
+    std::unique_ptr<std::array<ThreadBuffer, kMaxThreads>> m_threads;
+};
+
+/// Draws a `DebugDraw`'s shapes each frame: everything is expanded into one streamed vertex
+/// buffer and drawn with one draw per primitive type.
+class DebugDrawRenderer {
+public:
+    /// `pipeline` is normally `vertexDebug` + `fragmentUnlit` from `triangle.metal`.
+    DebugDrawRenderer(GraphicsDevice& device, PipelineHandle pipeline);
+
+    /// Expands `debug_draw` and draws it between `begin_frame` and `end_frame`.
+    void render(DebugDraw& debug_draw, UniformBufferHandle uniform_buffer, const math::Mat4& view_projection);
+
+    /// Vertices drawn by the last `render`.
+    uint32_t last_vertex_count() const { return m_last_vertex_count; }
+
+private:
+    GraphicsDevice& m_device;
+    PipelineHandle m_pipeline;
+    StreamingVertexBuffer m_buffer;
+    uint32_t m_last_vertex_count = 0;
+    DebugGeometry m_geometry;
+    std::vector<DebugVertex> m_upload;
+};
+
+} // namespace maya
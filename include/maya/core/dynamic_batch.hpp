@@ -0,0 +1,81 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/core/streaming_buffer.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+struct SceneObject;
+
+struct DynamicBatchSettings {
+    /// Objects whose mesh has more vertices than this are drawn individually.
+    uint32_t max_vertices_per_object = 64;
+    /// Capacity of the per-frame streaming buffers; objects beyond it fall back to per-draw.
+    uint32_t max_vertices_per_frame = 1u << 16;
+    uint32_t max_indices_per_frame = 1u << 18;
+    /// Material groups with fewer eligible objects than this are not worth a batch.
+    uint32_t min_objects_per_batch = 2;
+};
+
+/// Each frame, transforms small dynamic meshes that share a material into world space on
+/// worker threads and streams them into one vertex/index buffer, so each material group is
+/// drawn with one uniform update and one draw.
+class DynamicBatcher {
+public:
+    /// Index range of one material group inside this frame's streamed buffer.
+    struct Group {
+        Material material{};
+        uint32_t first_index = 0;
+        uint32_t index_count = 0;
+        uint32_t object_count = 0;
+    };
+
+    DynamicBatcher(GraphicsDevice& device, const DynamicBatchSettings& settings = {});
+
+    /// Small dynamic meshes that still hold their CPU copy (see `Mesh::release_cpu_data`).
+    static bool is_eligible(const SceneObject& object, const DynamicBatchSettings& settings);
+
+    /// CPU pass: selects eligible objects, groups them by material and writes their world-space
+    /// vertices and rebased indices into the frame staging arrays using `jobs`.
+    void build(const std::vector<SceneObject>& objects, JobSystem& jobs);
+
+    /// Copies the staging arrays into the next streaming buffer.
+    void upload();
+
+    /// Draws one group from the last upload (caller binds material and uniforms).
+    void draw_group(uint32_t group_index) const;
+
+    /// True if `objects[object_index]` from the last `build` is covered by a batch.
+    bool is_batched(uint32_t object_index) const {
+        return object_index < m_batched.size() && m_batched[object_index] != 0;
+    }
+
+    const std::vector<Group>& groups() const { return m_groups; }
+    const std::vector<Vertex>& staged_vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& staged_indices() const { return m_indices; }
+    const DynamicBatchSettings& settings() const { return m_settings; }
+
+private:
+    /// Where one batched object's data lands in the staging arrays.
+    struct Placement {
+        uint32_t object_index;
+        uint32_t first_vertex;
+        uint32_t first_index;
+    };
+
+    DynamicBatchSettings m_settings;
+    StreamingGeometryBuffer m_stream;
+    std::vector<Group> m_groups;
+    std::vector<Placement> m_placements;
+    std::vector<uint8_t> m_batched;
+    std::vector<Vertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+};
+
+} // namespace maya
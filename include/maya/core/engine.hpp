@@ -4,8 +4,14 @@
 #include "maya/rhi/graphics_device.hpp"
 #include "maya/rhi/resource.hpp"
 #include "maya/core/camera.hpp"
+#include "maya/core/debug_draw.hpp"
+#include "maya/core/particles.hpp"
+#include "maya/core/quality_governor.hpp"
 #include "maya/core/scene.hpp"
 #include "maya/core/texture.hpp"
+#include "maya/core/update_scheduler.hpp"
+#include "maya/core/view_culling.hpp"
+#include "maya/core/world_streamer.hpp"
 #include <memory>
 
 namespace maya {
@@ -25,9 +31,29 @@ private:
     std::unique_ptr<Camera> m_camera;
 
     Scene m_scene;
+    /// View 0 is the main camera; shadow/probe views can be added alongside it.
+    ViewSet m_views;
+    /// `Camera::version` the main view was last built from.
+    uint64_t m_main_view_camera_version = ~0ull;
     DirectionalLighting m_directional_light = DirectionalLighting::default_sun();
     std::unique_ptr<Texture> m_checker_texture;
     UniformBufferHandle m_uniform_buffer;
+    /// Per-object work amortized under a frame budget; `m_spin_system` turns the two demo objects.
+    UpdateScheduler m_updates{2.0f};
+    uint32_t m_spin_system = 0;
+    std::vector<float> m_spin_angles;
+    /// Frame-time driven quality: LOD bias, draw distance and update rates are knobs.
+    QualityRegistry m_quality;
+    QualityGovernor m_governor{m_quality};
+    float m_lod_bias = 1.0f;
+    float m_draw_distance_scale = 1.0f;
+    /// Draws `DebugDraw::instance()` after the scene; B toggles object bounds.
+    std::unique_ptr<DebugDrawRenderer> m_debug_renderer;
+    bool m_show_bounds = false;
+    std::unique_ptr<ParticleSystem> m_particles;
+    std::unique_ptr<ParticleRenderer> m_particle_renderer;
+    /// Streams `assets/world` cells around the camera (empty if that directory has no cells).
+    std::unique_ptr<WorldStreamer> m_world_streamer;
 
     bool m_is_running = false;
 };
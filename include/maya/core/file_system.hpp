@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <sstream>
@@ -19,6 +20,10 @@ public:
     static std::optional<std::filesystem::path> resolve(const std::string& relative_or_absolute);
 
     static std::string read_text(const std::string& path);
+    /// Whole file as bytes (images, binary assets); empty on failure.
+    static std::vector<uint8_t> read_binary(const std::string& path);
+    /// Creates or truncates `path` (not resolved against the roots) and writes `bytes`.
+    static bool write_binary(const std::string& path, const std::vector<uint8_t>& bytes);
 
 private:
     static std::vector<std::filesystem::path> s_roots;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/math/bounds.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace maya {
+
+struct SceneObject;
+
+/// Returned by `HlodTree::leaf_of` for objects not in any cluster.
+constexpr uint32_t kNoHlodCluster = ~0u;
+
+struct HlodSettings {
+    /// Edge length of the grid cells grouping objects into the finest clusters (by bounds center).
+    float cluster_size = 64.0f;
+    /// Levels built above the finest; each groups the 2x2x2 clusters below it.
+    uint32_t levels = 3;
+    /// Vertex-clustering cell of the finest proxies as a fraction of `cluster_size`; doubles per
+    /// level, so coarser proxies keep roughly the same triangle count on screen. Features smaller
+    /// than a cell collapse away.
+    float simplify_cell_fraction = 1.0f / 16.0f;
+    /// A cluster is drawn as its proxy once its screen size (bounds radius / distance, times
+    /// `CullView::lod_scale`) falls below this.
+    float switch_screen_size = 0.05f;
+};
+
+/// Simplified world-space geometry of one material in a cluster.
+struct HlodProxy {
+    Material material{};
+    std::unique_ptr<Mesh> mesh;
+};
+
+struct HlodCluster {
+    math::Aabb bounds;
+    uint32_t level = 0;
+    /// Clusters of the level below (none at level 0).
+    uint32_t first_child = 0;
+    uint32_t child_count = 0;
+    /// Level-0 clusters covered; every cluster covers a contiguous range.
+    uint32_t first_leaf = 0;
+    uint32_t leaf_count = 0;
+    std::vector<HlodProxy> proxies;
+};
+
+/// Hierarchical LOD for static objects: objects are grouped spatially into clusters, each
+/// cluster's geometry is merged per material and simplified by vertex clustering into proxy
+/// meshes, and clusters are grouped again level by level. At runtime a view draws the coarsest
+/// cluster small enough on screen as its proxies instead of the objects below it (see
+/// `ViewSet::hlod_proxies`), so far-away regions cost a handful of draws however much they hold.
+class HlodTree {
+public:
+    /// Builds from `objects` (normally `Scene::static_objects()`; index = object index).
+    void build(GraphicsDevice& device, const std::vector<SceneObject>& objects, const HlodSettings& settings = {});
+    void clear();
+
+    bool empty() const { return m_clusters.empty(); }
+    const HlodSettings& settings() const { return m_settings; }
+    /// Level 0 first (index = leaf index), then each coarser level.
+    const std::vector<HlodCluster>& clusters() const { return m_clusters; }
+    /// Clusters of the top level.
+    uint32_t first_root() const { return m_first_root; }
+    uint32_t root_count() const { return static_cast<uint32_t>(m_clusters.size()) - m_first_root; }
+    uint32_t leaf_count() const { return m_leaf_count; }
+    /// Level-0 cluster holding object `object`, or `kNoHlodCluster`.
+    uint32_t leaf_of(uint32_t object) const {
+        return object < m_object_leaves.size() ? m_object_leaves[object] : kNoHlodCluster;
+    }
+    /// Triangles across all proxies (tools and tests).
+    uint32_t proxy_triangle_count() const;
+
+private:
+    HlodSettings m_settings;
+    std::vector<HlodCluster> m_clusters;
+    std::vector<uint32_t> m_object_leaves;
+    uint32_t m_leaf_count = 0;
+    uint32_t m_first_root = 0;
+};
+
+} // namespace maya
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+/// Decoded image as tightly packed 8-bit RGBA rows, ready for `GraphicsDevice::create_texture`.
+struct ImageData {
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/// Decoded single-channel 16-bit image (heightmaps); 8-bit sources are scaled up to 16 bits.
+struct HeightImageData {
+    std::vector<uint16_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/// Decoded linear RGB float image (HDR environments), three floats per pixel.
+struct HdrImageData {
+    std::vector<float> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/// CPU-only image decoding (PNG, JPEG, TGA, BMP, ... via stb_image). Safe to call from worker
+/// threads; textures are created from the result on the render thread.
+class ImageLoader {
+public:
+    static bool decode(const void* bytes, size_t size, ImageData& out);
+    static bool read(const std::string& path, ImageData& out);
+    /// 16-bit grayscale (PNG, PGM, ...); color sources are converted to luminance.
+    static bool decode_gray16(const void* bytes, size_t size, HeightImageData& out);
+    static bool read_gray16(const std::string& path, HeightImageData& out);
+    /// Linear RGB floats (Radiance .hdr; LDR sources are converted from sRGB).
+    static bool decode_hdr(const void* bytes, size_t size, HdrImageData& out);
+    static bool read_hdr(const std::string& path, HdrImageData& out);
+};
+
+} // namespace maya
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "maya/core/image_loader.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+/// CPU-only image encoding for reference captures and bake output. PNG uses stored (uncompressed)
+/// deflate blocks, so files are large but byte-exact; EXR is uncompressed 32-bit float scanlines.
+class ImageWriter {
+public:
+    /// 8-bit RGBA as produced by `ImageLoader::decode`.
+    static std::vector<uint8_t> encode_png(const ImageData& image);
+    static bool write_png(const std::string& path, const ImageData& image);
+    /// Linear RGB floats as produced by `ImageLoader::decode_hdr`.
+    static std::vector<uint8_t> encode_exr(const HdrImageData& image);
+    static bool write_exr(const std::string& path, const HdrImageData& image);
+};
+
+} // namespace maya
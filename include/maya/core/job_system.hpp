@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace maya {
+
+/// Fixed pool of worker threads for CPU-side engine work (batching, culling, baking).
+/// `parallel_for` is the main entry point; the calling thread helps execute chunks,
+/// so nested calls from inside a job cannot deadlock.
+class JobSystem {
+public:
+    /// `worker_count` excludes the calling thread; 0 runs every job inline.
+    explicit JobSystem(uint32_t worker_count = default_worker_count());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /// Process-wide pool sized from `std::thread::hardware_concurrency`.
+    static JobSystem& instance() {
+        static JobSystem s_instance;
+        return s_instance;
+    }
+
+    static uint32_t default_worker_count();
+
+    uint32_t worker_count() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    /// Queues a fire-and-forget job.
+    void submit(std::function<void()> job);
+
+    /// Runs `fn(begin, end)` over `[0, count)` in chunks of at least `min_chunk` items and
+    /// returns once every chunk has finished.
+    void parallel_for(uint32_t count, uint32_t min_chunk, const std::function<void(uint32_t, uint32_t)>& fn);
+
+    /// Blocks until the queue is empty and no submitted job is running.
+    void wait_idle();
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_idle;
+    uint32_t m_active = 0;
+    bool m_stopping = false;
+};
+
+} // namespace maya
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "maya/math/bounds.hpp"
+#include "maya/math/spherical_harmonics.hpp"
+#include "maya/math/vector.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+struct HdrImageData;
+
+/// Projects an equirectangular (longitude/latitude) environment onto L2 SH. Row 0 looks along
+/// +y; column `x` faces `(sin(theta) cos(phi), cos(theta), sin(theta) sin(phi))` with
+/// `phi = 2 pi (x + 0.5) / width`. Rows are projected in parallel and summed in a fixed order,
+/// so the result does not depend on the worker count.
+math::SphericalHarmonicsL2 project_equirect_sh(const HdrImageData& image, JobSystem& jobs);
+
+/// Projects a cube map onto L2 SH. Faces are square, in the order +x, -x, +y, -y, +z, -z with
+/// the usual cube map orientation (image rows run along -y for the side faces).
+math::SphericalHarmonicsL2 project_cubemap_sh(const std::array<HdrImageData, 6>& faces, JobSystem& jobs);
+
+/// Reads an equirectangular HDR environment via `ImageLoader::read_hdr` and projects it.
+bool load_environment_sh(const std::string& path, JobSystem& jobs, math::SphericalHarmonicsL2& out);
+
+/// Regular grid of SH light probes over `bounds`. `sample` blends the eight surrounding probes
+/// trilinearly; positions outside the grid use the nearest face.
+class LightProbeGrid {
+public:
+    LightProbeGrid() = default;
+    /// `nx * ny * nz` probes (at least one per axis) spread from `bounds.min` to `bounds.max`,
+    /// all initialized to `initial`.
+    LightProbeGrid(const math::Aabb& bounds, uint32_t nx, uint32_t ny, uint32_t nz,
+        const math::SphericalHarmonicsL2& initial = {});
+
+    bool empty() const { return m_probes.empty(); }
+    const math::Aabb& bounds() const { return m_bounds; }
+    uint32_t count_x() const { return m_nx; }
+    uint32_t count_y() const { return m_ny; }
+    uint32_t count_z() const { return m_nz; }
+    uint32_t probe_count() const { return static_cast<uint32_t>(m_probes.size()); }
+
+    math::Vec3 probe_position(uint32_t x, uint32_t y, uint32_t z) const;
+    math::SphericalHarmonicsL2& probe(uint32_t x, uint32_t y, uint32_t z) { return m_probes[index(x, y, z)]; }
+    const math::SphericalHarmonicsL2& probe(uint32_t x, uint32_t y, uint32_t z) const {
+        return m_probes[index(x, y, z)];
+    }
+
+    /// Trilinear blend of the probes around `position`.
+    math::SphericalHarmonicsL2 sample(const math::Vec3& position) const;
+
+private:
+    uint32_t index(uint32_t x, uint32_t y, uint32_t z) const { return (z * m_ny + y) * m_nx + x; }
+
+    math::Aabb m_bounds;
+    uint32_t m_nx = 0;
+    uint32_t m_ny = 0;
+    uint32_t m_nz = 0;
+    std::vector<math::SphericalHarmonicsL2> m_probes;
+};
+
+} // namespace maya
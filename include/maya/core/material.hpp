@@ -1,6 +1,8 @@
 #pragma once
 
 #include "maya/rhi/resource.hpp"
+#include <cstddef>
+#include <functional>
 
 namespace maya {
 
@@ -13,4 +15,23 @@ struct Material {
     Texture* texture = nullptr;
 };
 
+/// Identity of a material's GPU bindings, used to group draws that can share state.
+struct MaterialKey {
+    ResourceHandle pipeline = INVALID_HANDLE;
+    const Texture* texture = nullptr;
+
+    explicit MaterialKey(const Material& material)
+        : pipeline(material.pipeline.handle), texture(material.texture) {}
+
+    bool operator==(const MaterialKey& other) const {
+        return pipeline == other.pipeline && texture == other.texture;
+    }
+};
+
+struct MaterialKeyHash {
+    size_t operator()(const MaterialKey& key) const {
+        return std::hash<const void*>()(key.texture) ^ (std::hash<ResourceHandle>()(key.pipeline) << 1);
+    }
+};
+
 } // namespace maya
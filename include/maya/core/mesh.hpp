@@ -1,28 +1,74 @@
 #pragma once
 
+#include "maya/math/bounds.hpp"
 #include "maya/rhi/graphics_device.hpp"
 #include "maya/rhi/vertex.hpp"
 #include <vector>
 
 namespace maya {
 
+/// GPU vertex/index buffers plus the CPU copy they were built from. The CPU copy serves
+/// passes that read geometry back (static batching, HLOD, baking, dynamic batching) and can be
+/// dropped with `release_cpu_data` once they have run; bounds and counts stay valid.
 class Mesh {
 public:
     Mesh(GraphicsDevice& device, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
-        : m_device(device), m_index_count(static_cast<uint32_t>(indices.size())) {
+        : m_device(device), m_vertices(vertices), m_indices(indices),
+          m_vertex_count(static_cast<uint32_t>(vertices.size())),
+          m_index_count(static_cast<uint32_t>(indices.size())) {
         m_vb = m_device.create_vertex_buffer(vertices.data(), vertices.size() * sizeof(Vertex));
         m_ib = m_device.create_index_buffer(indices.data(), indices.size() * sizeof(uint32_t));
+        for (const Vertex& v : vertices) {
+            m_local_bounds.expand(v.position);
+        }
     }
 
+    ~Mesh() {
+        m_device.destroy_vertex_buffer(m_vb);
+        m_device.destroy_index_buffer(m_ib);
+    }
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
     void draw() {
         m_device.bind_vertex_buffer(m_vb, 0);
         m_device.draw_indexed(m_ib, m_index_count);
     }
 
+    /// Binds the vertex buffer once; follow with `draw_range` for each sub-range.
+    void bind() {
+        m_device.bind_vertex_buffer(m_vb, 0);
+    }
+
+    void draw_range(uint32_t first_index, uint32_t index_count) {
+        m_device.draw_indexed_range(m_ib, first_index, index_count);
+    }
+
+    /// CPU copy of the geometry; empty after `release_cpu_data`.
+    const std::vector<Vertex>& vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& indices() const { return m_indices; }
+    bool has_cpu_data() const { return m_vertices.size() == m_vertex_count && m_indices.size() == m_index_count; }
+    /// Frees the CPU copy; the GPU buffers are unaffected.
+    void release_cpu_data() {
+        std::vector<Vertex>().swap(m_vertices);
+        std::vector<uint32_t>().swap(m_indices);
+    }
+
+    uint32_t vertex_count() const { return m_vertex_count; }
+    uint32_t index_count() const { return m_index_count; }
+
+    /// Object-space bounds of all vertex positions (empty for an empty mesh).
+    const math::Aabb& local_bounds() const { return m_local_bounds; }
+
 private:
     GraphicsDevice& m_device;
     VertexBufferHandle m_vb;
     IndexBufferHandle m_ib;
+    std::vector<Vertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    math::Aabb m_local_bounds;
+    uint32_t m_vertex_count;
     uint32_t m_index_count;
 };
 
@@ -3,12 +3,24 @@
 #include "maya/core/mesh.hpp"
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace maya {
 
+/// CPU-side geometry, e.g. parsed on a loader thread before the GPU mesh is created.
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
 class ModelLoader {
 public:
     static std::unique_ptr<Mesh> load_obj(GraphicsDevice& device, const std::string& path);
+
+    /// Reads and parses an OBJ file without touching the GPU; safe off the main thread.
+    static bool read_obj(const std::string& path, MeshData& out);
+    /// Parses OBJ text; `name` is only used in error messages.
+    static bool parse_obj(const std::string& content, const std::string& name, MeshData& out);
 };
 
 } // namespace maya
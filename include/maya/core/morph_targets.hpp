@@ -0,0 +1,96 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/core/streaming_buffer.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+/// Sparse blend shape: only the vertices it moves, in ascending order. Each delta is stored
+/// as eight floats (position xyz, 0, normal xyz, 0) so it adds onto a `Vertex`'s padded
+/// position and normal with one `math::simd::Float4` op each.
+struct MorphTarget {
+    std::string name;
+    std::vector<uint32_t> vertices;
+    std::vector<float> deltas;
+    /// False when every normal delta is zero; evaluation then skips renormalization for it.
+    bool has_normals = false;
+
+    uint32_t delta_count() const { return static_cast<uint32_t>(vertices.size()); }
+    size_t memory_bytes() const { return vertices.size() * sizeof(uint32_t) + deltas.size() * sizeof(float); }
+};
+
+/// Base geometry plus its morph targets.
+struct MorphedMeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MorphTarget> targets;
+};
+
+/// Sparse deltas from `base` to `shape` (same vertex count and order). Vertices whose position
+/// and normal both move less than `epsilon` per component are left out.
+MorphTarget make_morph_target(const std::string& name, const std::vector<Vertex>& base,
+    const std::vector<Vertex>& shape, float epsilon = 1e-6f);
+
+/// Writes vertices `[first, first + count)` of `mesh` to `out[0, count)` with every target whose
+/// `|weight| >= weight_epsilon` added in. Normals are renormalized when a normal delta applied.
+void apply_morph_targets(const MorphedMeshData& mesh, const float* weights, float weight_epsilon, uint32_t first,
+    uint32_t count, Vertex* out);
+
+/// Morph target evaluation for many meshes: per frame, every instance's weighted targets are
+/// accumulated in parallel into one vertex array (chunks span instances, as in
+/// `SkinningSystem`), which is streamed to the GPU and drawn with one indexed range per instance.
+class MorphTargetSystem {
+public:
+    /// Targets weighted below `weight_epsilon` are skipped.
+    MorphTargetSystem(GraphicsDevice& device, uint32_t max_vertices, uint32_t max_indices,
+        float weight_epsilon = 1e-3f);
+
+    /// `mesh` is borrowed and must outlive the system. Returns the instance id, or ~0u if the
+    /// streaming buffer has no room for the mesh.
+    uint32_t add_instance(const MorphedMeshData* mesh, const Material& material);
+    uint32_t instance_count() const { return static_cast<uint32_t>(m_instances.size()); }
+
+    /// One weight per target of the instance's mesh, all zero initially.
+    std::vector<float>& weights(uint32_t instance) { return m_instances[instance].weights; }
+    math::Mat4& model_matrix(uint32_t instance) { return m_instances[instance].model_matrix; }
+
+    /// Evaluates every instance, then uploads the result.
+    void update(JobSystem& jobs);
+    void render(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const math::Mat4& view_projection,
+        const DirectionalLighting& lighting, const math::Vec3& camera_position_world) const;
+
+    /// Morphed model-space vertices of the last `update`, all instances back to back.
+    const std::vector<Vertex>& morphed_vertices() const { return m_vertices; }
+    uint32_t first_vertex(uint32_t instance) const { return m_instances[instance].first_vertex; }
+
+private:
+    struct Instance {
+        const MorphedMeshData* mesh;
+        Material material;
+        std::vector<float> weights;
+        math::Mat4 model_matrix = math::Mat4::identity();
+        uint32_t first_vertex = 0;
+        uint32_t first_index = 0;
+    };
+
+    StreamingGeometryBuffer m_buffer;
+    float m_weight_epsilon;
+    std::vector<Instance> m_instances;
+    /// Instance `first_vertex` values plus the total, for mapping chunks to instances.
+    std::vector<uint32_t> m_vertex_offsets{0};
+    std::vector<Vertex> m_vertices;
+    /// Every instance's indices rebased to its `first_vertex`; rebuilt only when instances change.
+    std::vector<uint32_t> m_indices;
+};
+
+} // namespace maya
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "maya/core/debug_draw.hpp"
+#include "maya/core/streaming_buffer.hpp"
+#include "maya/math/frustum.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+/// Where and how an emitter spawns particles; all ranges are uniform.
+struct ParticleEmitterSettings {
+    math::Vec3 position;
+    /// Particles spawn uniformly inside this sphere around `position`.
+    float spawn_radius = 0.0f;
+    /// Initial velocity: `direction * speed` plus a random vector up to `spread * speed` long.
+    math::Vec3 direction{0.0f, 1.0f, 0.0f};
+    float spread = 0.25f;
+    float speed_min = 1.0f;
+    float speed_max = 2.0f;
+    float lifetime_min = 1.0f;
+    float lifetime_max = 2.0f;
+    float size_min = 0.05f;
+    float size_max = 0.1f;
+    uint32_t color = kDebugWhite;
+    /// Continuous emission in particles per second (0 for bursts only).
+    float rate = 0.0f;
+};
+
+/// Radial force: accelerates toward `position` (away for negative `strength`), falling off
+/// with squared distance beyond `radius`.
+struct ParticleAttractor {
+    math::Vec3 position;
+    float strength = 1.0f;
+    float radius = 1.0f;
+};
+
+struct ParticleSimulationSettings {
+    math::Vec3 gravity{0.0f, -9.81f, 0.0f};
+    /// Linear drag: velocity loses this fraction per second.
+    float drag = 0.1f;
+    std::vector<ParticleAttractor> attractors;
+    /// Particles stay on the positive side of every plane (see `math::Plane`).
+    std::vector<math::Plane> colliders;
+    /// Normal velocity kept (and reversed) on impact.
+    float restitution = 0.4f;
+    /// Tangential velocity lost on impact.
+    float friction = 0.2f;
+};
+
+/// CPU particles in structure-of-arrays storage (position, velocity, remaining life, color,
+/// size), simulated four at a time with `math::simd::Float4` and split across the job system.
+///
+/// Dead particles are removed by moving the last live particle into their slot, so order is
+/// not kept and removal costs nothing for the survivors. Camera-facing quads are written
+/// straight into a streamed vertex buffer (see `ParticleRenderer`).
+class ParticleSystem {
+public:
+    explicit ParticleSystem(uint32_t capacity, uint64_t seed = 1);
+
+    uint32_t add_emitter(const ParticleEmitterSettings& settings);
+    ParticleEmitterSettings& emitter(uint32_t id) { return m_emitters[id].settings; }
+    uint32_t emitter_count() const { return static_cast<uint32_t>(m_emitters.size()); }
+    /// Spawns up to `count` particles now; returns how many fit.
+    uint32_t burst(uint32_t emitter, uint32_t count);
+
+    ParticleSimulationSettings& simulation() { return m_simulation; }
+
+    /// Emits for `delta_time`, then integrates, collides, ages and removes dead particles.
+    void update(float delta_time, JobSystem& jobs);
+    void clear() { m_count = 0; }
+
+    uint32_t size() const { return m_count; }
+    uint32_t capacity() const { return m_capacity; }
+    math::Vec3 position(uint32_t i) const { return math::Vec3(m_px[i], m_py[i], m_pz[i]); }
+    math::Vec3 velocity(uint32_t i) const { return math::Vec3(m_vx[i], m_vy[i], m_vz[i]); }
+    float life(uint32_t i) const { return m_life[i]; }
+
+    /// Writes six vertices (two triangles) per particle facing along `right` x `up` to `out`,
+    /// which must hold `size() * 6`.
+    void write_billboards(const math::Vec3& right, const math::Vec3& up, DebugVertex* out, JobSystem& jobs) const;
+
+private:
+    struct Emitter {
+        ParticleEmitterSettings settings;
+        /// Fractional particles owed by `rate`.
+        float accumulator = 0.0f;
+    };
+
+    float random01();
+    void spawn(const ParticleEmitterSettings& settings);
+    /// Simulates particles `[begin, end)` (a multiple of four from `begin`) and appends the dead
+    /// ones to `dead`.
+    void simulate_range(uint32_t begin, uint32_t end, float delta_time, std::vector<uint32_t>& dead);
+    void remove_dead();
+
+    uint32_t m_capacity;
+    uint32_t m_count = 0;
+    uint64_t m_rng;
+    // Capacity rounded up to a multiple of four so the last block can be loaded whole.
+    std::vector<float> m_px, m_py, m_pz;
+    std::vector<float> m_vx, m_vy, m_vz;
+    std::vector<float> m_life;
+    std::vector<float> m_size;
+    std::vector<uint32_t> m_color;
+
+    std::vector<Emitter> m_emitters;
+    ParticleSimulationSettings m_simulation;
+    /// Dead indices per simulation chunk, ascending within each.
+    std::vector<std::vector<uint32_t>> m_dead;
+};
+
+/// Streams a `ParticleSystem`'s billboards and draws them with one non-indexed draw.
+class ParticleRenderer {
+public:
+    /// `pipeline` is normally `vertexDebug` + `fragmentUnlit` from `triangle.metal`.
+    ParticleRenderer(GraphicsDevice& device, PipelineHandle pipeline);
+
+    /// `view` is the camera's view matrix (its rows give the billboard axes).
+    void render(const ParticleSystem& particles, UniformBufferHandle uniform_buffer, const math::Mat4& view,
+        const math::Mat4& view_projection, JobSystem& jobs);
+
+private:
+    GraphicsDevice& m_device;
+    PipelineHandle m_pipeline;
+    StreamingVertexBuffer m_buffer;
+    std::vector<DebugVertex> m_vertices;
+};
+
+} // namespace maya
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "maya/core/bvh.hpp"
+#include "maya/core/image_loader.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class Camera;
+class JobSystem;
+class Scene;
+
+struct PathTracerSettings {
+    uint32_t width = 640;
+    uint32_t height = 360;
+    /// Surface interactions per path; rays leaving the last one still pick up the environment.
+    uint32_t max_bounces = 4;
+    /// Side of the square pixel tiles handed to the job system (rounded up to even).
+    uint32_t tile_size = 16;
+    uint32_t seed = 1;
+};
+
+/// CPU reference renderer for a `Scene`, meant for golden images and lighting validation
+/// rather than interactive use. Surfaces are Lambertian with the interpolated vertex color as
+/// albedo (textures live only on the GPU and are ignored). Light comes from the
+/// `DirectionalLighting` sun, with shadow rays, and from `ambient` as radiance from every
+/// escaping direction. With those conventions an unoccluded surface matches what the
+/// rasterizer's ambient and diffuse terms produce; specular highlights are not traced.
+///
+/// Each `render_sample` adds one path per pixel to the running mean. Pixels are traced in 2x2
+/// packets (`TriangleBvh::intersect4` / `occluded4`) per tile, tiles spread over the job system.
+/// Random numbers are seeded per pixel and sample, so images do not depend on the worker count.
+class PathTracer {
+public:
+    explicit PathTracer(const PathTracerSettings& settings = {});
+
+    /// Snapshots the world-space triangles of every object and static object with a mesh, and
+    /// clears the accumulated samples.
+    void set_scene(const Scene& scene);
+    /// Traces one sample per pixel through the camera's current view.
+    void render_sample(const Camera& camera, const DirectionalLighting& lighting, JobSystem& jobs);
+    void render_sample(const math::Mat4& inverse_view_projection, const math::Vec3& camera_position,
+        const DirectionalLighting& lighting, JobSystem& jobs);
+    /// Clears the accumulated samples (call after moving the camera or changing the lighting).
+    void reset();
+
+    const PathTracerSettings& settings() const { return m_settings; }
+    uint32_t sample_count() const { return m_samples; }
+    uint32_t triangle_count() const { return static_cast<uint32_t>(m_bvh.triangles().size()); }
+
+    /// Mean linear radiance of pixel (x, y); row 0 is the top of the image.
+    math::Vec3 pixel(uint32_t x, uint32_t y) const;
+    /// Mean linear radiance of every pixel.
+    HdrImageData image() const;
+    /// `image` clamped to [0, 1] and sRGB-encoded, opaque.
+    ImageData image_srgb() const;
+    bool write_png(const std::string& path) const;
+    bool write_exr(const std::string& path) const;
+
+private:
+    /// Vertex attributes of one source triangle, indexed by `BvhTriangle::id`.
+    struct TriangleShading {
+        math::Vec3 normals[3];
+        math::Vec3 colors[3];
+    };
+
+    void trace_tile(uint32_t tile, const math::Mat4& inverse_view_projection, const math::Vec3& camera_position,
+        const DirectionalLighting& lighting);
+
+    PathTracerSettings m_settings;
+    TriangleBvh m_bvh;
+    std::vector<TriangleShading> m_shading;
+    /// Running radiance sums, RGB per pixel.
+    std::vector<float> m_accumulation;
+    uint32_t m_samples = 0;
+};
+
+} // namespace maya
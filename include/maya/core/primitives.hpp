@@ -1,14 +1,62 @@
 #pragma once
 
 #include "maya/core/mesh.hpp"
+#include "maya/core/model_loader.hpp"
 #include "maya/rhi/graphics_device.hpp"
 #include "maya/math/vector.hpp"
+#include <cstdint>
 #include <memory>
 
 namespace maya {
 
-/// Axis-aligned cube centered at the origin with vertex colors (for unlit pipeline).
+/// Axis-aligned cube centered at the origin with vertex colors (for unlit pipeline). Each face
+/// has its own four vertices, so normals are flat.
 std::unique_ptr<Mesh> make_color_cube(GraphicsDevice& device, float half_extent,
     const math::Vec3& color_tint = math::Vec3(1.0f, 1.0f, 1.0f));
 
+// -----------------------------------------------------------------------------
+// Procedural meshes
+// -----------------------------------------------------------------------------
+// CPU-side generators, safe off the main thread. Shapes are centered at the origin with +y up
+// and wound CCW seen from outside. Curved surfaces get smooth normals; flat faces and caps get
+// their own vertices with the face normal. `v` runs top to bottom, `u` around the y axis.
+// Triangles are ordered by `optimize_vertex_cache` and vertices by `optimize_vertex_fetch`.
+
+/// Grid of `segments_x * segments_z` quads in the xz plane, facing +y.
+MeshData generate_plane(float size_x, float size_z, uint32_t segments_x = 1, uint32_t segments_z = 1,
+    const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Box with `segments` quads along each edge of every face.
+MeshData generate_box(const math::Vec3& half_extents, uint32_t segments = 1,
+    const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Latitude/longitude sphere: `segments` around y, `rings` from pole to pole.
+MeshData generate_uv_sphere(float radius, uint32_t segments = 32, uint32_t rings = 16,
+    const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Icosahedron with each triangle split in four `subdivisions` times, projected onto the sphere;
+/// evenly sized triangles without pole pinching. Vertices are split along the `u` seam.
+MeshData generate_icosphere(float radius, uint32_t subdivisions = 3,
+    const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Cylinder along y of total `height`, `stacks` rows of side quads, optionally capped.
+MeshData generate_cylinder(float radius, float height, uint32_t segments = 32, uint32_t stacks = 1,
+    bool caps = true, const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Cone with its base at `-height / 2` and apex at `+height / 2`, optionally capped.
+MeshData generate_cone(float radius, float height, uint32_t segments = 32, uint32_t stacks = 1,
+    bool cap = true, const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Torus around y: `segments` around the ring of radius `major_radius`, `sides` around the tube.
+MeshData generate_torus(float major_radius, float minor_radius, uint32_t segments = 48, uint32_t sides = 24,
+    const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Cylinder of `height` (excluding the end caps) closed by hemispheres of `radius`, with `rings`
+/// latitude rows per hemisphere.
+MeshData generate_capsule(float radius, float height, uint32_t segments = 32, uint32_t rings = 8,
+    const math::Vec4& color = math::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+/// Uploads generated (or loaded) geometry.
+std::unique_ptr<Mesh> make_mesh(GraphicsDevice& device, const MeshData& data);
+
 } // namespace maya
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "maya/core/image_loader.hpp"
+#include "maya/core/model_loader.hpp"
+#include "maya/math/noise.hpp"
+#include "maya/math/vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+enum class NoiseVariant {
+    /// One octave of `fractal.basis`.
+    Single,
+    Fbm,
+    Ridged,
+    Warped,
+};
+
+/// Noise function for the batch routines below. 2D callers sample `(x, y)`, 3D callers
+/// `(x, y, z)`; the first octave is sampled at `(p + offset) * fractal.frequency`.
+struct NoiseSettings {
+    math::noise::Fractal fractal;
+    NoiseVariant variant = NoiseVariant::Fbm;
+    /// Shifts the input so differently seeded fields use different parts of the lattice.
+    math::Vec3 offset;
+};
+
+/// Evaluates `count` samples of 2D noise (`z == nullptr`) or 3D noise into `out`. Samples go
+/// through the `Float4` templates eight at a time (two independent vectors, which hides the
+/// latency of the long dependency chains); the tail is evaluated with the scalar templates,
+/// which give the same values.
+void evaluate_noise(const NoiseSettings& settings, const float* x, const float* y, const float* z, float* out,
+    size_t count);
+
+/// Fills `out` (`width * height`, row-major) with 2D noise at `origin + (col, row) * step`.
+/// Rows are spread over `jobs`.
+void fill_noise_grid(const NoiseSettings& settings, uint32_t width, uint32_t height, const math::Vec2& origin,
+    float step, std::vector<float>& out, JobSystem& jobs);
+
+/// Fills `out` (`width * height * depth`, x fastest) with 3D noise at
+/// `origin + (x, y, z) * step`. Rows are spread over `jobs`.
+void fill_noise_volume(const NoiseSettings& settings, uint32_t width, uint32_t height, uint32_t depth,
+    const math::Vec3& origin, float step, std::vector<float>& out, JobSystem& jobs);
+
+/// 16-bit heightmap for `Heightfield::from_image`: noise over sample coordinates (one unit per
+/// sample, so `fractal.frequency` is in cycles per sample), mapped from [-1, 1] to [0, 65535].
+HeightImageData make_noise_heightmap(const NoiseSettings& settings, uint32_t width, uint32_t height,
+    JobSystem& jobs);
+
+/// Opaque RGBA texture blending from `low` to `high` by noise over texel coordinates
+/// (`fractal.frequency` in cycles per texel).
+ImageData make_noise_texture(const NoiseSettings& settings, uint32_t width, uint32_t height,
+    const math::Vec4& low, const math::Vec4& high, JobSystem& jobs);
+
+/// Moves every vertex along its normal by `amplitude` times 3D noise at its position, then
+/// recomputes area-weighted smooth normals from the displaced triangles. Vertices with a zero
+/// normal are left untouched. Normals are accumulated per displaced position, so vertices split
+/// at UV seams stay smooth; vertices split for hard edges move apart along their own normals.
+void displace_mesh(MeshData& mesh, const NoiseSettings& settings, float amplitude, JobSystem& jobs);
+
+} // namespace maya
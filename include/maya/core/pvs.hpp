@@ -0,0 +1,84 @@
+#pragma once
+
+#include "maya/math/bounds.hpp"
+#include "maya/math/vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+struct SceneObject;
+
+/// Returned by `PotentiallyVisibleSet::cell_at` outside the baked region.
+constexpr uint32_t kNoPvsCell = ~0u;
+
+struct PvsBakeSettings {
+    /// Edge length of the cubic view cells.
+    float cell_size = 4.0f;
+    /// Region divided into cells; empty uses the bounds of the baked objects.
+    math::Aabb bounds;
+    /// Rays from random points in a cell to random points on an object's surface before the
+    /// object is declared hidden from that cell. More rays find smaller gaps.
+    uint32_t rays_per_object = 32;
+    /// Extra rays per cell in random directions; whatever they hit first is visible. Cheap
+    /// coverage of objects seen through openings that targeted rays rarely pass.
+    uint32_t random_rays = 256;
+    /// Same seed, objects and settings give the same result regardless of thread count.
+    uint32_t seed = 1;
+};
+
+/// Precomputed static visibility: space is divided into a grid of view cells, and for each
+/// cell a bitset records which static objects can be seen from anywhere inside it. Rows are
+/// stored zero-run-length compressed; `decompress` expands the row of the camera's cell once,
+/// after which each object costs one bit test. Object indices are those of the list baked
+/// (normally `Scene::static_objects()`). Visibility is sampled, so an object is marked hidden
+/// from a cell when none of the rays cast toward it got through.
+class PotentiallyVisibleSet {
+public:
+    /// Ray-casts `objects` (those with a mesh) against each other from every cell on `jobs`.
+    static PotentiallyVisibleSet bake(const std::vector<SceneObject>& objects, const PvsBakeSettings& settings,
+        JobSystem& jobs);
+
+    bool empty() const { return m_row_offsets.empty(); }
+    uint32_t object_count() const { return m_object_count; }
+    uint32_t cell_count() const { return m_dims[0] * m_dims[1] * m_dims[2]; }
+    const math::Aabb& bounds() const { return m_bounds; }
+    float cell_size() const { return m_cell_size; }
+    /// Bytes of compressed rows.
+    size_t compressed_size() const { return m_rows.size(); }
+
+    /// Cell containing `position`, or `kNoPvsCell` outside the baked region.
+    uint32_t cell_at(const math::Vec3& position) const;
+    /// Writes the visibility row of `cell` as 64-bit words (bit `i` = object `i`); every bit is
+    /// set for `kNoPvsCell`.
+    void decompress(uint32_t cell, std::vector<uint64_t>& bits) const;
+    /// Single lookup in a row from `decompress`; objects past the baked count are visible.
+    static bool is_visible(const std::vector<uint64_t>& bits, uint32_t object) {
+        const uint32_t word = object >> 6;
+        return word >= bits.size() || ((bits[word] >> (object & 63)) & 1u);
+    }
+    /// Objects visible from `cell` (tools and tests).
+    uint32_t visible_count(uint32_t cell) const;
+
+    std::vector<uint8_t> serialize() const;
+    /// False (and `out` untouched) if `data` is not a valid PVS blob.
+    static bool deserialize(const std::vector<uint8_t>& data, PotentiallyVisibleSet& out);
+    bool save(const std::string& path) const;
+    /// Reads a file written by `save`, resolved through `FileSystem`.
+    static bool load(const std::string& path, PotentiallyVisibleSet& out);
+
+private:
+    math::Aabb m_bounds;
+    float m_cell_size = 1.0f;
+    uint32_t m_dims[3] = {0, 0, 0};
+    uint32_t m_object_count = 0;
+    /// `cell_count() + 1` offsets into `m_rows`.
+    std::vector<uint32_t> m_row_offsets;
+    /// Row bytes with each run of zero bytes replaced by a zero and the run length (1-255).
+    std::vector<uint8_t> m_rows;
+};
+
+} // namespace maya
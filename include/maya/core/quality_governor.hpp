@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+/// Returned by `QualityRegistry::find` for unknown names.
+constexpr uint32_t kNoQualityKnob = ~0u;
+
+/// One adjustable quality setting (LOD bias, draw distance, update rates, ...), stepped through
+/// discrete levels from 0 (cheapest) to `level_count - 1` (best).
+struct QualityKnob {
+    std::string name;
+    uint32_t level_count = 2;
+    uint32_t level = 1;
+    /// Higher means more visible when lowered: such knobs are reduced last and restored first.
+    int32_t importance = 0;
+    /// Applies a level to the owning system; called on registration and on every change.
+    std::function<void(uint32_t level)> apply;
+};
+
+/// Knobs other systems plug in so a `QualityGovernor` (or a settings menu) can drive them.
+class QualityRegistry {
+public:
+    /// Applies the knob's starting level and returns its id.
+    uint32_t add(QualityKnob knob);
+    /// Clamps to the knob's range; calls `apply` only if the level changes.
+    void set_level(uint32_t knob, uint32_t level);
+    uint32_t level(uint32_t knob) const { return m_knobs[knob].level; }
+    uint32_t find(const std::string& name) const;
+    const std::vector<QualityKnob>& knobs() const { return m_knobs; }
+
+private:
+    std::vector<QualityKnob> m_knobs;
+};
+
+struct QualityGovernorSettings {
+    float target_frame_ms = 16.6f;
+    /// Frame-time percentile compared against the target (0.9 = 90th, 0 = fastest frame), so a
+    /// lone hitch in a window does not count but a steady tail does.
+    float percentile = 0.9f;
+    /// Frames per evaluation window.
+    uint32_t window_frames = 60;
+    /// Lower quality when the percentile exceeds `target * (1 + degrade_margin)`.
+    float degrade_margin = 0.05f;
+    /// Raise quality only below `target * (1 - upgrade_margin)`...
+    float upgrade_margin = 0.2f;
+    /// ...for this many consecutive windows. Together with the margins this is the hysteresis
+    /// that keeps the governor from flipping a knob back and forth around the target.
+    uint32_t upgrade_windows = 3;
+    /// Frames ignored after a change while its effect settles.
+    uint32_t cooldown_frames = 30;
+};
+
+/// Watches measured frame times and steps registry knobs one level at a time: down (least
+/// important knob first) when the windowed percentile is over budget, up (most important first)
+/// after it has stayed comfortably under. Headless; feed it any frame-time trace.
+class QualityGovernor {
+public:
+    enum class Decision : uint8_t { None, Degraded, Upgraded };
+
+    explicit QualityGovernor(QualityRegistry& registry, const QualityGovernorSettings& settings = {});
+
+    /// Records one frame; evaluates and possibly changes a knob when a window completes.
+    Decision record_frame(float frame_ms);
+
+    const QualityGovernorSettings& settings() const { return m_settings; }
+    void set_settings(const QualityGovernorSettings& settings);
+    /// Percentile of the last completed window (0 before the first).
+    float last_percentile_ms() const { return m_last_percentile_ms; }
+    uint32_t degrade_count() const { return m_degrades; }
+    uint32_t upgrade_count() const { return m_upgrades; }
+
+private:
+    bool degrade();
+    bool upgrade();
+
+    QualityRegistry& m_registry;
+    QualityGovernorSettings m_settings;
+    std::vector<float> m_window;
+    std::vector<float> m_scratch;
+    uint32_t m_cooldown = 0;
+    uint32_t m_good_windows = 0;
+    float m_last_percentile_ms = 0.0f;
+    uint32_t m_degrades = 0;
+    uint32_t m_upgrades = 0;
+};
+
+} // namespace maya
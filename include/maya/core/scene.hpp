@@ -1,25 +1,42 @@
 #pragma once
 
+#include "maya/core/dynamic_batch.hpp"
+#include "maya/core/hlod.hpp"
+#include "maya/core/light_probes.hpp"
 #include "maya/core/material.hpp"
+#include "maya/core/pvs.hpp"
 #include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/core/static_batch.hpp"
 #include "maya/math/matrix.hpp"
 #include "maya/rhi/graphics_device.hpp"
 #include "maya/rhi/resource.hpp"
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace maya {
 
+class JobSystem;
 class Mesh;
+class ViewSet;
 
 /// Per-object CPU state updated each frame before `render`.
 struct SceneObject {
     Mesh* mesh = nullptr;
     Material material{};
     math::Mat4 model_matrix = math::Mat4::identity();
+    /// Static objects never move after load and are merged by `Scene::build_static_batches`.
+    bool is_static = false;
 };
 
+/// Writes `SceneDrawUniforms` for one draw and binds the material's pipeline, uniform slot 1
+/// and texture. Shared with renderers that draw outside `Scene` (e.g. `SkinningSystem`).
+void apply_draw_state(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const Material& material,
+    const math::Mat4& model_matrix, const math::Mat4& view_projection, const DirectionalLighting& lighting,
+    const math::Vec3& camera_position_world);
+
 /// Owns meshes and a flat list of drawable objects (no hierarchy yet).
 class Scene {
 public:
@@ -28,19 +45,99 @@ public:
 
     void add_object(std::unique_ptr<Mesh> mesh, Material material);
 
+    /// Removes every object in `objects()` that draws one of `meshes`, then frees those meshes
+    /// (streamed-out content). Object order is kept; later indices shift down. Meshes not owned
+    /// here or merged by `build_static_batches` are skipped. Returns the number freed.
+    uint32_t remove_meshes(const std::vector<const Mesh*>& meshes);
+
+    /// Adds an object that keeps `model_matrix` for its lifetime (see `build_static_batches`).
+    void add_static_object(std::unique_ptr<Mesh> mesh, Material material, const math::Mat4& model_matrix);
+
+    /// Moves every `is_static` object out of `objects()` into per-material world-space batches.
+    /// Call once after loading; static objects added later are drawn individually until the
+    /// next call, which rebuilds all batches. Returns the number of batches.
+    uint32_t build_static_batches(GraphicsDevice& device, const StaticBatchSettings& settings = {});
+
+    /// Frees the CPU geometry copy of owned meshes nothing reads back: static objects keep theirs
+    /// (batch rebuilds, HLOD, PVS bakes) and so do dynamic meshes eligible for dynamic batching.
+    /// Call after `enable_dynamic_batching`; `PathTracer::set_scene` skips dynamic objects
+    /// released here (with a warning), so trace before releasing.
+    void release_cpu_geometry();
+
+    /// Creates the per-frame batcher for small dynamic meshes (see `DynamicBatcher`).
+    void enable_dynamic_batching(GraphicsDevice& device, const DynamicBatchSettings& settings = {});
+
+    /// Re-batches eligible dynamic objects from their current model matrices. Call each frame
+    /// after updating `objects()` and before `render`; no-op unless batching is enabled.
+    void build_dynamic_batches(JobSystem& jobs);
+
+    const DynamicBatcher* dynamic_batcher() const { return m_dynamic_batcher.get(); }
+
     std::vector<SceneObject>& objects() { return m_objects; }
     const std::vector<SceneObject>& objects() const { return m_objects; }
 
-    uint32_t drawable_count() const { return static_cast<uint32_t>(m_objects.size()); }
+    /// Source objects merged into `static_batches()`; `StaticBatchRange::source_object` indexes this.
+    const std::vector<SceneObject>& static_objects() const { return m_static_objects; }
+    const std::vector<StaticBatch>& static_batches() const { return m_static_batches; }
+
+    /// Builds merged, simplified proxies over `static_objects()` (see `HlodTree`); call after
+    /// `build_static_batches`. Views culled by `ViewSet` then draw distant clusters as proxies.
+    void build_hlod(GraphicsDevice& device, const HlodSettings& settings = {});
+    /// Null until `build_hlod` produced at least one cluster.
+    const HlodTree* hlod() const { return m_hlod.empty() ? nullptr : &m_hlod; }
 
-    /// Binds pipeline, uniforms, optional texture, and issues draws for every object.
+    /// Static visibility baked from `static_objects()` (see `PotentiallyVisibleSet::bake`), used by
+    /// `ViewSet::cull` for views with `CullView::use_pvs`. Rejected (returns false) if it was baked
+    /// for a different number of static objects; an empty set clears it.
+    bool set_pvs(PotentiallyVisibleSet pvs);
+    /// Null when no PVS is set.
+    const PotentiallyVisibleSet* pvs() const { return m_pvs.empty() ? nullptr : &m_pvs; }
+
+    /// Probes that replace `DirectionalLighting::ambient` per draw: objects sample them at their
+    /// model translation, static batches at their bounds center. Dynamic batches and HLOD proxies
+    /// keep the global ambient. An empty grid clears them.
+    void set_light_probes(LightProbeGrid probes) { m_light_probes = std::move(probes); }
+    /// Null when no probes are set.
+    const LightProbeGrid* light_probes() const { return m_light_probes.empty() ? nullptr : &m_light_probes; }
+
+    /// Advances whenever meshes, objects, static batches, HLOD or the PVS change through Scene methods,
+    /// so caches keyed by object index (e.g. `ViewSet` temporal culling) can reset.
+    uint64_t structure_version() const { return m_structure_version; }
+
+    /// Draw calls `render` issues for the current batching state.
+    uint32_t drawable_count() const;
+
+    /// Binds pipeline, uniforms, optional texture, and issues draws for every object and batch.
     void render(GraphicsDevice& device, UniformBufferHandle uniform_buffer,
         const math::Mat4& view_projection, const DirectionalLighting& lighting,
         const math::Vec3& camera_position_world) const;
 
+    /// Draws what view `view_index` saw in the last `ViewSet::cull`: its visible objects, every
+    /// dynamic batch group, the static batch ranges inside that view and its HLOD proxies.
+    void render(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const ViewSet& views,
+        uint32_t view_index, const DirectionalLighting& lighting) const;
+
 private:
+    void draw_object(GraphicsDevice& device, UniformBufferHandle uniform_buffer, uint32_t object_index,
+        const math::Mat4& view_projection, const DirectionalLighting& lighting,
+        const math::Vec3& camera_position_world) const;
+    /// Dynamic groups, then static batch ranges accepted by `is_range_visible(batch, range)`.
+    void draw_batches(GraphicsDevice& device, UniformBufferHandle uniform_buffer,
+        const math::Mat4& view_projection, const DirectionalLighting& lighting,
+        const math::Vec3& camera_position_world,
+        const std::function<bool(uint32_t, uint32_t)>& is_range_visible) const;
+    /// `lighting` with its ambient taken from the light probes at `position`, if any.
+    DirectionalLighting lighting_at(const DirectionalLighting& lighting, const math::Vec3& position) const;
+
     std::vector<std::unique_ptr<Mesh>> m_mesh_storage;
     std::vector<SceneObject> m_objects;
+    std::vector<SceneObject> m_static_objects;
+    std::vector<StaticBatch> m_static_batches;
+    std::unique_ptr<DynamicBatcher> m_dynamic_batcher;
+    HlodTree m_hlod;
+    PotentiallyVisibleSet m_pvs;
+    LightProbeGrid m_light_probes;
+    uint64_t m_structure_version = 0;
 };
 
 } // namespace maya
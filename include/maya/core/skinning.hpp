@@ -0,0 +1,133 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/core/streaming_buffer.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/quaternion.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+/// Joints per skinned vertex.
+constexpr uint32_t kMaxSkinInfluences = 4;
+
+/// A joint's transform relative to its parent.
+struct JointTransform {
+    math::Vec3 translation;
+    math::Quat rotation;
+    math::Vec3 scale{1.0f, 1.0f, 1.0f};
+
+    math::Mat4 to_mat4() const;
+};
+
+struct Joint {
+    std::string name;
+    /// Index of the parent joint (always lower than this joint's), or -1 for a root.
+    int32_t parent = -1;
+    /// Transform relative to the parent in the bind pose; new instances start from it.
+    JointTransform bind_local;
+    /// Model space to this joint's space in the bind pose.
+    math::Mat4 inverse_bind = math::Mat4::identity();
+};
+
+/// Joint hierarchy, parents before children.
+struct Skeleton {
+    std::vector<Joint> joints;
+
+    uint32_t joint_count() const { return static_cast<uint32_t>(joints.size()); }
+};
+
+/// Joints influencing one vertex; weights sum to one (unused slots have weight zero).
+struct SkinInfluence {
+    uint16_t joints[kMaxSkinInfluences] = {0, 0, 0, 0};
+    float weights[kMaxSkinInfluences] = {1.0f, 0.0f, 0.0f, 0.0f};
+};
+
+/// Bind-pose geometry plus per-vertex joint influences. Kept next to `Vertex` rather than in
+/// it so static meshes keep the 64-byte layout the shaders expect.
+struct SkinnedMeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<SkinInfluence> influences;
+};
+
+/// Model-space joint matrices for `local_pose` (parent first), then the skinning palette
+/// `model * joint_model * inverse_bind` per joint. SIMD matrix products.
+void compute_joint_palette(const Skeleton& skeleton, const JointTransform* local_pose, const math::Mat4& model,
+    math::Mat4* joint_model, math::Mat4* palette);
+
+/// Linear-blend skins `count` vertices with `palette`; normals are renormalized (uniform
+/// scale assumed). Color and UV are copied. SIMD (SSE2/NEON) with a scalar fallback.
+void skin_vertices(const Vertex* bind, const SkinInfluence* influences, size_t count, const math::Mat4* palette,
+    Vertex* out);
+
+/// Chain of `joint_count` joints `segment_length` apart along +y, for tests and the demo.
+Skeleton make_chain_skeleton(uint32_t joint_count, float segment_length);
+/// Open cylinder along +y skinned to a `make_chain_skeleton` chain of the same height,
+/// each ring blended between its two nearest joints.
+SkinnedMeshData make_skinned_cylinder(float radius, uint32_t joint_count, float segment_length, uint32_t sides,
+    uint32_t rings, const math::Vec4& color);
+
+/// CPU skinning for many characters: per frame, every instance's joint palette is computed
+/// from its local pose, all vertices are skinned in parallel into one array in world space,
+/// and that array is streamed to the GPU and drawn with one indexed range per instance.
+/// `joint_matrices` keeps every instance's palette contiguously for a GPU skinning path.
+class SkinningSystem {
+public:
+    SkinningSystem(GraphicsDevice& device, uint32_t max_vertices, uint32_t max_indices);
+
+    /// `mesh` and `skeleton` are borrowed and must outlive the system. Returns the instance id,
+    /// or ~0u if the streaming buffer has no room for the mesh or the mesh does not fit the
+    /// skeleton (an influence per vertex, joint indices below `joint_count`, indices in range).
+    uint32_t add_instance(const SkinnedMeshData* mesh, const Skeleton* skeleton, const Material& material);
+    uint32_t instance_count() const { return static_cast<uint32_t>(m_instances.size()); }
+
+    /// Local pose of an instance, one transform per joint (starts at the bind pose).
+    std::vector<JointTransform>& pose(uint32_t instance) { return m_instances[instance].pose; }
+    math::Mat4& model_matrix(uint32_t instance) { return m_instances[instance].model_matrix; }
+
+    /// Computes palettes and skins every instance, then uploads the result.
+    void update(JobSystem& jobs);
+    void render(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const math::Mat4& view_projection,
+        const DirectionalLighting& lighting, const math::Vec3& camera_position_world) const;
+
+    /// All palettes of the last `update`; instance `i` starts at `joint_offset(i)`.
+    const std::vector<math::Mat4>& joint_matrices() const { return m_palettes; }
+    uint32_t joint_offset(uint32_t instance) const { return m_instances[instance].first_joint; }
+    /// Skinned world-space vertices of the last `update`, all instances back to back.
+    const std::vector<Vertex>& skinned_vertices() const { return m_vertices; }
+    uint32_t first_vertex(uint32_t instance) const { return m_instances[instance].first_vertex; }
+
+private:
+    struct Instance {
+        const SkinnedMeshData* mesh;
+        const Skeleton* skeleton;
+        Material material;
+        std::vector<JointTransform> pose;
+        math::Mat4 model_matrix = math::Mat4::identity();
+        uint32_t first_vertex = 0;
+        uint32_t first_index = 0;
+        uint32_t first_joint = 0;
+    };
+
+    StreamingGeometryBuffer m_buffer;
+    std::vector<Instance> m_instances;
+    /// Instance `first_vertex` values plus the total, for mapping skinning chunks to instances.
+    std::vector<uint32_t> m_vertex_offsets{0};
+    std::vector<math::Mat4> m_palettes;
+    std::vector<math::Mat4> m_joint_model;
+    std::vector<Vertex> m_vertices;
+    /// Every instance's indices rebased to its `first_vertex`; rebuilt only when instances change.
+    std::vector<uint32_t> m_indices;
+};
+
+} // namespace maya
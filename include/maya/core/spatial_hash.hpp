@@ -0,0 +1,106 @@
+#pragma once
+
+#include "maya/math/bounds.hpp"
+#include "maya/math/vector.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+struct SpatialHashSettings {
+    /// Edge length of one grid cell; roughly the typical object size or query radius.
+    float cell_size = 4.0f;
+    /// Objects covering more cells than this are kept in a list every query scans.
+    uint32_t max_cells_per_object = 64;
+    /// `commit` rebuilds once pending objects plus tombstoned entries reach this fraction of
+    /// the live objects.
+    float rebuild_fraction = 0.125f;
+};
+
+/// Uniform grid hashed into a flat bucket table for proximity queries over many moving objects.
+///
+/// Cell contents are stored as one sorted array of object ids with per-bucket offsets, built by
+/// a parallel counting sort. `insert`/`move`/`remove` are O(1): an object that stays inside its
+/// cells only updates its bounds, otherwise it becomes pending (its old entries are skipped as
+/// tombstones and queries test it directly) until `commit` or `rebuild` folds it back in.
+/// Queries are const and may run concurrently; updates may not.
+class SpatialHashGrid {
+public:
+    explicit SpatialHashGrid(const SpatialHashSettings& settings = {});
+
+    /// `id` is caller-chosen (e.g. an entity index); storage grows to the largest id.
+    void insert(uint32_t id, const math::Aabb& bounds);
+    void move(uint32_t id, const math::Aabb& bounds);
+    void remove(uint32_t id);
+    void clear();
+
+    bool contains(uint32_t id) const { return id < m_state.size() && m_state[id] != State::Absent; }
+    const math::Aabb& bounds(uint32_t id) const { return m_bounds[id]; }
+    uint32_t size() const { return m_size; }
+    /// Objects queries currently test outside the grid (pending plus oversized).
+    uint32_t loose_count() const { return static_cast<uint32_t>(m_loose.size()); }
+
+    /// Replaces the contents with ids `0..bounds.size()-1` and rebuilds; the cheapest path when
+    /// nearly everything moves every frame.
+    void assign(const std::vector<math::Aabb>& bounds, JobSystem& jobs);
+    /// Rebuilds the bucket table from every live object.
+    void rebuild(JobSystem& jobs);
+    /// Rebuilds only if enough objects are pending (see `SpatialHashSettings::rebuild_fraction`).
+    /// Returns true if it rebuilt.
+    bool commit(JobSystem& jobs);
+
+    /// Writes the ids whose bounds overlap `box` to `out` (cleared first), each once.
+    void query_box(const math::Aabb& box, std::vector<uint32_t>& out) const;
+    /// Writes the ids whose bounds come within `radius` of `center` to `out` (cleared first).
+    void query_radius(const math::Vec3& center, float radius, std::vector<uint32_t>& out) const;
+
+private:
+    enum class State : uint8_t { Absent, Grid, Pending, Oversized };
+
+    /// Inclusive integer cell coordinates covered by an object or query.
+    struct CellRange {
+        int32_t min[3];
+        int32_t max[3];
+    };
+
+    CellRange cell_range(const math::Aabb& box) const;
+    uint64_t cell_count(const CellRange& range) const;
+    uint32_t bucket_of(int32_t x, int32_t y, int32_t z) const;
+    void grow(uint32_t id);
+    void make_loose(uint32_t id, State state);
+    void drop_loose(uint32_t id);
+    /// Counting sort of (bucket, id) pairs for `ids` into the bucket table.
+    void build_table(const std::vector<uint32_t>& ids, JobSystem& jobs);
+
+    template <typename Fn>
+    void for_each_overlapping(const math::Aabb& box, Fn&& fn) const;
+
+    SpatialHashSettings m_settings;
+    float m_inv_cell_size;
+
+    std::vector<math::Aabb> m_bounds;
+    std::vector<CellRange> m_cells;
+    std::vector<State> m_state;
+    /// Index into `m_loose` for pending/oversized objects.
+    std::vector<uint32_t> m_loose_slot;
+    std::vector<uint32_t> m_loose;
+    uint32_t m_size = 0;
+    uint32_t m_pending = 0;
+    /// Objects whose bucket entries went stale (removed or moved out) since the last rebuild.
+    uint32_t m_tombstones = 0;
+
+    /// Ids sorted by bucket; bucket `b` owns `m_entries[m_bucket_start[b], m_bucket_start[b + 1])`.
+    std::vector<uint32_t> m_bucket_start;
+    std::vector<uint32_t> m_entries;
+    uint32_t m_bucket_mask = 0;
+
+    // Rebuild scratch, kept to avoid reallocating every frame.
+    std::vector<uint32_t> m_pair_offsets;
+    std::vector<uint32_t> m_pair_buckets;
+    std::vector<uint32_t> m_pair_ids;
+    std::vector<uint32_t> m_histograms;
+};
+
+} // namespace maya
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/math/bounds.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace maya {
+
+struct SceneObject;
+
+/// Index range of one source object inside a batch, kept for per-object culling.
+struct StaticBatchRange {
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+    /// Index of the source object in the list passed to `build_static_batches`.
+    uint32_t source_object = 0;
+    math::Aabb world_bounds;
+};
+
+/// Static objects sharing one material, pre-transformed to world space and concatenated
+/// into a single vertex/index buffer. Drawn with an identity model matrix.
+struct StaticBatch {
+    Material material{};
+    std::unique_ptr<Mesh> mesh;
+    std::vector<StaticBatchRange> ranges;
+    math::Aabb world_bounds;
+
+    /// Binds the batch buffer once and draws each range for which `is_visible(range_index)`
+    /// is true. Adjacent visible ranges are coalesced; returns the number of draws issued.
+    template <typename Visible>
+    uint32_t draw_ranges(Visible&& is_visible) const {
+        uint32_t draws = 0;
+        bool bound = false;
+        uint32_t run_first = 0;
+        uint32_t run_count = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(ranges.size()); ++i) {
+            const StaticBatchRange& r = ranges[i];
+            if (!is_visible(i)) {
+                continue;
+            }
+            if (run_count > 0 && run_first + run_count == r.first_index) {
+                run_count += r.index_count;
+                continue;
+            }
+            if (run_count > 0) {
+                if (!bound) {
+                    mesh->bind();
+                    bound = true;
+                }
+                mesh->draw_range(run_first, run_count);
+                ++draws;
+            }
+            run_first = r.first_index;
+            run_count = r.index_count;
+        }
+        if (run_count > 0) {
+            if (!bound) {
+                mesh->bind();
+            }
+            mesh->draw_range(run_first, run_count);
+            ++draws;
+        }
+        return draws;
+    }
+};
+
+struct StaticBatchSettings {
+    /// A material group is split into several batches once it exceeds this many vertices.
+    uint32_t max_vertices_per_batch = 1u << 20;
+};
+
+/// Groups `objects` by material (pipeline + texture), transforms their vertices into world
+/// space and concatenates them into one buffer per group. Objects without a mesh are skipped.
+/// Batch order follows the first appearance of each material in `objects`.
+std::vector<StaticBatch> build_static_batches(GraphicsDevice& device, const std::vector<SceneObject>& objects,
+    const StaticBatchSettings& settings = {});
+
+} // namespace maya
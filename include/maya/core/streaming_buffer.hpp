@@ -0,0 +1,152 @@
+#pragma once
+
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace maya {
+
+/// Vertex/index buffers rewritten by the CPU every frame. One buffer pair exists per frame in
+/// flight and `upload` rotates to the next, so a frame never overwrites data that an earlier,
+/// still-executing frame reads. Capacity is fixed at construction.
+class StreamingGeometryBuffer {
+public:
+    static constexpr uint32_t kFramesInFlight = 3;
+
+    StreamingGeometryBuffer(GraphicsDevice& device, uint32_t max_vertices, uint32_t max_indices)
+        : m_device(device), m_max_vertices(max_vertices), m_max_indices(max_indices) {
+        for (uint32_t i = 0; i < kFramesInFlight; ++i) {
+            m_vbs[i] = m_device.create_vertex_buffer(nullptr, static_cast<size_t>(max_vertices) * sizeof(Vertex));
+            m_ibs[i] = m_device.create_index_buffer(nullptr, static_cast<size_t>(max_indices) * sizeof(uint32_t));
+        }
+    }
+
+    ~StreamingGeometryBuffer() {
+        for (uint32_t i = 0; i < kFramesInFlight; ++i) {
+            m_device.destroy_vertex_buffer(m_vbs[i]);
+            m_device.destroy_index_buffer(m_ibs[i]);
+        }
+    }
+
+    StreamingGeometryBuffer(const StreamingGeometryBuffer&) = delete;
+    StreamingGeometryBuffer& operator=(const StreamingGeometryBuffer&) = delete;
+
+    /// Moves to the next buffer pair and writes this frame's geometry into it. Returns false and
+    /// leaves the frame empty if the data exceeds the capacity.
+    bool upload(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count) {
+        m_frame = (m_frame + 1) % kFramesInFlight;
+        if (vertex_count > m_max_vertices || index_count > m_max_indices) {
+            m_index_count = 0;
+            return false;
+        }
+        if (vertex_count > 0) {
+            m_device.update_vertex_buffer(m_vbs[m_frame], vertices, static_cast<size_t>(vertex_count) * sizeof(Vertex));
+        }
+        if (index_count > 0) {
+            m_device.update_index_buffer(m_ibs[m_frame], indices, static_cast<size_t>(index_count) * sizeof(uint32_t));
+        }
+        m_stale_indices[m_frame] = true;
+        m_index_count = index_count;
+        return true;
+    }
+
+    /// Sets indices that stay the same from frame to frame (e.g. rebuilt only when instances
+    /// change) for `upload_vertices`, which writes them into each frame's buffer once.
+    /// `indices` must stay valid until the next call. Returns false if they exceed the capacity.
+    bool set_indices(const uint32_t* indices, uint32_t index_count) {
+        if (index_count > m_max_indices) {
+            return false;
+        }
+        m_static_indices = indices;
+        m_static_index_count = index_count;
+        m_stale_indices.fill(true);
+        return true;
+    }
+
+    /// Like `upload` with the indices of the last `set_indices`, written only to buffers that
+    /// have not received them yet.
+    bool upload_vertices(const Vertex* vertices, uint32_t vertex_count) {
+        m_frame = (m_frame + 1) % kFramesInFlight;
+        if (vertex_count > m_max_vertices) {
+            m_index_count = 0;
+            return false;
+        }
+        if (vertex_count > 0) {
+            m_device.update_vertex_buffer(m_vbs[m_frame], vertices, static_cast<size_t>(vertex_count) * sizeof(Vertex));
+        }
+        if (m_stale_indices[m_frame] && m_static_index_count > 0) {
+            m_device.update_index_buffer(m_ibs[m_frame], m_static_indices,
+                static_cast<size_t>(m_static_index_count) * sizeof(uint32_t));
+        }
+        m_stale_indices[m_frame] = false;
+        m_index_count = m_static_index_count;
+        return true;
+    }
+
+    void bind() const { m_device.bind_vertex_buffer(m_vbs[m_frame], 0); }
+
+    void draw_range(uint32_t first_index, uint32_t index_count) const {
+        m_device.draw_indexed_range(m_ibs[m_frame], first_index, index_count);
+    }
+
+    uint32_t uploaded_index_count() const { return m_index_count; }
+    uint32_t max_vertices() const { return m_max_vertices; }
+    uint32_t max_indices() const { return m_max_indices; }
+
+private:
+    GraphicsDevice& m_device;
+    std::array<VertexBufferHandle, kFramesInFlight> m_vbs{};
+    std::array<IndexBufferHandle, kFramesInFlight> m_ibs{};
+    uint32_t m_max_vertices;
+    uint32_t m_max_indices;
+    uint32_t m_frame = 0;
+    uint32_t m_index_count = 0;
+    const uint32_t* m_static_indices = nullptr;
+    uint32_t m_static_index_count = 0;
+    std::array<bool, kFramesInFlight> m_stale_indices{};
+};
+
+/// Non-indexed vertex data of any layout rewritten every frame, one buffer per frame in flight
+/// like `StreamingGeometryBuffer`, but each buffer grows (by half again) when a frame needs more.
+class StreamingVertexBuffer {
+public:
+    static constexpr uint32_t kFramesInFlight = StreamingGeometryBuffer::kFramesInFlight;
+
+    explicit StreamingVertexBuffer(GraphicsDevice& device) : m_device(device) {}
+
+    ~StreamingVertexBuffer() {
+        for (VertexBufferHandle buffer : m_buffers) {
+            if (buffer.handle != INVALID_HANDLE) {
+                m_device.destroy_vertex_buffer(buffer);
+            }
+        }
+    }
+
+    StreamingVertexBuffer(const StreamingVertexBuffer&) = delete;
+    StreamingVertexBuffer& operator=(const StreamingVertexBuffer&) = delete;
+
+    /// Moves to the next frame's buffer, grows it if needed, writes `size` bytes and returns it.
+    VertexBufferHandle upload(const void* data, size_t size) {
+        m_frame = (m_frame + 1) % kFramesInFlight;
+        VertexBufferHandle& buffer = m_buffers[m_frame];
+        if (m_capacities[m_frame] < size) {
+            if (buffer.handle != INVALID_HANDLE) {
+                m_device.destroy_vertex_buffer(buffer);
+            }
+            m_capacities[m_frame] = std::max<size_t>(size + size / 2, 16 * 1024);
+            buffer = m_device.create_vertex_buffer(nullptr, m_capacities[m_frame]);
+        }
+        m_device.update_vertex_buffer(buffer, data, size);
+        return buffer;
+    }
+
+private:
+    GraphicsDevice& m_device;
+    std::array<VertexBufferHandle, kFramesInFlight> m_buffers{};
+    std::array<size_t, kFramesInFlight> m_capacities{};
+    uint32_t m_frame = 0;
+};
+
+} // namespace maya
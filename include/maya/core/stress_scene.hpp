@@ -0,0 +1,34 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cstdint>
+
+namespace maya {
+
+class Scene;
+
+struct StressSceneSettings {
+    uint32_t object_count = 1000;
+    /// Objects are centered uniformly inside the cube `[-extent, extent]^3`.
+    float extent = 50.0f;
+    float min_scale = 0.5f;
+    float max_scale = 2.0f;
+    /// Tessellation of every shape (segments around, scaled down for rings and sides).
+    uint32_t detail = 16;
+    /// Adds the objects with `Scene::add_static_object` semantics so `build_static_batches`
+    /// merges them; otherwise they are dynamic.
+    bool is_static = false;
+    uint32_t seed = 1;
+};
+
+/// Fills `scene` with `object_count` objects for benchmarks: one mesh per procedural shape
+/// (plane, box, UV sphere, icosphere, cylinder, cone, torus, capsule) is added once and shared,
+/// and every object draws a random shape with `material`, a random rotation, a uniform scale
+/// and a position. The same settings always produce the same scene. Returns the index of the
+/// first added object in `scene.objects()`.
+uint32_t add_stress_scene(Scene& scene, GraphicsDevice& device, const Material& material,
+    const StressSceneSettings& settings = {});
+
+} // namespace maya
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "maya/math/bounds.hpp"
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+/// Two overlapping objects, `a < b`.
+struct SapPair {
+    uint32_t a = 0;
+    uint32_t b = 0;
+
+    bool operator==(const SapPair&) const = default;
+};
+
+struct SweepAndPruneSettings {
+    /// `update` re-sorts from scratch instead of insertion-sorting when this fraction of the live
+    /// objects (or more) was inserted since the last update, e.g. on the first load.
+    float rebuild_fraction = 0.25f;
+};
+
+/// Incremental sweep-and-prune broadphase: keeps every object's interval endpoints sorted on
+/// each axis between updates and the set of overlapping pairs.
+///
+/// Objects move a little per frame, so `update` re-sorts each axis with an insertion sort that
+/// costs O(n + swaps); the three axes sort in parallel. Only swaps of a min endpoint past a max
+/// endpoint can change whether two objects overlap, so those swaps are the only pairs re-tested,
+/// and each change is reported once as an added or removed pair. Boxes that touch overlap (as in
+/// `math::Aabb::overlaps`). Not thread-safe; `update` uses the job system internally.
+class SweepAndPrune {
+public:
+    explicit SweepAndPrune(const SweepAndPruneSettings& settings = {});
+
+    /// `id` is caller-chosen (e.g. an entity index); storage grows to the largest id. Changes
+    /// take effect at the next `update`. Bounds inverted on an axis (min > max) are stored with
+    /// that axis swapped.
+    void insert(uint32_t id, const math::Aabb& bounds);
+    void move(uint32_t id, const math::Aabb& bounds);
+    /// Pairs with `id` are reported removed by the next `update`.
+    void remove(uint32_t id);
+    /// Drops everything without reporting removed pairs.
+    void clear();
+
+    bool contains(uint32_t id) const { return id < m_state.size() && m_state[id] != State::Absent; }
+    const math::Aabb& bounds(uint32_t id) const { return m_bounds[id]; }
+    uint32_t size() const { return m_size; }
+
+    /// Applies inserts, moves and removals since the last update, then fills `added_pairs` and
+    /// `removed_pairs` with the pairs that started or stopped overlapping.
+    void update(JobSystem& jobs);
+
+    const std::vector<SapPair>& added_pairs() const { return m_added; }
+    const std::vector<SapPair>& removed_pairs() const { return m_removed; }
+    uint32_t pair_count() const { return static_cast<uint32_t>(m_pairs.size()); }
+    /// As of the last update.
+    bool overlapping(uint32_t a, uint32_t b) const;
+    /// Writes every overlapping pair to `out` (cleared first), in no particular order.
+    void pairs(std::vector<SapPair>& out) const;
+
+private:
+    enum class State : uint8_t { Absent, Live, Inserted };
+
+    /// One interval end on one axis: `data` is `id << 1 | is_max`.
+    struct Endpoint {
+        float value;
+        uint32_t data;
+    };
+
+    /// Re-reads endpoint values from the bounds and insertion-sorts the axis, collecting the
+    /// pairs whose min/max endpoints swapped.
+    void sort_axis(uint32_t axis);
+    /// Rebuilds all axes with a full sort and recomputes the pair set with one sweep.
+    void rebuild(JobSystem& jobs);
+    void report(uint64_t key, bool overlap);
+
+    SweepAndPruneSettings m_settings;
+    std::vector<math::Aabb> m_bounds;
+    std::vector<State> m_state;
+    /// Whether the id's endpoints are in the axis arrays.
+    std::vector<uint8_t> m_in_axes;
+    uint32_t m_size = 0;
+
+    std::vector<uint32_t> m_inserted;
+    bool m_has_removals = false;
+
+    std::vector<Endpoint> m_axes[3];
+    std::vector<uint64_t> m_candidates[3];
+    /// Overlapping pairs keyed `a << 32 | b`.
+    std::unordered_set<uint64_t> m_pairs;
+    std::vector<SapPair> m_added;
+    std::vector<SapPair> m_removed;
+};
+
+} // namespace maya
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "maya/core/material.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/core/streaming_buffer.hpp"
+#include "maya/math/bounds.hpp"
+#include "maya/math/frustum.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+struct HeightImageData;
+
+/// Regular grid of 16-bit heights. Sample (x, z) sits at world `(x * spacing, height, z * spacing)`
+/// with `height = height_offset + height_scale * sample / 65535`.
+struct Heightfield {
+    uint32_t width = 0;
+    uint32_t depth = 0;
+    std::vector<uint16_t> samples;
+    float spacing = 1.0f;
+    float height_scale = 1.0f;
+    float height_offset = 0.0f;
+
+    /// Empty when `image.pixels` does not hold `width * height` samples.
+    static Heightfield from_image(const HeightImageData& image, float spacing, float height_scale,
+        float height_offset = 0.0f);
+
+    bool empty() const { return samples.empty(); }
+    /// Height of sample (x, z), clamped to the grid.
+    float sample_height(int32_t x, int32_t z) const;
+    /// Bilinear height at fractional sample coordinates, clamped to the grid.
+    float height(float x, float z) const;
+    /// Surface normal from central differences `step` samples apart.
+    math::Vec3 normal(float x, float z, float step = 1.0f) const;
+};
+
+/// Reads a 16-bit (or 8-bit, scaled up) grayscale image via `ImageLoader::read_gray16`; false
+/// if it cannot be read or is malformed.
+bool load_heightfield(const std::string& path, float spacing, float height_scale, Heightfield& out);
+
+struct TerrainSettings {
+    /// Quads along each side of every chunk's grid (power of two). A chunk at LOD `l` covers
+    /// `chunk_quads << l` samples, so all chunks cost the same triangles.
+    uint32_t chunk_quads = 32;
+    uint32_t lod_count = 6;
+    /// Distance up to which LOD 0 is used; each coarser LOD reaches twice as far.
+    float lod0_range = 48.0f;
+    /// Fraction of each LOD's distance band over which its vertices morph into the next LOD.
+    float morph_fraction = 0.35f;
+    /// Chunks drawn per frame at most; sizes the shared index buffer.
+    uint32_t max_chunks = 256;
+};
+
+/// A quadtree node picked for drawing; its grid covers the node, of which only the quadrants in
+/// `quadrant_mask` are drawn (bit `qx + 2 * qz`, the others are covered by finer chunks).
+struct TerrainChunk {
+    uint32_t lod = 0;
+    uint32_t x = 0;
+    uint32_t z = 0;
+    uint32_t quadrant_mask = 0xF;
+    math::Aabb bounds;
+};
+
+/// Heightfield terrain with CDLOD selection. The terrain is a quadtree whose nodes all use the
+/// same `chunk_quads` grid; each frame the coarsest node within range of the camera is picked
+/// per area, so the triangle count depends on the LOD ranges rather than the terrain size.
+/// Vertices morph toward the next coarser grid as they approach the end of their LOD range,
+/// which hides LOD switches and cracks between neighboring LODs.
+///
+/// Node bounds come from min/max height mips built at load. Vertices of the picked chunks are
+/// generated on the job system and streamed once per frame; indices never change: one index
+/// buffer holds the grid (ordered by quadrant, so any quadrant is a sub-range) once per chunk
+/// slot, rebased to that slot's vertices.
+class Terrain {
+public:
+    Terrain(GraphicsDevice& device, Heightfield heightfield, const TerrainSettings& settings = {});
+    ~Terrain();
+
+    Terrain(const Terrain&) = delete;
+    Terrain& operator=(const Terrain&) = delete;
+
+    /// Picks chunks for the camera, then writes and uploads their vertices.
+    void update(const math::Vec3& camera_position, const math::Frustum& frustum, JobSystem& jobs);
+    /// Draws the chunks of the last `update` with vertices already in world space.
+    void render(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const Material& material,
+        const math::Mat4& view_projection, const DirectionalLighting& lighting,
+        const math::Vec3& camera_position_world) const;
+
+    const Heightfield& heightfield() const { return m_heightfield; }
+    const TerrainSettings& settings() const { return m_settings; }
+    /// Distance at which LOD `lod` gives way to `lod + 1`.
+    float lod_range(uint32_t lod) const { return m_ranges[lod]; }
+    /// Nodes along x and z at `lod`.
+    uint32_t nodes_x(uint32_t lod) const { return m_mips[lod].nodes_x; }
+    uint32_t nodes_z(uint32_t lod) const { return m_mips[lod].nodes_z; }
+    /// World bounds of a node from the min/max mips.
+    math::Aabb node_bounds(uint32_t lod, uint32_t x, uint32_t z) const;
+
+    /// Chunks of the last `update`, chunk `i` using vertex slot `i`.
+    const std::vector<TerrainChunk>& chunks() const { return m_chunks; }
+    /// True if the last `update` picked more than `max_chunks` (the farthest were dropped).
+    bool overflowed() const { return m_overflowed; }
+    uint32_t triangle_count() const;
+    /// Vertices of the last `update`, `(chunk_quads + 1)^2` per chunk.
+    const std::vector<Vertex>& vertices() const { return m_vertices; }
+
+private:
+    struct MinMax {
+        float min;
+        float max;
+    };
+    struct MipLevel {
+        uint32_t nodes_x = 0;
+        uint32_t nodes_z = 0;
+        std::vector<MinMax> heights;
+    };
+
+    void build_mips();
+    void build_indices(GraphicsDevice& device);
+    void select(uint32_t lod, uint32_t x, uint32_t z, const math::Vec3& camera, const math::Frustum& frustum);
+    bool node_exists(uint32_t lod, uint32_t x, uint32_t z) const;
+    void write_chunk(const TerrainChunk& chunk, const math::Vec3& camera, Vertex* out) const;
+
+    GraphicsDevice& m_device;
+    Heightfield m_heightfield;
+    TerrainSettings m_settings;
+    std::vector<float> m_ranges;
+    std::vector<MipLevel> m_mips;
+    IndexBufferHandle m_indices;
+    uint32_t m_vertices_per_chunk = 0;
+    uint32_t m_indices_per_quadrant = 0;
+
+    std::vector<TerrainChunk> m_chunks;
+    bool m_overflowed = false;
+    std::vector<Vertex> m_vertices;
+    StreamingVertexBuffer m_vertex_buffer;
+    VertexBufferHandle m_uploaded;
+};
+
+} // namespace maya
@@ -12,6 +12,13 @@ public:
         m_handle = m_device.create_texture(data, width, height);
     }
 
+    ~Texture() {
+        m_device.destroy_texture(m_handle);
+    }
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
     void bind(uint32_t slot = 0) {
         m_device.bind_texture(m_handle, slot);
     }
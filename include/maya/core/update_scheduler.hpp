@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+/// How often an item wants updating, from its distance to the viewer and whether it was visible.
+struct UpdateRate {
+    float near_hz = 60.0f;
+    float far_hz = 4.0f;
+    /// Rate falls linearly from `near_hz` to `far_hz` between these distances.
+    float near_distance = 20.0f;
+    float far_distance = 200.0f;
+    /// Multiplies the rate of items that were not visible.
+    float hidden_scale = 0.25f;
+
+    float hz(float distance, bool visible) const;
+};
+
+struct UpdateSystemSettings {
+    std::string name;
+    /// Systems run in descending priority; when the frame budget runs out, lower ones wait.
+    int32_t priority = 0;
+    /// This system's own cap per frame; 0 shares the whole frame budget.
+    float budget_ms = 0.0f;
+    UpdateRate rate;
+};
+
+/// Called per item with the time since that item's previous update (or since it was added).
+using UpdateFunction = std::function<void(uint32_t item, float elapsed)>;
+
+/// Last `run` of one system.
+struct UpdateSystemStats {
+    /// Items that were due (their period had passed).
+    uint32_t due = 0;
+    /// Due items that ran; the rest stay due and go first next frame.
+    uint32_t updated = 0;
+    double time_ms = 0.0;
+    /// `time_ms` over the system's budget (its own `budget_ms`, else the frame budget).
+    float utilization = 0.0f;
+    /// Largest elapsed time handed to an update, in seconds.
+    float max_elapsed = 0.0f;
+};
+
+/// Amortizes per-object work across frames. Systems register an update function and a number of
+/// items; each item has a desired period derived from distance and visibility (`set_item_state`).
+/// Every `run` walks each system's items round-robin from where the last run stopped, updating
+/// the ones whose period has passed until the millisecond budget is spent, so frame time stays
+/// flat as item counts grow and the cost of overload is lower update rates, not long frames.
+/// Main thread only.
+class UpdateScheduler {
+public:
+    explicit UpdateScheduler(float frame_budget_ms = 2.0f);
+
+    /// Returns the system's id (index into `stats`).
+    uint32_t add_system(const UpdateSystemSettings& settings, UpdateFunction update);
+    /// Items are `0..count-1`; new items start their first period now at the nearest rate.
+    void set_item_count(uint32_t system, uint32_t count);
+    uint32_t item_count(uint32_t system) const { return static_cast<uint32_t>(m_systems[system].last.size()); }
+    /// Sets the item's desired rate from the system's `UpdateRate`.
+    void set_item_state(uint32_t system, uint32_t item, float distance, bool visible);
+    /// Explicit period in seconds (0 = every run).
+    void set_item_period(uint32_t system, uint32_t item, float seconds);
+
+    void set_frame_budget_ms(float budget_ms) { m_frame_budget_ms = budget_ms; }
+    float frame_budget_ms() const { return m_frame_budget_ms; }
+    /// Multiplies every rate given to `set_item_state` from then on (a quality knob).
+    void set_rate_scale(float scale) { m_rate_scale = scale; }
+    float rate_scale() const { return m_rate_scale; }
+
+    /// Advances the scheduler clock by `delta_time` seconds and runs due updates within budget.
+    void run(float delta_time);
+
+    const UpdateSystemStats& stats(uint32_t system) const { return m_systems[system].stats; }
+    const UpdateSystemSettings& settings(uint32_t system) const { return m_systems[system].settings; }
+    uint32_t system_count() const { return static_cast<uint32_t>(m_systems.size()); }
+    /// Scheduler clock: sum of `run` deltas.
+    double time() const { return m_time; }
+
+private:
+    struct System {
+        UpdateSystemSettings settings;
+        UpdateFunction update;
+        /// Per item: scheduler time of the last update and desired period.
+        std::vector<double> last;
+        std::vector<float> period;
+        /// Item the next run starts scanning from.
+        uint32_t cursor = 0;
+        UpdateSystemStats stats;
+    };
+
+    float m_frame_budget_ms;
+    float m_rate_scale = 1.0f;
+    double m_time = 0.0;
+    std::vector<System> m_systems;
+    /// System indices by descending priority (stable by registration).
+    std::vector<uint32_t> m_order;
+};
+
+} // namespace maya
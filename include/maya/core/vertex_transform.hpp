@@ -0,0 +1,15 @@
+#pragma once
+
+#include "maya/math/matrix.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cstddef>
+
+namespace maya {
+
+/// Writes `count` vertices into `out` with positions transformed by `model` and normals by
+/// `normal_matrix` (see `Mat4::normal_matrix`), renormalized. Color and UV are copied.
+/// `in` and `out` may alias. SIMD (SSE2/NEON) with a scalar fallback.
+void transform_vertices(const Vertex* in, Vertex* out, size_t count, const math::Mat4& model,
+    const math::Mat4& normal_matrix);
+
+} // namespace maya
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "maya/core/hlod.hpp"
+#include "maya/core/pvs.hpp"
+#include "maya/math/bounds.hpp"
+#include "maya/math/frustum.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+class Mesh;
+class Scene;
+
+/// Views per `ViewSet`; one bit each in the per-object visibility masks.
+constexpr uint32_t kMaxCullViews = 32;
+
+/// One view to cull for: main camera, shadow cascade, reflection probe face, split-screen player.
+struct CullView {
+    math::Mat4 view_projection = math::Mat4::identity();
+    math::Vec3 position;
+    /// Objects whose bounds start farther than this from `position` are culled (draw distance).
+    float max_distance = std::numeric_limits<float>::max();
+    /// Multiplies the bounds-radius / distance ratio reported as `VisibleObject::screen_size`,
+    /// e.g. half the projection's y scale so the value approximates screen-height fraction.
+    float lod_scale = 1.0f;
+    /// Also hide static batch ranges the scene's PVS marks as not visible from the cell holding
+    /// `position`. For views placed like the camera; leave off for shadow views.
+    bool use_pvs = false;
+};
+
+/// Entry of a per-view render list.
+struct VisibleObject {
+    uint32_t object_index = 0;
+    /// Approximate projected size for LOD selection (see `CullView::lod_scale`).
+    float screen_size = 0.0f;
+};
+
+struct TemporalCullingSettings {
+    /// Every object and static range is re-tested at least once per this many `cull` calls
+    /// (staggered across frames), bounding error from the motion estimates.
+    uint32_t refresh_period = 32;
+};
+
+/// Culls every view in one pass over scene bounds: each object's world bounds are computed and
+/// loaded once, then tested against all views. Produces a per-object visibility bitmask, per-view
+/// render lists for `Scene::objects()` and per-view masks for static batch ranges.
+///
+/// With temporal coherence enabled, results from earlier frames are reused. Each test records
+/// how far the bounds are from flipping (distance to the nearest plane crossing), and views
+/// accumulate how far their planes have moved since. An item is re-tested only when its model
+/// matrix or mesh changed, when the accumulated plane motion could have used up that margin, or
+/// on its staggered periodic refresh.
+class ViewSet {
+public:
+    /// Returns the new view's index (bit in the masks), or `kMaxCullViews` if the set is full.
+    uint32_t add_view(const CullView& view);
+    void set_view(uint32_t index, const CullView& view);
+    /// Same, reusing planes the caller already has (e.g. `Camera::get_frustum`).
+    void set_view(uint32_t index, const CullView& view, const math::Frustum& frustum);
+    void clear();
+
+    uint32_t view_count() const { return static_cast<uint32_t>(m_views.size()); }
+    const CullView& view(uint32_t index) const { return m_views[index].view; }
+
+    void cull(const Scene& scene, JobSystem& jobs);
+
+    void enable_temporal_coherence(const TemporalCullingSettings& settings = {});
+    void disable_temporal_coherence();
+    bool temporal_coherence_enabled() const { return m_temporal_enabled; }
+    /// Objects plus static ranges whose bounds were tested by the last `cull`.
+    uint32_t retested_count() const { return m_retested; }
+
+    /// Bit `v` set when `scene.objects()[i]` is visible in view `v`.
+    const std::vector<uint32_t>& object_masks() const { return m_object_masks; }
+    /// World bounds of `scene.objects()` from the last `cull`.
+    const std::vector<math::Aabb>& world_bounds() const { return m_world_bounds; }
+    /// Visible objects of one view, in scene order.
+    const std::vector<VisibleObject>& visible_objects(uint32_t view_index) const {
+        return m_views[view_index].visible;
+    }
+
+    bool is_static_range_visible(uint32_t view_index, uint32_t batch, uint32_t range) const {
+        const uint32_t slot = m_batch_range_offsets[batch] + range;
+        if (!((m_range_masks[slot] >> view_index) & 1u)) {
+            return false;
+        }
+        const uint32_t leaf = m_range_leaves[slot];
+        if (leaf != kNoHlodCluster && ((m_hlod_leaf_masks[leaf] >> view_index) & 1u)) {
+            return false;
+        }
+        return !((m_pvs_views >> view_index) & 1u)
+            || PotentiallyVisibleSet::is_visible(m_views[view_index].pvs_bits, m_range_sources[slot]);
+    }
+
+    /// Clusters of `Scene::hlod()` view `view_index` draws as proxies; the static ranges they
+    /// cover report not visible.
+    const std::vector<uint32_t>& hlod_proxies(uint32_t view_index) const { return m_views[view_index].hlod_proxies; }
+
+private:
+    /// Cumulative plane motion of one view (see `track_view_motion`).
+    struct ViewMotion {
+        /// Largest plane offset change at the camera position.
+        double shift = 0.0;
+        /// Largest plane normal change; scales with distance from the camera.
+        double turn = 0.0;
+        /// Camera travel (also bounds `max_distance` drift).
+        double travel = 0.0;
+    };
+
+    struct ViewState {
+        CullView view;
+        math::Frustum frustum;
+        std::vector<VisibleObject> visible;
+        // Temporal coherence: planes and position used by the previous `cull`, the running
+        // motion totals, and their values over the last `refresh_period` frames.
+        math::Frustum culled_frustum;
+        math::Vec3 culled_position;
+        ViewMotion motion;
+        std::vector<ViewMotion> history;
+        // PVS row of the cell holding `view.position` (when `view.use_pvs`).
+        uint32_t pvs_cell = kNoPvsCell;
+        std::vector<uint64_t> pvs_bits;
+        std::vector<uint32_t> hlod_proxies;
+    };
+
+    /// Bitmask of views that see `box`, using the packed SIMD plane sets. If `margins` is not
+    /// null, writes per view how far the box is from changing result.
+    uint32_t test_views(const math::Aabb& box, float* margins = nullptr) const;
+    void pack_planes();
+    void track_view_motion(bool reset);
+    /// True if the views may have moved enough since item `item` was tested to change its result.
+    bool is_stale(uint32_t item, const math::Aabb& box) const;
+    /// Refreshes `pvs_bits` of views with `use_pvs` from the scene's PVS.
+    void update_pvs_rows(const Scene& scene);
+    /// Picks each view's HLOD proxies, coarsest first, and marks the leaves they cover.
+    void select_hlod(const Scene& scene);
+
+    std::vector<ViewState> m_views;
+    /// SoA planes, 8 per view (6 used, 2 padding that always pass): nx[8] ny[8] nz[8] d[8].
+    std::vector<float> m_packed_planes;
+    std::vector<uint32_t> m_object_masks;
+    std::vector<math::Aabb> m_world_bounds;
+    std::vector<uint32_t> m_range_masks;
+    std::vector<uint32_t> m_batch_range_offsets;
+    /// `StaticBatchRange::source_object` of every range, in `m_range_masks` order.
+    std::vector<uint32_t> m_range_sources;
+    /// HLOD leaf cluster of every range (`kNoHlodCluster` if none).
+    std::vector<uint32_t> m_range_leaves;
+    /// Per HLOD leaf cluster, bit `v` set when view `v` draws an ancestor proxy instead.
+    std::vector<uint32_t> m_hlod_leaf_masks;
+    std::vector<uint32_t> m_cluster_masks;
+    std::vector<uint32_t> m_hlod_stack;
+    /// Views whose static ranges are also filtered by the scene's PVS.
+    uint32_t m_pvs_views = 0;
+    const Scene* m_pvs_scene = nullptr;
+    uint64_t m_pvs_version = 0;
+
+    bool m_temporal_enabled = false;
+    TemporalCullingSettings m_temporal;
+    bool m_temporal_valid = false;
+    const Scene* m_scene = nullptr;
+    uint64_t m_scene_version = 0;
+    uint32_t m_frame = 0;
+    uint32_t m_retested = 0;
+    // Per item (objects, then static ranges): frame of its last test and per-view margins.
+    std::vector<uint32_t> m_tested_frame;
+    std::vector<float> m_margins;
+    std::vector<math::Mat4> m_cached_models;
+    std::vector<const Mesh*> m_cached_meshes;
+};
+
+} // namespace maya
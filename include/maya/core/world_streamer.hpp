@@ -0,0 +1,190 @@
+#pragma once
+
+#include "maya/core/image_loader.hpp"
+#include "maya/core/model_loader.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/resource.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace maya {
+
+class GraphicsDevice;
+class Mesh;
+class Scene;
+class Texture;
+
+/// Integer coordinates of a world partition cell on the XZ plane.
+struct WorldCell {
+    int32_t x = 0;
+    int32_t z = 0;
+
+    bool operator==(const WorldCell& other) const { return x == other.x && z == other.z; }
+};
+
+struct WorldCellHash {
+    size_t operator()(const WorldCell& cell) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32)
+            | static_cast<uint32_t>(cell.z));
+    }
+};
+
+/// One object of a streamed cell; `mesh` and `texture` index `WorldCellContent` (-1 = untextured).
+struct WorldCellObject {
+    uint32_t mesh = 0;
+    int32_t texture = -1;
+    math::Mat4 model_matrix = math::Mat4::identity();
+};
+
+/// CPU-side contents of one cell, produced by a `WorldCellLoader` on a loader thread.
+struct WorldCellContent {
+    std::vector<MeshData> meshes;
+    std::vector<ImageData> textures;
+    std::vector<WorldCellObject> objects;
+
+    /// Geometry plus texel bytes; what the cell costs against the memory budget once resident.
+    size_t byte_size() const;
+};
+
+/// Fills `out` for `cell` on a loader thread (no GPU calls). A cell with no content is not an
+/// error: return true and leave `out` empty. Returning false logs and keeps the cell empty.
+using WorldCellLoader = std::function<bool(const WorldCell& cell, WorldCellContent& out)>;
+
+struct WorldStreamingSettings {
+    float cell_size = 64.0f;
+    /// Cells whose center is within this distance (XZ) of the camera or of its predicted
+    /// position are loaded.
+    float load_radius = 160.0f;
+    /// Cells farther than this from both are evicted. Keep it above `load_radius` so cells on
+    /// the boundary do not load and unload every frame.
+    float unload_radius = 224.0f;
+    /// Seconds of current camera velocity to look ahead when predicting where it will be.
+    float velocity_lookahead = 1.0f;
+    /// Resident cell bytes (see `WorldCellContent::byte_size`). Farther cells are evicted to
+    /// make room for nearer ones; a cell that still does not fit is skipped.
+    size_t memory_budget_bytes = size_t(512) << 20;
+    /// Background threads running the loader; 0 loads inline during `update` (tests, tools).
+    uint32_t loader_threads = 2;
+    /// Cells queued or loading at once; nearest first.
+    uint32_t max_in_flight = 8;
+    /// Main-thread time per `update` spent creating GPU resources and objects for loaded cells.
+    float integration_budget_ms = 2.0f;
+    /// Pipelines for streamed objects with and without a texture.
+    PipelineHandle textured_pipeline{};
+    PipelineHandle untextured_pipeline{};
+};
+
+/// Streams a grid-partitioned world around the camera: cells in range are read and parsed on
+/// loader threads (nearest to the camera's predicted position first), turned into meshes,
+/// textures and scene objects on the main thread within a per-frame time budget, and evicted
+/// when the camera leaves or the memory budget needs room for nearer cells.
+class WorldStreamer {
+public:
+    WorldStreamer(const WorldStreamingSettings& settings, WorldCellLoader loader);
+    /// Stops the loader threads. Call `unload_all` first if the scene outlives the streamer.
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    /// Loader reading `<directory>/cell_<x>_<z>.txt` manifests (format documented in
+    /// world_streamer.cpp); a missing manifest is an empty cell.
+    static WorldCellLoader manifest_loader(const std::string& directory);
+
+    /// Main thread, once per frame before culling: tracks camera velocity, evicts cells out of
+    /// range, requests cells coming into range and integrates finished loads into `scene`.
+    void update(Scene& scene, GraphicsDevice& device, const math::Vec3& camera_position, float delta_time);
+
+    /// Evicts every cell and cancels outstanding requests.
+    void unload_all(Scene& scene);
+
+    WorldCell cell_at(const math::Vec3& position) const;
+    math::Vec3 cell_center(const WorldCell& cell) const;
+
+    /// True once every object of `cell` is in the scene.
+    bool is_resident(const WorldCell& cell) const;
+    uint32_t resident_cell_count() const;
+    /// Bytes charged for cells that are resident or being integrated.
+    size_t resident_bytes() const { return m_resident_bytes; }
+    uint32_t in_flight_count() const;
+    /// Smoothed camera velocity used for prediction.
+    const math::Vec3& velocity() const { return m_velocity; }
+    const WorldStreamingSettings& settings() const { return m_settings; }
+
+private:
+    enum class CellState : uint8_t { Requested, Loaded, Integrating, Resident };
+
+    struct CellRecord {
+        CellState state = CellState::Requested;
+        uint64_t request = 0;
+        /// Distance used for ordering; lower loads sooner and evicts later.
+        float priority = 0.0f;
+        std::unique_ptr<WorldCellContent> content;
+        /// Created GPU resources, parallel to `content` (null until created).
+        std::vector<std::unique_ptr<Texture>> textures;
+        std::vector<Mesh*> meshes;
+        uint32_t next_texture = 0;
+        uint32_t next_object = 0;
+        size_t bytes = 0;
+    };
+
+    struct Request {
+        WorldCell cell;
+        uint64_t id;
+        float priority;
+    };
+
+    struct Completed {
+        WorldCell cell;
+        uint64_t id;
+        bool ok;
+        std::unique_ptr<WorldCellContent> content;
+    };
+
+    void loader_loop();
+    /// Runs the nearest queued request on the calling thread; false if the queue is empty.
+    bool load_next();
+    float priority_of(const WorldCell& cell) const;
+    void collect_completed();
+    void request_cells();
+    void integrate(Scene& scene, GraphicsDevice& device);
+    /// Creates one texture, mesh or object of `record`; true when the cell is complete.
+    bool integrate_step(Scene& scene, GraphicsDevice& device, CellRecord& record);
+    /// Evicts resident cells farther than `priority` until `bytes` more fit; false if they cannot.
+    bool make_room(Scene& scene, size_t bytes, float priority);
+    void evict(Scene& scene, const WorldCell& cell);
+
+    WorldStreamingSettings m_settings;
+    WorldCellLoader m_loader;
+
+    math::Vec3 m_camera_position;
+    math::Vec3 m_predicted_position;
+    math::Vec3 m_velocity;
+    bool m_has_camera = false;
+
+    // Main thread only.
+    std::unordered_map<WorldCell, CellRecord, WorldCellHash> m_cells;
+    /// Bytes of cells seen before, so cells that did not fit are not re-requested needlessly.
+    std::unordered_map<WorldCell, size_t, WorldCellHash> m_known_bytes;
+    size_t m_resident_bytes = 0;
+    uint64_t m_next_request = 1;
+
+    // Shared with loader threads, guarded by `m_mutex`.
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::vector<Request> m_queue;
+    std::vector<Completed> m_completed;
+    bool m_stopping = false;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace maya
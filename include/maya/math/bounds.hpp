@@ -0,0 +1,69 @@
+#pragma once
+
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace maya::math {
+
+// -----------------------------------------------------------------------------
+// Aabb
+// -----------------------------------------------------------------------------
+/// Axis-aligned bounding box. Default-constructed boxes are empty (min > max) so
+/// that `expand`/`merge` can start from nothing.
+struct Aabb {
+    Vec3 min{std::numeric_limits<float>::max()};
+    Vec3 max{std::numeric_limits<float>::lowest()};
+
+    constexpr Aabb() = default;
+    constexpr Aabb(const Vec3& min, const Vec3& max) : min(min), max(max) {}
+
+    bool empty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+    Vec3 center() const { return (min + max) * 0.5f; }
+    Vec3 extents() const { return (max - min) * 0.5f; }
+
+    void expand(const Vec3& p) {
+        min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+        max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+    }
+
+    void merge(const Aabb& other) {
+        if (other.empty()) {
+            return;
+        }
+        expand(other.min);
+        expand(other.max);
+    }
+
+    bool contains(const Vec3& p) const {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z;
+    }
+
+    bool overlaps(const Aabb& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y
+            && min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    /// Conservative world-space box of this box under an affine transform (Arvo's method:
+    /// transformed center plus extents projected through the absolute upper 3x3).
+    Aabb transformed(const Mat4& m) const {
+        if (empty()) {
+            return {};
+        }
+        const Vec3 c = center();
+        const Vec3 e = extents();
+        const Vec3 wc(
+            m.at(0, 0) * c.x + m.at(0, 1) * c.y + m.at(0, 2) * c.z + m.at(0, 3),
+            m.at(1, 0) * c.x + m.at(1, 1) * c.y + m.at(1, 2) * c.z + m.at(1, 3),
+            m.at(2, 0) * c.x + m.at(2, 1) * c.y + m.at(2, 2) * c.z + m.at(2, 3));
+        const Vec3 we(
+            std::fabs(m.at(0, 0)) * e.x + std::fabs(m.at(0, 1)) * e.y + std::fabs(m.at(0, 2)) * e.z,
+            std::fabs(m.at(1, 0)) * e.x + std::fabs(m.at(1, 1)) * e.y + std::fabs(m.at(1, 2)) * e.z,
+            std::fabs(m.at(2, 0)) * e.x + std::fabs(m.at(2, 1)) * e.y + std::fabs(m.at(2, 2)) * e.z);
+        return {wc - we, wc + we};
+    }
+};
+
+} // namespace maya::math
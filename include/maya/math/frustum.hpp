@@ -0,0 +1,84 @@
+#pragma once
+
+#include "maya/math/bounds.hpp"
+#include "maya/math/matrix.hpp"
+#include "maya/math/vector.hpp"
+#include <array>
+#include <cmath>
+
+namespace maya::math {
+
+/// Plane `dot(normal, p) + d = 0`; positive distances are on the side `normal` points to.
+struct Plane {
+    Vec3 normal;
+    float d = 0.0f;
+
+    float distance(const Vec3& p) const { return Vec3::dot(normal, p) + d; }
+
+    void normalize() {
+        const float len = normal.length();
+        if (len > EPSILON) {
+            normal = normal / len;
+            d /= len;
+        }
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Frustum
+// -----------------------------------------------------------------------------
+/// Six inward-facing planes of a view volume.
+struct Frustum {
+    enum Side { Left = 0, Right, Bottom, Top, Near, Far };
+
+    std::array<Plane, 6> planes;
+
+    /// Gribb/Hartmann extraction for a projection * view matrix with Metal clip space
+    /// (x, y in [-w, w], depth in [0, w]).
+    static Frustum from_view_projection(const Mat4& vp) {
+        auto row = [&vp](int r) { return Vec4(vp.at(r, 0), vp.at(r, 1), vp.at(r, 2), vp.at(r, 3)); };
+        const Vec4 r0 = row(0);
+        const Vec4 r1 = row(1);
+        const Vec4 r2 = row(2);
+        const Vec4 r3 = row(3);
+        auto make = [](const Vec4& v) {
+            Plane p{Vec3(v.x, v.y, v.z), v.w};
+            p.normalize();
+            return p;
+        };
+        Frustum f;
+        f.planes[Left] = make(r3 + r0);
+        f.planes[Right] = make(r3 - r0);
+        f.planes[Bottom] = make(r3 + r1);
+        f.planes[Top] = make(r3 - r1);
+        f.planes[Near] = make(r2);
+        f.planes[Far] = make(r3 - r2);
+        return f;
+    }
+
+    /// Smallest plane distance of the box's most-inside corner: negative means the box is fully
+    /// outside one plane. Conservative (boxes near frustum corners may be kept).
+    float box_slack(const Aabb& box) const {
+        const Vec3 c = box.center();
+        const Vec3 e = box.extents();
+        float slack = std::numeric_limits<float>::max();
+        for (const Plane& p : planes) {
+            const float r = std::fabs(p.normal.x) * e.x + std::fabs(p.normal.y) * e.y + std::fabs(p.normal.z) * e.z;
+            slack = std::min(slack, p.distance(c) + r);
+        }
+        return slack;
+    }
+
+    bool intersects(const Aabb& box) const { return box_slack(box) >= 0.0f; }
+
+    bool contains(const Vec3& p) const {
+        for (const Plane& plane : planes) {
+            if (plane.distance(p) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace maya::math
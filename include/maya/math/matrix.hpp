@@ -54,6 +54,58 @@ struct Mat4 {
         );
     }
 
+    /// General 4x4 inverse by cofactor expansion. Returns identity for singular matrices.
+    Mat4 inverse() const {
+        const float* m = elements;
+        float inv[16];
+        inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+        inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+        inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+        inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+        inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+        inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+        inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+        inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+        inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+        inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+        inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+        inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+        const float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+        if (std::fabs(det) < 1e-30f) {
+            return identity();
+        }
+        const float inv_det = 1.0f / det;
+        Mat4 result;
+        for (int i = 0; i < 16; ++i) {
+            result.elements[i] = inv[i] * inv_det;
+        }
+        return result;
+    }
+
+    /// Cofactor of the upper 3x3 (the inverse-transpose scaled by the determinant, sign kept so
+    /// mirrored transforms still flip normals). Transforms normals; renormalize the result.
+    Mat4 normal_matrix() const {
+        Mat4 result(1.0f);
+        const float sign = (at(0, 0) * (at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1))
+                          - at(0, 1) * (at(1, 0) * at(2, 2) - at(1, 2) * at(2, 0))
+                          + at(0, 2) * (at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0))) < 0.0f ? -1.0f : 1.0f;
+        result.at(0, 0) = sign * (at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1));
+        result.at(0, 1) = sign * (at(1, 2) * at(2, 0) - at(1, 0) * at(2, 2));
+        result.at(0, 2) = sign * (at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0));
+        result.at(1, 0) = sign * (at(0, 2) * at(2, 1) - at(0, 1) * at(2, 2));
+        result.at(1, 1) = sign * (at(0, 0) * at(2, 2) - at(0, 2) * at(2, 0));
+        result.at(1, 2) = sign * (at(0, 1) * at(2, 0) - at(0, 0) * at(2, 1));
+        result.at(2, 0) = sign * (at(0, 1) * at(1, 2) - at(0, 2) * at(1, 1));
+        result.at(2, 1) = sign * (at(0, 2) * at(1, 0) - at(0, 0) * at(1, 2));
+        result.at(2, 2) = sign * (at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0));
+        return result;
+    }
+
     // Transformations
     static Mat4 translate(const Vec3& translation) {
         Mat4 result(1.0f);
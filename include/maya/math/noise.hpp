@@ -0,0 +1,400 @@
+#pragma once
+
+#include "maya/math/simd.hpp"
+#include <cmath>
+#include <type_traits>
+
+/// Gradient noise built only from float arithmetic and `floor`, after Gustavson and McEwan's
+/// "webgl-noise": lattice corners are hashed with the permutation polynomial (34x^2 + x) mod 289,
+/// so one template serves `float` and `simd::Float4` (four points per call) without integer SIMD.
+/// Results are roughly in [-1, 1]; the lattice repeats every 289 units.
+namespace maya::math::noise {
+
+namespace detail {
+
+using simd::Float4;
+
+template <typename T>
+T constant(float s) {
+    if constexpr (std::is_same_v<T, float>) {
+        return s;
+    } else {
+        return T::splat(s);
+    }
+}
+
+inline float floor(float x) { return std::floor(x); }
+inline Float4 floor(const Float4& x) { return Float4::floor(x); }
+inline float abs(float x) { return std::fabs(x); }
+inline Float4 abs(const Float4& x) { return Float4::abs(x); }
+inline float min(float a, float b) { return b < a ? b : a; }
+inline Float4 min(const Float4& a, const Float4& b) { return Float4::min(a, b); }
+inline float max(float a, float b) { return a < b ? b : a; }
+inline Float4 max(const Float4& a, const Float4& b) { return Float4::max(a, b); }
+/// GLSL `step`: 1 where `x >= edge`, else 0.
+inline float step(float edge, float x) { return x >= edge ? 1.0f : 0.0f; }
+inline Float4 step(const Float4& edge, const Float4& x) {
+    return Float4::greater_equal(x, edge) & Float4::splat(1.0f);
+}
+
+template <typename T>
+T fract(const T& x) { return x - floor(x); }
+template <typename T>
+T clamp01(const T& x) { return min(max(x, constant<T>(0.0f)), constant<T>(1.0f)); }
+template <typename T>
+T mod289(const T& x) { return x - floor(x * (1.0f / 289.0f)) * 289.0f; }
+template <typename T>
+T permute(const T& x) { return mod289((x * 34.0f + 1.0f) * x); }
+/// First-order approximation of 1 / sqrt(r) around r = 0.7, the typical squared gradient length.
+template <typename T>
+T taylor_inv_sqrt(const T& r) { return 1.79284291400159f - 0.85373472095314f * r; }
+template <typename T>
+T fade(const T& t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+template <typename T>
+T lerp(const T& a, const T& b, const T& t) { return a + (b - a) * t; }
+
+/// Simplex corner falloff, `max(radius^2 - distance^2, 0)^4`.
+template <typename T>
+T simplex_weight(const T& distance_sq, float radius_sq) {
+    const T t = max(radius_sq - distance_sq, constant<T>(0.0f));
+    const T t2 = t * t;
+    return t2 * t2;
+}
+
+/// 2D gradients: 41 points on a line, folded onto a diamond.
+template <typename T>
+T gradient_dot(const T& hash, const T& dx, const T& dy) {
+    T gx = fract(hash * (1.0f / 41.0f)) * 2.0f - 1.0f;
+    const T gy = abs(gx) - 0.5f;
+    gx = gx - floor(gx + 0.5f);
+    return taylor_inv_sqrt(gx * gx + gy * gy) * (gx * dx + gy * dy);
+}
+
+/// 3D simplex gradients: 7x7 points over a square, mapped onto an octahedron.
+template <typename T>
+T simplex_gradient_dot(const T& hash, const T& dx, const T& dy, const T& dz) {
+    const T j = hash - 49.0f * floor(hash * (1.0f / 49.0f));
+    const T row = floor(j * (1.0f / 7.0f));
+    const T column = floor(j - 7.0f * row);
+    T gx = row * (2.0f / 7.0f) + (0.5f / 7.0f - 1.0f);
+    T gy = column * (2.0f / 7.0f) + (0.5f / 7.0f - 1.0f);
+    const T gz = 1.0f - abs(gx) - abs(gy);
+    const T fold = step(gz, constant<T>(0.0f));
+    gx = gx - (floor(gx) * 2.0f + 1.0f) * fold;
+    gy = gy - (floor(gy) * 2.0f + 1.0f) * fold;
+    return taylor_inv_sqrt(gx * gx + gy * gy + gz * gz) * (gx * dx + gy * dy + gz * dz);
+}
+
+/// 3D Perlin gradients: 7x7 points folded onto the faces of an octahedron.
+template <typename T>
+T perlin_gradient_dot(const T& hash, const T& dx, const T& dy, const T& dz) {
+    T gx = hash * (1.0f / 7.0f);
+    T gy = fract(floor(gx) * (1.0f / 7.0f)) - 0.5f;
+    gx = fract(gx);
+    const T gz = 0.5f - abs(gx) - abs(gy);
+    const T fold = step(gz, constant<T>(0.0f));
+    const T zero = constant<T>(0.0f);
+    gx = gx - fold * (step(zero, gx) - 0.5f);
+    gy = gy - fold * (step(zero, gy) - 0.5f);
+    return taylor_inv_sqrt(gx * gx + gy * gy + gz * gz) * (gx * dx + gy * dy + gz * dz);
+}
+
+/// 4D gradients: points on the faces of a cross-polytope.
+template <typename T>
+T gradient_dot(const T& hash, const T& dx, const T& dy, const T& dz, const T& dw) {
+    const T zero = constant<T>(0.0f);
+    T gx = floor(fract(hash * (1.0f / 294.0f)) * 7.0f) * (1.0f / 7.0f) - 1.0f;
+    T gy = floor(fract(hash * (1.0f / 49.0f)) * 7.0f) * (1.0f / 7.0f) - 1.0f;
+    T gz = floor(fract(hash * (1.0f / 7.0f)) * 7.0f) * (1.0f / 7.0f) - 1.0f;
+    const T gw = 1.5f - abs(gx) - abs(gy) - abs(gz);
+    const T fold = 1.0f - step(zero, gw);
+    gx = gx + ((1.0f - step(zero, gx)) * 2.0f - 1.0f) * fold;
+    gy = gy + ((1.0f - step(zero, gy)) * 2.0f - 1.0f) * fold;
+    gz = gz + ((1.0f - step(zero, gz)) * 2.0f - 1.0f) * fold;
+    return taylor_inv_sqrt(gx * gx + gy * gy + gz * gz + gw * gw) * (gx * dx + gy * dy + gz * dz + gw * dw);
+}
+
+} // namespace detail
+
+// -----------------------------------------------------------------------------
+// Simplex noise
+// -----------------------------------------------------------------------------
+template <typename T>
+T simplex(const T& x, const T& y) {
+    using namespace detail;
+    constexpr float kSkew = 0.366025403784439f;   // (sqrt(3) - 1) / 2
+    constexpr float kUnskew = 0.211324865405187f; // (3 - sqrt(3)) / 6
+    T i = floor(x + (x + y) * kSkew);
+    T j = floor(y + (x + y) * kSkew);
+    const T t = (i + j) * kUnskew;
+    const T x0 = x - i + t;
+    const T y0 = y - j + t;
+    // The middle corner is (1, 0) below the diagonal, (0, 1) above it.
+    const T i1 = step(y0, x0);
+    const T j1 = 1.0f - i1;
+    const T x1 = x0 - i1 + kUnskew;
+    const T y1 = y0 - j1 + kUnskew;
+    const T x2 = x0 + (2.0f * kUnskew - 1.0f);
+    const T y2 = y0 + (2.0f * kUnskew - 1.0f);
+
+    i = mod289(i);
+    j = mod289(j);
+    const T h0 = permute(permute(j) + i);
+    const T h1 = permute(permute(j + j1) + i + i1);
+    const T h2 = permute(permute(j + 1.0f) + i + 1.0f);
+    const T n = simplex_weight(x0 * x0 + y0 * y0, 0.5f) * gradient_dot(h0, x0, y0)
+        + simplex_weight(x1 * x1 + y1 * y1, 0.5f) * gradient_dot(h1, x1, y1)
+        + simplex_weight(x2 * x2 + y2 * y2, 0.5f) * gradient_dot(h2, x2, y2);
+    return n * 130.0f;
+}
+
+template <typename T>
+T simplex(const T& x, const T& y, const T& z) {
+    using namespace detail;
+    constexpr float kSkew = 1.0f / 3.0f;
+    constexpr float kUnskew = 1.0f / 6.0f;
+    const T s = (x + y + z) * kSkew;
+    T i = floor(x + s);
+    T j = floor(y + s);
+    T k = floor(z + s);
+    const T t = (i + j + k) * kUnskew;
+    const T x0 = x - i + t;
+    const T y0 = y - j + t;
+    const T z0 = z - k + t;
+
+    // Rank the offsets to pick the two middle corners.
+    const T gx = step(y0, x0);
+    const T gy = step(z0, y0);
+    const T gz = step(x0, z0);
+    const T i1 = min(gx, 1.0f - gz);
+    const T j1 = min(gy, 1.0f - gx);
+    const T k1 = min(gz, 1.0f - gy);
+    const T i2 = max(gx, 1.0f - gz);
+    const T j2 = max(gy, 1.0f - gx);
+    const T k2 = max(gz, 1.0f - gy);
+    const T x1 = x0 - i1 + kUnskew;
+    const T y1 = y0 - j1 + kUnskew;
+    const T z1 = z0 - k1 + kUnskew;
+    const T x2 = x0 - i2 + 2.0f * kUnskew;
+    const T y2 = y0 - j2 + 2.0f * kUnskew;
+    const T z2 = z0 - k2 + 2.0f * kUnskew;
+    const T x3 = x0 - 0.5f;
+    const T y3 = y0 - 0.5f;
+    const T z3 = z0 - 0.5f;
+
+    i = mod289(i);
+    j = mod289(j);
+    k = mod289(k);
+    const T h0 = permute(permute(permute(k) + j) + i);
+    const T h1 = permute(permute(permute(k + k1) + j + j1) + i + i1);
+    const T h2 = permute(permute(permute(k + k2) + j + j2) + i + i2);
+    const T h3 = permute(permute(permute(k + 1.0f) + j + 1.0f) + i + 1.0f);
+    const T n = simplex_weight(x0 * x0 + y0 * y0 + z0 * z0, 0.6f) * simplex_gradient_dot(h0, x0, y0, z0)
+        + simplex_weight(x1 * x1 + y1 * y1 + z1 * z1, 0.6f) * simplex_gradient_dot(h1, x1, y1, z1)
+        + simplex_weight(x2 * x2 + y2 * y2 + z2 * z2, 0.6f) * simplex_gradient_dot(h2, x2, y2, z2)
+        + simplex_weight(x3 * x3 + y3 * y3 + z3 * z3, 0.6f) * simplex_gradient_dot(h3, x3, y3, z3);
+    return n * 42.0f;
+}
+
+template <typename T>
+T simplex(const T& x, const T& y, const T& z, const T& w) {
+    using namespace detail;
+    constexpr float kSkew = 0.309016994374947f;   // (sqrt(5) - 1) / 4
+    constexpr float kUnskew = 0.138196601125011f; // (5 - sqrt(5)) / 20
+    const T s = (x + y + z + w) * kSkew;
+    T i = floor(x + s);
+    T j = floor(y + s);
+    T k = floor(z + s);
+    T l = floor(w + s);
+    const T t = (i + j + k + l) * kUnskew;
+    const T x0 = x - i + t;
+    const T y0 = y - j + t;
+    const T z0 = z - k + t;
+    const T w0 = w - l + t;
+
+    // Rank each offset by how many of the others it exceeds; corner n steps along the axes
+    // ranked above 3 - n.
+    const T xy = step(y0, x0);
+    const T xz = step(z0, x0);
+    const T xw = step(w0, x0);
+    const T yz = step(z0, y0);
+    const T yw = step(w0, y0);
+    const T zw = step(w0, z0);
+    const T rx = xy + xz + xw;
+    const T ry = (1.0f - xy) + yz + yw;
+    const T rz = (1.0f - xz) + (1.0f - yz) + zw;
+    const T rw = (1.0f - xw) + (1.0f - yw) + (1.0f - zw);
+    const T i1 = clamp01(rx - 2.0f), j1 = clamp01(ry - 2.0f), k1 = clamp01(rz - 2.0f), l1 = clamp01(rw - 2.0f);
+    const T i2 = clamp01(rx - 1.0f), j2 = clamp01(ry - 1.0f), k2 = clamp01(rz - 1.0f), l2 = clamp01(rw - 1.0f);
+    const T i3 = clamp01(rx), j3 = clamp01(ry), k3 = clamp01(rz), l3 = clamp01(rw);
+    const T x1 = x0 - i1 + kUnskew, y1 = y0 - j1 + kUnskew, z1 = z0 - k1 + kUnskew, w1 = w0 - l1 + kUnskew;
+    const T x2 = x0 - i2 + 2.0f * kUnskew, y2 = y0 - j2 + 2.0f * kUnskew;
+    const T z2 = z0 - k2 + 2.0f * kUnskew, w2 = w0 - l2 + 2.0f * kUnskew;
+    const T x3 = x0 - i3 + 3.0f * kUnskew, y3 = y0 - j3 + 3.0f * kUnskew;
+    const T z3 = z0 - k3 + 3.0f * kUnskew, w3 = w0 - l3 + 3.0f * kUnskew;
+    const T x4 = x0 + (4.0f * kUnskew - 1.0f), y4 = y0 + (4.0f * kUnskew - 1.0f);
+    const T z4 = z0 + (4.0f * kUnskew - 1.0f), w4 = w0 + (4.0f * kUnskew - 1.0f);
+
+    i = mod289(i);
+    j = mod289(j);
+    k = mod289(k);
+    l = mod289(l);
+    const T h0 = permute(permute(permute(permute(l) + k) + j) + i);
+    const T h1 = permute(permute(permute(permute(l + l1) + k + k1) + j + j1) + i + i1);
+    const T h2 = permute(permute(permute(permute(l + l2) + k + k2) + j + j2) + i + i2);
+    const T h3 = permute(permute(permute(permute(l + l3) + k + k3) + j + j3) + i + i3);
+    const T h4 = permute(permute(permute(permute(l + 1.0f) + k + 1.0f) + j + 1.0f) + i + 1.0f);
+    const T n = simplex_weight(x0 * x0 + y0 * y0 + z0 * z0 + w0 * w0, 0.6f) * gradient_dot(h0, x0, y0, z0, w0)
+        + simplex_weight(x1 * x1 + y1 * y1 + z1 * z1 + w1 * w1, 0.6f) * gradient_dot(h1, x1, y1, z1, w1)
+        + simplex_weight(x2 * x2 + y2 * y2 + z2 * z2 + w2 * w2, 0.6f) * gradient_dot(h2, x2, y2, z2, w2)
+        + simplex_weight(x3 * x3 + y3 * y3 + z3 * z3 + w3 * w3, 0.6f) * gradient_dot(h3, x3, y3, z3, w3)
+        + simplex_weight(x4 * x4 + y4 * y4 + z4 * z4 + w4 * w4, 0.6f) * gradient_dot(h4, x4, y4, z4, w4);
+    return n * 49.0f;
+}
+
+// -----------------------------------------------------------------------------
+// Classic Perlin noise
+// -----------------------------------------------------------------------------
+template <typename T>
+T perlin(const T& x, const T& y) {
+    using namespace detail;
+    const T fx = floor(x);
+    const T fy = floor(y);
+    const T x0 = x - fx;
+    const T y0 = y - fy;
+    const T x1 = x0 - 1.0f;
+    const T y1 = y0 - 1.0f;
+    const T i0 = mod289(fx);
+    const T j0 = mod289(fy);
+    const T i1 = mod289(fx + 1.0f);
+    const T j1 = mod289(fy + 1.0f);
+    const T hi0 = permute(i0);
+    const T hi1 = permute(i1);
+
+    const T n00 = gradient_dot(permute(hi0 + j0), x0, y0);
+    const T n10 = gradient_dot(permute(hi1 + j0), x1, y0);
+    const T n01 = gradient_dot(permute(hi0 + j1), x0, y1);
+    const T n11 = gradient_dot(permute(hi1 + j1), x1, y1);
+    const T u = fade(x0);
+    return lerp(lerp(n00, n10, u), lerp(n01, n11, u), fade(y0)) * 2.3f;
+}
+
+template <typename T>
+T perlin(const T& x, const T& y, const T& z) {
+    using namespace detail;
+    const T fx = floor(x);
+    const T fy = floor(y);
+    const T fz = floor(z);
+    const T x0 = x - fx, y0 = y - fy, z0 = z - fz;
+    const T x1 = x0 - 1.0f, y1 = y0 - 1.0f, z1 = z0 - 1.0f;
+    const T i0 = mod289(fx), j0 = mod289(fy), k0 = mod289(fz);
+    const T i1 = mod289(fx + 1.0f), j1 = mod289(fy + 1.0f), k1 = mod289(fz + 1.0f);
+    const T h00 = permute(permute(i0) + j0);
+    const T h10 = permute(permute(i1) + j0);
+    const T h01 = permute(permute(i0) + j1);
+    const T h11 = permute(permute(i1) + j1);
+
+    const T n000 = perlin_gradient_dot(permute(h00 + k0), x0, y0, z0);
+    const T n100 = perlin_gradient_dot(permute(h10 + k0), x1, y0, z0);
+    const T n010 = perlin_gradient_dot(permute(h01 + k0), x0, y1, z0);
+    const T n110 = perlin_gradient_dot(permute(h11 + k0), x1, y1, z0);
+    const T n001 = perlin_gradient_dot(permute(h00 + k1), x0, y0, z1);
+    const T n101 = perlin_gradient_dot(permute(h10 + k1), x1, y0, z1);
+    const T n011 = perlin_gradient_dot(permute(h01 + k1), x0, y1, z1);
+    const T n111 = perlin_gradient_dot(permute(h11 + k1), x1, y1, z1);
+    const T u = fade(x0);
+    const T v = fade(y0);
+    const T near = lerp(lerp(n000, n100, u), lerp(n010, n110, u), v);
+    const T far = lerp(lerp(n001, n101, u), lerp(n011, n111, u), v);
+    return lerp(near, far, fade(z0)) * 2.2f;
+}
+
+// -----------------------------------------------------------------------------
+// Fractal sums
+// -----------------------------------------------------------------------------
+enum class Basis { Simplex, Perlin };
+
+struct Fractal {
+    Basis basis = Basis::Simplex;
+    int octaves = 5;
+    /// Frequency of the first octave, in lattice cells per input unit.
+    float frequency = 1.0f;
+    /// Frequency multiplier per octave.
+    float lacunarity = 2.0f;
+    /// Amplitude multiplier per octave.
+    float gain = 0.5f;
+    /// How far `warped` displaces its input, in input units.
+    float warp = 1.0f;
+};
+
+namespace detail {
+
+template <typename T, typename... Rest>
+T basis(Basis kind, const T& x, const Rest&... rest) {
+    return kind == Basis::Perlin ? perlin(x, rest...) : simplex(x, rest...);
+}
+
+/// Octave `o` of a fractal sum, shifted so the octaves' lattice origins do not line up.
+template <typename T, typename... Rest>
+T octave(const Fractal& fractal, int o, float frequency, const T& x, const Rest&... rest) {
+    const float shift = 19.1f * static_cast<float>(o);
+    return basis(fractal.basis, x * frequency + shift, (rest * frequency + shift)...);
+}
+
+} // namespace detail
+
+/// Fractal Brownian motion over 2D or 3D `basis` noise, normalized back to roughly [-1, 1].
+template <typename T, typename... Rest>
+T fbm(const Fractal& fractal, const T& x, const Rest&... rest) {
+    T sum = detail::constant<T>(0.0f);
+    float amplitude = 1.0f;
+    float frequency = fractal.frequency;
+    float total = 0.0f;
+    for (int o = 0; o < fractal.octaves; ++o) {
+        sum = sum + detail::octave(fractal, o, frequency, x, rest...) * amplitude;
+        total += amplitude;
+        amplitude *= fractal.gain;
+        frequency *= fractal.lacunarity;
+    }
+    return total > 0.0f ? sum * (1.0f / total) : sum;
+}
+
+/// Ridged multifractal: octaves of `(1 - |n|)^2`, each weighted by the octave before it, so
+/// ridges stay sharp and valleys smooth. Mapped to roughly [-1, 1].
+template <typename T, typename... Rest>
+T ridged(const Fractal& fractal, const T& x, const Rest&... rest) {
+    using namespace detail;
+    T sum = constant<T>(0.0f);
+    T weight = constant<T>(1.0f);
+    float amplitude = 1.0f;
+    float frequency = fractal.frequency;
+    float total = 0.0f;
+    for (int o = 0; o < fractal.octaves; ++o) {
+        T ridge = 1.0f - abs(octave(fractal, o, frequency, x, rest...));
+        ridge = ridge * ridge * weight;
+        weight = clamp01(ridge * 2.0f);
+        sum = sum + ridge * amplitude;
+        total += amplitude;
+        amplitude *= fractal.gain;
+        frequency *= fractal.lacunarity;
+    }
+    return total > 0.0f ? sum * (2.0f / total) - 1.0f : sum;
+}
+
+/// Domain-warped fBm: the input is displaced by `warp` times an fBm vector field first.
+template <typename T>
+T warped(const Fractal& fractal, const T& x, const T& y) {
+    const T qx = fbm(fractal, x, y);
+    const T qy = fbm(fractal, x + 5.2f, y + 1.3f);
+    return fbm(fractal, x + qx * fractal.warp, y + qy * fractal.warp);
+}
+
+template <typename T>
+T warped(const Fractal& fractal, const T& x, const T& y, const T& z) {
+    const T qx = fbm(fractal, x, y, z);
+    const T qy = fbm(fractal, x + 5.2f, y + 1.3f, z + 2.8f);
+    const T qz = fbm(fractal, x + 1.7f, y + 9.2f, z + 4.6f);
+    return fbm(fractal, x + qx * fractal.warp, y + qy * fractal.warp, z + qz * fractal.warp);
+}
+
+} // namespace maya::math::noise
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAYA_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAYA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace maya::math::simd {
+
+// -----------------------------------------------------------------------------
+// Float4
+// -----------------------------------------------------------------------------
+/// Four packed floats mapped to SSE2 or NEON registers, with a scalar fallback.
+/// Comparisons return lane masks (all bits set / clear) usable with `select`.
+struct Float4 {
+#if defined(MAYA_SIMD_SSE)
+    __m128 v;
+    Float4() : v(_mm_setzero_ps()) {}
+    Float4(__m128 r) : v(r) {}
+
+    static Float4 load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    static Float4 splat(float s) { return _mm_set1_ps(s); }
+    static Float4 set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+
+    Float4 operator+(const Float4& o) const { return _mm_add_ps(v, o.v); }
+    Float4 operator-(const Float4& o) const { return _mm_sub_ps(v, o.v); }
+    Float4 operator*(const Float4& o) const { return _mm_mul_ps(v, o.v); }
+    Float4 operator/(const Float4& o) const { return _mm_div_ps(v, o.v); }
+    Float4 operator&(const Float4& o) const { return _mm_and_ps(v, o.v); }
+    Float4 operator|(const Float4& o) const { return _mm_or_ps(v, o.v); }
+
+    static Float4 min(const Float4& a, const Float4& b) { return _mm_min_ps(a.v, b.v); }
+    static Float4 max(const Float4& a, const Float4& b) { return _mm_max_ps(a.v, b.v); }
+    static Float4 sqrt(const Float4& a) { return _mm_sqrt_ps(a.v); }
+    /// Rounds toward negative infinity; exact for |a| < 2^31.
+    static Float4 floor(const Float4& a) {
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f)));
+    }
+
+    static Float4 less(const Float4& a, const Float4& b) { return _mm_cmplt_ps(a.v, b.v); }
+    static Float4 less_equal(const Float4& a, const Float4& b) { return _mm_cmple_ps(a.v, b.v); }
+    static Float4 greater(const Float4& a, const Float4& b) { return _mm_cmpgt_ps(a.v, b.v); }
+    static Float4 greater_equal(const Float4& a, const Float4& b) { return _mm_cmpge_ps(a.v, b.v); }
+    /// Lanes of `a` where `mask` is set, otherwise lanes of `b`.
+    static Float4 select(const Float4& mask, const Float4& a, const Float4& b) {
+        return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+    }
+    /// Bit i set when lane i of a comparison mask is set.
+    int move_mask() const { return _mm_movemask_ps(v); }
+
+    /// Dot product of all four lanes, broadcast to every lane.
+    static Float4 dot(const Float4& a, const Float4& b) {
+        __m128 m = _mm_mul_ps(a.v, b.v);
+        __m128 s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    float lane(int i) const {
+        alignas(16) float tmp[4];
+        _mm_store_ps(tmp, v);
+        return tmp[i];
+    }
+#elif defined(MAYA_SIMD_NEON)
+    float32x4_t v;
+    Float4() : v(vdupq_n_f32(0.0f)) {}
+    Float4(float32x4_t r) : v(r) {}
+
+    static Float4 load(const float* p) { return vld1q_f32(p); }
+    void store(float* p) const { vst1q_f32(p, v); }
+    static Float4 splat(float s) { return vdupq_n_f32(s); }
+    static Float4 set(float x, float y, float z, float w) {
+        const float tmp[4] = {x, y, z, w};
+        return vld1q_f32(tmp);
+    }
+
+    Float4 operator+(const Float4& o) const { return vaddq_f32(v, o.v); }
+    Float4 operator-(const Float4& o) const { return vsubq_f32(v, o.v); }
+    Float4 operator*(const Float4& o) const { return vmulq_f32(v, o.v); }
+    Float4 operator/(const Float4& o) const { return vdivq_f32(v, o.v); }
+    Float4 operator&(const Float4& o) const {
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(o.v)));
+    }
+    Float4 operator|(const Float4& o) const {
+        return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(o.v)));
+    }
+
+    static Float4 min(const Float4& a, const Float4& b) { return vminq_f32(a.v, b.v); }
+    static Float4 max(const Float4& a, const Float4& b) { return vmaxq_f32(a.v, b.v); }
+    static Float4 sqrt(const Float4& a) { return vsqrtq_f32(a.v); }
+    static Float4 floor(const Float4& a) { return vrndmq_f32(a.v); }
+
+    static Float4 less(const Float4& a, const Float4& b) { return vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)); }
+    static Float4 less_equal(const Float4& a, const Float4& b) { return vreinterpretq_f32_u32(vcleq_f32(a.v, b.v)); }
+    static Float4 greater(const Float4& a, const Float4& b) { return vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)); }
+    static Float4 greater_equal(const Float4& a, const Float4& b) {
+        return vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v));
+    }
+    static Float4 select(const Float4& mask, const Float4& a, const Float4& b) {
+        return vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v);
+    }
+    int move_mask() const {
+        const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(v), 31);
+        return static_cast<int>(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1)
+            | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+    }
+
+    static Float4 dot(const Float4& a, const Float4& b) { return vdupq_n_f32(vaddvq_f32(vmulq_f32(a.v, b.v))); }
+
+    float lane(int i) const {
+        float tmp[4];
+        vst1q_f32(tmp, v);
+        return tmp[i];
+    }
+#else
+    float v[4];
+    Float4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+
+    static Float4 load(const float* p) { return set(p[0], p[1], p[2], p[3]); }
+    void store(float* p) const { std::memcpy(p, v, sizeof(v)); }
+    static Float4 splat(float s) { return set(s, s, s, s); }
+    static Float4 set(float x, float y, float z, float w) {
+        Float4 r;
+        r.v[0] = x; r.v[1] = y; r.v[2] = z; r.v[3] = w;
+        return r;
+    }
+
+    template <typename Op>
+    static Float4 map(const Float4& a, const Float4& b, Op op) {
+        return set(op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]));
+    }
+    static float from_bits(uint32_t bits) { float f; std::memcpy(&f, &bits, sizeof(f)); return f; }
+    static uint32_t to_bits(float f) { uint32_t b; std::memcpy(&b, &f, sizeof(b)); return b; }
+    static float mask(bool b) { return from_bits(b ? 0xFFFFFFFFu : 0u); }
+
+    Float4 operator+(const Float4& o) const { return map(*this, o, [](float a, float b) { return a + b; }); }
+    Float4 operator-(const Float4& o) const { return map(*this, o, [](float a, float b) { return a - b; }); }
+    Float4 operator*(const Float4& o) const { return map(*this, o, [](float a, float b) { return a * b; }); }
+    Float4 operator/(const Float4& o) const { return map(*this, o, [](float a, float b) { return a / b; }); }
+    Float4 operator&(const Float4& o) const {
+        return map(*this, o, [](float a, float b) { return from_bits(to_bits(a) & to_bits(b)); });
+    }
+    Float4 operator|(const Float4& o) const {
+        return map(*this, o, [](float a, float b) { return from_bits(to_bits(a) | to_bits(b)); });
+    }
+
+    static Float4 min(const Float4& a, const Float4& b) { return map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+    static Float4 max(const Float4& a, const Float4& b) { return map(a, b, [](float x, float y) { return x < y ? y : x; }); }
+    static Float4 sqrt(const Float4& a) { return set(std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3])); }
+    static Float4 floor(const Float4& a) {
+        return set(std::floor(a.v[0]), std::floor(a.v[1]), std::floor(a.v[2]), std::floor(a.v[3]));
+    }
+
+    static Float4 less(const Float4& a, const Float4& b) { return map(a, b, [](float x, float y) { return mask(x < y); }); }
+    static Float4 less_equal(const Float4& a, const Float4& b) { return map(a, b, [](float x, float y) { return mask(x <= y); }); }
+    static Float4 greater(const Float4& a, const Float4& b) { return map(a, b, [](float x, float y) { return mask(x > y); }); }
+    static Float4 greater_equal(const Float4& a, const Float4& b) { return map(a, b, [](float x, float y) { return mask(x >= y); }); }
+    static Float4 select(const Float4& m, const Float4& a, const Float4& b) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i) {
+            r.v[i] = from_bits((to_bits(m.v[i]) & to_bits(a.v[i])) | (~to_bits(m.v[i]) & to_bits(b.v[i])));
+        }
+        return r;
+    }
+    int move_mask() const {
+        int bits = 0;
+        for (int i = 0; i < 4; ++i) {
+            bits |= static_cast<int>(to_bits(v[i]) >> 31) << i;
+        }
+        return bits;
+    }
+
+    static Float4 dot(const Float4& a, const Float4& b) {
+        return splat(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3]);
+    }
+
+    float lane(int i) const { return v[i]; }
+#endif
+
+    static Float4 zero() { return Float4(); }
+
+    Float4& operator+=(const Float4& o) { *this = *this + o; return *this; }
+    Float4& operator-=(const Float4& o) { *this = *this - o; return *this; }
+    Float4& operator*=(const Float4& o) { *this = *this * o; return *this; }
+
+    /// a * b + c (the compiler may fuse this where the target allows).
+    static Float4 madd(const Float4& a, const Float4& b, const Float4& c) { return a * b + c; }
+
+    static Float4 abs(const Float4& a) { return max(a, zero() - a); }
+    static Float4 clamp(const Float4& a, const Float4& lo, const Float4& hi) { return min(max(a, lo), hi); }
+
+    bool any() const { return move_mask() != 0; }
+    bool all() const { return move_mask() == 0xF; }
+};
+
+/// Scalar operands are broadcast to every lane.
+inline Float4 operator+(const Float4& a, float s) { return a + Float4::splat(s); }
+inline Float4 operator-(const Float4& a, float s) { return a - Float4::splat(s); }
+inline Float4 operator*(const Float4& a, float s) { return a * Float4::splat(s); }
+inline Float4 operator+(float s, const Float4& a) { return Float4::splat(s) + a; }
+inline Float4 operator-(float s, const Float4& a) { return Float4::splat(s) - a; }
+inline Float4 operator*(float s, const Float4& a) { return Float4::splat(s) * a; }
+
+} // namespace maya::math::simd
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "maya/math/math_utils.hpp"
+#include "maya/math/vector.hpp"
+#include <array>
+
+namespace maya::math {
+
+// -----------------------------------------------------------------------------
+// SphericalHarmonicsL2
+// -----------------------------------------------------------------------------
+/// RGB radiance projected onto the nine real spherical harmonics of bands 0-2. Basis order is
+/// (0,0), (1,-1), (1,0), (1,1), (2,-2), (2,-1), (2,0), (2,1), (2,2) over a unit direction.
+struct SphericalHarmonicsL2 {
+    static constexpr int kCount = 9;
+
+    std::array<Vec3, kCount> coefficients{};
+
+    /// Basis functions evaluated at unit direction `d`.
+    static void basis(const Vec3& d, float out[kCount]) {
+        out[0] = 0.282095f;
+        out[1] = 0.488603f * d.y;
+        out[2] = 0.488603f * d.z;
+        out[3] = 0.488603f * d.x;
+        out[4] = 1.092548f * d.x * d.y;
+        out[5] = 1.092548f * d.y * d.z;
+        out[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+        out[7] = 1.092548f * d.x * d.z;
+        out[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+    }
+
+    /// Uniform radiance from every direction.
+    static SphericalHarmonicsL2 constant(const Vec3& radiance) {
+        SphericalHarmonicsL2 sh;
+        // Integral of Y00 over the sphere: 0.282095 * 4 pi.
+        sh.coefficients[0] = radiance * 3.544908f;
+        return sh;
+    }
+
+    /// Adds radiance arriving from `d` over solid angle `weight` (Monte Carlo / texel projection).
+    void add(const Vec3& d, const Vec3& radiance, float weight) {
+        float y[kCount];
+        basis(d, y);
+        for (int i = 0; i < kCount; ++i) {
+            coefficients[i] += radiance * (y[i] * weight);
+        }
+    }
+
+    /// Reconstructed radiance from `d`.
+    Vec3 evaluate(const Vec3& d) const {
+        float y[kCount];
+        basis(d, y);
+        Vec3 result;
+        for (int i = 0; i < kCount; ++i) {
+            result += coefficients[i] * y[i];
+        }
+        return result;
+    }
+
+    /// Coefficients convolved with the clamped cosine lobe and divided by pi, so `evaluate` on the
+    /// result gives the ambient color of a white Lambertian surface with normal `d`.
+    SphericalHarmonicsL2 diffuse_convolved() const {
+        // Band factors A0 = pi, A1 = 2 pi / 3, A2 = pi / 4 (Ramamoorthi & Hanrahan), over pi.
+        constexpr float kBand[3] = {1.0f, 2.0f / 3.0f, 0.25f};
+        SphericalHarmonicsL2 result;
+        for (int i = 0; i < kCount; ++i) {
+            result.coefficients[i] = coefficients[i] * kBand[i == 0 ? 0 : (i < 4 ? 1 : 2)];
+        }
+        return result;
+    }
+
+    /// Irradiance at a surface facing `normal`, divided by pi (see `diffuse_convolved`).
+    Vec3 diffuse(const Vec3& normal) const { return diffuse_convolved().evaluate(normal); }
+
+    SphericalHarmonicsL2 operator+(const SphericalHarmonicsL2& other) const {
+        SphericalHarmonicsL2 result;
+        for (int i = 0; i < kCount; ++i) {
+            result.coefficients[i] = coefficients[i] + other.coefficients[i];
+        }
+        return result;
+    }
+
+    SphericalHarmonicsL2 operator*(float scale) const {
+        SphericalHarmonicsL2 result;
+        for (int i = 0; i < kCount; ++i) {
+            result.coefficients[i] = coefficients[i] * scale;
+        }
+        return result;
+    }
+
+    SphericalHarmonicsL2& operator+=(const SphericalHarmonicsL2& other) {
+        for (int i = 0; i < kCount; ++i) {
+            coefficients[i] += other.coefficients[i];
+        }
+        return *this;
+    }
+
+    static SphericalHarmonicsL2 lerp(const SphericalHarmonicsL2& a, const SphericalHarmonicsL2& b, float t) {
+        return a * (1.0f - t) + b * t;
+    }
+};
+
+} // namespace maya::math
@@ -15,6 +15,7 @@ enum class KeyCode {
     Down = 264,
     Up = 265,
     A = 65,
+    B = 66,
     D = 68,
     S = 83,
     W = 87
@@ -25,7 +25,7 @@ public:
 private:
     static void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 
-    GLFWwindow* m_window;
+    GLFWwindow* m_window = nullptr;
     FramebufferResizeCallback m_framebuffer_resize_callback;
 };
 
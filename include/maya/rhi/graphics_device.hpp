@@ -25,8 +25,17 @@ public:
         const std::string& vertex_entry = "vertexMain",
         const std::string& fragment_entry = "fragmentMain") = 0;
     virtual void bind_pipeline(PipelineHandle handle) { (void)handle; }
+    /// `data` may be null to allocate an uninitialized buffer for later `update_*` calls.
     virtual VertexBufferHandle create_vertex_buffer(const void* data, size_t size) = 0;
     virtual IndexBufferHandle create_index_buffer(const void* data, size_t size) = 0;
+    /// Overwrites the first `size` bytes of a CPU-visible buffer (streamed per-frame geometry).
+    virtual void update_vertex_buffer(VertexBufferHandle handle, const void* data, size_t size) = 0;
+    virtual void update_index_buffer(IndexBufferHandle handle, const void* data, size_t size) = 0;
+    
+    /// Releases a buffer; the handle must not be used afterwards. GPU work already encoded
+    /// keeps the resource alive until it completes.
+    virtual void destroy_vertex_buffer(VertexBufferHandle handle) { (void)handle; }
+    virtual void destroy_index_buffer(IndexBufferHandle handle) { (void)handle; }
     
     // Uniforms (Constants)
     virtual UniformBufferHandle create_uniform_buffer(size_t size) = 0;
@@ -34,6 +43,7 @@ public:
 
     // Textures
     virtual TextureHandle create_texture(const void* data, uint32_t width, uint32_t height) = 0;
+    virtual void destroy_texture(TextureHandle handle) { (void)handle; }
 
     // Command Execution
     virtual void bind_vertex_buffer(VertexBufferHandle handle, uint32_t slot) = 0;
@@ -41,7 +51,19 @@ public:
     virtual void bind_texture(TextureHandle handle, uint32_t slot) = 0;
 
     virtual void draw_indexed(IndexBufferHandle handle, uint32_t index_count) = 0;
+    /// Draws `index_count` indices starting at `first_index` (used for sub-ranges of shared
+    /// batch buffers).
+    virtual void draw_indexed_range(IndexBufferHandle handle, uint32_t first_index, uint32_t index_count) = 0;
+
+    /// Non-indexed draw of `vertex_count` vertices starting at `first_vertex` of the bound vertex
+    /// buffer (streamed debug geometry). Backends without it draw nothing.
+    virtual void draw(PrimitiveTopology topology, uint32_t first_vertex, uint32_t vertex_count) {
+        (void)topology; (void)first_vertex; (void)vertex_count;
+    }
 
+    /// Metal on Apple platforms, `NullDevice` elsewhere. `MAYA_RHI=null` forces the null
+    /// backend (headless CI, profiling CPU-side code); `MAYA_RHI=software` selects the CPU
+    /// rasterizer (`SoftwareDevice`).
     static std::unique_ptr<GraphicsDevice> create_default();
 };
 
@@ -29,17 +29,24 @@ public:
     void bind_pipeline(PipelineHandle handle) override;
     VertexBufferHandle create_vertex_buffer(const void* data, size_t size) override;
     IndexBufferHandle create_index_buffer(const void* data, size_t size) override;
+    void update_vertex_buffer(VertexBufferHandle handle, const void* data, size_t size) override;
+    void update_index_buffer(IndexBufferHandle handle, const void* data, size_t size) override;
+    void destroy_vertex_buffer(VertexBufferHandle handle) override;
+    void destroy_index_buffer(IndexBufferHandle handle) override;
     
     UniformBufferHandle create_uniform_buffer(size_t size) override;
     void update_uniform_buffer(UniformBufferHandle handle, const void* data, size_t size) override;
 
     TextureHandle create_texture(const void* data, uint32_t width, uint32_t height) override;
+    void destroy_texture(TextureHandle handle) override;
 
     void bind_vertex_buffer(VertexBufferHandle handle, uint32_t slot) override;
     void bind_uniform_buffer(UniformBufferHandle handle, uint32_t slot) override;
     void bind_texture(TextureHandle handle, uint32_t slot) override;
 
     void draw_indexed(IndexBufferHandle handle, uint32_t index_count) override;
+    void draw_indexed_range(IndexBufferHandle handle, uint32_t first_index, uint32_t index_count) override;
+    void draw(PrimitiveTopology topology, uint32_t first_vertex, uint32_t vertex_count) override;
 
 private:
 #ifdef __OBJC__
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "maya/rhi/graphics_device.hpp"
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace maya {
+
+/// Headless backend: resources live in CPU memory and every call is validated, but nothing is
+/// rasterized. Selected by `create_default` on platforms without Metal (or with `MAYA_RHI=null`)
+/// so engine code can be built, tested and profiled anywhere. Misuse is logged to stderr and
+/// counted instead of crashing, mirroring what the Metal debug layer would reject.
+class NullDevice : public GraphicsDevice {
+public:
+    static constexpr uint32_t kMaxBufferSlots = 31;
+    static constexpr uint32_t kMaxTextureSlots = 31;
+
+    /// Counters for one frame (`begin_frame` resets them).
+    struct FrameStats {
+        uint32_t draw_calls = 0;
+        uint64_t indices = 0;          ///< Indices submitted by indexed draws.
+        uint64_t vertices = 0;         ///< Vertices submitted by non-indexed draws.
+        uint64_t bytes_uploaded = 0;   ///< Create/update traffic, including outside the frame.
+        uint32_t pipeline_binds = 0;
+    };
+
+    /// `validate_indices` also checks every index of indexed draws against the bound vertex buffer
+    /// (linear in the index count; turn off when profiling submission cost).
+    explicit NullDevice(bool validate_indices = true);
+    ~NullDevice() override;
+
+    bool initialize(void* native_window_handle) override;
+    void shutdown() override;
+
+    void resize(uint32_t width, uint32_t height) override;
+
+    void begin_frame() override;
+    void end_frame() override;
+
+    /// Accepts any source that defines both entry points as functions; there is no compiler.
+    PipelineHandle create_pipeline(const std::string& shader_source,
+        const std::string& vertex_entry = "vertexMain",
+        const std::string& fragment_entry = "fragmentMain") override;
+    void bind_pipeline(PipelineHandle handle) override;
+    VertexBufferHandle create_vertex_buffer(const void* data, size_t size) override;
+    IndexBufferHandle create_index_buffer(const void* data, size_t size) override;
+    void update_vertex_buffer(VertexBufferHandle handle, const void* data, size_t size) override;
+    void update_index_buffer(IndexBufferHandle handle, const void* data, size_t size) override;
+    void destroy_vertex_buffer(VertexBufferHandle handle) override;
+    void destroy_index_buffer(IndexBufferHandle handle) override;
+
+    UniformBufferHandle create_uniform_buffer(size_t size) override;
+    void update_uniform_buffer(UniformBufferHandle handle, const void* data, size_t size) override;
+
+    TextureHandle create_texture(const void* data, uint32_t width, uint32_t height) override;
+    void destroy_texture(TextureHandle handle) override;
+
+    void bind_vertex_buffer(VertexBufferHandle handle, uint32_t slot) override;
+    void bind_uniform_buffer(UniformBufferHandle handle, uint32_t slot) override;
+    void bind_texture(TextureHandle handle, uint32_t slot) override;
+
+    void draw_indexed(IndexBufferHandle handle, uint32_t index_count) override;
+    void draw_indexed_range(IndexBufferHandle handle, uint32_t first_index, uint32_t index_count) override;
+    void draw(PrimitiveTopology topology, uint32_t first_vertex, uint32_t vertex_count) override;
+
+    // Inspection (tests and tools)
+    /// Contents of a live vertex, index or uniform buffer; null for unknown handles.
+    const std::vector<uint8_t>* buffer_data(ResourceHandle handle) const;
+    /// RGBA8 pixels of a live texture; null for unknown handles.
+    const std::vector<uint8_t>* texture_data(TextureHandle handle) const;
+    size_t live_buffer_count() const { return m_buffers.size(); }
+    size_t live_texture_count() const { return m_textures.size(); }
+    size_t live_pipeline_count() const { return m_pipelines.size(); }
+
+    uint32_t width() const { return m_width; }
+    uint32_t height() const { return m_height; }
+    bool in_frame() const { return m_in_frame; }
+    /// Counters of the frame being recorded, and of the last frame that ended.
+    const FrameStats& frame_stats() const { return m_frame_stats; }
+    const FrameStats& last_frame_stats() const { return m_last_frame_stats; }
+
+    uint32_t validation_error_count() const { return m_validation_errors; }
+    const std::string& last_validation_error() const { return m_last_validation_error; }
+    /// Silences stderr output (errors are still counted); used by tests that provoke misuse.
+    void set_log_validation_errors(bool log) { m_log_validation_errors = log; }
+
+protected:
+    struct Texture {
+        uint32_t width;
+        uint32_t height;
+        std::vector<uint8_t> pixels;
+    };
+
+    struct Pipeline {
+        std::string vertex_entry;
+        std::string fragment_entry;
+    };
+
+    /// A draw that passed validation. `indices` is null for non-indexed draws, in which case
+    /// `first`/`count` address vertices. Index ranges are in bounds; index values and vertex
+    /// ranges are not guaranteed to be (the stride depends on the vertex function).
+    struct DrawCall {
+        PrimitiveTopology topology;
+        const Pipeline* pipeline;
+        const std::vector<uint8_t>* vertices;  ///< Buffer bound at slot 0.
+        const uint32_t* indices;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /// Called for every validated draw; backends that execute draws override it.
+    virtual void execute(const DrawCall& draw) { (void)draw; }
+
+    /// Contents of the buffer or texture bound at `slot` in the current frame; null if none.
+    const std::vector<uint8_t>* bound_buffer(uint32_t slot) const;
+    const Texture* bound_texture(uint32_t slot) const;
+    const Pipeline* find_pipeline(PipelineHandle handle) const;
+    void report(const char* call, const std::string& message);
+
+private:
+    enum class BufferKind : uint8_t { Vertex, Index, Uniform };
+
+    struct Buffer {
+        BufferKind kind;
+        std::vector<uint8_t> data;
+    };
+
+    ResourceHandle create_buffer(BufferKind kind, const void* data, size_t size, const char* call);
+    void update_buffer(BufferKind kind, ResourceHandle handle, const void* data, size_t size, const char* call);
+    void destroy_buffer(BufferKind kind, ResourceHandle handle, const char* call);
+    Buffer* find_buffer(BufferKind kind, ResourceHandle handle, const char* call);
+    bool validate_draw(const char* call);
+
+    bool m_validate_indices;
+    bool m_initialized = false;
+    bool m_in_frame = false;
+    bool m_log_validation_errors = true;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+
+    std::unordered_map<ResourceHandle, Buffer> m_buffers;
+    std::unordered_map<ResourceHandle, Texture> m_textures;
+    std::unordered_map<ResourceHandle, Pipeline> m_pipelines;
+    ResourceHandle m_next_handle = 1;
+
+    ResourceHandle m_bound_pipeline = INVALID_HANDLE;
+    std::array<ResourceHandle, kMaxBufferSlots> m_bound_buffers{};
+    std::array<ResourceHandle, kMaxTextureSlots> m_bound_textures{};
+
+    FrameStats m_frame_stats;
+    FrameStats m_last_frame_stats;
+    uint32_t m_validation_errors = 0;
+    std::string m_last_validation_error;
+};
+
+} // namespace maya
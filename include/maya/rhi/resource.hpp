@@ -13,4 +13,6 @@ struct UniformBufferHandle { ResourceHandle handle = INVALID_HANDLE; };
 struct TextureHandle { ResourceHandle handle = INVALID_HANDLE; };
 struct PipelineHandle { ResourceHandle handle = INVALID_HANDLE; };
 
+enum class PrimitiveTopology : uint8_t { Triangles, Lines, Points };
+
 } // namespace maya
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "maya/core/image_loader.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/math/vector.hpp"
+#include "maya/rhi/null/null_device.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maya {
+
+class JobSystem;
+
+/// CPU rasterizer behind `GraphicsDevice`, for seeing and regression-testing `Scene::render`
+/// output without a GPU. Resources and validation come from `NullDevice`; draws run C++
+/// versions of the `triangle.metal` entry points (`vertexMain`, `vertexDebug`, `fragmentMain`,
+/// `fragmentUnlit`) with the `MetalDevice` fixed-function state: Metal clip space (z in [0, 1]),
+/// counter-clockwise front faces with back faces culled, 32-bit float depth cleared to 1 with a
+/// Less test and writes, no blending, bilinear repeat sampling of RGBA8 textures (an unbound
+/// texture samples as opaque white).
+///
+/// Draws are vertex-shaded, clipped and binned into `kTileSize` screen tiles as they are
+/// submitted; `end_frame` rasterizes the tiles in parallel on the job system, testing four pixels
+/// at a time against the edge functions. Each tile keeps submission order, so the image does not
+/// depend on the worker count. Edges are evaluated in a canonical direction with a top-left fill
+/// rule, so triangles sharing an edge cover each pixel exactly once. Lines and points are drawn
+/// as one-pixel-wide quads. Resources bound to a draw must stay alive until `end_frame`.
+class SoftwareDevice : public NullDevice {
+public:
+    static constexpr uint32_t kTileSize = 64;
+
+    /// Counters for the last frame rasterized by `end_frame`.
+    struct RasterStats {
+        uint64_t primitives = 0;   ///< Triangles, lines and points submitted.
+        uint64_t culled = 0;       ///< Back-facing, degenerate or covering no pixel center.
+        uint64_t clipped = 0;      ///< Primitives that crossed a clip plane.
+        uint64_t tile_entries = 0; ///< Triangle references across all tile bins.
+        uint64_t fragments = 0;    ///< Pixels that passed the depth test and were shaded.
+    };
+
+    explicit SoftwareDevice(JobSystem& jobs, uint32_t width = 640, uint32_t height = 360);
+
+    /// Only the entry points listed above are accepted (other sources fail like a bad shader).
+    PipelineHandle create_pipeline(const std::string& shader_source,
+        const std::string& vertex_entry = "vertexMain",
+        const std::string& fragment_entry = "fragmentMain") override;
+
+    /// Takes effect at the next `begin_frame`.
+    void resize(uint32_t width, uint32_t height) override;
+    void begin_frame() override;
+    /// Rasterizes the frame's bins into `image()` and `depth_at()`.
+    void end_frame() override;
+
+    void set_clear_color(const math::Vec4& color) { m_clear_color = color; }
+
+    /// RGBA8 color of the last completed frame; row 0 is the top of the image.
+    const ImageData& image() const { return m_image; }
+    /// Depth of the last completed frame at pixel (x, y), 1 where nothing was drawn.
+    float depth_at(uint32_t x, uint32_t y) const { return m_depth[static_cast<size_t>(y) * m_stride + x]; }
+    const RasterStats& raster_stats() const { return m_stats; }
+    bool write_png(const std::string& path) const;
+
+protected:
+    void execute(const DrawCall& draw) override;
+
+private:
+    /// Varyings of `VertexOut` after the position: world position, world normal, color, uv.
+    static constexpr uint32_t kVaryingCount = 12;
+
+    /// Vertex function output: clip-space position followed by the varyings.
+    struct ClipVertex {
+        float position[4];
+        float varyings[kVaryingCount];
+    };
+
+    /// Vertex after the perspective divide and viewport transform (pixels, y down).
+    struct RasterVertex {
+        float x, y, z, inv_w;
+        float varyings[kVaryingCount];
+    };
+
+    enum class VertexFunction : uint8_t { Main, Debug };
+    enum class FragmentFunction : uint8_t { Main, Unlit };
+
+    /// Per-draw state snapshot; the engine rewrites one uniform buffer between draws.
+    struct DrawState {
+        SceneDrawUniforms uniforms;
+        const Texture* texture;
+        FragmentFunction fragment;
+    };
+
+    struct Triangle {
+        uint32_t vertices[3];
+        uint32_t state;
+    };
+
+    void apply_size();
+    uint32_t push_vertex(const ClipVertex& clip);
+    /// Bins a triangle of `m_vertices`; `cull_back_faces` is false for line and point quads.
+    void add_triangle(uint32_t a, uint32_t b, uint32_t c, uint32_t state, bool cull_back_faces);
+    void add_clipped_triangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, uint32_t outcodes,
+        uint32_t state);
+    void add_line(const ClipVertex& a, const ClipVertex& b, uint32_t state);
+    void add_quad(const RasterVertex& a, const RasterVertex& b, const math::Vec2& along,
+        const math::Vec2& across, uint32_t state);
+    void rasterize_tile(uint32_t tile);
+
+    /// Signed distance-like value to clip plane `plane` (near, far, then the x/y guard band);
+    /// negative outside.
+    static float plane_distance(const ClipVertex& v, uint32_t plane);
+    static uint32_t outcode(const ClipVertex& v);
+    static ClipVertex lerp(const ClipVertex& a, const ClipVertex& b, float t);
+    /// Sutherland-Hodgman against the planes set in `outcodes`; returns the output vertex count.
+    static uint32_t clip_polygon(ClipVertex* polygon, uint32_t count, uint32_t outcodes);
+
+    JobSystem& m_jobs;
+    math::Vec4 m_clear_color{0.1f, 0.1f, 0.1f, 1.0f};
+    uint32_t m_pending_width;
+    uint32_t m_pending_height;
+
+    // Framebuffer; rows are padded to a multiple of four pixels for the SIMD loops.
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_stride = 0;
+    uint32_t m_tiles_x = 0;
+    uint32_t m_tiles_y = 0;
+    std::vector<uint32_t> m_color;
+    std::vector<float> m_depth;
+    ImageData m_image;
+
+    // Current frame
+    std::vector<ClipVertex> m_shaded;
+    std::vector<uint8_t> m_outcodes;
+    std::vector<uint32_t> m_raster_index;  ///< `m_shaded` -> `m_vertices`, for unclipped vertices.
+    std::vector<RasterVertex> m_vertices;
+    std::vector<Triangle> m_triangles;
+    std::vector<DrawState> m_states;
+    std::vector<std::vector<uint32_t>> m_bins;
+    std::vector<uint64_t> m_tile_fragments;
+    RasterStats m_frame_stats;
+    RasterStats m_stats;
+};
+
+} // namespace maya
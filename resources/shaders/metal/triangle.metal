@@ -12,7 +12,7 @@ struct Uniforms {
     float4x4 model_matrix;
     float4x4 view_projection_matrix;
     float4 light_dir_world;
-    float4 ambient_rgb;
+    float4 ambient_sh[9];
     float4 light_diffuse_rgb;
     float4 camera_position_world;
     float4 specular_rgb_shininess;
@@ -50,6 +50,36 @@ vertex VertexOut vertexMain(uint vertexID [[vertex_id]],
     return out;
 }
 
+struct DebugVertex {
+    packed_float3 position;
+    uint color;
+};
+
+/// Debug lines and triangles (`DebugDrawRenderer`): world-space positions, RGBA8 colors.
+vertex VertexOut vertexDebug(uint vertexID [[vertex_id]],
+                            constant DebugVertex* vertices [[buffer(0)]],
+                            constant Uniforms& uniforms [[buffer(1)]]) {
+    VertexOut out;
+    float3 world_pos = vertices[vertexID].position;
+    out.world_position = world_pos;
+    out.position = uniforms.view_projection_matrix * float4(world_pos, 1.0);
+    out.world_normal = float3(0.0, 1.0, 0.0);
+    out.color = unpack_unorm4x8_to_float(vertices[vertexID].color);
+    out.uv = float2(0.0);
+    return out;
+}
+
+/// Ambient color for normal `n` from diffuse-convolved L2 spherical harmonics
+/// (`SphericalHarmonicsL2::diffuse_convolved`, same basis order).
+float3 sh_ambient(constant float4* sh, float3 n) {
+    float3 result = 0.282095 * sh[0].rgb;
+    result += 0.488603 * (n.y * sh[1].rgb + n.z * sh[2].rgb + n.x * sh[3].rgb);
+    result += 1.092548 * (n.x * n.y * sh[4].rgb + n.y * n.z * sh[5].rgb + n.x * n.z * sh[7].rgb);
+    result += 0.315392 * (3.0 * n.z * n.z - 1.0) * sh[6].rgb;
+    result += 0.546274 * (n.x * n.x - n.y * n.y) * sh[8].rgb;
+    return max(result, float3(0.0));
+}
+
 fragment float4 fragmentMain(VertexOut in [[stage_in]],
                             constant Uniforms& uniforms [[buffer(1)]],
                             texture2d<float> colorTexture [[texture(0)]],
@@ -66,7 +96,7 @@ fragment float4 fragmentMain(VertexOut in [[stage_in]],
     float spec_mask = pow(saturate(dot(N, H)), shininess);
 
     float3 albedo = texColor.rgb * in.color.rgb;
-    float3 ambient_term = uniforms.ambient_rgb.rgb * albedo;
+    float3 ambient_term = sh_ambient(uniforms.ambient_sh, N) * albedo;
     float3 diffuse_term = ndotl * uniforms.light_diffuse_rgb.rgb * albedo;
     float3 specular_term =
         spec_mask * uniforms.specular_rgb_shininess.rgb * uniforms.light_diffuse_rgb.rgb;
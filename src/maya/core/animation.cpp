@@ -0,0 +1,435 @@
+#include "maya/core/animation.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace maya {
+
+namespace {
+
+using math::simd::Float4;
+
+constexpr float kSqrt2 = 1.41421356237f;
+constexpr float kQuatScale = 32767.0f;
+constexpr float kVectorScale = 65535.0f;
+constexpr uint32_t kMaxFrames = 65536;
+
+/// Four quaternions in structure-of-arrays form.
+struct QuatLanes {
+    Float4 x, y, z, w;
+};
+
+/// Shortest-path nlerp of four quaternion pairs at once.
+QuatLanes nlerp(const QuatLanes& a, QuatLanes b, const Float4& t) {
+    const Float4 dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    const Float4 sign = Float4::select(Float4::less(dot, Float4::zero()), Float4::splat(-1.0f), Float4::splat(1.0f));
+    b.x *= sign;
+    b.y *= sign;
+    b.z *= sign;
+    b.w *= sign;
+    QuatLanes r{Float4::madd(b.x - a.x, t, a.x), Float4::madd(b.y - a.y, t, a.y), Float4::madd(b.z - a.z, t, a.z),
+        Float4::madd(b.w - a.w, t, a.w)};
+    const Float4 inv_length = Float4::splat(1.0f) / Float4::sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+    r.x *= inv_length;
+    r.y *= inv_length;
+    r.z *= inv_length;
+    r.w *= inv_length;
+    return r;
+}
+
+math::Quat nlerp(const math::Quat& a, math::Quat b, float t) {
+    if (a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f) {
+        b = math::Quat(-b.x, -b.y, -b.z, -b.w);
+    }
+    math::Quat r(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+    r.normalize();
+    return r;
+}
+
+/// Largest component difference, with `b`'s sign chosen to match `a` (q and -q are the same rotation).
+float quat_error(const math::Quat& a, const math::Quat& b) {
+    const float same = std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z), std::abs(a.w - b.w)});
+    const float flipped =
+        std::max({std::abs(a.x + b.x), std::abs(a.y + b.y), std::abs(a.z + b.z), std::abs(a.w + b.w)});
+    return std::min(same, flipped);
+}
+
+float vector_error(const math::Vec3& a, const math::Vec3& b) {
+    return std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z)});
+}
+
+/// Greedy key reduction: from each kept key, extends the segment as far as interpolating
+/// `decoded` between its ends stays within `tolerance` of `raw` for every frame inside it.
+/// Returns kept frame numbers; a track within tolerance of its first value keeps only that.
+template <typename T, typename Lerp, typename Error>
+std::vector<uint32_t> reduce_keys(const std::vector<T>& raw, const std::vector<T>& decoded, float tolerance,
+    Lerp lerp, Error error) {
+    const uint32_t count = static_cast<uint32_t>(raw.size());
+    std::vector<uint32_t> keys{0};
+    bool constant = true;
+    for (uint32_t f = 1; f < count && constant; ++f) {
+        constant = error(decoded[0], raw[f]) <= tolerance;
+    }
+    if (constant) {
+        return keys;
+    }
+
+    auto segment_fits = [&](uint32_t first, uint32_t last) {
+        const float span = static_cast<float>(last - first);
+        for (uint32_t f = first + 1; f < last; ++f) {
+            const T value = lerp(decoded[first], decoded[last], static_cast<float>(f - first) / span);
+            if (error(value, raw[f]) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    };
+    uint32_t first = 0;
+    while (first + 1 < count) {
+        uint32_t last = first + 1;
+        while (last + 1 < count && segment_fits(first, last + 1)) {
+            ++last;
+        }
+        keys.push_back(last);
+        first = last;
+    }
+    return keys;
+}
+
+} // namespace
+
+QuantizedQuat QuantizedQuat::encode(const math::Quat& q) {
+    math::Quat n = q;
+    n.normalize();
+    float c[4] = {n.x, n.y, n.z, n.w};
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) {
+            largest = i;
+        }
+    }
+    // The dropped component is rebuilt as positive, so flip the quaternion to match.
+    const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+    QuantizedQuat result;
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        // The other three lie within +-1/sqrt(2).
+        const float unit = std::clamp((c[i] * sign * kSqrt2 + 1.0f) * 0.5f, 0.0f, 1.0f);
+        result.packed[slot++] = static_cast<uint16_t>(std::lround(unit * kQuatScale));
+    }
+    result.packed[0] |= static_cast<uint16_t>((largest & 1u) << 15);
+    result.packed[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+    return result;
+}
+
+math::Quat QuantizedQuat::decode() const {
+    const uint32_t largest = (packed[0] >> 15) | ((packed[1] >> 15) << 1);
+    float c[4];
+    float sum = 0.0f;
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const float unit = static_cast<float>(packed[slot++] & 0x7FFF) / kQuatScale;
+        c[i] = (unit * 2.0f - 1.0f) / kSqrt2;
+        sum += c[i] * c[i];
+    }
+    c[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+    return math::Quat(c[0], c[1], c[2], c[3]);
+}
+
+size_t AnimationClip::memory_bytes() const {
+    return (m_rotation_tracks.size() + m_vector_tracks.size()) * sizeof(Track)
+        + m_vector_ranges.size() * sizeof(VectorRange)
+        + (m_rotation_frames.size() + m_vector_frames.size()) * sizeof(uint16_t)
+        + m_rotation_keys.size() * sizeof(QuantizedQuat) + m_vector_keys.size() * sizeof(QuantizedVec3);
+}
+
+uint32_t AnimationClip::find_key(const std::vector<uint16_t>& frames, const Track& track, float frame) {
+    const auto begin = frames.begin() + track.first_key;
+    const auto end = begin + track.key_count;
+    const auto next = std::upper_bound(begin, end, frame, [](float f, uint16_t key) { return f < key; });
+    return next == begin ? 0 : static_cast<uint32_t>(next - begin - 1);
+}
+
+void AnimationClip::sample(float time, JointTransform* out) const {
+    const float frame = std::clamp(time, 0.0f, m_duration) * m_sample_rate;
+    math::Vec3 vectors[4];
+    for (uint32_t j = 0; j < m_joint_count; j += 4) {
+        const uint32_t lanes = std::min(4u, m_joint_count - j);
+        sample_rotations(j, lanes, frame, out + j);
+        sample_vectors(j, lanes, frame, vectors);
+        for (uint32_t l = 0; l < lanes; ++l) {
+            out[j + l].translation = vectors[l];
+        }
+        sample_vectors(m_joint_count + j, lanes, frame, vectors);
+        for (uint32_t l = 0; l < lanes; ++l) {
+            out[j + l].scale = vectors[l];
+        }
+    }
+}
+
+void AnimationClip::sample_rotations(uint32_t first_joint, uint32_t lanes, float frame, JointTransform* out) const {
+    // Unused lanes interpolate identity with itself.
+    alignas(16) float a[4][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {1, 1, 1, 1}};
+    alignas(16) float b[4][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {1, 1, 1, 1}};
+    alignas(16) float t[4] = {0, 0, 0, 0};
+    for (uint32_t l = 0; l < lanes; ++l) {
+        const Track& track = m_rotation_tracks[first_joint + l];
+        const uint32_t k = find_key(m_rotation_frames, track, frame);
+        const uint32_t key = track.first_key + k;
+        const math::Quat qa = m_rotation_keys[key].decode();
+        math::Quat qb = qa;
+        if (k + 1 < track.key_count) {
+            qb = m_rotation_keys[key + 1].decode();
+            const float fa = m_rotation_frames[key];
+            const float fb = m_rotation_frames[key + 1];
+            t[l] = std::clamp((frame - fa) / (fb - fa), 0.0f, 1.0f);
+        }
+        a[0][l] = qa.x; a[1][l] = qa.y; a[2][l] = qa.z; a[3][l] = qa.w;
+        b[0][l] = qb.x; b[1][l] = qb.y; b[2][l] = qb.z; b[3][l] = qb.w;
+    }
+
+    const QuatLanes r = nlerp({Float4::load(a[0]), Float4::load(a[1]), Float4::load(a[2]), Float4::load(a[3])},
+        {Float4::load(b[0]), Float4::load(b[1]), Float4::load(b[2]), Float4::load(b[3])}, Float4::load(t));
+    alignas(16) float x[4], y[4], z[4], w[4];
+    r.x.store(x);
+    r.y.store(y);
+    r.z.store(z);
+    r.w.store(w);
+    for (uint32_t l = 0; l < lanes; ++l) {
+        out[l].rotation = math::Quat(x[l], y[l], z[l], w[l]);
+    }
+}
+
+void AnimationClip::sample_vectors(uint32_t first_track, uint32_t lanes, float frame, math::Vec3* out) const {
+    // Interpolate the quantized values, then dequantize once.
+    alignas(16) float a[3][4] = {};
+    alignas(16) float b[3][4] = {};
+    alignas(16) float t[4] = {};
+    alignas(16) float min[3][4] = {};
+    alignas(16) float step[3][4] = {};
+    for (uint32_t l = 0; l < lanes; ++l) {
+        const uint32_t index = first_track + l;
+        const Track& track = m_vector_tracks[index];
+        const uint32_t k = find_key(m_vector_frames, track, frame);
+        const uint32_t key = track.first_key + k;
+        const QuantizedVec3& qa = m_vector_keys[key];
+        const QuantizedVec3& qb = k + 1 < track.key_count ? m_vector_keys[key + 1] : qa;
+        if (k + 1 < track.key_count) {
+            const float fa = m_vector_frames[key];
+            const float fb = m_vector_frames[key + 1];
+            t[l] = std::clamp((frame - fa) / (fb - fa), 0.0f, 1.0f);
+        }
+        const VectorRange& range = m_vector_ranges[index];
+        const float range_min[3] = {range.min.x, range.min.y, range.min.z};
+        const float range_extent[3] = {range.extent.x, range.extent.y, range.extent.z};
+        for (int c = 0; c < 3; ++c) {
+            a[c][l] = qa.packed[c];
+            b[c][l] = qb.packed[c];
+            min[c][l] = range_min[c];
+            step[c][l] = range_extent[c] / kVectorScale;
+        }
+    }
+
+    const Float4 tv = Float4::load(t);
+    alignas(16) float result[3][4];
+    for (int c = 0; c < 3; ++c) {
+        const Float4 av = Float4::load(a[c]);
+        const Float4 q = Float4::madd(Float4::load(b[c]) - av, tv, av);
+        Float4::madd(q, Float4::load(step[c]), Float4::load(min[c])).store(result[c]);
+    }
+    for (uint32_t l = 0; l < lanes; ++l) {
+        out[l] = math::Vec3(result[0][l], result[1][l], result[2][l]);
+    }
+}
+
+AnimationClip compress_clip(const RawAnimationClip& raw, const AnimationCompressionSettings& settings) {
+    AnimationClip clip;
+    const uint32_t joints = raw.joint_count;
+    const uint32_t frames = std::min(raw.frame_count(), kMaxFrames);
+    clip.m_joint_count = joints;
+    clip.m_sample_rate = raw.sample_rate;
+    clip.m_duration = frames < 2 ? 0.0f : static_cast<float>(frames - 1) / raw.sample_rate;
+    if (frames == 0) {
+        clip.m_joint_count = 0;
+        return clip;
+    }
+
+    auto lerp_quat = [](const math::Quat& a, const math::Quat& b, float t) { return nlerp(a, b, t); };
+    auto lerp_vector = [](const math::Vec3& a, const math::Vec3& b, float t) { return a + (b - a) * t; };
+
+    std::vector<math::Quat> raw_rotations(frames);
+    std::vector<math::Quat> decoded_rotations(frames);
+    std::vector<QuantizedQuat> encoded_rotations(frames);
+    for (uint32_t j = 0; j < joints; ++j) {
+        for (uint32_t f = 0; f < frames; ++f) {
+            raw_rotations[f] = raw.samples[f * joints + j].rotation;
+            raw_rotations[f].normalize();
+            encoded_rotations[f] = QuantizedQuat::encode(raw_rotations[f]);
+            decoded_rotations[f] = encoded_rotations[f].decode();
+        }
+        const std::vector<uint32_t> keys =
+            reduce_keys(raw_rotations, decoded_rotations, settings.rotation_tolerance, lerp_quat, quat_error);
+        clip.m_rotation_tracks.push_back(
+            {static_cast<uint32_t>(clip.m_rotation_keys.size()), static_cast<uint32_t>(keys.size())});
+        for (uint32_t f : keys) {
+            clip.m_rotation_frames.push_back(static_cast<uint16_t>(f));
+            clip.m_rotation_keys.push_back(encoded_rotations[f]);
+        }
+    }
+
+    std::vector<math::Vec3> raw_vectors(frames);
+    std::vector<math::Vec3> decoded_vectors(frames);
+    std::vector<QuantizedVec3> encoded_vectors(frames);
+    for (uint32_t track = 0; track < joints * 2; ++track) {
+        const bool is_scale = track >= joints;
+        const uint32_t j = is_scale ? track - joints : track;
+        for (uint32_t f = 0; f < frames; ++f) {
+            const JointTransform& sample = raw.samples[f * joints + j];
+            raw_vectors[f] = is_scale ? sample.scale : sample.translation;
+        }
+
+        math::Vec3 lo = raw_vectors[0];
+        math::Vec3 hi = raw_vectors[0];
+        for (const math::Vec3& v : raw_vectors) {
+            lo = math::Vec3(std::min(lo.x, v.x), std::min(lo.y, v.y), std::min(lo.z, v.z));
+            hi = math::Vec3(std::max(hi.x, v.x), std::max(hi.y, v.y), std::max(hi.z, v.z));
+        }
+        const math::Vec3 extent = hi - lo;
+        const float lo_c[3] = {lo.x, lo.y, lo.z};
+        const float extent_c[3] = {extent.x, extent.y, extent.z};
+        for (uint32_t f = 0; f < frames; ++f) {
+            const float v[3] = {raw_vectors[f].x, raw_vectors[f].y, raw_vectors[f].z};
+            float decoded[3];
+            for (int c = 0; c < 3; ++c) {
+                const float unit = extent_c[c] > 0.0f ? (v[c] - lo_c[c]) / extent_c[c] : 0.0f;
+                const uint16_t packed = static_cast<uint16_t>(std::lround(std::clamp(unit, 0.0f, 1.0f) * kVectorScale));
+                encoded_vectors[f].packed[c] = packed;
+                decoded[c] = lo_c[c] + static_cast<float>(packed) * (extent_c[c] / kVectorScale);
+            }
+            decoded_vectors[f] = math::Vec3(decoded[0], decoded[1], decoded[2]);
+        }
+
+        const float tolerance = is_scale ? settings.scale_tolerance : settings.translation_tolerance;
+        const std::vector<uint32_t> keys =
+            reduce_keys(raw_vectors, decoded_vectors, tolerance, lerp_vector, vector_error);
+        clip.m_vector_tracks.push_back(
+            {static_cast<uint32_t>(clip.m_vector_keys.size()), static_cast<uint32_t>(keys.size())});
+        clip.m_vector_ranges.push_back({lo, extent});
+        for (uint32_t f : keys) {
+            clip.m_vector_frames.push_back(static_cast<uint16_t>(f));
+            clip.m_vector_keys.push_back(encoded_vectors[f]);
+        }
+    }
+    return clip;
+}
+
+void blend_poses(const JointTransform* a, const JointTransform* b, float weight, uint32_t joint_count,
+    JointTransform* out) {
+    const Float4 t = Float4::splat(weight);
+    for (uint32_t j = 0; j < joint_count; j += 4) {
+        const uint32_t lanes = std::min(4u, joint_count - j);
+        // Rows 0-3: rotation xyzw, 4-6: translation, 7-9: scale. Unused lanes stay zero
+        // apart from w so the normalization stays finite.
+        alignas(16) float ga[10][4] = {};
+        alignas(16) float gb[10][4] = {};
+        for (int l = 0; l < 4; ++l) {
+            ga[3][l] = 1.0f;
+            gb[3][l] = 1.0f;
+        }
+        for (uint32_t l = 0; l < lanes; ++l) {
+            const JointTransform* src[2] = {&a[j + l], &b[j + l]};
+            float(*dst[2])[4] = {ga, gb};
+            for (int s = 0; s < 2; ++s) {
+                const JointTransform& x = *src[s];
+                const float values[10] = {x.rotation.x, x.rotation.y, x.rotation.z, x.rotation.w, x.translation.x,
+                    x.translation.y, x.translation.z, x.scale.x, x.scale.y, x.scale.z};
+                for (int r = 0; r < 10; ++r) {
+                    dst[s][r][l] = values[r];
+                }
+            }
+        }
+
+        alignas(16) float result[10][4];
+        const QuatLanes q = nlerp({Float4::load(ga[0]), Float4::load(ga[1]), Float4::load(ga[2]), Float4::load(ga[3])},
+            {Float4::load(gb[0]), Float4::load(gb[1]), Float4::load(gb[2]), Float4::load(gb[3])}, t);
+        q.x.store(result[0]);
+        q.y.store(result[1]);
+        q.z.store(result[2]);
+        q.w.store(result[3]);
+        for (int r = 4; r < 10; ++r) {
+            const Float4 va = Float4::load(ga[r]);
+            Float4::madd(Float4::load(gb[r]) - va, t, va).store(result[r]);
+        }
+        for (uint32_t l = 0; l < lanes; ++l) {
+            JointTransform& o = out[j + l];
+            o.rotation = math::Quat(result[0][l], result[1][l], result[2][l], result[3][l]);
+            o.translation = math::Vec3(result[4][l], result[5][l], result[6][l]);
+            o.scale = math::Vec3(result[7][l], result[8][l], result[9][l]);
+        }
+    }
+}
+
+AnimationPlayer::AnimationPlayer(uint32_t joint_count) : m_joint_count(joint_count), m_scratch(joint_count) {}
+
+bool AnimationPlayer::play(const AnimationClip* clip, float fade_duration, bool loop) {
+    if (clip != nullptr && clip->joint_count() != m_joint_count) {
+        return false;
+    }
+    if (fade_duration > 0.0f && m_current.clip != nullptr) {
+        m_previous = m_current;
+        m_fade_duration = fade_duration;
+    } else {
+        m_previous.clip = nullptr;
+        m_fade_duration = 0.0f;
+    }
+    m_fade_time = 0.0f;
+    m_current = Layer{clip, 0.0f, loop};
+    return true;
+}
+
+void AnimationPlayer::advance(Layer& layer, float delta_time) {
+    if (layer.clip == nullptr) {
+        return;
+    }
+    const float duration = layer.clip->duration();
+    layer.time += delta_time;
+    if (layer.loop && duration > 0.0f) {
+        layer.time = std::fmod(layer.time, duration);
+    } else {
+        layer.time = std::min(layer.time, duration);
+    }
+}
+
+void AnimationPlayer::advance(float delta_time) {
+    advance(m_current, delta_time);
+    if (m_previous.clip == nullptr) {
+        return;
+    }
+    advance(m_previous, delta_time);
+    m_fade_time += delta_time;
+    if (m_fade_time >= m_fade_duration) {
+        m_previous.clip = nullptr;
+        m_fade_time = 0.0f;
+        m_fade_duration = 0.0f;
+    }
+}
+
+void AnimationPlayer::evaluate(JointTransform* out) {
+    if (m_current.clip == nullptr) {
+        return;
+    }
+    m_current.clip->sample(m_current.time, out);
+    if (m_previous.clip != nullptr) {
+        m_previous.clip->sample(m_previous.time, m_scratch.data());
+        blend_poses(m_scratch.data(), out, blend_weight(), m_joint_count, out);
+    }
+}
+
+} // namespace maya
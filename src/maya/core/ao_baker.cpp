@@ -0,0 +1,140 @@
+#include "maya/core/ao_baker.hpp"
+#include "maya/core/bvh.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/vertex_transform.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace maya {
+
+namespace {
+
+/// Vertices per bake job.
+constexpr uint32_t kVerticesPerChunk = 64;
+constexpr float kGoldenAngle = 2.39996323f;
+
+/// Orthonormal tangent and bitangent for unit normal `n` (Duff et al., branchless).
+void tangent_frame(const math::Vec3& n, math::Vec3& tangent, math::Vec3& bitangent) {
+    const float sign = n.z >= 0.0f ? 1.0f : -1.0f;
+    const float a = -1.0f / (sign + n.z);
+    const float b = n.x * n.y * a;
+    tangent = math::Vec3(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    bitangent = math::Vec3(b, sign + n.y * n.y * a, -n.y);
+}
+
+/// Rotation of the sample spiral for vertex `index`, so neighboring vertices use different rays.
+float spiral_rotation(uint32_t index) {
+    uint32_t h = index * 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return math::TWO_PI * static_cast<float>(h >> 8) * (1.0f / 16777216.0f);
+}
+
+} // namespace
+
+void bake_vertex_ao(const std::vector<AoBakeTarget>& targets, const AoBakeSettings& settings, JobSystem& jobs) {
+    // World-space copies of every target's vertices; `first_vertex[t]` is target t's offset.
+    std::vector<uint32_t> first_vertex;
+    std::vector<Vertex> world;
+    std::vector<BvhTriangle> triangles;
+    for (uint32_t t = 0; t < static_cast<uint32_t>(targets.size()); ++t) {
+        first_vertex.push_back(static_cast<uint32_t>(world.size()));
+        const MeshData* mesh = targets[t].mesh;
+        if (!mesh) {
+            continue;
+        }
+        const size_t offset = world.size();
+        world.insert(world.end(), mesh->vertices.begin(), mesh->vertices.end());
+        transform_vertices(world.data() + offset, world.data() + offset, mesh->vertices.size(),
+            targets[t].model_matrix, targets[t].model_matrix.normal_matrix());
+        for (size_t i = 0; i + 2 < mesh->indices.size(); i += 3) {
+            triangles.push_back(BvhTriangle{world[offset + mesh->indices[i]].position,
+                world[offset + mesh->indices[i + 1]].position, world[offset + mesh->indices[i + 2]].position, t});
+        }
+    }
+    if (world.empty()) {
+        return;
+    }
+    TriangleBvh bvh;
+    bvh.build(std::move(triangles));
+
+    // Cosine-weighted directions in the tangent frame: a Fibonacci spiral on the unit disk,
+    // projected up onto the hemisphere (Malley's method).
+    const uint32_t ray_count = std::max(4u, (settings.rays_per_vertex + 3) & ~3u);
+    std::vector<math::Vec3> spiral(ray_count);
+    for (uint32_t i = 0; i < ray_count; ++i) {
+        const float r = std::sqrt((static_cast<float>(i) + 0.5f) / static_cast<float>(ray_count));
+        const float phi = kGoldenAngle * static_cast<float>(i);
+        spiral[i] = math::Vec3(r * std::cos(phi), r * std::sin(phi), std::sqrt(std::max(0.0f, 1.0f - r * r)));
+    }
+
+    jobs.parallel_for(static_cast<uint32_t>(world.size()), kVerticesPerChunk, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t v = begin; v < end; ++v) {
+            const float length = world[v].normal.length();
+            if (length < 1e-6f) {
+                continue;
+            }
+            const math::Vec3 n = world[v].normal * (1.0f / length);
+            math::Vec3 tangent;
+            math::Vec3 bitangent;
+            tangent_frame(n, tangent, bitangent);
+            const float rotation = spiral_rotation(v);
+            const float c = std::cos(rotation);
+            const float s = std::sin(rotation);
+            const math::Vec3 origin = world[v].position + n * settings.bias;
+
+            RayPacket4 packet;
+            for (int lane = 0; lane < 4; ++lane) {
+                packet.origin[0][lane] = origin.x;
+                packet.origin[1][lane] = origin.y;
+                packet.origin[2][lane] = origin.z;
+                packet.t_max[lane] = settings.max_distance;
+            }
+            uint32_t occluded_rays = 0;
+            math::Vec3 bent;
+            for (uint32_t first = 0; first < ray_count; first += 4) {
+                math::Vec3 directions[4];
+                for (int lane = 0; lane < 4; ++lane) {
+                    const math::Vec3& local = spiral[first + lane];
+                    directions[lane] = tangent * (local.x * c - local.y * s) + bitangent * (local.x * s + local.y * c)
+                        + n * local.z;
+                    packet.direction[0][lane] = directions[lane].x;
+                    packet.direction[1][lane] = directions[lane].y;
+                    packet.direction[2][lane] = directions[lane].z;
+                }
+                const uint32_t hits = bvh.occluded4(packet);
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (hits & (1u << lane)) {
+                        ++occluded_rays;
+                    } else {
+                        bent += directions[lane];
+                    }
+                }
+            }
+            const float ao = 1.0f - static_cast<float>(occluded_rays) / static_cast<float>(ray_count);
+
+            const uint32_t t = static_cast<uint32_t>(
+                std::upper_bound(first_vertex.begin(), first_vertex.end(), v) - first_vertex.begin()) - 1;
+            Vertex& out = targets[t].mesh->vertices[v - first_vertex[t]];
+            if (!settings.bent_normals) {
+                out.color = math::Vec4(out.color.x * ao, out.color.y * ao, out.color.z * ao, out.color.w);
+                continue;
+            }
+            // Back to object space with the transpose of the model's upper 3x3 (the inverse of
+            // the normal matrix up to scale).
+            math::Vec3 object_bent = out.normal;
+            if (occluded_rays < ray_count) {
+                const math::Mat4& m = targets[t].model_matrix;
+                object_bent = math::Vec3(m.at(0, 0) * bent.x + m.at(1, 0) * bent.y + m.at(2, 0) * bent.z,
+                    m.at(0, 1) * bent.x + m.at(1, 1) * bent.y + m.at(2, 1) * bent.z,
+                    m.at(0, 2) * bent.x + m.at(1, 2) * bent.y + m.at(2, 2) * bent.z);
+            }
+            object_bent = object_bent.normalized();
+            out.color = math::Vec4(object_bent.x * 0.5f + 0.5f, object_bent.y * 0.5f + 0.5f,
+                object_bent.z * 0.5f + 0.5f, ao);
+        }
+    });
+}
+
+} // namespace maya
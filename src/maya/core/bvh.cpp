@@ -0,0 +1,420 @@
+#include "maya/core/bvh.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace maya {
+
+namespace {
+
+constexpr uint32_t kSahBins = 16;
+constexpr uint32_t kMaxLeafTriangles = 4;
+/// Relative cost of one node visit against one triangle test.
+constexpr float kTraversalCost = 1.0f;
+constexpr uint32_t kMaxDepth = 64;
+
+float component(const math::Vec3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+float surface_area(const math::Aabb& box) {
+    if (box.empty()) {
+        return 0.0f;
+    }
+    const math::Vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+math::Aabb triangle_bounds(const BvhTriangle& tri) {
+    math::Aabb box;
+    box.expand(tri.v0);
+    box.expand(tri.v1);
+    box.expand(tri.v2);
+    return box;
+}
+
+/// Slab test; `inv_dir` components may be infinite for axis-parallel rays.
+bool hits_box(const math::Aabb& box, const math::Vec3& origin, const math::Vec3& inv_dir, float t_min,
+    float t_max) {
+    const float tx0 = (box.min.x - origin.x) * inv_dir.x;
+    const float tx1 = (box.max.x - origin.x) * inv_dir.x;
+    const float ty0 = (box.min.y - origin.y) * inv_dir.y;
+    const float ty1 = (box.max.y - origin.y) * inv_dir.y;
+    const float tz0 = (box.min.z - origin.z) * inv_dir.z;
+    const float tz1 = (box.max.z - origin.z) * inv_dir.z;
+    const float enter = std::max({std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), t_min});
+    const float exit = std::min({std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), t_max});
+    return enter <= exit;
+}
+
+/// Möller-Trumbore, double-sided.
+bool hits_triangle(const BvhTriangle& tri, const math::Vec3& origin, const math::Vec3& direction, float t_min,
+    float t_max, float& t, float& u, float& v) {
+    const math::Vec3 e1 = tri.v1 - tri.v0;
+    const math::Vec3 e2 = tri.v2 - tri.v0;
+    const math::Vec3 p = math::Vec3::cross(direction, e2);
+    const float det = math::Vec3::dot(e1, p);
+    if (std::fabs(det) < 1e-12f) {
+        return false;
+    }
+    const float inv_det = 1.0f / det;
+    const math::Vec3 s = origin - tri.v0;
+    u = math::Vec3::dot(s, p) * inv_det;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const math::Vec3 q = math::Vec3::cross(s, e1);
+    v = math::Vec3::dot(direction, q) * inv_det;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    t = math::Vec3::dot(e2, q) * inv_det;
+    return t >= t_min && t <= t_max;
+}
+
+using math::simd::Float4;
+
+/// Lanes of the packet that hit `tri` within their interval, with their `t` and barycentrics.
+Float4 hits_triangle4(const BvhTriangle& tri, const Float4 origin[3], const Float4 direction[3], const Float4& t_min,
+    const Float4& t_max, Float4& t, Float4& u, Float4& v) {
+    const math::Vec3 e1v = tri.v1 - tri.v0;
+    const math::Vec3 e2v = tri.v2 - tri.v0;
+    const Float4 e1[3] = {Float4::splat(e1v.x), Float4::splat(e1v.y), Float4::splat(e1v.z)};
+    const Float4 e2[3] = {Float4::splat(e2v.x), Float4::splat(e2v.y), Float4::splat(e2v.z)};
+    const Float4 p[3] = {direction[1] * e2[2] - direction[2] * e2[1], direction[2] * e2[0] - direction[0] * e2[2],
+        direction[0] * e2[1] - direction[1] * e2[0]};
+    const Float4 det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    Float4 mask = Float4::greater(Float4::abs(det), Float4::splat(1e-12f));
+    if (!mask.any()) {
+        return mask;
+    }
+    const Float4 inv_det = Float4::splat(1.0f) / det;
+    const Float4 s[3] = {origin[0] - Float4::splat(tri.v0.x), origin[1] - Float4::splat(tri.v0.y),
+        origin[2] - Float4::splat(tri.v0.z)};
+    u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv_det;
+    const Float4 q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+    v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inv_det;
+    t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv_det;
+    const Float4 zero = Float4::zero();
+    return mask & Float4::greater_equal(u, zero) & Float4::greater_equal(v, zero)
+        & Float4::less_equal(u + v, Float4::splat(1.0f)) & Float4::greater_equal(t, t_min)
+        & Float4::less_equal(t, t_max);
+}
+
+/// Lane mask of the rays in the packet whose interval overlaps `box` (slab test).
+int hits_box4(const math::Aabb& box, const Float4 origin[3], const Float4 inv_dir[3], const Float4& t_min,
+    const Float4& t_max) {
+    const Float4 x0 = (Float4::splat(box.min.x) - origin[0]) * inv_dir[0];
+    const Float4 x1 = (Float4::splat(box.max.x) - origin[0]) * inv_dir[0];
+    const Float4 y0 = (Float4::splat(box.min.y) - origin[1]) * inv_dir[1];
+    const Float4 y1 = (Float4::splat(box.max.y) - origin[1]) * inv_dir[1];
+    const Float4 z0 = (Float4::splat(box.min.z) - origin[2]) * inv_dir[2];
+    const Float4 z1 = (Float4::splat(box.max.z) - origin[2]) * inv_dir[2];
+    const Float4 enter = Float4::max(Float4::max(Float4::min(x0, x1), Float4::min(y0, y1)),
+        Float4::max(Float4::min(z0, z1), t_min));
+    const Float4 exit = Float4::min(Float4::min(Float4::max(x0, x1), Float4::max(y0, y1)),
+        Float4::min(Float4::max(z0, z1), t_max));
+    return Float4::less_equal(enter, exit).move_mask();
+}
+
+/// Packet rays loaded into SIMD registers.
+struct Packet {
+    Float4 origin[3];
+    Float4 direction[3];
+    Float4 inv_dir[3];
+    Float4 t_min;
+    Float4 t_max;
+
+    explicit Packet(const RayPacket4& rays) {
+        const Float4 one = Float4::splat(1.0f);
+        for (int axis = 0; axis < 3; ++axis) {
+            origin[axis] = Float4::load(rays.origin[axis]);
+            direction[axis] = Float4::load(rays.direction[axis]);
+            inv_dir[axis] = one / direction[axis];
+        }
+        t_min = Float4::load(rays.t_min);
+        t_max = Float4::load(rays.t_max);
+    }
+};
+
+} // namespace
+
+void append_mesh_triangles(const Mesh& mesh, const math::Mat4& model, uint32_t id, std::vector<BvhTriangle>& out) {
+    const std::vector<Vertex>& vertices = mesh.vertices();
+    const std::vector<uint32_t>& indices = mesh.indices();
+    auto world = [&](uint32_t index) {
+        const math::Vec3& p = vertices[index].position;
+        const math::Vec4 w = model * math::Vec4(p.x, p.y, p.z, 1.0f);
+        return math::Vec3(w.x, w.y, w.z);
+    };
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        out.push_back(BvhTriangle{world(indices[i]), world(indices[i + 1]), world(indices[i + 2]), id});
+    }
+}
+
+const math::Aabb& TriangleBvh::bounds() const {
+    static const math::Aabb kEmpty;
+    return m_nodes.empty() ? kEmpty : m_nodes[0].bounds;
+}
+
+void TriangleBvh::build(std::vector<BvhTriangle> triangles) {
+    m_triangles = std::move(triangles);
+    m_nodes.clear();
+    if (m_triangles.empty()) {
+        return;
+    }
+    const uint32_t count = static_cast<uint32_t>(m_triangles.size());
+    std::vector<math::Aabb> boxes(count);
+    std::vector<math::Vec3> centroids(count);
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        boxes[i] = triangle_bounds(m_triangles[i]);
+        centroids[i] = boxes[i].center();
+        order[i] = i;
+    }
+
+    m_nodes.reserve(2 * static_cast<size_t>(count / kMaxLeafTriangles + 1));
+    m_nodes.push_back(Node{{}, 0, count});
+    struct Pending {
+        uint32_t node;
+        uint32_t depth;
+    };
+    std::vector<Pending> stack{{0, 0}};
+    while (!stack.empty()) {
+        const Pending pending = stack.back();
+        stack.pop_back();
+        const uint32_t first = m_nodes[pending.node].first;
+        const uint32_t n = m_nodes[pending.node].count;
+
+        math::Aabb bounds;
+        math::Aabb centroid_bounds;
+        for (uint32_t i = first; i < first + n; ++i) {
+            bounds.merge(boxes[order[i]]);
+            centroid_bounds.expand(centroids[order[i]]);
+        }
+        m_nodes[pending.node].bounds = bounds;
+        if (n <= kMaxLeafTriangles || pending.depth >= kMaxDepth) {
+            continue;
+        }
+
+        // Binned SAH over the axis with the widest centroid spread.
+        const math::Vec3 spread = centroid_bounds.max - centroid_bounds.min;
+        const int axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+        const float lo = component(centroid_bounds.min, axis);
+        const float width = component(spread, axis);
+        if (width <= 0.0f) {
+            continue;
+        }
+        const float bin_scale = static_cast<float>(kSahBins) / width;
+        auto bin_of = [&](uint32_t tri) {
+            const float offset = (component(centroids[tri], axis) - lo) * bin_scale;
+            return std::min(static_cast<uint32_t>(offset), kSahBins - 1);
+        };
+        math::Aabb bin_bounds[kSahBins];
+        uint32_t bin_counts[kSahBins] = {};
+        for (uint32_t i = first; i < first + n; ++i) {
+            const uint32_t b = bin_of(order[i]);
+            bin_bounds[b].merge(boxes[order[i]]);
+            ++bin_counts[b];
+        }
+        float right_area[kSahBins];
+        uint32_t right_count[kSahBins];
+        math::Aabb sweep;
+        uint32_t swept = 0;
+        for (uint32_t b = kSahBins - 1; b > 0; --b) {
+            sweep.merge(bin_bounds[b]);
+            swept += bin_counts[b];
+            right_area[b] = surface_area(sweep);
+            right_count[b] = swept;
+        }
+        float best_cost = std::numeric_limits<float>::max();
+        uint32_t best_split = 0;
+        sweep = {};
+        swept = 0;
+        for (uint32_t b = 1; b < kSahBins; ++b) {
+            sweep.merge(bin_bounds[b - 1]);
+            swept += bin_counts[b - 1];
+            if (swept == 0 || right_count[b] == 0) {
+                continue;
+            }
+            const float cost = surface_area(sweep) * static_cast<float>(swept)
+                + right_area[b] * static_cast<float>(right_count[b]);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_split = b;
+            }
+        }
+        const float leaf_cost = surface_area(bounds) * static_cast<float>(n);
+        if (best_split == 0 || kTraversalCost * surface_area(bounds) + best_cost >= leaf_cost) {
+            continue;
+        }
+
+        uint32_t* split = std::partition(order.data() + first, order.data() + first + n,
+            [&](uint32_t tri) { return bin_of(tri) < best_split; });
+        const uint32_t left_count = static_cast<uint32_t>(split - (order.data() + first));
+        const uint32_t child = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(Node{{}, first, left_count});
+        m_nodes.push_back(Node{{}, first + left_count, n - left_count});
+        m_nodes[pending.node].first = child;
+        m_nodes[pending.node].count = 0;
+        stack.push_back({child + 1, pending.depth + 1});
+        stack.push_back({child, pending.depth + 1});
+    }
+
+    std::vector<BvhTriangle> sorted(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        sorted[i] = m_triangles[order[i]];
+    }
+    m_triangles = std::move(sorted);
+}
+
+template <bool AnyHit>
+bool TriangleBvh::traverse(const math::Vec3& origin, const math::Vec3& direction, float t_min, float t_max,
+    RayHit* hit) const {
+    if (m_nodes.empty()) {
+        return false;
+    }
+    const math::Vec3 inv_dir(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    bool found = false;
+    uint32_t stack[kMaxDepth + 2];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        if (!hits_box(node.bounds, origin, inv_dir, t_min, t_max)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                float t, u, v;
+                if (!hits_triangle(m_triangles[i], origin, direction, t_min, t_max, t, u, v)) {
+                    continue;
+                }
+                if constexpr (AnyHit) {
+                    return true;
+                }
+                found = true;
+                t_max = t;
+                *hit = RayHit{t, i, u, v};
+            }
+            continue;
+        }
+        // Visit the child nearer along the ray first so the closest hit shrinks `t_max` early.
+        const math::Vec3 to_left = m_nodes[node.first].bounds.center() - origin;
+        const math::Vec3 to_right = m_nodes[node.first + 1].bounds.center() - origin;
+        const bool left_first = math::Vec3::dot(to_left, direction) <= math::Vec3::dot(to_right, direction);
+        stack[top++] = left_first ? node.first + 1 : node.first;
+        stack[top++] = left_first ? node.first : node.first + 1;
+    }
+    return found;
+}
+
+bool TriangleBvh::intersect(const math::Vec3& origin, const math::Vec3& direction, float t_min, float t_max,
+    RayHit& hit) const {
+    return traverse<false>(origin, direction, t_min, t_max, &hit);
+}
+
+bool TriangleBvh::occluded(const math::Vec3& origin, const math::Vec3& direction, float t_min, float t_max) const {
+    return traverse<true>(origin, direction, t_min, t_max, nullptr);
+}
+
+uint32_t TriangleBvh::occluded4(const RayPacket4& rays) const {
+    const Packet packet(rays);
+    int active = Float4::less_equal(packet.t_min, packet.t_max).move_mask();
+    if (m_nodes.empty() || active == 0) {
+        return 0;
+    }
+    int occluded = 0;
+    uint32_t stack[kMaxDepth + 2];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0 && active != 0) {
+        const Node& node = m_nodes[stack[--top]];
+        if ((hits_box4(node.bounds, packet.origin, packet.inv_dir, packet.t_min, packet.t_max) & active) == 0) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count && active != 0; ++i) {
+                Float4 t;
+                Float4 u;
+                Float4 v;
+                const int hits = hits_triangle4(m_triangles[i], packet.origin, packet.direction, packet.t_min,
+                    packet.t_max, t, u, v).move_mask() & active;
+                occluded |= hits;
+                active &= ~hits;
+            }
+            continue;
+        }
+        stack[top++] = node.first + 1;
+        stack[top++] = node.first;
+    }
+    return static_cast<uint32_t>(occluded);
+}
+
+uint32_t TriangleBvh::intersect4(const RayPacket4& rays, RayHit hits[4]) const {
+    Packet packet(rays);
+    const Float4 enabled = Float4::less_equal(packet.t_min, packet.t_max);
+    if (m_nodes.empty() || !enabled.any()) {
+        return 0;
+    }
+    // Disabled lanes get an empty interval so they never pass a box or triangle test.
+    packet.t_max = Float4::select(enabled, packet.t_max, packet.t_min - Float4::splat(1.0f));
+    Float4 best_u;
+    Float4 best_v;
+    uint32_t best_triangle[4] = {};
+    int found = 0;
+
+    // Children are visited in the order of the first enabled ray's direction.
+    const int lead = std::countr_zero(static_cast<unsigned>(enabled.move_mask()));
+    const math::Vec3 lead_origin(rays.origin[0][lead], rays.origin[1][lead], rays.origin[2][lead]);
+    const math::Vec3 lead_direction(rays.direction[0][lead], rays.direction[1][lead], rays.direction[2][lead]);
+
+    uint32_t stack[kMaxDepth + 2];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        if (hits_box4(node.bounds, packet.origin, packet.inv_dir, packet.t_min, packet.t_max) == 0) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                Float4 t;
+                Float4 u;
+                Float4 v;
+                const Float4 mask = hits_triangle4(m_triangles[i], packet.origin, packet.direction, packet.t_min,
+                    packet.t_max, t, u, v);
+                const int bits = mask.move_mask();
+                if (bits == 0) {
+                    continue;
+                }
+                packet.t_max = Float4::select(mask, t, packet.t_max);
+                best_u = Float4::select(mask, u, best_u);
+                best_v = Float4::select(mask, v, best_v);
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (bits & (1 << lane)) {
+                        best_triangle[lane] = i;
+                    }
+                }
+                found |= bits;
+            }
+            continue;
+        }
+        const math::Vec3 to_left = m_nodes[node.first].bounds.center() - lead_origin;
+        const math::Vec3 to_right = m_nodes[node.first + 1].bounds.center() - lead_origin;
+        const bool left_first = math::Vec3::dot(to_left, lead_direction) <= math::Vec3::dot(to_right, lead_direction);
+        stack[top++] = left_first ? node.first + 1 : node.first;
+        stack[top++] = left_first ? node.first : node.first + 1;
+    }
+    for (int lane = 0; lane < 4; ++lane) {
+        if (found & (1 << lane)) {
+            hits[lane] = RayHit{packet.t_max.lane(lane), best_triangle[lane], best_u.lane(lane), best_v.lane(lane)};
+        }
+    }
+    return static_cast<uint32_t>(found);
+}
+
+} // namespace maya
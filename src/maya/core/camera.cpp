@@ -32,23 +32,100 @@ void Camera::update(float delta_time) {
     process_mouse();
 }
 
-math::Mat4 Camera::get_view_matrix() const {
-    return math::Mat4::look_at(m_position, m_position + m_front, m_up);
+void Camera::set_position(const math::Vec3& position) {
+    if (position.x == m_position.x && position.y == m_position.y && position.z == m_position.z) {
+        return;
+    }
+    m_position = position;
+    mark_view_dirty();
+}
+
+void Camera::set_aspect_ratio(float aspect_ratio) {
+    if (aspect_ratio == m_aspect_ratio) {
+        return;
+    }
+    m_aspect_ratio = aspect_ratio;
+    mark_projection_dirty();
+}
+
+void Camera::set_fov(float fov) {
+    if (fov == m_fov) {
+        return;
+    }
+    m_fov = fov;
+    mark_projection_dirty();
 }
 
-math::Mat4 Camera::get_projection_matrix() const {
-    // Convert FOV to radians for the matrix calculation
-    return math::Mat4::perspective(math::to_radians(m_fov), m_aspect_ratio, m_near_clip, m_far_clip);
+void Camera::mark_view_dirty() {
+    m_view_dirty = true;
+    ++m_version;
 }
 
-math::Mat4 Camera::get_view_projection_matrix() const {
+void Camera::mark_projection_dirty() {
+    m_projection_dirty = true;
+    ++m_version;
+}
+
+void Camera::refresh() const {
+    if (!m_view_dirty && !m_projection_dirty) {
+        return;
+    }
+    if (m_view_dirty) {
+        m_view = math::Mat4::look_at(m_position, m_position + m_front, m_up);
+        m_inverse_view = m_view.inverse();
+    }
+    if (m_projection_dirty) {
+        // Convert FOV to radians for the matrix calculation
+        m_projection = math::Mat4::perspective(math::to_radians(m_fov), m_aspect_ratio, m_near_clip, m_far_clip);
+        m_inverse_projection = m_projection.inverse();
+    }
     // Order: Projection * View
-    return get_projection_matrix() * get_view_matrix();
+    m_view_projection = m_projection * m_view;
+    m_inverse_view_projection = m_inverse_view * m_inverse_projection;
+    m_frustum = math::Frustum::from_view_projection(m_view_projection);
+    m_view_dirty = false;
+    m_projection_dirty = false;
+}
+
+const math::Mat4& Camera::get_view_matrix() const {
+    refresh();
+    return m_view;
+}
+
+const math::Mat4& Camera::get_projection_matrix() const {
+    refresh();
+    return m_projection;
+}
+
+const math::Mat4& Camera::get_view_projection_matrix() const {
+    refresh();
+    return m_view_projection;
+}
+
+const math::Mat4& Camera::get_inverse_view_matrix() const {
+    refresh();
+    return m_inverse_view;
+}
+
+const math::Mat4& Camera::get_inverse_projection_matrix() const {
+    refresh();
+    return m_inverse_projection;
+}
+
+const math::Mat4& Camera::get_inverse_view_projection_matrix() const {
+    refresh();
+    return m_inverse_view_projection;
+}
+
+const math::Frustum& Camera::get_frustum() const {
+    refresh();
+    return m_frustum;
 }
 
 void Camera::process_keyboard(float delta_time) {
     Input& input = Input::instance();
     float velocity = m_movement_speed * delta_time;
+    const math::Vec3 previous = m_position;
 
     if (input.is_key_down(KeyCode::W)) {
         m_position += m_front * velocity;
@@ -70,6 +147,9 @@ void Camera::process_keyboard(float delta_time) {
          // Or just strictly planar movement if we didn't want flying. 
          // Let's implement full free-cam.
     }
+    if (m_position.x != previous.x || m_position.y != previous.y || m_position.z != previous.z) {
+        mark_view_dirty();
+    }
 }
 
 void Camera::process_mouse() {
@@ -88,6 +168,9 @@ void Camera::process_mouse() {
     
     m_last_x = mouse_pos.x;
     m_last_y = mouse_pos.y;
+    if (x_offset == 0.0f && y_offset == 0.0f) {
+        return;
+    }
 
     x_offset *= m_mouse_sensitivity;
     y_offset *= m_mouse_sensitivity;
@@ -108,6 +191,7 @@ void Camera::process_mouse() {
     
     m_right = math::Vec3::cross(m_front, m_world_up).normalized();
     m_up    = math::Vec3::cross(m_right, m_front).normalized();
+    mark_view_dirty();
 }
 
 } // namespace maya
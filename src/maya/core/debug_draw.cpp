@@ -0,0 +1,252 @@
+#include "maya/core/debug_draw.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace maya {
+
+namespace {
+
+std::atomic<uint64_t> g_next_debug_draw_id{1};
+
+/// Slots this thread claimed, by instance id; almost always a single entry.
+struct SlotCache {
+    uint64_t id;
+    uint32_t slot;
+};
+
+thread_local std::vector<SlotCache> t_slots;
+
+/// Box corner `i`: bit 0 picks x, bit 1 y, bit 2 z from `lo` or `hi`.
+math::Vec3 corner(const math::Vec3& lo, const math::Vec3& hi, uint32_t i) {
+    return math::Vec3((i & 1u) ? hi.x : lo.x, (i & 2u) ? hi.y : lo.y, (i & 4u) ? hi.z : lo.z);
+}
+
+/// Corner pairs of the 12 box edges, in `corner` numbering.
+constexpr uint8_t kBoxEdges[12][2] = {
+    {0, 1}, {2, 3}, {4, 5}, {6, 7},
+    {0, 2}, {1, 3}, {4, 6}, {5, 7},
+    {0, 4}, {1, 5}, {2, 6}, {3, 7},
+};
+
+math::Vec3 transform_point(const math::Mat4& m, const math::Vec3& p) {
+    const math::Vec4 r = m * math::Vec4(p, 1.0f);
+    const float inv_w = r.w != 0.0f ? 1.0f / r.w : 1.0f;
+    return math::Vec3(r.x * inv_w, r.y * inv_w, r.z * inv_w);
+}
+
+void append_box_edges(const math::Vec3 (&corners)[8], uint32_t color, std::vector<DebugVertex>& out) {
+    for (const auto& edge : kBoxEdges) {
+        out.push_back(DebugVertex{corners[edge[0]], color});
+        out.push_back(DebugVertex{corners[edge[1]], color});
+    }
+}
+
+} // namespace
+
+DebugDraw::DebugDraw()
+    : m_id(g_next_debug_draw_id.fetch_add(1, std::memory_order_relaxed)),
+      m_threads(std::make_unique<std::array<ThreadBuffer, kMaxThreads>>()) {}
+
+DebugDraw::~DebugDraw() = default;
+
+DebugDraw::ThreadBuffer* DebugDraw::thread_buffer() {
+    for (const SlotCache& entry : t_slots) {
+        if (entry.id == m_id) {
+            return entry.slot < kMaxThreads ? &(*m_threads)[entry.slot] : nullptr;
+        }
+    }
+    // Claim a slot without ever moving the counter past `kMaxThreads`, so it cannot wrap and
+    // hand out a taken slot; threads left without one remember it (`kMaxThreads`).
+    uint32_t slot = m_thread_count.load(std::memory_order_relaxed);
+    while (slot < kMaxThreads
+        && !m_thread_count.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed)) {
+    }
+    t_slots.push_back(SlotCache{m_id, std::min(slot, kMaxThreads)});
+    return slot < kMaxThreads ? &(*m_threads)[slot] : nullptr;
+}
+
+void DebugDraw::record(Kind kind, const float* data, uint32_t count, uint32_t color) {
+    ThreadBuffer* buffer = thread_buffer();
+    if (!buffer) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Shape shape;
+    std::copy(data, data + count, shape.data);
+    shape.color = color;
+    shape.kind = kind;
+    buffer->shapes.push_back(shape);
+}
+
+void DebugDraw::line(const math::Vec3& a, const math::Vec3& b, uint32_t color) {
+    if (!enabled()) {
+        return;
+    }
+    const float data[] = {a.x, a.y, a.z, b.x, b.y, b.z};
+    record(Kind::Line, data, 6, color);
+}
+
+void DebugDraw::box(const math::Aabb& box, uint32_t color) {
+    if (!enabled() || box.empty()) {
+        return;
+    }
+    const float data[] = {box.min.x, box.min.y, box.min.z, box.max.x, box.max.y, box.max.z};
+    record(Kind::Box, data, 6, color);
+}
+
+void DebugDraw::box(const math::Aabb& local, const math::Mat4& transform, uint32_t color) {
+    if (!enabled() || local.empty()) {
+        return;
+    }
+    // The unit cube mapped onto `local`, then by `transform`.
+    const math::Mat4 m = transform * math::Mat4::translate(local.min) * math::Mat4::scale(local.max - local.min);
+    record(Kind::OrientedBox, m.elements, 16, color);
+}
+
+void DebugDraw::sphere(const math::Vec3& center, float radius, uint32_t color) {
+    if (!enabled()) {
+        return;
+    }
+    const float data[] = {center.x, center.y, center.z, radius};
+    record(Kind::Sphere, data, 4, color);
+}
+
+void DebugDraw::frustum(const math::Mat4& view_projection, uint32_t color) {
+    if (!enabled()) {
+        return;
+    }
+    const math::Mat4 inverse = view_projection.inverse();
+    record(Kind::Frustum, inverse.elements, 16, color);
+}
+
+void DebugDraw::triangle(const math::Vec3& a, const math::Vec3& b, const math::Vec3& c, uint32_t color) {
+    if (!enabled()) {
+        return;
+    }
+    const float data[] = {a.x, a.y, a.z, b.x, b.y, b.z, c.x, c.y, c.z};
+    record(Kind::Triangle, data, 9, color);
+}
+
+uint32_t DebugDraw::shape_count() const {
+    const uint32_t threads = std::min(m_thread_count.load(std::memory_order_relaxed), kMaxThreads);
+    size_t count = 0;
+    for (uint32_t t = 0; t < threads; ++t) {
+        count += (*m_threads)[t].shapes.size();
+    }
+    return static_cast<uint32_t>(count);
+}
+
+void DebugDraw::clear() {
+    for (ThreadBuffer& buffer : *m_threads) {
+        buffer.shapes.clear();
+    }
+}
+
+void DebugDraw::expand(DebugGeometry& out) {
+    const uint32_t threads = std::min(m_thread_count.load(std::memory_order_acquire), kMaxThreads);
+    for (uint32_t t = 0; t < threads; ++t) {
+        std::vector<Shape>& shapes = (*m_threads)[t].shapes;
+        for (const Shape& shape : shapes) {
+            const float* d = shape.data;
+            switch (shape.kind) {
+            case Kind::Line:
+                out.lines.push_back(DebugVertex{math::Vec3(d[0], d[1], d[2]), shape.color});
+                out.lines.push_back(DebugVertex{math::Vec3(d[3], d[4], d[5]), shape.color});
+                break;
+            case Kind::Box: {
+                const math::Vec3 lo(d[0], d[1], d[2]);
+                const math::Vec3 hi(d[3], d[4], d[5]);
+                math::Vec3 corners[8];
+                for (uint32_t i = 0; i < 8; ++i) {
+                    corners[i] = corner(lo, hi, i);
+                }
+                append_box_edges(corners, shape.color, out.lines);
+                break;
+            }
+            case Kind::OrientedBox:
+            case Kind::Frustum: {
+                // Unit cube, or the clip volume (x, y in -1..1, Metal depth 0..1), mapped back.
+                math::Mat4 m;
+                std::copy(d, d + 16, m.elements);
+                const bool clip = shape.kind == Kind::Frustum;
+                const math::Vec3 lo = clip ? math::Vec3(-1.0f, -1.0f, 0.0f) : math::Vec3(0.0f);
+                const math::Vec3 hi(1.0f);
+                math::Vec3 corners[8];
+                for (uint32_t i = 0; i < 8; ++i) {
+                    corners[i] = transform_point(m, corner(lo, hi, i));
+                }
+                append_box_edges(corners, shape.color, out.lines);
+                break;
+            }
+            case Kind::Sphere: {
+                const math::Vec3 center(d[0], d[1], d[2]);
+                const float radius = d[3];
+                constexpr float kStep = 2.0f * std::numbers::pi_v<float> / static_cast<float>(kSphereSegments);
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    auto point = [&](uint32_t i) {
+                        const float c = radius * std::cos(kStep * static_cast<float>(i));
+                        const float s = radius * std::sin(kStep * static_cast<float>(i));
+                        const math::Vec3 offset = axis == 0 ? math::Vec3(0.0f, c, s)
+                            : axis == 1 ? math::Vec3(c, 0.0f, s) : math::Vec3(c, s, 0.0f);
+                        return center + offset;
+                    };
+                    for (uint32_t i = 0; i < kSphereSegments; ++i) {
+                        out.lines.push_back(DebugVertex{point(i), shape.color});
+                        out.lines.push_back(DebugVertex{point(i + 1), shape.color});
+                    }
+                }
+                break;
+            }
+            case Kind::Triangle: {
+                const DebugVertex a{math::Vec3(d[0], d[1], d[2]), shape.color};
+                const DebugVertex b{math::Vec3(d[3], d[4], d[5]), shape.color};
+                const DebugVertex c{math::Vec3(d[6], d[7], d[8]), shape.color};
+                // Both windings, so back-face culling keeps one.
+                out.triangles.insert(out.triangles.end(), {a, b, c, a, c, b});
+                break;
+            }
+            }
+        }
+        shapes.clear();
+    }
+}
+
+DebugDrawRenderer::DebugDrawRenderer(GraphicsDevice& device, PipelineHandle pipeline)
+    : m_device(device), m_pipeline(pipeline), m_buffer(device) {}
+
+void DebugDrawRenderer::render(DebugDraw& debug_draw, UniformBufferHandle uniform_buffer,
+    const math::Mat4& view_projection) {
+    m_geometry.lines.clear();
+    m_geometry.triangles.clear();
+    debug_draw.expand(m_geometry);
+    const uint32_t line_count = static_cast<uint32_t>(m_geometry.lines.size());
+    const uint32_t triangle_count = static_cast<uint32_t>(m_geometry.triangles.size());
+    m_last_vertex_count = line_count + triangle_count;
+    if (m_last_vertex_count == 0) {
+        return;
+    }
+
+    m_upload.assign(m_geometry.lines.begin(), m_geometry.lines.end());
+    m_upload.insert(m_upload.end(), m_geometry.triangles.begin(), m_geometry.triangles.end());
+
+    const VertexBufferHandle buffer = m_buffer.upload(m_upload.data(), m_upload.size() * sizeof(DebugVertex));
+
+    SceneDrawUniforms uniforms{};
+    uniforms.model_matrix = math::Mat4::identity();
+    uniforms.view_projection_matrix = view_projection;
+    m_device.update_uniform_buffer(uniform_buffer, &uniforms, sizeof(SceneDrawUniforms));
+    m_device.bind_pipeline(m_pipeline);
+    m_device.bind_uniform_buffer(uniform_buffer, 1);
+    m_device.bind_vertex_buffer(buffer, 0);
+    if (line_count > 0) {
+        m_device.draw(PrimitiveTopology::Lines, 0, line_count);
+    }
+    if (triangle_count > 0) {
+        m_device.draw(PrimitiveTopology::Triangles, line_count, triangle_count);
+    }
+}
+
+} // namespace maya
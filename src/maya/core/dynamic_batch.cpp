@@ -0,0 +1,110 @@
+#include "maya/core/dynamic_batch.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/vertex_transform.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace maya {
+
+DynamicBatcher::DynamicBatcher(GraphicsDevice& device, const DynamicBatchSettings& settings)
+    : m_settings(settings),
+      m_stream(device, settings.max_vertices_per_frame, settings.max_indices_per_frame) {}
+
+bool DynamicBatcher::is_eligible(const SceneObject& object, const DynamicBatchSettings& settings) {
+    return object.mesh && !object.is_static && object.mesh->index_count() > 0
+        && object.mesh->vertex_count() <= settings.max_vertices_per_object && object.mesh->has_cpu_data();
+}
+
+void DynamicBatcher::build(const std::vector<SceneObject>& objects, JobSystem& jobs) {
+    m_groups.clear();
+    m_placements.clear();
+    m_batched.assign(objects.size(), 0);
+
+    // Eligible objects per material, in order of first appearance.
+    std::vector<std::vector<uint32_t>> candidates;
+    std::vector<Material> candidate_materials;
+    std::unordered_map<MaterialKey, size_t, MaterialKeyHash> lookup;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(objects.size()); ++i) {
+        if (!is_eligible(objects[i], m_settings)) {
+            continue;
+        }
+        auto [it, inserted] = lookup.try_emplace(MaterialKey(objects[i].material), candidates.size());
+        if (inserted) {
+            candidates.emplace_back();
+            candidate_materials.push_back(objects[i].material);
+        }
+        candidates[it->second].push_back(i);
+    }
+
+    uint32_t vertex_total = 0;
+    uint32_t index_total = 0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (candidates[c].size() < m_settings.min_objects_per_batch) {
+            continue;
+        }
+        Group group;
+        group.material = candidate_materials[c];
+        group.first_index = index_total;
+        const size_t placements_before = m_placements.size();
+        const uint32_t vertices_before = vertex_total;
+        for (uint32_t object_index : candidates[c]) {
+            const Mesh& mesh = *objects[object_index].mesh;
+            if (vertex_total + mesh.vertex_count() > m_settings.max_vertices_per_frame
+                || index_total + mesh.index_count() > m_settings.max_indices_per_frame) {
+                break;
+            }
+            m_placements.push_back({object_index, vertex_total, index_total});
+            vertex_total += mesh.vertex_count();
+            index_total += mesh.index_count();
+            ++group.object_count;
+        }
+        if (group.object_count < m_settings.min_objects_per_batch) {
+            // Out of frame capacity; leave these to the per-draw path.
+            m_placements.resize(placements_before);
+            vertex_total = vertices_before;
+            index_total = group.first_index;
+            continue;
+        }
+        group.index_count = index_total - group.first_index;
+        m_groups.push_back(group);
+    }
+
+    for (const Placement& p : m_placements) {
+        m_batched[p.object_index] = 1;
+    }
+
+    m_vertices.resize(vertex_total, Vertex(math::Vec3(0.0f), math::Vec3(0.0f), math::Vec4(0.0f)));
+    m_indices.resize(index_total);
+    jobs.parallel_for(static_cast<uint32_t>(m_placements.size()), 64, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t p = begin; p < end; ++p) {
+            const Placement& placement = m_placements[p];
+            const SceneObject& obj = objects[placement.object_index];
+            const Mesh& mesh = *obj.mesh;
+            transform_vertices(mesh.vertices().data(), m_vertices.data() + placement.first_vertex,
+                mesh.vertex_count(), obj.model_matrix, obj.model_matrix.normal_matrix());
+            uint32_t* out = m_indices.data() + placement.first_index;
+            for (uint32_t index : mesh.indices()) {
+                *out++ = placement.first_vertex + index;
+            }
+        }
+    });
+}
+
+void DynamicBatcher::upload() {
+    if (!m_stream.upload(m_vertices.data(), static_cast<uint32_t>(m_vertices.size()), m_indices.data(),
+            static_cast<uint32_t>(m_indices.size()))) {
+        // Cannot happen while build respects the capacity; drop batching rather than draw garbage.
+        m_groups.clear();
+        std::fill(m_batched.begin(), m_batched.end(), 0);
+    }
+}
+
+void DynamicBatcher::draw_group(uint32_t group_index) const {
+    const Group& group = m_groups[group_index];
+    m_stream.bind();
+    m_stream.draw_range(group.first_index, group.index_count);
+}
+
+} // namespace maya
@@ -1,5 +1,6 @@
 #include "maya/core/engine.hpp"
 #include "maya/core/file_system.hpp"
+#include "maya/core/job_system.hpp"
 #include "maya/core/model_loader.hpp"
 #include "maya/core/primitives.hpp"
 #include "maya/platform/input.hpp"
@@ -10,9 +11,6 @@
 #include <iostream>
 #include <sstream>
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
 namespace maya {
 
 Engine::Engine() = default;
@@ -20,6 +18,12 @@ Engine::~Engine() {
     shutdown();
 }
 
+namespace {
+
+constexpr float kFarClip = 100.0f;
+
+} // namespace
+
 static_assert(sizeof(Vertex) == 64, "Vertex struct size mismatch! Metal shader expects 64 bytes due to float4 alignment.");
 
 bool Engine::initialize() {
@@ -35,7 +39,7 @@ bool Engine::initialize() {
         return false;
     }
 
-    m_camera = std::make_unique<Camera>(60.0f, 1280.0f / 720.0f, 0.1f, 100.0f);
+    m_camera = std::make_unique<Camera>(60.0f, 1280.0f / 720.0f, 0.1f, kFarClip);
     m_camera->set_position(math::Vec3(0.0f, 0.0f, 3.0f));
 
     m_window->set_framebuffer_resize_callback([this](int width, int height) {
@@ -71,6 +75,13 @@ bool Engine::initialize() {
         return false;
     }
 
+    // Debug shapes are optional; without the pipeline they are recorded and dropped.
+    const PipelineHandle pipeline_debug = m_graphics_device->create_pipeline(shader_source, "vertexDebug", "fragmentUnlit");
+    if (pipeline_debug.handle != INVALID_HANDLE) {
+        m_debug_renderer = std::make_unique<DebugDrawRenderer>(*m_graphics_device, pipeline_debug);
+        m_particle_renderer = std::make_unique<ParticleRenderer>(*m_graphics_device, pipeline_debug);
+    }
+
     auto pyramid = ModelLoader::load_obj(*m_graphics_device, "assets/models/pyramid.obj");
     if (!pyramid) {
         std::cerr << "Failed to load pyramid model.\n";
@@ -90,14 +101,71 @@ bool Engine::initialize() {
 
     m_scene.add_object(std::move(pyramid), Material{pipeline_textured, m_checker_texture.get()});
     m_scene.add_object(std::move(unlit_cube), Material{pipeline_unlit, nullptr});
+    m_scene.build_static_batches(*m_graphics_device);
+    m_scene.build_hlod(*m_graphics_device);
+    // Baked static visibility is optional (see PotentiallyVisibleSet::save).
+    if (FileSystem::resolve("assets/scene.pvs")) {
+        PotentiallyVisibleSet pvs;
+        if (!PotentiallyVisibleSet::load("assets/scene.pvs", pvs) || !m_scene.set_pvs(std::move(pvs))) {
+            std::cerr << "Ignoring assets/scene.pvs: unreadable or baked for another scene.\n";
+        }
+    }
+    m_scene.enable_dynamic_batching(*m_graphics_device);
+    m_scene.release_cpu_geometry();
+    UpdateSystemSettings spin;
+    spin.name = "spin";
+    m_spin_system = m_updates.add_system(spin, [this](uint32_t item, float elapsed) {
+        m_spin_angles[item] += 0.5f * elapsed;
+        const float angle = m_spin_angles[item];
+        m_scene.objects()[item].model_matrix = item == 0
+            ? math::Mat4::rotate_z(angle) * math::Mat4::rotate_x(angle * 0.5f)
+            : math::Mat4::translate(math::Vec3(-1.35f, 0.0f, 0.0f)) * math::Mat4::rotate_y(angle * 0.35f);
+    });
+    m_spin_angles.assign(2, 0.0f);
+    m_updates.set_item_count(m_spin_system, 2);
+    m_views.add_view(CullView{});
+    m_views.enable_temporal_coherence();
+
+    // Knobs cheapest to lose go first: update rates, then LOD bias, then draw distance.
+    // View knobs force the main view to be rebuilt.
+    m_quality.add(QualityKnob{"update_rate", 3, 2, 0, [this](uint32_t level) {
+        static constexpr float kScales[] = {0.5f, 0.75f, 1.0f};
+        m_updates.set_rate_scale(kScales[level]);
+    }});
+    m_quality.add(QualityKnob{"lod_bias", 4, 3, 1, [this](uint32_t level) {
+        static constexpr float kBiases[] = {0.5f, 0.7f, 0.85f, 1.0f};
+        m_lod_bias = kBiases[level];
+        m_main_view_camera_version = ~0ull;
+    }});
+    m_quality.add(QualityKnob{"draw_distance", 4, 3, 2, [this](uint32_t level) {
+        static constexpr float kScales[] = {0.4f, 0.6f, 0.8f, 1.0f};
+        m_draw_distance_scale = kScales[level];
+        m_main_view_camera_version = ~0ull;
+    }});
+
+    // Demo fountain bouncing on a floor below the objects.
+    m_particles = std::make_unique<ParticleSystem>(20000);
+    ParticleEmitterSettings fountain;
+    fountain.position = math::Vec3(1.5f, -1.0f, 0.0f);
+    fountain.speed_min = 3.0f;
+    fountain.speed_max = 4.0f;
+    fountain.size_min = 0.02f;
+    fountain.size_max = 0.05f;
+    fountain.color = pack_debug_color(120, 190, 255);
+    fountain.rate = 2000.0f;
+    m_particles->add_emitter(fountain);
+    m_particles->simulation().colliders.push_back(math::Plane{math::Vec3(0.0f, 1.0f, 0.0f), 1.0f});
+
+    WorldStreamingSettings streaming;
+    streaming.textured_pipeline = pipeline_textured;
+    streaming.untextured_pipeline = pipeline_unlit;
+    m_world_streamer = std::make_unique<WorldStreamer>(streaming, WorldStreamer::manifest_loader("assets/world"));
 
     m_is_running = true;
     return true;
 }
 
 void Engine::run() {
-    float rotation_speed = 0.5f;
-    float current_rotation = 0.0f;
     double last_time = glfwGetTime();
     float fps_smooth = 0.0f;
 
@@ -107,6 +175,7 @@ void Engine::run() {
         m_window->poll_events();
         Input& input = Input::instance();
         if (input.is_key_pressed(KeyCode::Escape)) m_is_running = false;
+        if (input.is_key_pressed(KeyCode::B)) m_show_bounds = !m_show_bounds;
 
         double current_time = glfwGetTime();
         float delta_time = static_cast<float>(current_time - last_time);
@@ -115,30 +184,67 @@ void Engine::run() {
         if (delta_time > 0.0f) {
             float inst_fps = 1.0f / delta_time;
             fps_smooth = (fps_smooth <= 0.0f) ? inst_fps : (fps_smooth * 0.92f + inst_fps * 0.08f);
+            m_governor.record_frame(delta_time * 1000.0f);
         }
 
         m_camera->update(delta_time);
-        current_rotation += rotation_speed * delta_time;
-
-        const math::Mat4 vp = m_camera->get_view_projection_matrix();
 
-        math::Mat4 rotZ = math::Mat4::rotate_z(current_rotation);
-        math::Mat4 rotX = math::Mat4::rotate_x(current_rotation * 0.5f);
-        const math::Mat4 pyramid_model = rotZ * rotX;
+        const math::Mat4& vp = m_camera->get_view_projection_matrix();
 
-        const float cube_rot = current_rotation * 0.35f;
-        const math::Mat4 cube_model = math::Mat4::translate(math::Vec3(-1.35f, 0.0f, 0.0f))
-            * math::Mat4::rotate_y(cube_rot);
-
-        std::vector<SceneObject>& objects = m_scene.objects();
-        if (objects.size() >= 2) {
-            objects[0].model_matrix = pyramid_model;
-            objects[1].model_matrix = cube_model;
+        // Spin rate follows distance and last frame's visibility.
+        const std::vector<uint32_t>& masks = m_views.object_masks();
+        for (uint32_t i = 0; i < m_updates.item_count(m_spin_system); ++i) {
+            const math::Mat4& model = m_scene.objects()[i].model_matrix;
+            const math::Vec3 offset = math::Vec3(model.at(0, 3), model.at(1, 3), model.at(2, 3)) - m_camera->get_position();
+            m_updates.set_item_state(m_spin_system, i, offset.length(), i >= masks.size() || (masks[i] & 1u));
+        }
+        m_updates.run(delta_time);
+        m_particles->update(delta_time, JobSystem::instance());
+
+        m_world_streamer->update(m_scene, *m_graphics_device, m_camera->get_position(), delta_time);
+        m_scene.build_dynamic_batches(JobSystem::instance());
+
+        if (m_camera->version() != m_main_view_camera_version) {
+            CullView main_view;
+            main_view.view_projection = vp;
+            main_view.position = m_camera->get_position();
+            main_view.lod_scale = 0.5f * m_camera->get_projection_matrix().at(1, 1) * m_lod_bias;
+            if (m_draw_distance_scale < 1.0f) {
+                main_view.max_distance = kFarClip * m_draw_distance_scale;
+            }
+            main_view.use_pvs = m_scene.pvs() != nullptr;
+            m_views.set_view(0, main_view, m_camera->get_frustum());
+            m_main_view_camera_version = m_camera->version();
+        }
+        m_views.cull(m_scene, JobSystem::instance());
+
+        DebugDraw& debug_draw = DebugDraw::instance();
+        if (m_show_bounds) {
+            for (const SceneObject& obj : m_scene.objects()) {
+                if (!obj.mesh) {
+                    continue;
+                }
+                debug_draw.box(obj.mesh->local_bounds(), obj.model_matrix, kDebugGreen);
+            }
+            for (const SceneObject& obj : m_scene.static_objects()) {
+                if (!obj.mesh) {
+                    continue;
+                }
+                debug_draw.box(obj.mesh->local_bounds().transformed(obj.model_matrix), kDebugBlue);
+            }
         }
 
         m_graphics_device->begin_frame();
-        m_scene.render(*m_graphics_device, m_uniform_buffer, vp, m_directional_light,
-            m_camera->get_position());
+        m_scene.render(*m_graphics_device, m_uniform_buffer, m_views, 0, m_directional_light);
+        if (m_particle_renderer) {
+            m_particle_renderer->render(*m_particles, m_uniform_buffer, m_camera->get_view_matrix(), vp,
+                JobSystem::instance());
+        }
+        if (m_debug_renderer) {
+            m_debug_renderer->render(debug_draw, m_uniform_buffer, vp);
+        } else {
+            debug_draw.clear();
+        }
         m_graphics_device->end_frame();
         input.update();
 
@@ -151,13 +257,23 @@ void Engine::run() {
         std::ostringstream title;
         title << std::fixed << std::setprecision(1)
               << "Maya | " << fps_smooth << " fps | " << (delta_time * 1000.0f) << " ms | "
-              << fb_w << "x" << fb_h << " | draws " << draw_calls << " | cam "
+              << fb_w << "x" << fb_h << " | draws " << draw_calls
+              << " | p90 " << m_governor.last_percentile_ms() << " ms | cam "
               << std::setprecision(2) << pos.x << ", " << pos.y << ", " << pos.z;
         m_window->set_title(title.str());
     }
 }
 
 void Engine::shutdown() {
+    if (m_world_streamer) {
+        m_world_streamer->unload_all(m_scene);
+        m_world_streamer.reset();
+    }
+    m_debug_renderer.reset();
+    m_particle_renderer.reset();
+    // Meshes, batch streams and textures free their GPU resources on destruction.
+    m_scene = Scene();
+    m_checker_texture.reset();
     if (m_graphics_device) m_graphics_device->shutdown();
     m_is_running = false;
 }
@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <system_error>
 
@@ -56,8 +57,8 @@ void push_unique(std::vector<std::filesystem::path>& out, const std::filesystem:
     out.push_back(p);
 }
 
-void log_read_text_failure(const std::string& path_str, const std::vector<std::filesystem::path>& roots) {
-    std::cerr << "[FileSystem] read_text failed for: " << path_str << "\n";
+void log_read_failure(const char* reader, const std::string& path_str, const std::vector<std::filesystem::path>& roots) {
+    std::cerr << "[FileSystem] " << reader << " failed for: " << path_str << "\n";
     std::filesystem::path p(path_str);
     if (p.is_absolute()) {
         std::cerr << "  The path does not exist or is not a regular file.\n";
@@ -132,7 +133,7 @@ std::optional<std::filesystem::path> FileSystem::resolve(const std::string& path
 std::string FileSystem::read_text(const std::string& path) {
     auto resolved = resolve(path);
     if (!resolved) {
-        log_read_text_failure(path, s_roots);
+        log_read_failure("read_text", path, s_roots);
         return "";
     }
     std::ifstream file(*resolved);
@@ -145,4 +146,28 @@ std::string FileSystem::read_text(const std::string& path) {
     return buffer.str();
 }
 
+std::vector<uint8_t> FileSystem::read_binary(const std::string& path) {
+    auto resolved = resolve(path);
+    if (!resolved) {
+        log_read_failure("read_binary", path, s_roots);
+        return {};
+    }
+    std::ifstream file(*resolved, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[FileSystem] read_binary could not open resolved path: " << resolved->string() << "\n";
+        return {};
+    }
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool FileSystem::write_binary(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[FileSystem] write_binary could not open: " << path << "\n";
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
 } // namespace maya
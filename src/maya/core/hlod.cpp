@@ -0,0 +1,277 @@
+#include "maya/core/hlod.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/vertex_transform.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+
+namespace maya {
+
+namespace {
+
+/// CPU geometry of one material while a cluster's proxies are assembled.
+struct ProxyData {
+    Material material{};
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+ProxyData& group_for(std::vector<ProxyData>& groups, const Material& material) {
+    const MaterialKey key(material);
+    for (ProxyData& group : groups) {
+        if (MaterialKey(group.material) == key) {
+            return group;
+        }
+    }
+    groups.push_back(ProxyData{material, {}, {}});
+    return groups.back();
+}
+
+void append_geometry(ProxyData& group, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    const uint32_t base = static_cast<uint32_t>(group.vertices.size());
+    group.vertices.insert(group.vertices.end(), vertices.begin(), vertices.end());
+    for (uint32_t index : indices) {
+        group.indices.push_back(base + index);
+    }
+}
+
+uint64_t spread_bits(uint32_t v) {
+    uint64_t x = v & 0x1fffffu;
+    x = (x | x << 32) & 0x1f00000000ffffull;
+    x = (x | x << 16) & 0x1f0000ff0000ffull;
+    x = (x | x << 8) & 0x100f00f00f00f00full;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+    x = (x | x << 2) & 0x1249249249249249ull;
+    return x;
+}
+
+/// Interleaves 21-bit cell coordinates; clusters sharing a parent are then adjacent in sorted
+/// order at every level.
+uint64_t morton(uint32_t x, uint32_t y, uint32_t z) {
+    return spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2);
+}
+
+int32_t to_cell(float v, float inv_cell_size) {
+    return static_cast<int32_t>(std::clamp(std::floor(v * inv_cell_size), -1.0e6f, 1.0e6f));
+}
+
+/// Vertex clustering: vertices in the same grid cell collapse to their average, triangles that
+/// become degenerate or duplicated are dropped, and unreferenced vertices are removed.
+void simplify(ProxyData& data, float cell_size) {
+    if (cell_size <= 0.0f || data.vertices.empty()) {
+        return;
+    }
+    const float inv = 1.0f / cell_size;
+    std::unordered_map<uint64_t, uint32_t> cells;
+    std::vector<Vertex> merged;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> remap(data.vertices.size());
+    for (size_t i = 0; i < data.vertices.size(); ++i) {
+        const Vertex& v = data.vertices[i];
+        const uint64_t key = morton(static_cast<uint32_t>(to_cell(v.position.x, inv)),
+            static_cast<uint32_t>(to_cell(v.position.y, inv)), static_cast<uint32_t>(to_cell(v.position.z, inv)));
+        auto [it, inserted] = cells.try_emplace(key, static_cast<uint32_t>(merged.size()));
+        if (inserted) {
+            merged.push_back(v);
+            counts.push_back(1);
+        } else {
+            Vertex& sum = merged[it->second];
+            sum.position += v.position;
+            sum.normal += v.normal;
+            sum.color = sum.color + v.color;
+            ++counts[it->second];
+        }
+        remap[i] = it->second;
+    }
+    for (size_t i = 0; i < merged.size(); ++i) {
+        const float scale = 1.0f / static_cast<float>(counts[i]);
+        merged[i].position *= scale;
+        merged[i].color = merged[i].color * scale;
+        merged[i].normal = merged[i].normal.length_squared() > 1e-12f ? merged[i].normal.normalized()
+                                                                       : math::Vec3(0.0f, 1.0f, 0.0f);
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    triangles.reserve(data.indices.size() / 3);
+    for (size_t i = 0; i + 2 < data.indices.size(); i += 3) {
+        std::array<uint32_t, 3> tri = {remap[data.indices[i]], remap[data.indices[i + 1]], remap[data.indices[i + 2]]};
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+            continue;
+        }
+        // Rotate the smallest index first (keeps winding) so duplicates compare equal.
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        triangles.push_back(tri);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+    std::vector<uint32_t> compact(merged.size(), ~0u);
+    data.vertices.clear();
+    data.indices.clear();
+    for (const std::array<uint32_t, 3>& tri : triangles) {
+        for (uint32_t index : tri) {
+            if (compact[index] == ~0u) {
+                compact[index] = static_cast<uint32_t>(data.vertices.size());
+                data.vertices.push_back(merged[index]);
+            }
+            data.indices.push_back(compact[index]);
+        }
+    }
+}
+
+std::vector<HlodProxy> make_proxies(GraphicsDevice& device, std::vector<ProxyData>& groups, float cell_size) {
+    std::vector<HlodProxy> proxies;
+    for (ProxyData& group : groups) {
+        simplify(group, cell_size);
+        if (group.indices.empty()) {
+            continue;
+        }
+        proxies.push_back(HlodProxy{group.material, std::make_unique<Mesh>(device, group.vertices, group.indices)});
+    }
+    return proxies;
+}
+
+} // namespace
+
+void HlodTree::clear() {
+    m_clusters.clear();
+    m_object_leaves.clear();
+    m_leaf_count = 0;
+    m_first_root = 0;
+}
+
+void HlodTree::build(GraphicsDevice& device, const std::vector<SceneObject>& objects, const HlodSettings& settings) {
+    clear();
+    m_settings = settings;
+    m_object_leaves.assign(objects.size(), kNoHlodCluster);
+
+    struct Placed {
+        uint64_t code;
+        uint32_t object;
+        math::Aabb bounds;
+    };
+    std::vector<Placed> placed;
+    std::vector<std::array<int32_t, 3>> cells;
+    int32_t min_cell[3] = {INT32_MAX, INT32_MAX, INT32_MAX};
+    const float inv_cluster = 1.0f / settings.cluster_size;
+    uint32_t released = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(objects.size()); ++i) {
+        const SceneObject& obj = objects[i];
+        if (!obj.mesh || obj.mesh->index_count() == 0) {
+            continue;
+        }
+        if (!obj.mesh->has_cpu_data()) {
+            // Left out of every cluster, so views keep drawing the object itself.
+            ++released;
+            continue;
+        }
+        const math::Aabb bounds = obj.mesh->local_bounds().transformed(obj.model_matrix);
+        const math::Vec3 c = bounds.center();
+        const std::array<int32_t, 3> cell = {to_cell(c.x, inv_cluster), to_cell(c.y, inv_cluster),
+                                             to_cell(c.z, inv_cluster)};
+        for (int axis = 0; axis < 3; ++axis) {
+            min_cell[axis] = std::min(min_cell[axis], cell[axis]);
+        }
+        cells.push_back(cell);
+        placed.push_back(Placed{0, i, bounds});
+    }
+    if (released > 0) {
+        std::cerr << "HlodTree::build: skipped " << released << " object(s) whose mesh CPU data was released\n";
+    }
+    if (placed.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < placed.size(); ++i) {
+        placed[i].code = morton(static_cast<uint32_t>(cells[i][0] - min_cell[0]),
+            static_cast<uint32_t>(cells[i][1] - min_cell[1]), static_cast<uint32_t>(cells[i][2] - min_cell[2]));
+    }
+    std::sort(placed.begin(), placed.end(), [](const Placed& a, const Placed& b) {
+        return a.code != b.code ? a.code < b.code : a.object < b.object;
+    });
+
+    // Level 0: one cluster per occupied cell.
+    std::vector<uint64_t> codes;
+    const float leaf_cell = settings.cluster_size * settings.simplify_cell_fraction;
+    for (size_t begin = 0; begin < placed.size();) {
+        size_t end = begin;
+        HlodCluster cluster;
+        std::vector<ProxyData> groups;
+        const uint32_t leaf = static_cast<uint32_t>(m_clusters.size());
+        std::vector<Vertex> world;
+        while (end < placed.size() && placed[end].code == placed[begin].code) {
+            const SceneObject& obj = objects[placed[end].object];
+            world = obj.mesh->vertices();
+            transform_vertices(world.data(), world.data(), world.size(), obj.model_matrix,
+                obj.model_matrix.normal_matrix());
+            append_geometry(group_for(groups, obj.material), world, obj.mesh->indices());
+            cluster.bounds.merge(placed[end].bounds);
+            m_object_leaves[placed[end].object] = leaf;
+            ++end;
+        }
+        cluster.first_leaf = leaf;
+        cluster.leaf_count = 1;
+        cluster.proxies = make_proxies(device, groups, leaf_cell);
+        m_clusters.push_back(std::move(cluster));
+        codes.push_back(placed[begin].code);
+        begin = end;
+    }
+    m_leaf_count = static_cast<uint32_t>(m_clusters.size());
+
+    // Coarser levels: group clusters whose codes share a parent cell, re-simplifying the
+    // children's proxies on a grid twice as coarse each time.
+    uint32_t level_first = 0;
+    uint32_t level_count = m_leaf_count;
+    for (uint32_t level = 1; level <= settings.levels && level_count > 1; ++level) {
+        const uint32_t next_first = static_cast<uint32_t>(m_clusters.size());
+        std::vector<uint64_t> next_codes;
+        const float cell = leaf_cell * static_cast<float>(1u << std::min(level, 20u));
+        for (uint32_t begin = 0; begin < level_count;) {
+            const uint64_t parent = codes[begin] >> 3;
+            uint32_t end = begin;
+            HlodCluster cluster;
+            cluster.level = level;
+            cluster.first_child = level_first + begin;
+            cluster.first_leaf = m_clusters[level_first + begin].first_leaf;
+            std::vector<ProxyData> groups;
+            while (end < level_count && (codes[end] >> 3) == parent) {
+                const HlodCluster& child = m_clusters[level_first + end];
+                cluster.bounds.merge(child.bounds);
+                cluster.leaf_count += child.leaf_count;
+                for (const HlodProxy& proxy : child.proxies) {
+                    append_geometry(group_for(groups, proxy.material), proxy.mesh->vertices(), proxy.mesh->indices());
+                }
+                ++end;
+            }
+            cluster.child_count = end - begin;
+            cluster.proxies = make_proxies(device, groups, cell);
+            m_clusters.push_back(std::move(cluster));
+            next_codes.push_back(parent);
+            begin = end;
+        }
+        level_first = next_first;
+        level_count = static_cast<uint32_t>(m_clusters.size()) - next_first;
+        codes = std::move(next_codes);
+    }
+    m_first_root = level_first;
+    // Proxy geometry is only read back while building coarser levels.
+    for (HlodCluster& cluster : m_clusters) {
+        for (HlodProxy& proxy : cluster.proxies) {
+            proxy.mesh->release_cpu_data();
+        }
+    }
+}
+
+uint32_t HlodTree::proxy_triangle_count() const {
+    uint32_t triangles = 0;
+    for (const HlodCluster& cluster : m_clusters) {
+        for (const HlodProxy& proxy : cluster.proxies) {
+            triangles += proxy.mesh->index_count() / 3;
+        }
+    }
+    return triangles;
+}
+
+} // namespace maya
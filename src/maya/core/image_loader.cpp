@@ -0,0 +1,90 @@
+#include "maya/core/image_loader.hpp"
+#include "maya/core/file_system.hpp"
+#include <cstring>
+#include <iostream>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace maya {
+
+bool ImageLoader::decode(const void* bytes, size_t size, ImageData& out) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    stbi_uc* pixels = stbi_load_from_memory(static_cast<const stbi_uc*>(bytes), static_cast<int>(size),
+        &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cerr << "Failed to decode image: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    out.width = static_cast<uint32_t>(width);
+    out.height = static_cast<uint32_t>(height);
+    out.pixels.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    std::memcpy(out.pixels.data(), pixels, out.pixels.size());
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool ImageLoader::read(const std::string& path, ImageData& out) {
+    const std::vector<uint8_t> bytes = FileSystem::read_binary(path);
+    if (bytes.empty()) {
+        std::cerr << "Failed to read image file: " << path << std::endl;
+        return false;
+    }
+    return decode(bytes.data(), bytes.size(), out);
+}
+
+bool ImageLoader::decode_gray16(const void* bytes, size_t size, HeightImageData& out) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    stbi_us* pixels = stbi_load_16_from_memory(static_cast<const stbi_uc*>(bytes), static_cast<int>(size),
+        &width, &height, &channels, 1);
+    if (!pixels) {
+        std::cerr << "Failed to decode 16-bit image: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    out.width = static_cast<uint32_t>(width);
+    out.height = static_cast<uint32_t>(height);
+    out.pixels.assign(pixels, pixels + static_cast<size_t>(width) * static_cast<size_t>(height));
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool ImageLoader::read_gray16(const std::string& path, HeightImageData& out) {
+    const std::vector<uint8_t> bytes = FileSystem::read_binary(path);
+    if (bytes.empty()) {
+        std::cerr << "Failed to read image file: " << path << std::endl;
+        return false;
+    }
+    return decode_gray16(bytes.data(), bytes.size(), out);
+}
+
+bool ImageLoader::decode_hdr(const void* bytes, size_t size, HdrImageData& out) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    float* pixels = stbi_loadf_from_memory(static_cast<const stbi_uc*>(bytes), static_cast<int>(size),
+        &width, &height, &channels, 3);
+    if (!pixels) {
+        std::cerr << "Failed to decode HDR image: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    out.width = static_cast<uint32_t>(width);
+    out.height = static_cast<uint32_t>(height);
+    out.pixels.assign(pixels, pixels + static_cast<size_t>(width) * static_cast<size_t>(height) * 3);
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool ImageLoader::read_hdr(const std::string& path, HdrImageData& out) {
+    const std::vector<uint8_t> bytes = FileSystem::read_binary(path);
+    if (bytes.empty()) {
+        std::cerr << "Failed to read image file: " << path << std::endl;
+        return false;
+    }
+    return decode_hdr(bytes.data(), bytes.size(), out);
+}
+
+} // namespace maya
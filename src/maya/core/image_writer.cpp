@@ -0,0 +1,182 @@
+#include "maya/core/image_writer.hpp"
+#include "maya/core/file_system.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace maya {
+
+namespace {
+
+/// Largest payload of one stored deflate block.
+constexpr size_t kMaxStoredBlock = 65535;
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> kTable = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return table;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = kTable[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t adler32(const std::vector<uint8_t>& data) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (uint8_t byte : data) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+void put_u32_be(std::vector<uint8_t>& out, uint32_t value) {
+    out.insert(out.end(), {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+        static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)});
+}
+
+template <typename T>
+void put_le(std::vector<uint8_t>& out, T value) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    // EXR is little-endian, as are all targets this engine builds for.
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void put_png_chunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& payload) {
+    put_u32_be(out, static_cast<uint32_t>(payload.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+    put_u32_be(out, crc32(out.data() + start, out.size() - start));
+}
+
+void put_exr_attribute(std::vector<uint8_t>& out, const char* name, const char* type,
+    const std::vector<uint8_t>& value) {
+    out.insert(out.end(), name, name + std::strlen(name) + 1);
+    out.insert(out.end(), type, type + std::strlen(type) + 1);
+    put_le(out, static_cast<int32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+} // namespace
+
+std::vector<uint8_t> ImageWriter::encode_png(const ImageData& image) {
+    const size_t row_bytes = static_cast<size_t>(image.width) * 4;
+    if (image.width == 0 || image.height == 0 || image.pixels.size() < row_bytes * image.height) {
+        return {};
+    }
+    // Scanlines with filter type 0 (none).
+    std::vector<uint8_t> raw;
+    raw.reserve((row_bytes + 1) * image.height);
+    for (uint32_t y = 0; y < image.height; ++y) {
+        raw.push_back(0);
+        const uint8_t* row = image.pixels.data() + y * row_bytes;
+        raw.insert(raw.end(), row, row + row_bytes);
+    }
+
+    // zlib stream of stored deflate blocks.
+    std::vector<uint8_t> idat = {0x78, 0x01};
+    for (size_t offset = 0; offset < raw.size(); offset += kMaxStoredBlock) {
+        const size_t size = std::min(kMaxStoredBlock, raw.size() - offset);
+        const bool last = offset + size >= raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.insert(idat.end(), {static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+            static_cast<uint8_t>(~size), static_cast<uint8_t>(~size >> 8)});
+        idat.insert(idat.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset),
+            raw.begin() + static_cast<std::ptrdiff_t>(offset + size));
+    }
+    put_u32_be(idat, adler32(raw));
+
+    std::vector<uint8_t> header;
+    put_u32_be(header, image.width);
+    put_u32_be(header, image.height);
+    // 8-bit depth, color type 6 (RGBA), default compression, filter and no interlace.
+    header.insert(header.end(), {8, 6, 0, 0, 0});
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    put_png_chunk(png, "IHDR", header);
+    put_png_chunk(png, "IDAT", idat);
+    put_png_chunk(png, "IEND", {});
+    return png;
+}
+
+bool ImageWriter::write_png(const std::string& path, const ImageData& image) {
+    const std::vector<uint8_t> bytes = encode_png(image);
+    return !bytes.empty() && FileSystem::write_binary(path, bytes);
+}
+
+std::vector<uint8_t> ImageWriter::encode_exr(const HdrImageData& image) {
+    const size_t pixel_count = static_cast<size_t>(image.width) * image.height;
+    if (pixel_count == 0 || image.pixels.size() < pixel_count * 3) {
+        return {};
+    }
+    std::vector<uint8_t> exr;
+    put_le(exr, 20000630);
+    // Version 2, single-part scanline file.
+    put_le(exr, 2);
+
+    // Channels are listed alphabetically; pixel type 2 is 32-bit float.
+    std::vector<uint8_t> channels;
+    for (const char* name : {"B", "G", "R"}) {
+        channels.insert(channels.end(), name, name + 2);
+        put_le(channels, 2);
+        put_le(channels, 0);
+        put_le(channels, 1);
+        put_le(channels, 1);
+    }
+    channels.push_back(0);
+    std::vector<uint8_t> window;
+    for (int32_t value : {0, 0, static_cast<int32_t>(image.width) - 1, static_cast<int32_t>(image.height) - 1}) {
+        put_le(window, value);
+    }
+    std::vector<uint8_t> one;
+    put_le(one, 1.0f);
+    std::vector<uint8_t> center;
+    put_le(center, 0.0f);
+    put_le(center, 0.0f);
+    put_exr_attribute(exr, "channels", "chlist", channels);
+    put_exr_attribute(exr, "compression", "compression", {0});
+    put_exr_attribute(exr, "dataWindow", "box2i", window);
+    put_exr_attribute(exr, "displayWindow", "box2i", window);
+    put_exr_attribute(exr, "lineOrder", "lineOrder", {0});
+    put_exr_attribute(exr, "pixelAspectRatio", "float", one);
+    put_exr_attribute(exr, "screenWindowCenter", "v2f", center);
+    put_exr_attribute(exr, "screenWindowWidth", "float", one);
+    exr.push_back(0);
+
+    // Offset table, then one block per scanline: y, byte count and the B, G and R rows.
+    const uint32_t block_data = image.width * 3 * static_cast<uint32_t>(sizeof(float));
+    const uint64_t first_block = exr.size() + static_cast<uint64_t>(image.height) * sizeof(uint64_t);
+    for (uint32_t y = 0; y < image.height; ++y) {
+        put_le(exr, first_block + static_cast<uint64_t>(y) * (8 + block_data));
+    }
+    for (uint32_t y = 0; y < image.height; ++y) {
+        put_le(exr, static_cast<int32_t>(y));
+        put_le(exr, static_cast<int32_t>(block_data));
+        const float* row = image.pixels.data() + static_cast<size_t>(y) * image.width * 3;
+        for (int channel = 2; channel >= 0; --channel) {
+            for (uint32_t x = 0; x < image.width; ++x) {
+                put_le(exr, row[x * 3 + static_cast<uint32_t>(channel)]);
+            }
+        }
+    }
+    return exr;
+}
+
+bool ImageWriter::write_exr(const std::string& path, const HdrImageData& image) {
+    const std::vector<uint8_t> bytes = encode_exr(image);
+    return !bytes.empty() && FileSystem::write_binary(path, bytes);
+}
+
+} // namespace maya
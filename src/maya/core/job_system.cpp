@@ -0,0 +1,128 @@
+#include "maya/core/job_system.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace maya {
+
+JobSystem::JobSystem(uint32_t worker_count) {
+    m_workers.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        m_workers.emplace_back([this] { worker_loop(); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_work_available.notify_all();
+    for (std::thread& t : m_workers) {
+        t.join();
+    }
+}
+
+uint32_t JobSystem::default_worker_count() {
+    const uint32_t hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+}
+
+void JobSystem::submit(std::function<void()> job) {
+    if (m_workers.empty()) {
+        job();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(job));
+    }
+    m_work_available.notify_one();
+}
+
+void JobSystem::worker_loop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_work_available.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            ++m_active;
+        }
+        job();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active;
+            if (m_active == 0 && m_queue.empty()) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
+
+void JobSystem::wait_idle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_active == 0 && m_queue.empty(); });
+}
+
+void JobSystem::parallel_for(uint32_t count, uint32_t min_chunk, const std::function<void(uint32_t, uint32_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+    min_chunk = std::max<uint32_t>(min_chunk, 1);
+    const uint32_t threads = worker_count() + 1;
+    // A few chunks per thread so uneven chunks still balance.
+    const uint32_t chunk = std::max(min_chunk, (count + threads * 4 - 1) / (threads * 4));
+    const uint32_t chunk_count = (count + chunk - 1) / chunk;
+    if (chunk_count == 1 || m_workers.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    // Shared with helper jobs, which may still be queued after the caller returns.
+    struct State {
+        std::atomic<uint32_t> next_chunk{0};
+        std::atomic<uint32_t> remaining;
+        const std::function<void(uint32_t, uint32_t)>* fn;
+        uint32_t count;
+        uint32_t chunk;
+        uint32_t chunk_count;
+    };
+    auto state = std::make_shared<State>();
+    state->remaining.store(chunk_count);
+    state->fn = &fn;
+    state->count = count;
+    state->chunk = chunk;
+    state->chunk_count = chunk_count;
+
+    auto run_chunks = [](State& s) {
+        for (;;) {
+            const uint32_t c = s.next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (c >= s.chunk_count) {
+                return;
+            }
+            const uint32_t begin = c * s.chunk;
+            (*s.fn)(begin, std::min(begin + s.chunk, s.count));
+            if (s.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                s.remaining.notify_all();
+            }
+        }
+    };
+
+    const uint32_t helpers = std::min(worker_count(), chunk_count - 1);
+    for (uint32_t i = 0; i < helpers; ++i) {
+        submit([state, run_chunks] { run_chunks(*state); });
+    }
+    run_chunks(*state);
+
+    for (uint32_t left = state->remaining.load(std::memory_order_acquire); left != 0;
+         left = state->remaining.load(std::memory_order_acquire)) {
+        state->remaining.wait(left, std::memory_order_acquire);
+    }
+}
+
+} // namespace maya
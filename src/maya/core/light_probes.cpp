@@ -0,0 +1,268 @@
+#include "maya/core/light_probes.hpp"
+#include "maya/core/image_loader.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace maya {
+
+namespace {
+
+using math::SphericalHarmonicsL2;
+using math::simd::Float4;
+
+/// Rows per projection job.
+constexpr uint32_t kRowsPerChunk = 8;
+
+/// Lane-wise SH sums over four texels at a time: basis function `i`, channel `c` at `i * 3 + c`.
+struct ShAccumulator {
+    Float4 sums[SphericalHarmonicsL2::kCount * 3];
+    Float4 weight;
+
+    /// Adds radiance `(r, g, b)` from unit directions `(x, y, z)` over solid angles `w`.
+    void add(const Float4& x, const Float4& y, const Float4& z, const Float4& w, const Float4& r,
+        const Float4& g, const Float4& b) {
+        const Float4 xy = x * y;
+        const Float4 basis[SphericalHarmonicsL2::kCount] = {
+            Float4::splat(0.282095f),
+            Float4::splat(0.488603f) * y,
+            Float4::splat(0.488603f) * z,
+            Float4::splat(0.488603f) * x,
+            Float4::splat(1.092548f) * xy,
+            Float4::splat(1.092548f) * y * z,
+            Float4::splat(0.315392f) * Float4::madd(Float4::splat(3.0f), z * z, Float4::splat(-1.0f)),
+            Float4::splat(1.092548f) * x * z,
+            Float4::splat(0.546274f) * (x * x - y * y),
+        };
+        const Float4 wr = r * w;
+        const Float4 wg = g * w;
+        const Float4 wb = b * w;
+        for (int i = 0; i < SphericalHarmonicsL2::kCount; ++i) {
+            sums[i * 3 + 0] = Float4::madd(basis[i], wr, sums[i * 3 + 0]);
+            sums[i * 3 + 1] = Float4::madd(basis[i], wg, sums[i * 3 + 1]);
+            sums[i * 3 + 2] = Float4::madd(basis[i], wb, sums[i * 3 + 2]);
+        }
+        weight += w;
+    }
+
+    SphericalHarmonicsL2 reduce() const {
+        SphericalHarmonicsL2 sh;
+        for (int i = 0; i < SphericalHarmonicsL2::kCount; ++i) {
+            float channel[3];
+            for (int c = 0; c < 3; ++c) {
+                const Float4& s = sums[i * 3 + c];
+                channel[c] = (s.lane(0) + s.lane(1)) + (s.lane(2) + s.lane(3));
+            }
+            sh.coefficients[i] = math::Vec3(channel[0], channel[1], channel[2]);
+        }
+        return sh;
+    }
+
+    float total_weight() const { return (weight.lane(0) + weight.lane(1)) + (weight.lane(2) + weight.lane(3)); }
+};
+
+/// De-interleaves texels `x .. x + 3` of an RGB row; texels at or past `width` read as black.
+void load_rgb(const float* row, uint32_t x, uint32_t width, Float4& r, Float4& g, Float4& b) {
+    if (x + 4 <= width) {
+        const float* p = row + x * 3;
+        r = Float4::set(p[0], p[3], p[6], p[9]);
+        g = Float4::set(p[1], p[4], p[7], p[10]);
+        b = Float4::set(p[2], p[5], p[8], p[11]);
+        return;
+    }
+    float rgb[3][4] = {};
+    for (uint32_t i = 0; x + i < width; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            rgb[c][i] = row[(x + i) * 3 + c];
+        }
+    }
+    r = Float4::load(rgb[0]);
+    g = Float4::load(rgb[1]);
+    b = Float4::load(rgb[2]);
+}
+
+/// Columns rounded up to whole Float4 steps.
+uint32_t padded(uint32_t width) { return (width + 3) & ~3u; }
+
+/// 1 for real columns, 0 for the padding of the last Float4 step.
+std::vector<float> column_mask(uint32_t width) {
+    std::vector<float> mask(padded(width), 0.0f);
+    std::fill(mask.begin(), mask.begin() + width, 1.0f);
+    return mask;
+}
+
+SphericalHarmonicsL2 sum_rows(const std::vector<SphericalHarmonicsL2>& rows) {
+    SphericalHarmonicsL2 sh;
+    for (const SphericalHarmonicsL2& row : rows) {
+        sh += row;
+    }
+    return sh;
+}
+
+} // namespace
+
+math::SphericalHarmonicsL2 project_equirect_sh(const HdrImageData& image, JobSystem& jobs) {
+    const uint32_t width = image.width;
+    const uint32_t height = image.height;
+    if (width == 0 || height == 0 || image.pixels.size() < static_cast<size_t>(width) * height * 3) {
+        return {};
+    }
+
+    std::vector<float> cos_phi(padded(width), 0.0f);
+    std::vector<float> sin_phi(padded(width), 0.0f);
+    for (uint32_t x = 0; x < width; ++x) {
+        const float phi = math::TWO_PI * (static_cast<float>(x) + 0.5f) / static_cast<float>(width);
+        cos_phi[x] = std::cos(phi);
+        sin_phi[x] = std::sin(phi);
+    }
+    const std::vector<float> mask = column_mask(width);
+    // Texel solid angle is sin(theta) * dtheta * dphi.
+    const float texel_area = (math::PI / static_cast<float>(height)) * (math::TWO_PI / static_cast<float>(width));
+
+    std::vector<SphericalHarmonicsL2> rows(height);
+    jobs.parallel_for(height, kRowsPerChunk, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t y = begin; y < end; ++y) {
+            const float theta = math::PI * (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+            const float sin_theta = std::sin(theta);
+            const Float4 st = Float4::splat(sin_theta);
+            const Float4 dy = Float4::splat(std::cos(theta));
+            const Float4 w = Float4::splat(sin_theta * texel_area);
+            const float* row = image.pixels.data() + static_cast<size_t>(y) * width * 3;
+
+            ShAccumulator acc;
+            for (uint32_t x = 0; x < width; x += 4) {
+                Float4 r;
+                Float4 g;
+                Float4 b;
+                load_rgb(row, x, width, r, g, b);
+                acc.add(st * Float4::load(&cos_phi[x]), dy, st * Float4::load(&sin_phi[x]),
+                    w * Float4::load(&mask[x]), r, g, b);
+            }
+            rows[y] = acc.reduce();
+        }
+    });
+    return sum_rows(rows);
+}
+
+math::SphericalHarmonicsL2 project_cubemap_sh(const std::array<HdrImageData, 6>& faces, JobSystem& jobs) {
+    const uint32_t size = faces[0].width;
+    for (const HdrImageData& face : faces) {
+        if (size == 0 || face.width != size || face.height != size
+            || face.pixels.size() < static_cast<size_t>(size) * size * 3) {
+            return {};
+        }
+    }
+
+    // Texel centers in [-1, 1] along a face.
+    std::vector<float> coords(padded(size), 0.0f);
+    for (uint32_t i = 0; i < size; ++i) {
+        coords[i] = 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(size) - 1.0f;
+    }
+    const std::vector<float> mask = column_mask(size);
+    const float texel_area = 4.0f / (static_cast<float>(size) * static_cast<float>(size));
+
+    std::vector<SphericalHarmonicsL2> rows(6 * size);
+    std::vector<float> row_weights(6 * size);
+    jobs.parallel_for(6 * size, kRowsPerChunk, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t row_index = begin; row_index < end; ++row_index) {
+            const uint32_t face = row_index / size;
+            const uint32_t y = row_index % size;
+            const Float4 v = Float4::splat(coords[y]);
+            const Float4 one = Float4::splat(1.0f);
+            const Float4 zero = Float4::zero();
+            const float* row = faces[face].pixels.data() + static_cast<size_t>(y) * size * 3;
+
+            ShAccumulator acc;
+            for (uint32_t x = 0; x < size; x += 4) {
+                const Float4 u = Float4::load(&coords[x]);
+                Float4 dx;
+                Float4 dy;
+                Float4 dz;
+                switch (face) {
+                    case 0: dx = one; dy = zero - v; dz = zero - u; break;
+                    case 1: dx = zero - one; dy = zero - v; dz = u; break;
+                    case 2: dx = u; dy = one; dz = v; break;
+                    case 3: dx = u; dy = zero - one; dz = zero - v; break;
+                    case 4: dx = u; dy = zero - v; dz = one; break;
+                    default: dx = zero - u; dy = zero - v; dz = zero - one; break;
+                }
+                // Solid angle of a texel at (u, v) is area / (1 + u^2 + v^2)^(3/2).
+                const Float4 inv_length = one / Float4::sqrt(Float4::madd(u, u, Float4::madd(v, v, one)));
+                const Float4 w = Float4::splat(texel_area) * inv_length * inv_length * inv_length
+                    * Float4::load(&mask[x]);
+                Float4 r;
+                Float4 g;
+                Float4 b;
+                load_rgb(row, x, size, r, g, b);
+                acc.add(dx * inv_length, dy * inv_length, dz * inv_length, w, r, g, b);
+            }
+            rows[row_index] = acc.reduce();
+            row_weights[row_index] = acc.total_weight();
+        }
+    });
+
+    // The texel solid angles only approximately cover the sphere; normalize them to 4 pi.
+    float total_weight = 0.0f;
+    for (float w : row_weights) {
+        total_weight += w;
+    }
+    return sum_rows(rows) * (4.0f * math::PI / total_weight);
+}
+
+bool load_environment_sh(const std::string& path, JobSystem& jobs, math::SphericalHarmonicsL2& out) {
+    HdrImageData image;
+    if (!ImageLoader::read_hdr(path, image)) {
+        return false;
+    }
+    out = project_equirect_sh(image, jobs);
+    return true;
+}
+
+LightProbeGrid::LightProbeGrid(const math::Aabb& bounds, uint32_t nx, uint32_t ny, uint32_t nz,
+    const math::SphericalHarmonicsL2& initial)
+    : m_bounds(bounds), m_nx(std::max(nx, 1u)), m_ny(std::max(ny, 1u)), m_nz(std::max(nz, 1u)),
+      m_probes(static_cast<size_t>(m_nx) * m_ny * m_nz, initial) {}
+
+math::Vec3 LightProbeGrid::probe_position(uint32_t x, uint32_t y, uint32_t z) const {
+    const auto axis = [](float lo, float hi, uint32_t i, uint32_t n) {
+        return n > 1 ? lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(n - 1) : (lo + hi) * 0.5f;
+    };
+    return {axis(m_bounds.min.x, m_bounds.max.x, x, m_nx), axis(m_bounds.min.y, m_bounds.max.y, y, m_ny),
+        axis(m_bounds.min.z, m_bounds.max.z, z, m_nz)};
+}
+
+math::SphericalHarmonicsL2 LightProbeGrid::sample(const math::Vec3& position) const {
+    if (m_probes.empty()) {
+        return {};
+    }
+    // Probe-space coordinate along one axis: lower probe index and blend factor toward the next.
+    const auto axis = [](float p, float lo, float hi, uint32_t n, uint32_t& i, float& t) {
+        const float extent = hi - lo;
+        const float f = (n > 1 && extent > 0.0f)
+            ? std::clamp((p - lo) / extent, 0.0f, 1.0f) * static_cast<float>(n - 1) : 0.0f;
+        i = std::min(static_cast<uint32_t>(f), n > 1 ? n - 2 : 0u);
+        t = n > 1 ? f - static_cast<float>(i) : 0.0f;
+    };
+    uint32_t x0;
+    uint32_t y0;
+    uint32_t z0;
+    float tx;
+    float ty;
+    float tz;
+    axis(position.x, m_bounds.min.x, m_bounds.max.x, m_nx, x0, tx);
+    axis(position.y, m_bounds.min.y, m_bounds.max.y, m_ny, y0, ty);
+    axis(position.z, m_bounds.min.z, m_bounds.max.z, m_nz, z0, tz);
+    const uint32_t x1 = std::min(x0 + 1, m_nx - 1);
+    const uint32_t y1 = std::min(y0 + 1, m_ny - 1);
+    const uint32_t z1 = std::min(z0 + 1, m_nz - 1);
+
+    const auto along_x = [&](uint32_t y, uint32_t z) {
+        return math::SphericalHarmonicsL2::lerp(probe(x0, y, z), probe(x1, y, z), tx);
+    };
+    const math::SphericalHarmonicsL2 near_z = math::SphericalHarmonicsL2::lerp(along_x(y0, z0), along_x(y1, z0), ty);
+    const math::SphericalHarmonicsL2 far_z = math::SphericalHarmonicsL2::lerp(along_x(y0, z1), along_x(y1, z1), ty);
+    return math::SphericalHarmonicsL2::lerp(near_z, far_z, tz);
+}
+
+} // namespace maya
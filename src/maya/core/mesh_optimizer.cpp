@@ -0,0 +1,179 @@
+#include "maya/core/mesh_optimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace maya {
+
+namespace {
+
+constexpr uint32_t kCacheSize = 32;
+constexpr uint32_t kNoTriangle = std::numeric_limits<uint32_t>::max();
+/// Vertices of the triangle just emitted score this regardless of position, so the algorithm
+/// does not favor immediately re-using an edge over fanning around a vertex.
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+/// Forsyth's vertex score: recency in the cache plus a boost for vertices with few triangles left,
+/// so isolated triangles are not left behind. Vertices with none left score -1.
+float vertex_score(int32_t cache_position, uint32_t remaining) {
+    static const std::array<float, kCacheSize> kPositionScores = [] {
+        std::array<float, kCacheSize> scores{};
+        for (uint32_t i = 0; i < kCacheSize; ++i) {
+            scores[i] = i < 3 ? kLastTriangleScore
+                              : std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(kCacheSize - 3),
+                                    kCacheDecayPower);
+        }
+        return scores;
+    }();
+    if (remaining == 0) {
+        return -1.0f;
+    }
+    const float cache = cache_position >= 0 ? kPositionScores[static_cast<uint32_t>(cache_position)] : 0.0f;
+    return cache + kValenceBoostScale * std::pow(static_cast<float>(remaining), -kValenceBoostPower);
+}
+
+} // namespace
+
+void optimize_vertex_cache(std::vector<uint32_t>& indices, uint32_t vertex_count) {
+    const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+    if (triangle_count == 0 || vertex_count == 0) {
+        return;
+    }
+
+    // Triangles of each vertex; the first `remaining[v]` entries of its range are not yet emitted.
+    std::vector<uint32_t> offsets(vertex_count + 1, 0);
+    for (uint32_t i = 0; i < triangle_count * 3; ++i) {
+        ++offsets[indices[i] + 1];
+    }
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<uint32_t> adjacency(triangle_count * 3);
+    std::vector<uint32_t> remaining(vertex_count, 0);
+    for (uint32_t i = 0; i < triangle_count * 3; ++i) {
+        const uint32_t v = indices[i];
+        adjacency[offsets[v] + remaining[v]++] = i / 3;
+    }
+
+    std::vector<int32_t> cache_position(vertex_count, -1);
+    std::vector<float> scores(vertex_count);
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        scores[v] = vertex_score(-1, remaining[v]);
+    }
+    std::vector<float> triangle_scores(triangle_count);
+    std::vector<uint8_t> emitted(triangle_count, 0);
+    uint32_t best = 0;
+    for (uint32_t t = 0; t < triangle_count; ++t) {
+        triangle_scores[t] = scores[indices[t * 3]] + scores[indices[t * 3 + 1]] + scores[indices[t * 3 + 2]];
+        if (triangle_scores[t] > triangle_scores[best]) {
+            best = t;
+        }
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triangle_count * 3);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> next_cache;
+    cache.reserve(kCacheSize + 3);
+    next_cache.reserve(kCacheSize + 3);
+    uint32_t next_unemitted = 0;
+
+    for (uint32_t step = 0; step < triangle_count; ++step) {
+        if (best == kNoTriangle) {
+            // Nothing in the cache has triangles left; continue in input order.
+            while (emitted[next_unemitted]) {
+                ++next_unemitted;
+            }
+            best = next_unemitted;
+        }
+        emitted[best] = 1;
+        const uint32_t* triangle = &indices[best * 3];
+        output.insert(output.end(), triangle, triangle + 3);
+
+        // The triangle's vertices move to the front of the LRU cache.
+        next_cache.clear();
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = triangle[k];
+            if (std::find(next_cache.begin(), next_cache.end(), v) == next_cache.end()) {
+                next_cache.push_back(v);
+            }
+            uint32_t* begin = adjacency.data() + offsets[v];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, best);
+            if (it != end) {
+                std::swap(*it, *(end - 1));
+                --remaining[v];
+            }
+        }
+        for (uint32_t v : cache) {
+            if (std::find(next_cache.begin(), next_cache.end(), v) == next_cache.end()) {
+                next_cache.push_back(v);
+            }
+        }
+
+        // Rescore every vertex that was or is cached (evicted ones drop to -1 position).
+        for (uint32_t i = 0; i < next_cache.size(); ++i) {
+            const uint32_t v = next_cache[i];
+            cache_position[v] = i < kCacheSize ? static_cast<int32_t>(i) : -1;
+            const float score = vertex_score(cache_position[v], remaining[v]);
+            const float delta = score - scores[v];
+            scores[v] = score;
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                triangle_scores[adjacency[a]] += delta;
+            }
+        }
+        next_cache.resize(std::min<size_t>(next_cache.size(), kCacheSize));
+        std::swap(cache, next_cache);
+
+        best = kNoTriangle;
+        float best_score = -std::numeric_limits<float>::max();
+        for (uint32_t v : cache) {
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                const uint32_t t = adjacency[a];
+                if (triangle_scores[t] > best_score) {
+                    best_score = triangle_scores[t];
+                    best = t;
+                }
+            }
+        }
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void optimize_vertex_fetch(MeshData& mesh) {
+    constexpr uint32_t kUnused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(mesh.vertices.size(), kUnused);
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == kUnused) {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+float vertex_cache_miss_ratio(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size) {
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0) {
+        return 0.0f;
+    }
+    // FIFO: a vertex is cached if fewer than `cache_size` misses happened since it was loaded.
+    std::vector<uint32_t> loaded_at(vertex_count, 0);
+    uint32_t misses = 0;
+    for (size_t i = 0; i < triangle_count * 3; ++i) {
+        const uint32_t v = indices[i];
+        if (loaded_at[v] == 0 || misses - loaded_at[v] >= cache_size) {
+            loaded_at[v] = ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+} // namespace maya
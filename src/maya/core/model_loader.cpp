@@ -17,18 +17,31 @@ struct ObjIndex {
 };
 
 std::unique_ptr<Mesh> ModelLoader::load_obj(GraphicsDevice& device, const std::string& path) {
+    MeshData data;
+    if (!read_obj(path, data)) {
+        return nullptr;
+    }
+    return std::make_unique<Mesh>(device, data.vertices, data.indices);
+}
+
+bool ModelLoader::read_obj(const std::string& path, MeshData& out) {
     std::string content = FileSystem::read_text(path);
     if (content.empty()) {
         std::cerr << "Failed to read OBJ file: " << path << std::endl;
-        return nullptr;
+        return false;
     }
+    return parse_obj(content, path, out);
+}
 
+bool ModelLoader::parse_obj(const std::string& content, const std::string& name, MeshData& out) {
     std::vector<math::Vec3> positions;
     std::vector<math::Vec2> uvs;
     std::vector<math::Vec3> normals;
     
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<Vertex>& vertices = out.vertices;
+    std::vector<uint32_t>& indices = out.indices;
+    vertices.clear();
+    indices.clear();
     std::map<ObjIndex, uint32_t> index_map;
 
     std::stringstream ss(content);
@@ -85,7 +98,7 @@ std::unique_ptr<Mesh> ModelLoader::load_obj(GraphicsDevice& device, const std::s
                     
                     if (idx.v < 0 || idx.v >= (int)positions.size()) {
                         std::cerr << "Invalid vertex index in OBJ: " << idx.v + 1 << std::endl;
-                        return nullptr;
+                        return false;
                     }
                     
                     math::Vec3 pos = positions[idx.v];
@@ -100,11 +113,10 @@ std::unique_ptr<Mesh> ModelLoader::load_obj(GraphicsDevice& device, const std::s
     }
 
     if (vertices.empty()) {
-        std::cerr << "No vertices loaded from OBJ: " << path << std::endl;
-        return nullptr;
+        std::cerr << "No vertices loaded from OBJ: " << name << std::endl;
+        return false;
     }
-
-    return std::make_unique<Mesh>(device, vertices, indices);
+    return true;
 }
 
 } // namespace maya
@@ -0,0 +1,158 @@
+#include "maya/core/morph_targets.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace maya {
+
+namespace {
+
+using math::simd::Float4;
+
+// Deltas are added straight onto the padded position and normal of a `Vertex`.
+static_assert(offsetof(Vertex, normal) == offsetof(Vertex, position) + 4 * sizeof(float));
+
+/// Floats per delta: position xyz + pad, normal xyz + pad.
+constexpr uint32_t kDeltaStride = 8;
+/// Vertices per evaluation job.
+constexpr uint32_t kVerticesPerChunk = 4096;
+
+} // namespace
+
+MorphTarget make_morph_target(const std::string& name, const std::vector<Vertex>& base,
+    const std::vector<Vertex>& shape, float epsilon) {
+    MorphTarget target;
+    target.name = name;
+    const size_t count = std::min(base.size(), shape.size());
+    for (size_t v = 0; v < count; ++v) {
+        const math::Vec3 dp = shape[v].position - base[v].position;
+        const math::Vec3 dn = shape[v].normal - base[v].normal;
+        const bool moves = std::abs(dp.x) >= epsilon || std::abs(dp.y) >= epsilon || std::abs(dp.z) >= epsilon;
+        const bool turns = std::abs(dn.x) >= epsilon || std::abs(dn.y) >= epsilon || std::abs(dn.z) >= epsilon;
+        if (!moves && !turns) {
+            continue;
+        }
+        target.vertices.push_back(static_cast<uint32_t>(v));
+        target.deltas.insert(target.deltas.end(), {dp.x, dp.y, dp.z, 0.0f, dn.x, dn.y, dn.z, 0.0f});
+        target.has_normals = target.has_normals || turns;
+    }
+    return target;
+}
+
+void apply_morph_targets(const MorphedMeshData& mesh, const float* weights, float weight_epsilon, uint32_t first,
+    uint32_t count, Vertex* out) {
+    std::copy(mesh.vertices.begin() + first, mesh.vertices.begin() + first + count, out);
+
+    const uint32_t last = first + count;
+    bool normals_changed = false;
+    for (size_t t = 0; t < mesh.targets.size(); ++t) {
+        const float weight = weights[t];
+        if (std::abs(weight) < weight_epsilon) {
+            continue;
+        }
+        const MorphTarget& target = mesh.targets[t];
+        const auto begin = std::lower_bound(target.vertices.begin(), target.vertices.end(), first);
+        const auto end = std::lower_bound(begin, target.vertices.end(), last);
+        if (begin == end) {
+            continue;
+        }
+
+        const Float4 w = Float4::splat(weight);
+        const float* delta = target.deltas.data() + static_cast<size_t>(begin - target.vertices.begin()) * kDeltaStride;
+        if (target.has_normals) {
+            normals_changed = true;
+            for (auto it = begin; it != end; ++it, delta += kDeltaStride) {
+                float* p = &out[*it - first].position.x;
+                Float4::madd(Float4::load(delta), w, Float4::load(p)).store(p);
+                Float4::madd(Float4::load(delta + 4), w, Float4::load(p + 4)).store(p + 4);
+            }
+        } else {
+            for (auto it = begin; it != end; ++it, delta += kDeltaStride) {
+                float* p = &out[*it - first].position.x;
+                Float4::madd(Float4::load(delta), w, Float4::load(p)).store(p);
+            }
+        }
+    }
+
+    if (!normals_changed) {
+        return;
+    }
+    for (uint32_t v = 0; v < count; ++v) {
+        float* n = &out[v].normal.x;
+        const Float4 normal = Float4::load(n);
+        const float length_squared = Float4::dot(normal, normal).lane(0);
+        if (length_squared > 0.0f) {
+            (normal * Float4::splat(1.0f / std::sqrt(length_squared))).store(n);
+        }
+    }
+}
+
+MorphTargetSystem::MorphTargetSystem(GraphicsDevice& device, uint32_t max_vertices, uint32_t max_indices,
+    float weight_epsilon)
+    : m_buffer(device, max_vertices, max_indices), m_weight_epsilon(weight_epsilon) {}
+
+uint32_t MorphTargetSystem::add_instance(const MorphedMeshData* mesh, const Material& material) {
+    const uint32_t first_vertex = m_vertex_offsets.back();
+    const uint32_t vertex_count = static_cast<uint32_t>(mesh->vertices.size());
+    const uint32_t first_index = static_cast<uint32_t>(m_indices.size());
+    if (first_vertex + vertex_count > m_buffer.max_vertices()
+        || first_index + mesh->indices.size() > m_buffer.max_indices()) {
+        return ~0u;
+    }
+
+    Instance instance;
+    instance.mesh = mesh;
+    instance.material = material;
+    instance.weights.assign(mesh->targets.size(), 0.0f);
+    instance.first_vertex = first_vertex;
+    instance.first_index = first_index;
+    m_instances.push_back(std::move(instance));
+
+    m_vertex_offsets.push_back(first_vertex + vertex_count);
+    m_vertices.insert(m_vertices.end(), mesh->vertices.begin(), mesh->vertices.end());
+    for (uint32_t index : mesh->indices) {
+        m_indices.push_back(first_vertex + index);
+    }
+    m_buffer.set_indices(m_indices.data(), static_cast<uint32_t>(m_indices.size()));
+    return static_cast<uint32_t>(m_instances.size() - 1);
+}
+
+void MorphTargetSystem::update(JobSystem& jobs) {
+    const uint32_t total = m_vertex_offsets.back();
+    const uint32_t chunks = (total + kVerticesPerChunk - 1) / kVerticesPerChunk;
+    jobs.parallel_for(chunks, 1, [&](uint32_t begin, uint32_t end) {
+        uint32_t v = begin * kVerticesPerChunk;
+        const uint32_t last = std::min(total, end * kVerticesPerChunk);
+        uint32_t i = static_cast<uint32_t>(
+            std::upper_bound(m_vertex_offsets.begin(), m_vertex_offsets.end(), v) - m_vertex_offsets.begin() - 1);
+        while (v < last) {
+            const Instance& instance = m_instances[i];
+            const uint32_t count = std::min(last, m_vertex_offsets[i + 1]) - v;
+            apply_morph_targets(*instance.mesh, instance.weights.data(), m_weight_epsilon, v - instance.first_vertex,
+                count, &m_vertices[v]);
+            v += count;
+            ++i;
+        }
+    });
+
+    m_buffer.upload_vertices(m_vertices.data(), total);
+}
+
+void MorphTargetSystem::render(GraphicsDevice& device, UniformBufferHandle uniform_buffer,
+    const math::Mat4& view_projection, const DirectionalLighting& lighting,
+    const math::Vec3& camera_position_world) const {
+    if (m_buffer.uploaded_index_count() == 0) {
+        return;
+    }
+    for (const Instance& instance : m_instances) {
+        apply_draw_state(device, uniform_buffer, instance.material, instance.model_matrix, view_projection, lighting,
+            camera_position_world);
+        m_buffer.bind();
+        m_buffer.draw_range(instance.first_index, static_cast<uint32_t>(instance.mesh->indices.size()));
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,273 @@
+#include "maya/core/particles.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace maya {
+
+namespace {
+
+using math::simd::Float4;
+
+/// Particles per simulation job; a multiple of four.
+constexpr uint32_t kParticlesPerChunk = 16384;
+/// Particles per billboard-writing job.
+constexpr uint32_t kBillboardsPerChunk = 8192;
+
+uint32_t round_up4(uint32_t n) {
+    return (n + 3u) & ~3u;
+}
+
+} // namespace
+
+ParticleSystem::ParticleSystem(uint32_t capacity, uint64_t seed)
+    : m_capacity(capacity), m_rng(seed) {
+    const size_t padded = round_up4(capacity);
+    for (std::vector<float>* array : {&m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_life, &m_size}) {
+        array->assign(padded, 0.0f);
+    }
+    m_color.assign(padded, 0u);
+}
+
+uint32_t ParticleSystem::add_emitter(const ParticleEmitterSettings& settings) {
+    m_emitters.push_back(Emitter{settings, 0.0f});
+    return static_cast<uint32_t>(m_emitters.size() - 1);
+}
+
+float ParticleSystem::random01() {
+    // splitmix64
+    uint64_t z = (m_rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::spawn(const ParticleEmitterSettings& settings) {
+    auto in_unit_sphere = [this] {
+        for (;;) {
+            const math::Vec3 v(random01() * 2.0f - 1.0f, random01() * 2.0f - 1.0f, random01() * 2.0f - 1.0f);
+            if (math::Vec3::dot(v, v) <= 1.0f) {
+                return v;
+            }
+        }
+    };
+    auto range = [this](float lo, float hi) { return lo + (hi - lo) * random01(); };
+
+    const uint32_t i = m_count++;
+    const math::Vec3 p = settings.position + in_unit_sphere() * settings.spawn_radius;
+    const float speed = range(settings.speed_min, settings.speed_max);
+    const math::Vec3 v = (settings.direction + in_unit_sphere() * settings.spread) * speed;
+    m_px[i] = p.x;
+    m_py[i] = p.y;
+    m_pz[i] = p.z;
+    m_vx[i] = v.x;
+    m_vy[i] = v.y;
+    m_vz[i] = v.z;
+    m_life[i] = range(settings.lifetime_min, settings.lifetime_max);
+    m_size[i] = range(settings.size_min, settings.size_max);
+    m_color[i] = settings.color;
+}
+
+uint32_t ParticleSystem::burst(uint32_t emitter, uint32_t count) {
+    count = std::min(count, m_capacity - m_count);
+    const ParticleEmitterSettings& settings = m_emitters[emitter].settings;
+    for (uint32_t n = 0; n < count; ++n) {
+        spawn(settings);
+    }
+    return count;
+}
+
+void ParticleSystem::update(float delta_time, JobSystem& jobs) {
+    for (uint32_t e = 0; e < static_cast<uint32_t>(m_emitters.size()); ++e) {
+        Emitter& emitter = m_emitters[e];
+        emitter.accumulator += emitter.settings.rate * delta_time;
+        const float whole = std::floor(emitter.accumulator);
+        emitter.accumulator -= whole;
+        burst(e, static_cast<uint32_t>(whole));
+    }
+    if (m_count == 0) {
+        return;
+    }
+
+    const uint32_t chunks = (m_count + kParticlesPerChunk - 1) / kParticlesPerChunk;
+    if (m_dead.size() < chunks) {
+        m_dead.resize(chunks);
+    }
+    jobs.parallel_for(chunks, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t c = begin; c < end; ++c) {
+            m_dead[c].clear();
+            simulate_range(c * kParticlesPerChunk, std::min(m_count, (c + 1) * kParticlesPerChunk), delta_time,
+                m_dead[c]);
+        }
+    });
+    for (uint32_t c = chunks; c < m_dead.size(); ++c) {
+        m_dead[c].clear();
+    }
+    remove_dead();
+}
+
+void ParticleSystem::simulate_range(uint32_t begin, uint32_t end, float delta_time, std::vector<uint32_t>& dead) {
+    const ParticleSimulationSettings& sim = m_simulation;
+    const Float4 dt = Float4::splat(delta_time);
+    const Float4 gx = Float4::splat(sim.gravity.x * delta_time);
+    const Float4 gy = Float4::splat(sim.gravity.y * delta_time);
+    const Float4 gz = Float4::splat(sim.gravity.z * delta_time);
+    const Float4 damping = Float4::splat(std::max(0.0f, 1.0f - sim.drag * delta_time));
+    const Float4 zero = Float4::zero();
+    const Float4 restitution = Float4::splat(sim.restitution);
+    const Float4 keep_tangent = Float4::splat(1.0f - sim.friction);
+    const Float4 tiny = Float4::splat(1e-12f);
+
+    for (uint32_t i = begin; i < end; i += 4) {
+        Float4 px = Float4::load(&m_px[i]);
+        Float4 py = Float4::load(&m_py[i]);
+        Float4 pz = Float4::load(&m_pz[i]);
+        Float4 vx = Float4::load(&m_vx[i]) + gx;
+        Float4 vy = Float4::load(&m_vy[i]) + gy;
+        Float4 vz = Float4::load(&m_vz[i]) + gz;
+
+        for (const ParticleAttractor& a : sim.attractors) {
+            const Float4 dx = Float4::splat(a.position.x) - px;
+            const Float4 dy = Float4::splat(a.position.y) - py;
+            const Float4 dz = Float4::splat(a.position.z) - pz;
+            const Float4 d2 = dx * dx + dy * dy + dz * dz;
+            // strength / max(d^2, r^2) along the unit direction.
+            const Float4 falloff = Float4::max(d2, Float4::splat(a.radius * a.radius));
+            const Float4 k = Float4::splat(a.strength * delta_time) / (falloff * Float4::sqrt(d2 + tiny));
+            vx = Float4::madd(dx, k, vx);
+            vy = Float4::madd(dy, k, vy);
+            vz = Float4::madd(dz, k, vz);
+        }
+
+        vx *= damping;
+        vy *= damping;
+        vz *= damping;
+        px = Float4::madd(vx, dt, px);
+        py = Float4::madd(vy, dt, py);
+        pz = Float4::madd(vz, dt, pz);
+
+        for (const math::Plane& plane : sim.colliders) {
+            const Float4 nx = Float4::splat(plane.normal.x);
+            const Float4 ny = Float4::splat(plane.normal.y);
+            const Float4 nz = Float4::splat(plane.normal.z);
+            const Float4 dist = Float4::madd(nx, px, Float4::madd(ny, py, Float4::madd(nz, pz, Float4::splat(plane.d))));
+            const Float4 inside = Float4::less(dist, zero);
+            if (!inside.any()) {
+                continue;
+            }
+            // Push back onto the plane; reflect the normal velocity and damp the tangential.
+            px = Float4::select(inside, px - nx * dist, px);
+            py = Float4::select(inside, py - ny * dist, py);
+            pz = Float4::select(inside, pz - nz * dist, pz);
+            const Float4 vn = nx * vx + ny * vy + nz * vz;
+            const Float4 hit = inside & Float4::less(vn, zero);
+            const Float4 rx = (vx - nx * vn) * keep_tangent - nx * vn * restitution;
+            const Float4 ry = (vy - ny * vn) * keep_tangent - ny * vn * restitution;
+            const Float4 rz = (vz - nz * vn) * keep_tangent - nz * vn * restitution;
+            vx = Float4::select(hit, rx, vx);
+            vy = Float4::select(hit, ry, vy);
+            vz = Float4::select(hit, rz, vz);
+        }
+
+        const Float4 life = Float4::load(&m_life[i]) - dt;
+        px.store(&m_px[i]);
+        py.store(&m_py[i]);
+        pz.store(&m_pz[i]);
+        vx.store(&m_vx[i]);
+        vy.store(&m_vy[i]);
+        vz.store(&m_vz[i]);
+        life.store(&m_life[i]);
+
+        int dead_lanes = Float4::less_equal(life, zero).move_mask();
+        if (end - i < 4) {
+            dead_lanes &= (1 << (end - i)) - 1;
+        }
+        while (dead_lanes) {
+            const int lane = std::countr_zero(static_cast<unsigned>(dead_lanes));
+            dead.push_back(i + static_cast<uint32_t>(lane));
+            dead_lanes &= dead_lanes - 1;
+        }
+    }
+}
+
+void ParticleSystem::remove_dead() {
+    // Highest index first: every slot above the one being filled is live or already removed,
+    // so the last particle is always a live one (or the dead one itself).
+    for (size_t c = m_dead.size(); c-- > 0;) {
+        const std::vector<uint32_t>& dead = m_dead[c];
+        for (size_t d = dead.size(); d-- > 0;) {
+            const uint32_t i = dead[d];
+            const uint32_t last = --m_count;
+            if (i == last) {
+                continue;
+            }
+            m_px[i] = m_px[last];
+            m_py[i] = m_py[last];
+            m_pz[i] = m_pz[last];
+            m_vx[i] = m_vx[last];
+            m_vy[i] = m_vy[last];
+            m_vz[i] = m_vz[last];
+            m_life[i] = m_life[last];
+            m_size[i] = m_size[last];
+            m_color[i] = m_color[last];
+        }
+    }
+}
+
+void ParticleSystem::write_billboards(const math::Vec3& right, const math::Vec3& up, DebugVertex* out,
+    JobSystem& jobs) const {
+    const uint32_t chunks = (m_count + kBillboardsPerChunk - 1) / kBillboardsPerChunk;
+    jobs.parallel_for(chunks, 1, [&](uint32_t begin, uint32_t end) {
+        const uint32_t last = std::min(m_count, end * kBillboardsPerChunk);
+        for (uint32_t i = begin * kBillboardsPerChunk; i < last; ++i) {
+            const float half = 0.5f * m_size[i];
+            const math::Vec3 c(m_px[i], m_py[i], m_pz[i]);
+            const math::Vec3 r = right * half;
+            const math::Vec3 u = up * half;
+            const uint32_t color = m_color[i];
+            // Counter-clockwise seen from the side `right x up` points to.
+            const DebugVertex v0{c - r - u, color};
+            const DebugVertex v1{c + r - u, color};
+            const DebugVertex v2{c + r + u, color};
+            const DebugVertex v3{c - r + u, color};
+            DebugVertex* q = out + static_cast<size_t>(i) * 6;
+            q[0] = v0;
+            q[1] = v1;
+            q[2] = v2;
+            q[3] = v0;
+            q[4] = v2;
+            q[5] = v3;
+        }
+    });
+}
+
+ParticleRenderer::ParticleRenderer(GraphicsDevice& device, PipelineHandle pipeline)
+    : m_device(device), m_pipeline(pipeline), m_buffer(device) {}
+
+void ParticleRenderer::render(const ParticleSystem& particles, UniformBufferHandle uniform_buffer,
+    const math::Mat4& view, const math::Mat4& view_projection, JobSystem& jobs) {
+    const uint32_t vertex_count = particles.size() * 6;
+    if (vertex_count == 0) {
+        return;
+    }
+    m_vertices.resize(vertex_count);
+    const math::Vec3 right(view.at(0, 0), view.at(0, 1), view.at(0, 2));
+    const math::Vec3 up(view.at(1, 0), view.at(1, 1), view.at(1, 2));
+    particles.write_billboards(right, up, m_vertices.data(), jobs);
+    const VertexBufferHandle buffer = m_buffer.upload(m_vertices.data(), m_vertices.size() * sizeof(DebugVertex));
+
+    SceneDrawUniforms uniforms{};
+    uniforms.model_matrix = math::Mat4::identity();
+    uniforms.view_projection_matrix = view_projection;
+    m_device.update_uniform_buffer(uniform_buffer, &uniforms, sizeof(SceneDrawUniforms));
+    m_device.bind_pipeline(m_pipeline);
+    m_device.bind_uniform_buffer(uniform_buffer, 1);
+    m_device.bind_vertex_buffer(buffer, 0);
+    m_device.draw(PrimitiveTopology::Triangles, 0, vertex_count);
+}
+
+} // namespace maya
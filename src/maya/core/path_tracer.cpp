@@ -0,0 +1,317 @@
+#include "maya/core/path_tracer.hpp"
+#include "maya/core/camera.hpp"
+#include "maya/core/image_writer.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/vertex_transform.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace maya {
+
+namespace {
+
+/// splitmix64 stream, seeded per pixel and sample.
+class PathRandom {
+public:
+    explicit PathRandom(uint64_t seed) : m_state(seed) {}
+
+    /// Uniform in [0, 1).
+    float unit() {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+/// Cosine-weighted direction around unit `n`.
+math::Vec3 sample_cosine(const math::Vec3& n, float r1, float r2) {
+    const float sign = n.z >= 0.0f ? 1.0f : -1.0f;
+    const float a = -1.0f / (sign + n.z);
+    const float b = n.x * n.y * a;
+    const math::Vec3 tangent(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    const math::Vec3 bitangent(b, sign + n.y * n.y * a, -n.y);
+    const float r = std::sqrt(r1);
+    const float phi = math::TWO_PI * r2;
+    return tangent * (r * std::cos(phi)) + bitangent * (r * std::sin(phi))
+        + n * std::sqrt(std::max(0.0f, 1.0f - r1));
+}
+
+math::Vec3 transform_point(const math::Mat4& m, const math::Vec3& p) {
+    const math::Vec4 h = m * math::Vec4(p.x, p.y, p.z, 1.0f);
+    return math::Vec3(h.x, h.y, h.z) * (1.0f / h.w);
+}
+
+math::Vec3 mul(const math::Vec3& a, const math::Vec3& b) { return {a.x * b.x, a.y * b.y, a.z * b.z}; }
+
+void set_lane(RayPacket4& packet, int lane, const math::Vec3& origin, const math::Vec3& direction, float t_max) {
+    packet.origin[0][lane] = origin.x;
+    packet.origin[1][lane] = origin.y;
+    packet.origin[2][lane] = origin.z;
+    packet.direction[0][lane] = direction.x;
+    packet.direction[1][lane] = direction.y;
+    packet.direction[2][lane] = direction.z;
+    packet.t_min[lane] = 0.0f;
+    packet.t_max[lane] = t_max;
+}
+
+float srgb_encode(float linear) {
+    const float c = std::clamp(linear, 0.0f, 1.0f);
+    return c <= 0.0031308f ? 12.92f * c : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+} // namespace
+
+PathTracer::PathTracer(const PathTracerSettings& settings) : m_settings(settings) {
+    m_settings.tile_size = std::max(2u, (m_settings.tile_size + 1) & ~1u);
+    m_accumulation.assign(static_cast<size_t>(m_settings.width) * m_settings.height * 3, 0.0f);
+}
+
+void PathTracer::set_scene(const Scene& scene) {
+    std::vector<BvhTriangle> triangles;
+    m_shading.clear();
+    std::vector<Vertex> world;
+    uint32_t released = 0;
+    for (const std::vector<SceneObject>* list : {&scene.objects(), &scene.static_objects()}) {
+        for (const SceneObject& obj : *list) {
+            if (!obj.mesh) {
+                continue;
+            }
+            if (!obj.mesh->has_cpu_data()) {
+                ++released;
+                continue;
+            }
+            world = obj.mesh->vertices();
+            transform_vertices(world.data(), world.data(), world.size(), obj.model_matrix,
+                obj.model_matrix.normal_matrix());
+            const std::vector<uint32_t>& indices = obj.mesh->indices();
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                const Vertex* v[3] = {&world[indices[i]], &world[indices[i + 1]], &world[indices[i + 2]]};
+                triangles.push_back(BvhTriangle{v[0]->position, v[1]->position, v[2]->position,
+                    static_cast<uint32_t>(m_shading.size())});
+                TriangleShading shading;
+                for (int k = 0; k < 3; ++k) {
+                    shading.normals[k] = v[k]->normal;
+                    shading.colors[k] = math::Vec3(v[k]->color.x, v[k]->color.y, v[k]->color.z);
+                }
+                m_shading.push_back(shading);
+            }
+        }
+    }
+    if (released > 0) {
+        std::cerr << "PathTracer::set_scene: skipped " << released
+                  << " object(s) whose mesh CPU data was released\n";
+    }
+    m_bvh.build(std::move(triangles));
+    reset();
+}
+
+void PathTracer::reset() {
+    std::fill(m_accumulation.begin(), m_accumulation.end(), 0.0f);
+    m_samples = 0;
+}
+
+void PathTracer::render_sample(const Camera& camera, const DirectionalLighting& lighting, JobSystem& jobs) {
+    render_sample(camera.get_inverse_view_projection_matrix(), camera.get_position(), lighting, jobs);
+}
+
+void PathTracer::render_sample(const math::Mat4& inverse_view_projection, const math::Vec3& camera_position,
+    const DirectionalLighting& lighting, JobSystem& jobs) {
+    const uint32_t tile = m_settings.tile_size;
+    const uint32_t tiles_x = (m_settings.width + tile - 1) / tile;
+    const uint32_t tiles_y = (m_settings.height + tile - 1) / tile;
+    jobs.parallel_for(tiles_x * tiles_y, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t t = begin; t < end; ++t) {
+            trace_tile(t, inverse_view_projection, camera_position, lighting);
+        }
+    });
+    ++m_samples;
+}
+
+void PathTracer::trace_tile(uint32_t tile, const math::Mat4& inverse_view_projection,
+    const math::Vec3& camera_position, const DirectionalLighting& lighting) {
+    const uint32_t size = m_settings.tile_size;
+    const uint32_t tiles_x = (m_settings.width + size - 1) / size;
+    const uint32_t x0 = (tile % tiles_x) * size;
+    const uint32_t y0 = (tile / tiles_x) * size;
+    const uint32_t x1 = std::min(x0 + size, m_settings.width);
+    const uint32_t y1 = std::min(y0 + size, m_settings.height);
+    const math::Vec3 to_light = lighting.direction_to_light.normalized();
+    const float inv_width = 1.0f / static_cast<float>(m_settings.width);
+    const float inv_height = 1.0f / static_cast<float>(m_settings.height);
+
+    for (uint32_t qy = y0; qy < y1; qy += 2) {
+        for (uint32_t qx = x0; qx < x1; qx += 2) {
+            // One 2x2 quad of pixels per packet; lanes past the image edge start inactive.
+            uint32_t pixels[4];
+            bool in_image[4];
+            bool active[4];
+            PathRandom rng[4] = {PathRandom(0), PathRandom(0), PathRandom(0), PathRandom(0)};
+            math::Vec3 throughput[4];
+            math::Vec3 radiance[4];
+            RayPacket4 rays;
+            for (int lane = 0; lane < 4; ++lane) {
+                const uint32_t px = qx + static_cast<uint32_t>(lane & 1);
+                const uint32_t py = qy + static_cast<uint32_t>(lane >> 1);
+                in_image[lane] = px < x1 && py < y1;
+                active[lane] = in_image[lane];
+                pixels[lane] = py * m_settings.width + px;
+                set_lane(rays, lane, camera_position, math::Vec3(0, 0, 1), -1.0f);
+                if (!active[lane]) {
+                    continue;
+                }
+                rng[lane] = PathRandom((static_cast<uint64_t>(m_settings.seed) << 48)
+                    ^ (static_cast<uint64_t>(m_samples) << 32) ^ pixels[lane]);
+                throughput[lane] = math::Vec3(1.0f);
+                // Jittered NDC position; y points up and rows run down.
+                const float ndc_x = 2.0f * (static_cast<float>(px) + rng[lane].unit()) * inv_width - 1.0f;
+                const float ndc_y = 1.0f - 2.0f * (static_cast<float>(py) + rng[lane].unit()) * inv_height;
+                const math::Vec3 near_point = transform_point(inverse_view_projection, math::Vec3(ndc_x, ndc_y, 0.0f));
+                const math::Vec3 far_point = transform_point(inverse_view_projection, math::Vec3(ndc_x, ndc_y, 1.0f));
+                set_lane(rays, lane, camera_position, (far_point - near_point).normalized(),
+                    std::numeric_limits<float>::max());
+            }
+
+            for (uint32_t depth = 0; depth <= m_settings.max_bounces; ++depth) {
+                RayHit hits[4];
+                const uint32_t hit_mask = m_bvh.intersect4(rays, hits);
+                RayPacket4 shadows;
+                math::Vec3 direct[4];
+                math::Vec3 hit_points[4];
+                math::Vec3 normals[4];
+                math::Vec3 offsets[4];
+                for (int lane = 0; lane < 4; ++lane) {
+                    set_lane(shadows, lane, math::Vec3(0.0f), to_light, -1.0f);
+                    if (!active[lane]) {
+                        continue;
+                    }
+                    const math::Vec3 direction(rays.direction[0][lane], rays.direction[1][lane], rays.direction[2][lane]);
+                    if (!(hit_mask & (1u << lane))) {
+                        // Escaped: the ambient SH is the environment.
+                        const math::Vec3 sky = lighting.ambient.evaluate(direction);
+                        radiance[lane] += mul(throughput[lane],
+                            math::Vec3(std::max(sky.x, 0.0f), std::max(sky.y, 0.0f), std::max(sky.z, 0.0f)));
+                        active[lane] = false;
+                        rays.t_max[lane] = -1.0f;
+                        continue;
+                    }
+                    if (depth == m_settings.max_bounces) {
+                        active[lane] = false;
+                        rays.t_max[lane] = -1.0f;
+                        continue;
+                    }
+
+                    const BvhTriangle& tri = m_bvh.triangles()[hits[lane].triangle];
+                    const TriangleShading& shading = m_shading[tri.id];
+                    const float u = hits[lane].u;
+                    const float v = hits[lane].v;
+                    const float w = 1.0f - u - v;
+                    math::Vec3 geometric = math::Vec3::cross(tri.v1 - tri.v0, tri.v2 - tri.v0).normalized();
+                    if (math::Vec3::dot(geometric, direction) > 0.0f) {
+                        geometric = geometric * -1.0f;
+                    }
+                    math::Vec3 n = (shading.normals[0] * w + shading.normals[1] * u + shading.normals[2] * v);
+                    n = n.length() > 1e-6f ? n.normalized() : geometric;
+                    if (math::Vec3::dot(n, geometric) < 0.0f) {
+                        n = n * -1.0f;
+                    }
+                    const math::Vec3 albedo = shading.colors[0] * w + shading.colors[1] * u + shading.colors[2] * v;
+
+                    const math::Vec3 p(rays.origin[0][lane] + direction.x * hits[lane].t,
+                        rays.origin[1][lane] + direction.y * hits[lane].t,
+                        rays.origin[2][lane] + direction.z * hits[lane].t);
+                    const float scale = std::max({1.0f, std::fabs(p.x), std::fabs(p.y), std::fabs(p.z)});
+                    hit_points[lane] = p;
+                    normals[lane] = n;
+                    offsets[lane] = geometric * (1e-4f * scale);
+                    throughput[lane] = mul(throughput[lane], albedo);
+
+                    // Sun, matching the rasterizer's `ndotl * light_diffuse * albedo` term.
+                    const float ndotl = math::Vec3::dot(n, to_light);
+                    if (ndotl > 0.0f && math::Vec3::dot(geometric, to_light) > 0.0f) {
+                        direct[lane] = mul(throughput[lane], lighting.diffuse) * ndotl;
+                        set_lane(shadows, lane, p + offsets[lane], to_light, std::numeric_limits<float>::max());
+                    }
+                }
+                const uint32_t shadowed = m_bvh.occluded4(shadows);
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (!active[lane]) {
+                        continue;
+                    }
+                    if (shadows.t_max[lane] >= 0.0f && !(shadowed & (1u << lane))) {
+                        radiance[lane] += direct[lane];
+                    }
+                    // Lambertian bounce: cosine sampling cancels the cosine and 1/pi of the BRDF.
+                    const float r1 = rng[lane].unit();
+                    const float r2 = rng[lane].unit();
+                    set_lane(rays, lane, hit_points[lane] + offsets[lane], sample_cosine(normals[lane], r1, r2),
+                        std::numeric_limits<float>::max());
+                }
+            }
+
+            for (int lane = 0; lane < 4; ++lane) {
+                if (!in_image[lane]) {
+                    continue;
+                }
+                float* out = &m_accumulation[static_cast<size_t>(pixels[lane]) * 3];
+                out[0] += radiance[lane].x;
+                out[1] += radiance[lane].y;
+                out[2] += radiance[lane].z;
+            }
+        }
+    }
+}
+
+math::Vec3 PathTracer::pixel(uint32_t x, uint32_t y) const {
+    if (m_samples == 0) {
+        return math::Vec3(0.0f);
+    }
+    const float* sum = &m_accumulation[(static_cast<size_t>(y) * m_settings.width + x) * 3];
+    const float inv = 1.0f / static_cast<float>(m_samples);
+    return math::Vec3(sum[0] * inv, sum[1] * inv, sum[2] * inv);
+}
+
+HdrImageData PathTracer::image() const {
+    HdrImageData image;
+    image.width = m_settings.width;
+    image.height = m_settings.height;
+    image.pixels.resize(m_accumulation.size());
+    const float inv = m_samples > 0 ? 1.0f / static_cast<float>(m_samples) : 0.0f;
+    for (size_t i = 0; i < m_accumulation.size(); ++i) {
+        image.pixels[i] = m_accumulation[i] * inv;
+    }
+    return image;
+}
+
+ImageData PathTracer::image_srgb() const {
+    const HdrImageData linear = image();
+    ImageData image;
+    image.width = linear.width;
+    image.height = linear.height;
+    image.pixels.resize(static_cast<size_t>(linear.width) * linear.height * 4);
+    for (size_t p = 0; p < static_cast<size_t>(linear.width) * linear.height; ++p) {
+        for (int c = 0; c < 3; ++c) {
+            image.pixels[p * 4 + c] = static_cast<uint8_t>(srgb_encode(linear.pixels[p * 3 + c]) * 255.0f + 0.5f);
+        }
+        image.pixels[p * 4 + 3] = 255;
+    }
+    return image;
+}
+
+bool PathTracer::write_png(const std::string& path) const {
+    return ImageWriter::write_png(path, image_srgb());
+}
+
+bool PathTracer::write_exr(const std::string& path) const {
+    return ImageWriter::write_exr(path, image());
+}
+
+} // namespace maya
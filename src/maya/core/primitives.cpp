@@ -1,47 +1,313 @@
 #include "maya/core/primitives.hpp"
+#include "maya/core/mesh_optimizer.hpp"
+#include "maya/math/math_utils.hpp"
 #include "maya/rhi/vertex.hpp"
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace maya {
 
+namespace {
+
+using math::Vec2;
+using math::Vec3;
+using math::Vec4;
+
+/// Unit direction in the xz plane for column `i` of `segments`; column `segments` wraps to 0
+/// exactly so seam vertices share positions. Increasing `i` runs left to right seen from outside.
+Vec3 ring_direction(uint32_t i, uint32_t segments) {
+    if (i % segments == 0) {
+        return Vec3(1.0f, 0.0f, 0.0f);
+    }
+    const float angle = math::TWO_PI * static_cast<float>(i) / static_cast<float>(segments);
+    return Vec3(std::cos(angle), 0.0f, -std::sin(angle));
+}
+
+/// Adds triangle (a, b, c), wound CCW around the side its vertex normals face. Triangles
+/// collapsed to a line (at poles and apexes) are dropped.
+void add_triangle(MeshData& mesh, uint32_t a, uint32_t b, uint32_t c) {
+    const Vertex& va = mesh.vertices[a];
+    const Vertex& vb = mesh.vertices[b];
+    const Vertex& vc = mesh.vertices[c];
+    const Vec3 face = Vec3::cross(vb.position - va.position, vc.position - va.position);
+    if (face.length_squared() == 0.0f) {
+        return;
+    }
+    if (Vec3::dot(face, va.normal + vb.normal + vc.normal) < 0.0f) {
+        std::swap(b, c);
+    }
+    mesh.indices.insert(mesh.indices.end(), {a, b, c});
+}
+
+/// Appends `(columns + 1) * (rows + 1)` vertices from `vertex(column, row)` and triangulates
+/// the quads between them.
+template <typename VertexFn>
+void add_lattice(MeshData& mesh, uint32_t columns, uint32_t rows, VertexFn&& vertex) {
+    const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+    for (uint32_t row = 0; row <= rows; ++row) {
+        for (uint32_t column = 0; column <= columns; ++column) {
+            mesh.vertices.push_back(vertex(column, row));
+        }
+    }
+    const uint32_t stride = columns + 1;
+    for (uint32_t row = 0; row < rows; ++row) {
+        for (uint32_t column = 0; column < columns; ++column) {
+            const uint32_t a = base + row * stride + column;
+            add_triangle(mesh, a, a + stride, a + 1);
+            add_triangle(mesh, a + 1, a + stride, a + stride + 1);
+        }
+    }
+}
+
+/// Flat disk of `radius` at height `y` facing `normal_y` (+1 or -1), with planar UVs.
+void add_disk(MeshData& mesh, float radius, float y, float normal_y, uint32_t segments, const Vec4& color) {
+    const Vec3 normal(0.0f, normal_y, 0.0f);
+    const uint32_t center = static_cast<uint32_t>(mesh.vertices.size());
+    mesh.vertices.emplace_back(Vec3(0.0f, y, 0.0f), normal, color, Vec2(0.5f, 0.5f));
+    for (uint32_t i = 0; i < segments; ++i) {
+        const Vec3 d = ring_direction(i, segments);
+        mesh.vertices.emplace_back(Vec3(d.x * radius, y, d.z * radius), normal, color,
+            Vec2(0.5f + 0.5f * d.x, 0.5f - 0.5f * d.z * normal_y));
+    }
+    for (uint32_t i = 0; i < segments; ++i) {
+        add_triangle(mesh, center, center + 1 + i, center + 1 + (i + 1) % segments);
+    }
+}
+
+/// Vertex-cache and fetch ordering shared by every generator.
+MeshData finish(MeshData mesh) {
+    optimize_vertex_cache(mesh.indices, static_cast<uint32_t>(mesh.vertices.size()));
+    optimize_vertex_fetch(mesh);
+    return mesh;
+}
+
+} // namespace
+
 std::unique_ptr<Mesh> make_color_cube(GraphicsDevice& device, float half_extent,
     const math::Vec3& color_tint) {
     const float h = half_extent;
-    const std::array<math::Vec3, 8> pos = {{
-        {-h, -h, -h},
-        {h, -h, -h},
-        {h, h, -h},
-        {-h, h, -h},
-        {-h, -h, h},
-        {h, -h, h},
-        {h, h, h},
-        {-h, h, h},
-    }};
-
-    std::vector<Vertex> vertices;
-    vertices.reserve(8);
-    for (const auto& p : pos) {
-        math::Vec3 n = math::Vec3(p.x, p.y, p.z).normalized();
+    MeshData data = generate_box(Vec3(h, h, h));
+    for (Vertex& v : data.vertices) {
+        const Vec3& p = v.position;
         const float r = color_tint.x * (0.35f + 0.65f * std::fabs(p.x / h));
         const float g = color_tint.y * (0.35f + 0.65f * std::fabs(p.y / h));
         const float b = color_tint.z * (0.35f + 0.65f * std::fabs(p.z / h));
-        vertices.emplace_back(p, n, math::Vec4(r, g, b, 1.0f), math::Vec2(0.0f, 0.0f));
+        v.color = Vec4(r, g, b, 1.0f);
     }
+    return make_mesh(device, data);
+}
+
+MeshData generate_plane(float size_x, float size_z, uint32_t segments_x, uint32_t segments_z, const Vec4& color) {
+    segments_x = std::max(segments_x, 1u);
+    segments_z = std::max(segments_z, 1u);
+    MeshData mesh;
+    add_lattice(mesh, segments_x, segments_z, [&](uint32_t column, uint32_t row) {
+        const float u = static_cast<float>(column) / static_cast<float>(segments_x);
+        const float v = static_cast<float>(row) / static_cast<float>(segments_z);
+        return Vertex(Vec3((u - 0.5f) * size_x, 0.0f, (v - 0.5f) * size_z), Vec3(0.0f, 1.0f, 0.0f), color, Vec2(u, v));
+    });
+    return finish(std::move(mesh));
+}
 
-    // CCW faces as seen from outside (matches back-face cull + CCW front face).
-    const std::array<uint32_t, 36> indices = {{
-        0, 3, 1, 1, 3, 2,
-        4, 5, 6, 4, 6, 7,
-        0, 4, 3, 3, 4, 7,
-        1, 2, 5, 5, 2, 6,
-        0, 1, 4, 1, 5, 4,
-        3, 7, 2, 2, 7, 6,
+MeshData generate_box(const Vec3& half_extents, uint32_t segments, const Vec4& color) {
+    segments = std::max(segments, 1u);
+    struct Face {
+        Vec3 normal;
+        Vec3 right;
+        Vec3 up;
+    };
+    // Each face seen from outside: `right` is +u, `up` is -v.
+    const std::array<Face, 6> faces = {{
+        {{1, 0, 0}, {0, 0, -1}, {0, 1, 0}},
+        {{-1, 0, 0}, {0, 0, 1}, {0, 1, 0}},
+        {{0, 1, 0}, {1, 0, 0}, {0, 0, -1}},
+        {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}},
+        {{0, 0, 1}, {1, 0, 0}, {0, 1, 0}},
+        {{0, 0, -1}, {-1, 0, 0}, {0, 1, 0}},
     }};
+    auto scale = [&](const Vec3& d) { return Vec3(d.x * half_extents.x, d.y * half_extents.y, d.z * half_extents.z); };
+
+    MeshData mesh;
+    for (const Face& face : faces) {
+        add_lattice(mesh, segments, segments, [&](uint32_t column, uint32_t row) {
+            const float u = static_cast<float>(column) / static_cast<float>(segments);
+            const float v = static_cast<float>(row) / static_cast<float>(segments);
+            const Vec3 p = face.normal + face.right * (2.0f * u - 1.0f) + face.up * (1.0f - 2.0f * v);
+            return Vertex(scale(p), face.normal, color, Vec2(u, v));
+        });
+    }
+    return finish(std::move(mesh));
+}
+
+MeshData generate_uv_sphere(float radius, uint32_t segments, uint32_t rings, const Vec4& color) {
+    segments = std::max(segments, 3u);
+    rings = std::max(rings, 2u);
+    MeshData mesh;
+    add_lattice(mesh, segments, rings, [&](uint32_t column, uint32_t row) {
+        const float v = static_cast<float>(row) / static_cast<float>(rings);
+        const bool pole = row == 0 || row == rings;
+        const float ring = pole ? 0.0f : std::sin(math::PI * v);
+        const Vec3 d = ring_direction(column, segments);
+        const Vec3 n(d.x * ring, pole ? (row == 0 ? 1.0f : -1.0f) : std::cos(math::PI * v), d.z * ring);
+        // Pole vertices take the middle of their column's texel span.
+        const float u = (static_cast<float>(column) + (pole ? 0.5f : 0.0f)) / static_cast<float>(segments);
+        return Vertex(n * radius, n, color, Vec2(u, v));
+    });
+    return finish(std::move(mesh));
+}
+
+MeshData generate_icosphere(float radius, uint32_t subdivisions, const Vec4& color) {
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    std::vector<Vec3> positions = {{-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0}, {0, -1, t}, {0, 1, t},
+        {0, -1, -t}, {0, 1, -t}, {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}};
+    for (Vec3& p : positions) {
+        p = p.normalized();
+    }
+    std::vector<uint32_t> triangles = {0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2,
+        10, 7, 6, 7, 1, 8, 3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1};
+
+    for (uint32_t level = 0; level < subdivisions; ++level) {
+        std::unordered_map<uint64_t, uint32_t> midpoints;
+        auto midpoint = [&](uint32_t a, uint32_t b) {
+            const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            auto [it, inserted] = midpoints.emplace(key, static_cast<uint32_t>(positions.size()));
+            if (inserted) {
+                positions.push_back(((positions[a] + positions[b]) * 0.5f).normalized());
+            }
+            return it->second;
+        };
+        std::vector<uint32_t> split;
+        split.reserve(triangles.size() * 4);
+        for (size_t i = 0; i < triangles.size(); i += 3) {
+            const uint32_t a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+            const uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            split.insert(split.end(), {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca});
+        }
+        triangles = std::move(split);
+    }
+
+    MeshData mesh;
+    mesh.vertices.reserve(positions.size() + positions.size() / 8);
+    for (const Vec3& n : positions) {
+        float u = std::atan2(-n.z, n.x) / math::TWO_PI;
+        u = u < 0.0f ? u + 1.0f : u;
+        const float v = std::acos(std::clamp(n.y, -1.0f, 1.0f)) / math::PI;
+        mesh.vertices.emplace_back(n * radius, n, color, Vec2(u, v));
+    }
+    // Triangles straddling the seam get copies of their low-u vertices shifted by one.
+    std::unordered_map<uint32_t, uint32_t> seam_copies;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        uint32_t* tri = &triangles[i];
+        const float u0 = mesh.vertices[tri[0]].uv.x, u1 = mesh.vertices[tri[1]].uv.x, u2 = mesh.vertices[tri[2]].uv.x;
+        if (std::max({u0, u1, u2}) - std::min({u0, u1, u2}) <= 0.5f) {
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            if (mesh.vertices[tri[k]].uv.x < 0.5f) {
+                auto [it, inserted] = seam_copies.emplace(tri[k], static_cast<uint32_t>(mesh.vertices.size()));
+                if (inserted) {
+                    Vertex copy = mesh.vertices[tri[k]];
+                    copy.uv.x += 1.0f;
+                    mesh.vertices.push_back(copy);
+                }
+                tri[k] = it->second;
+            }
+        }
+    }
+    mesh.indices.reserve(triangles.size());
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        add_triangle(mesh, triangles[i], triangles[i + 1], triangles[i + 2]);
+    }
+    return finish(std::move(mesh));
+}
+
+MeshData generate_cylinder(float radius, float height, uint32_t segments, uint32_t stacks, bool caps,
+    const Vec4& color) {
+    segments = std::max(segments, 3u);
+    stacks = std::max(stacks, 1u);
+    const float half = height * 0.5f;
+    MeshData mesh;
+    add_lattice(mesh, segments, stacks, [&](uint32_t column, uint32_t row) {
+        const float u = static_cast<float>(column) / static_cast<float>(segments);
+        const float v = static_cast<float>(row) / static_cast<float>(stacks);
+        const Vec3 d = ring_direction(column, segments);
+        return Vertex(Vec3(d.x * radius, half - height * v, d.z * radius), d, color, Vec2(u, v));
+    });
+    if (caps) {
+        add_disk(mesh, radius, half, 1.0f, segments, color);
+        add_disk(mesh, radius, -half, -1.0f, segments, color);
+    }
+    return finish(std::move(mesh));
+}
+
+MeshData generate_cone(float radius, float height, uint32_t segments, uint32_t stacks, bool cap, const Vec4& color) {
+    segments = std::max(segments, 3u);
+    stacks = std::max(stacks, 1u);
+    const float half = height * 0.5f;
+    // The slant normal tilts up by atan(radius / height).
+    const float normal_xz = height / std::sqrt(height * height + radius * radius);
+    const float normal_y = radius / std::sqrt(height * height + radius * radius);
+    MeshData mesh;
+    add_lattice(mesh, segments, stacks, [&](uint32_t column, uint32_t row) {
+        const float u = static_cast<float>(column) / static_cast<float>(segments);
+        const float v = static_cast<float>(row) / static_cast<float>(stacks);
+        const Vec3 d = ring_direction(column, segments);
+        const float ring = radius * v;
+        return Vertex(Vec3(d.x * ring, half - height * v, d.z * ring),
+            Vec3(d.x * normal_xz, normal_y, d.z * normal_xz), color, Vec2(u, v));
+    });
+    if (cap) {
+        add_disk(mesh, radius, -half, -1.0f, segments, color);
+    }
+    return finish(std::move(mesh));
+}
+
+MeshData generate_torus(float major_radius, float minor_radius, uint32_t segments, uint32_t sides, const Vec4& color) {
+    segments = std::max(segments, 3u);
+    sides = std::max(sides, 3u);
+    MeshData mesh;
+    add_lattice(mesh, segments, sides, [&](uint32_t column, uint32_t row) {
+        const float u = static_cast<float>(column) / static_cast<float>(segments);
+        const float v = static_cast<float>(row) / static_cast<float>(sides);
+        const Vec3 d = ring_direction(column, segments);
+        // Row 0 is the top of the tube; rows run outward, down, inward and back up.
+        const float theta = math::HALF_PI - math::TWO_PI * v;
+        const Vec3 n = d * std::cos(theta) + Vec3(0.0f, std::sin(theta), 0.0f);
+        return Vertex(d * major_radius + n * minor_radius, n, color, Vec2(u, v));
+    });
+    return finish(std::move(mesh));
+}
+
+MeshData generate_capsule(float radius, float height, uint32_t segments, uint32_t rings, const Vec4& color) {
+    segments = std::max(segments, 3u);
+    rings = std::max(rings, 1u);
+    const float half = height * 0.5f;
+    // Rows 0..rings cover the top hemisphere, rings+1..2*rings+1 the bottom one; the rows
+    // between them bound the cylinder. `v` follows the arc length of the profile.
+    const uint32_t rows = 2 * rings + 1;
+    const float length = math::PI * radius + height;
+    MeshData mesh;
+    add_lattice(mesh, segments, rows, [&](uint32_t column, uint32_t row) {
+        const bool top = row <= rings;
+        const float step = static_cast<float>(top ? row : row - 1) / static_cast<float>(rings);
+        const float theta = math::HALF_PI * step;
+        const bool pole = row == 0 || row == rows;
+        const float ring = pole ? 0.0f : std::sin(theta);
+        const Vec3 d = ring_direction(column, segments);
+        const Vec3 n(d.x * ring, pole ? (top ? 1.0f : -1.0f) : std::cos(theta), d.z * ring);
+        const float arc = radius * theta + (top ? 0.0f : height);
+        const float u = (static_cast<float>(column) + (pole ? 0.5f : 0.0f)) / static_cast<float>(segments);
+        return Vertex(n * radius + Vec3(0.0f, top ? half : -half, 0.0f), n, color, Vec2(u, arc / length));
+    });
+    return finish(std::move(mesh));
+}
 
-    return std::make_unique<Mesh>(device, vertices,
-        std::vector<uint32_t>(indices.begin(), indices.end()));
+std::unique_ptr<Mesh> make_mesh(GraphicsDevice& device, const MeshData& data) {
+    return std::make_unique<Mesh>(device, data.vertices, data.indices);
 }
 
 } // namespace maya
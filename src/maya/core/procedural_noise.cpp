@@ -0,0 +1,215 @@
+#include "maya/core/procedural_noise.hpp"
+#include "maya/core/job_system.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace maya {
+
+namespace {
+
+using math::simd::Float4;
+
+/// Grid rows per fill job.
+constexpr uint32_t kRowsPerChunk = 4;
+/// Vertices per displacement job.
+constexpr uint32_t kVerticesPerChunk = 1024;
+
+template <typename T>
+T sample(const math::noise::Fractal& fractal, NoiseVariant variant, const T& x, const T& y) {
+    switch (variant) {
+    case NoiseVariant::Ridged:
+        return math::noise::ridged(fractal, x, y);
+    case NoiseVariant::Warped:
+        return math::noise::warped(fractal, x, y);
+    default:
+        return math::noise::fbm(fractal, x, y);
+    }
+}
+
+template <typename T>
+T sample(const math::noise::Fractal& fractal, NoiseVariant variant, const T& x, const T& y, const T& z) {
+    switch (variant) {
+    case NoiseVariant::Ridged:
+        return math::noise::ridged(fractal, x, y, z);
+    case NoiseVariant::Warped:
+        return math::noise::warped(fractal, x, y, z);
+    default:
+        return math::noise::fbm(fractal, x, y, z);
+    }
+}
+
+/// Bit pattern of a position, for welding split vertices.
+struct PositionKey {
+    uint32_t bits[3];
+    bool operator==(const PositionKey& o) const { return std::memcmp(bits, o.bits, sizeof(bits)) == 0; }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& k) const {
+        return (k.bits[0] * 73856093u) ^ (k.bits[1] * 19349663u) ^ (k.bits[2] * 83492791u);
+    }
+};
+
+PositionKey position_key(const math::Vec3& p) {
+    PositionKey key;
+    // Adding 0 folds -0 into +0.
+    const float coords[3] = {p.x + 0.0f, p.y + 0.0f, p.z + 0.0f};
+    std::memcpy(key.bits, coords, sizeof(key.bits));
+    return key;
+}
+
+} // namespace
+
+void evaluate_noise(const NoiseSettings& settings, const float* x, const float* y, const float* z, float* out,
+    size_t count) {
+    math::noise::Fractal fractal = settings.fractal;
+    NoiseVariant variant = settings.variant;
+    if (variant == NoiseVariant::Single) {
+        fractal.octaves = 1;
+        variant = NoiseVariant::Fbm;
+    }
+    const math::Vec3& o = settings.offset;
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const Float4 x0 = Float4::load(x + i) + o.x;
+        const Float4 x1 = Float4::load(x + i + 4) + o.x;
+        const Float4 y0 = Float4::load(y + i) + o.y;
+        const Float4 y1 = Float4::load(y + i + 4) + o.y;
+        if (z) {
+            const Float4 z0 = Float4::load(z + i) + o.z;
+            const Float4 z1 = Float4::load(z + i + 4) + o.z;
+            sample(fractal, variant, x0, y0, z0).store(out + i);
+            sample(fractal, variant, x1, y1, z1).store(out + i + 4);
+        } else {
+            sample(fractal, variant, x0, y0).store(out + i);
+            sample(fractal, variant, x1, y1).store(out + i + 4);
+        }
+    }
+    for (; i < count; ++i) {
+        out[i] = z ? sample(fractal, variant, x[i] + o.x, y[i] + o.y, z[i] + o.z)
+                   : sample(fractal, variant, x[i] + o.x, y[i] + o.y);
+    }
+}
+
+void fill_noise_grid(const NoiseSettings& settings, uint32_t width, uint32_t height, const math::Vec2& origin,
+    float step, std::vector<float>& out, JobSystem& jobs) {
+    out.resize(static_cast<size_t>(width) * height);
+    std::vector<float> xs(width);
+    for (uint32_t x = 0; x < width; ++x) {
+        xs[x] = origin.x + static_cast<float>(x) * step;
+    }
+    jobs.parallel_for(height, kRowsPerChunk, [&](uint32_t begin, uint32_t end) {
+        std::vector<float> ys(width);
+        for (uint32_t row = begin; row < end; ++row) {
+            std::fill(ys.begin(), ys.end(), origin.y + static_cast<float>(row) * step);
+            evaluate_noise(settings, xs.data(), ys.data(), nullptr, out.data() + static_cast<size_t>(row) * width,
+                width);
+        }
+    });
+}
+
+void fill_noise_volume(const NoiseSettings& settings, uint32_t width, uint32_t height, uint32_t depth,
+    const math::Vec3& origin, float step, std::vector<float>& out, JobSystem& jobs) {
+    out.resize(static_cast<size_t>(width) * height * depth);
+    std::vector<float> xs(width);
+    for (uint32_t x = 0; x < width; ++x) {
+        xs[x] = origin.x + static_cast<float>(x) * step;
+    }
+    jobs.parallel_for(height * depth, kRowsPerChunk, [&](uint32_t begin, uint32_t end) {
+        std::vector<float> ys(width);
+        std::vector<float> zs(width);
+        for (uint32_t row = begin; row < end; ++row) {
+            std::fill(ys.begin(), ys.end(), origin.y + static_cast<float>(row % height) * step);
+            std::fill(zs.begin(), zs.end(), origin.z + static_cast<float>(row / height) * step);
+            evaluate_noise(settings, xs.data(), ys.data(), zs.data(), out.data() + static_cast<size_t>(row) * width,
+                width);
+        }
+    });
+}
+
+HeightImageData make_noise_heightmap(const NoiseSettings& settings, uint32_t width, uint32_t height,
+    JobSystem& jobs) {
+    std::vector<float> values;
+    fill_noise_grid(settings, width, height, math::Vec2(0.0f, 0.0f), 1.0f, values, jobs);
+    HeightImageData image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        const float t = std::clamp(values[i] * 0.5f + 0.5f, 0.0f, 1.0f);
+        image.pixels[i] = static_cast<uint16_t>(t * 65535.0f + 0.5f);
+    }
+    return image;
+}
+
+ImageData make_noise_texture(const NoiseSettings& settings, uint32_t width, uint32_t height,
+    const math::Vec4& low, const math::Vec4& high, JobSystem& jobs) {
+    std::vector<float> values;
+    fill_noise_grid(settings, width, height, math::Vec2(0.0f, 0.0f), 1.0f, values, jobs);
+    ImageData image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(values.size() * 4);
+    for (size_t i = 0; i < values.size(); ++i) {
+        const float t = std::clamp(values[i] * 0.5f + 0.5f, 0.0f, 1.0f);
+        const float channels[4] = {low.x + (high.x - low.x) * t, low.y + (high.y - low.y) * t,
+            low.z + (high.z - low.z) * t, 1.0f};
+        for (int c = 0; c < 4; ++c) {
+            image.pixels[i * 4 + static_cast<size_t>(c)] =
+                static_cast<uint8_t>(std::clamp(channels[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+    return image;
+}
+
+void displace_mesh(MeshData& mesh, const NoiseSettings& settings, float amplitude, JobSystem& jobs) {
+    std::vector<Vertex>& vertices = mesh.vertices;
+    const uint32_t count = static_cast<uint32_t>(vertices.size());
+    jobs.parallel_for(count, kVerticesPerChunk, [&](uint32_t begin, uint32_t end) {
+        const size_t n = end - begin;
+        std::vector<float> coords(n * 4);
+        float* xs = coords.data();
+        float* ys = xs + n;
+        float* zs = ys + n;
+        float* values = zs + n;
+        for (size_t i = 0; i < n; ++i) {
+            const math::Vec3& p = vertices[begin + i].position;
+            xs[i] = p.x;
+            ys[i] = p.y;
+            zs[i] = p.z;
+        }
+        evaluate_noise(settings, xs, ys, zs, values, n);
+        for (size_t i = 0; i < n; ++i) {
+            Vertex& v = vertices[begin + i];
+            v.position += v.normal * (values[i] * amplitude);
+        }
+    });
+
+    // Area-weighted normals (unnormalized cross products), shared by coincident vertices.
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> welds;
+    std::vector<uint32_t> group(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        group[i] = welds.emplace(position_key(vertices[i].position), static_cast<uint32_t>(welds.size())).first->second;
+    }
+    std::vector<math::Vec3> normals(welds.size());
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const uint32_t a = mesh.indices[t];
+        const uint32_t b = mesh.indices[t + 1];
+        const uint32_t c = mesh.indices[t + 2];
+        const math::Vec3 face = math::Vec3::cross(vertices[b].position - vertices[a].position,
+            vertices[c].position - vertices[a].position);
+        normals[group[a]] += face;
+        normals[group[b]] += face;
+        normals[group[c]] += face;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const math::Vec3& n = normals[group[i]];
+        if (vertices[i].normal.length_squared() > 0.0f && n.length_squared() > 0.0f) {
+            vertices[i].normal = n.normalized();
+        }
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,360 @@
+#include "maya/core/pvs.hpp"
+#include "maya/core/bvh.hpp"
+#include "maya/core/file_system.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace maya {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'P', 'V', 'S'};
+constexpr uint32_t kVersion = 1;
+
+/// Small counter-based generator so bakes match across platforms and standard libraries.
+class BakeRandom {
+public:
+    explicit BakeRandom(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next() {
+        // splitmix64
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform in [0, 1).
+    float unit() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+
+    math::Vec3 in_box(const math::Aabb& box) {
+        const float x = unit();
+        const float y = unit();
+        const float z = unit();
+        return {box.min.x + (box.max.x - box.min.x) * x, box.min.y + (box.max.y - box.min.y) * y,
+                box.min.z + (box.max.z - box.min.z) * z};
+    }
+
+    math::Vec3 direction() {
+        const float z = 2.0f * unit() - 1.0f;
+        const float phi = 6.28318530718f * unit();
+        const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+        return {r * std::cos(phi), r * std::sin(phi), z};
+    }
+
+private:
+    uint64_t m_state;
+};
+
+/// Triangle range of one object in the bake's source list.
+struct BakeObject {
+    uint32_t first = 0;
+    uint32_t count = 0;
+    math::Aabb bounds;
+    /// No geometry to test (CPU copy released); marked visible from every cell.
+    bool unknown = false;
+};
+
+math::Vec3 sample_surface(const std::vector<BvhTriangle>& triangles, const std::vector<float>& area_prefix,
+    const BakeObject& object, BakeRandom& rng) {
+    const float* begin = area_prefix.data() + object.first;
+    const float total = begin[object.count - 1];
+    uint32_t index = 0;
+    if (total > 0.0f) {
+        const float pick = rng.unit() * total;
+        index = static_cast<uint32_t>(std::upper_bound(begin, begin + object.count, pick) - begin);
+        index = std::min(index, object.count - 1);
+    } else {
+        index = static_cast<uint32_t>(rng.next() % object.count);
+    }
+    const BvhTriangle& tri = triangles[object.first + index];
+    const float r1 = std::sqrt(rng.unit());
+    const float r2 = rng.unit();
+    return tri.v0 * (1.0f - r1) + tri.v1 * (r1 * (1.0f - r2)) + tri.v2 * (r1 * r2);
+}
+
+void compress_row(const std::vector<uint8_t>& row, std::vector<uint8_t>& out) {
+    for (size_t i = 0; i < row.size();) {
+        if (row[i] != 0) {
+            out.push_back(row[i++]);
+            continue;
+        }
+        uint32_t run = 0;
+        while (i < row.size() && row[i] == 0 && run < 255) {
+            ++run;
+            ++i;
+        }
+        out.push_back(0);
+        out.push_back(static_cast<uint8_t>(run));
+    }
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& out, const T& value) {
+    const size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T>
+bool get(const std::vector<uint8_t>& in, size_t& at, T& value) {
+    if (in.size() - at < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, in.data() + at, sizeof(T));
+    at += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+PotentiallyVisibleSet PotentiallyVisibleSet::bake(const std::vector<SceneObject>& objects,
+    const PvsBakeSettings& settings, JobSystem& jobs) {
+    PotentiallyVisibleSet pvs;
+    pvs.m_object_count = static_cast<uint32_t>(objects.size());
+    pvs.m_cell_size = settings.cell_size;
+
+    std::vector<BvhTriangle> source;
+    std::vector<BakeObject> bake_objects(objects.size());
+    math::Aabb scene_bounds;
+    uint32_t released = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(objects.size()); ++i) {
+        BakeObject& object = bake_objects[i];
+        object.first = static_cast<uint32_t>(source.size());
+        if (objects[i].mesh && !objects[i].mesh->has_cpu_data()) {
+            object.unknown = true;
+            ++released;
+        } else if (objects[i].mesh) {
+            append_mesh_triangles(*objects[i].mesh, objects[i].model_matrix, i, source);
+        }
+        object.count = static_cast<uint32_t>(source.size()) - object.first;
+        for (uint32_t t = object.first; t < object.first + object.count; ++t) {
+            object.bounds.expand(source[t].v0);
+            object.bounds.expand(source[t].v1);
+            object.bounds.expand(source[t].v2);
+        }
+        scene_bounds.merge(object.bounds);
+    }
+    if (released > 0) {
+        std::cerr << "PotentiallyVisibleSet::bake: " << released
+                  << " object(s) whose mesh CPU data was released are marked always visible\n";
+    }
+    std::vector<float> area_prefix(source.size());
+    for (const BakeObject& object : bake_objects) {
+        float sum = 0.0f;
+        for (uint32_t t = object.first; t < object.first + object.count; ++t) {
+            const BvhTriangle& tri = source[t];
+            sum += 0.5f * math::Vec3::cross(tri.v1 - tri.v0, tri.v2 - tri.v0).length();
+            area_prefix[t] = sum;
+        }
+    }
+
+    const math::Aabb region = settings.bounds.empty() ? scene_bounds : settings.bounds;
+    if (region.empty() || settings.cell_size <= 0.0f) {
+        return pvs;
+    }
+    const math::Vec3 size = region.max - region.min;
+    const float sizes[3] = {size.x, size.y, size.z};
+    for (int axis = 0; axis < 3; ++axis) {
+        pvs.m_dims[axis] = std::max(1u, static_cast<uint32_t>(std::ceil(sizes[axis] / settings.cell_size)));
+    }
+    pvs.m_bounds = math::Aabb(region.min, region.min + math::Vec3(
+        static_cast<float>(pvs.m_dims[0]) * settings.cell_size,
+        static_cast<float>(pvs.m_dims[1]) * settings.cell_size,
+        static_cast<float>(pvs.m_dims[2]) * settings.cell_size));
+
+    TriangleBvh bvh;
+    bvh.build(source);
+    const std::vector<BvhTriangle>& hit_triangles = bvh.triangles();
+
+    const uint32_t cells = pvs.cell_count();
+    const size_t row_bytes = (objects.size() + 7) / 8;
+    std::vector<std::vector<uint8_t>> rows(cells);
+    // One cell per task: its generator is seeded from the cell index, so results do not depend on
+    // how cells are spread over workers.
+    jobs.parallel_for(cells, 1, [&](uint32_t begin, uint32_t end) {
+        std::vector<uint8_t> row;
+        for (uint32_t cell = begin; cell < end; ++cell) {
+            BakeRandom rng((static_cast<uint64_t>(settings.seed) << 32) ^ cell);
+            const uint32_t cx = cell % pvs.m_dims[0];
+            const uint32_t cy = (cell / pvs.m_dims[0]) % pvs.m_dims[1];
+            const uint32_t cz = cell / (pvs.m_dims[0] * pvs.m_dims[1]);
+            const math::Vec3 cell_min = pvs.m_bounds.min + math::Vec3(static_cast<float>(cx),
+                static_cast<float>(cy), static_cast<float>(cz)) * settings.cell_size;
+            const math::Aabb cell_box(cell_min, cell_min + math::Vec3(settings.cell_size));
+
+            row.assign(row_bytes, 0);
+            auto mark = [&row](uint32_t object) { row[object >> 3] |= static_cast<uint8_t>(1u << (object & 7)); };
+            auto marked = [&row](uint32_t object) { return (row[object >> 3] >> (object & 7)) & 1u; };
+
+            RayHit hit;
+            for (uint32_t r = 0; r < settings.random_rays && !bvh.empty(); ++r) {
+                const math::Vec3 origin = rng.in_box(cell_box);
+                if (bvh.intersect(origin, rng.direction(), 0.0f, std::numeric_limits<float>::max(), hit)) {
+                    mark(hit_triangles[hit.triangle].id);
+                }
+            }
+            for (uint32_t o = 0; o < static_cast<uint32_t>(bake_objects.size()); ++o) {
+                const BakeObject& object = bake_objects[o];
+                if (object.unknown) {
+                    mark(o);
+                    continue;
+                }
+                if (object.count == 0 || marked(o)) {
+                    continue;
+                }
+                if (object.bounds.overlaps(cell_box)) {
+                    mark(o);
+                    continue;
+                }
+                for (uint32_t r = 0; r < settings.rays_per_object; ++r) {
+                    const math::Vec3 origin = rng.in_box(cell_box);
+                    const math::Vec3 target = sample_surface(source, area_prefix, object, rng);
+                    // Segment to the target; reaching it (or first hitting the object) means visible.
+                    if (!bvh.intersect(origin, target - origin, 0.0f, 1.0001f, hit)) {
+                        mark(o);
+                        break;
+                    }
+                    const uint32_t first_hit = hit_triangles[hit.triangle].id;
+                    mark(first_hit);
+                    if (first_hit == o) {
+                        break;
+                    }
+                }
+            }
+            compress_row(row, rows[cell]);
+        }
+    });
+
+    pvs.m_row_offsets.reserve(cells + 1);
+    for (const std::vector<uint8_t>& row : rows) {
+        pvs.m_row_offsets.push_back(static_cast<uint32_t>(pvs.m_rows.size()));
+        pvs.m_rows.insert(pvs.m_rows.end(), row.begin(), row.end());
+    }
+    pvs.m_row_offsets.push_back(static_cast<uint32_t>(pvs.m_rows.size()));
+    return pvs;
+}
+
+uint32_t PotentiallyVisibleSet::cell_at(const math::Vec3& position) const {
+    if (empty() || !m_bounds.contains(position)) {
+        return kNoPvsCell;
+    }
+    const math::Vec3 local = (position - m_bounds.min) / m_cell_size;
+    const uint32_t x = std::min(static_cast<uint32_t>(local.x), m_dims[0] - 1);
+    const uint32_t y = std::min(static_cast<uint32_t>(local.y), m_dims[1] - 1);
+    const uint32_t z = std::min(static_cast<uint32_t>(local.z), m_dims[2] - 1);
+    return x + m_dims[0] * (y + m_dims[1] * z);
+}
+
+void PotentiallyVisibleSet::decompress(uint32_t cell, std::vector<uint64_t>& bits) const {
+    const size_t words = (static_cast<size_t>(m_object_count) + 63) / 64;
+    if (cell >= cell_count()) {
+        bits.assign(words, ~0ull);
+        return;
+    }
+    bits.assign(words, 0);
+    const size_t row_bytes = words * 8;
+    size_t byte = 0;
+    const uint32_t end = m_row_offsets[cell + 1];
+    for (uint32_t i = m_row_offsets[cell]; i < end && byte < row_bytes; ++i) {
+        if (m_rows[i] == 0) {
+            byte += i + 1 < end ? m_rows[++i] : row_bytes;
+            continue;
+        }
+        bits[byte >> 3] |= static_cast<uint64_t>(m_rows[i]) << (8 * (byte & 7));
+        ++byte;
+    }
+    // Objects added after the bake share the last word; keep them visible like those beyond it.
+    if (const uint32_t tail = m_object_count & 63) {
+        bits.back() |= ~0ull << tail;
+    }
+}
+
+uint32_t PotentiallyVisibleSet::visible_count(uint32_t cell) const {
+    std::vector<uint64_t> bits;
+    decompress(cell, bits);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < m_object_count; ++i) {
+        count += is_visible(bits, i) ? 1 : 0;
+    }
+    return count;
+}
+
+std::vector<uint8_t> PotentiallyVisibleSet::serialize() const {
+    std::vector<uint8_t> out(std::begin(kMagic), std::end(kMagic));
+    put(out, kVersion);
+    put(out, m_bounds.min);
+    put(out, m_bounds.max);
+    put(out, m_cell_size);
+    put(out, m_dims);
+    put(out, m_object_count);
+    put(out, static_cast<uint32_t>(m_row_offsets.size()));
+    for (uint32_t offset : m_row_offsets) {
+        put(out, offset);
+    }
+    out.insert(out.end(), m_rows.begin(), m_rows.end());
+    return out;
+}
+
+bool PotentiallyVisibleSet::deserialize(const std::vector<uint8_t>& data, PotentiallyVisibleSet& out) {
+    if (data.size() < sizeof(kMagic) || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    size_t at = sizeof(kMagic);
+    uint32_t version = 0;
+    PotentiallyVisibleSet pvs;
+    uint32_t offset_count = 0;
+    if (!get(data, at, version) || version != kVersion || !get(data, at, pvs.m_bounds.min)
+        || !get(data, at, pvs.m_bounds.max) || !get(data, at, pvs.m_cell_size) || !get(data, at, pvs.m_dims)
+        || !get(data, at, pvs.m_object_count) || !get(data, at, offset_count)) {
+        return false;
+    }
+    const uint64_t cells = static_cast<uint64_t>(pvs.m_dims[0]) * pvs.m_dims[1] * pvs.m_dims[2];
+    if (offset_count != 0) {
+        // A grid that `cell_at` can index: positive finite cells, no empty axis, finite ordered bounds.
+        const math::Vec3& lo = pvs.m_bounds.min;
+        const math::Vec3& hi = pvs.m_bounds.max;
+        const bool bounds_ok = std::isfinite(lo.x) && std::isfinite(lo.y) && std::isfinite(lo.z)
+            && std::isfinite(hi.x) && std::isfinite(hi.y) && std::isfinite(hi.z) && lo.x <= hi.x && lo.y <= hi.y
+            && lo.z <= hi.z;
+        if (!std::isfinite(pvs.m_cell_size) || !(pvs.m_cell_size > 0.0f) || cells == 0 || offset_count != cells + 1
+            || !bounds_ok) {
+            return false;
+        }
+    }
+    pvs.m_row_offsets.resize(offset_count);
+    for (uint32_t& offset : pvs.m_row_offsets) {
+        if (!get(data, at, offset)) {
+            return false;
+        }
+    }
+    pvs.m_rows.assign(data.begin() + static_cast<std::ptrdiff_t>(at), data.end());
+    for (size_t i = 1; i < pvs.m_row_offsets.size(); ++i) {
+        if (pvs.m_row_offsets[i] < pvs.m_row_offsets[i - 1] || pvs.m_row_offsets[i] > pvs.m_rows.size()) {
+            return false;
+        }
+    }
+    out = std::move(pvs);
+    return true;
+}
+
+bool PotentiallyVisibleSet::save(const std::string& path) const {
+    const std::vector<uint8_t> data = serialize();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool PotentiallyVisibleSet::load(const std::string& path, PotentiallyVisibleSet& out) {
+    const std::vector<uint8_t> data = FileSystem::read_binary(path);
+    return !data.empty() && deserialize(data, out);
+}
+
+} // namespace maya
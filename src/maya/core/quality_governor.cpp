@@ -0,0 +1,128 @@
+#include "maya/core/quality_governor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace maya {
+
+uint32_t QualityRegistry::add(QualityKnob knob) {
+    knob.level_count = std::max(knob.level_count, 1u);
+    knob.level = std::min(knob.level, knob.level_count - 1);
+    if (knob.apply) {
+        knob.apply(knob.level);
+    }
+    m_knobs.push_back(std::move(knob));
+    return static_cast<uint32_t>(m_knobs.size() - 1);
+}
+
+void QualityRegistry::set_level(uint32_t knob, uint32_t level) {
+    QualityKnob& k = m_knobs[knob];
+    level = std::min(level, k.level_count - 1);
+    if (level == k.level) {
+        return;
+    }
+    k.level = level;
+    if (k.apply) {
+        k.apply(level);
+    }
+}
+
+uint32_t QualityRegistry::find(const std::string& name) const {
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_knobs.size()); ++i) {
+        if (m_knobs[i].name == name) {
+            return i;
+        }
+    }
+    return kNoQualityKnob;
+}
+
+QualityGovernor::QualityGovernor(QualityRegistry& registry, const QualityGovernorSettings& settings)
+    : m_registry(registry) {
+    set_settings(settings);
+}
+
+void QualityGovernor::set_settings(const QualityGovernorSettings& settings) {
+    m_settings = settings;
+    m_settings.window_frames = std::max(m_settings.window_frames, 1u);
+    m_settings.percentile = std::clamp(m_settings.percentile, 0.0f, 1.0f);
+    m_window.clear();
+    m_window.reserve(m_settings.window_frames);
+    m_good_windows = 0;
+}
+
+QualityGovernor::Decision QualityGovernor::record_frame(float frame_ms) {
+    if (m_cooldown > 0) {
+        --m_cooldown;
+        return Decision::None;
+    }
+    m_window.push_back(frame_ms);
+    if (m_window.size() < m_settings.window_frames) {
+        return Decision::None;
+    }
+
+    m_scratch = m_window;
+    m_window.clear();
+    // Nearest rank; percentile 0 is the fastest frame.
+    const size_t rank = m_settings.percentile <= 0.0f ? 0 : std::min(m_scratch.size() - 1,
+        static_cast<size_t>(std::ceil(m_settings.percentile * static_cast<float>(m_scratch.size()))) - 1);
+    std::nth_element(m_scratch.begin(), m_scratch.begin() + static_cast<std::ptrdiff_t>(rank), m_scratch.end());
+    m_last_percentile_ms = m_scratch[rank];
+
+    const float target = m_settings.target_frame_ms;
+    if (m_last_percentile_ms > target * (1.0f + m_settings.degrade_margin)) {
+        m_good_windows = 0;
+        if (degrade()) {
+            m_cooldown = m_settings.cooldown_frames;
+            ++m_degrades;
+            return Decision::Degraded;
+        }
+        return Decision::None;
+    }
+    if (m_last_percentile_ms >= target * (1.0f - m_settings.upgrade_margin)) {
+        m_good_windows = 0;
+        return Decision::None;
+    }
+    if (++m_good_windows < m_settings.upgrade_windows) {
+        return Decision::None;
+    }
+    m_good_windows = 0;
+    if (upgrade()) {
+        m_cooldown = m_settings.cooldown_frames;
+        ++m_upgrades;
+        return Decision::Upgraded;
+    }
+    return Decision::None;
+}
+
+bool QualityGovernor::degrade() {
+    const std::vector<QualityKnob>& knobs = m_registry.knobs();
+    uint32_t pick = kNoQualityKnob;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(knobs.size()); ++i) {
+        if (knobs[i].level > 0 && (pick == kNoQualityKnob || knobs[i].importance < knobs[pick].importance)) {
+            pick = i;
+        }
+    }
+    if (pick == kNoQualityKnob) {
+        return false;
+    }
+    m_registry.set_level(pick, knobs[pick].level - 1);
+    return true;
+}
+
+bool QualityGovernor::upgrade() {
+    const std::vector<QualityKnob>& knobs = m_registry.knobs();
+    uint32_t pick = kNoQualityKnob;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(knobs.size()); ++i) {
+        if (knobs[i].level + 1 < knobs[i].level_count
+            && (pick == kNoQualityKnob || knobs[i].importance > knobs[pick].importance)) {
+            pick = i;
+        }
+    }
+    if (pick == kNoQualityKnob) {
+        return false;
+    }
+    m_registry.set_level(pick, knobs[pick].level + 1);
+    return true;
+}
+
+} // namespace maya
@@ -1,12 +1,40 @@
 #include "maya/core/scene.hpp"
 #include "maya/core/mesh.hpp"
 #include "maya/core/texture.hpp"
+#include "maya/core/view_culling.hpp"
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
 
 namespace maya {
 
+void apply_draw_state(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const Material& material,
+    const math::Mat4& model_matrix, const math::Mat4& view_projection, const DirectionalLighting& lighting,
+    const math::Vec3& camera_position_world) {
+    SceneDrawUniforms uniforms{};
+    uniforms.model_matrix = model_matrix;
+    uniforms.view_projection_matrix = view_projection;
+    uniforms.light_dir_world = math::Vec4(lighting.direction_to_light, 0.0f);
+    const math::SphericalHarmonicsL2 ambient = lighting.ambient.diffuse_convolved();
+    for (int i = 0; i < math::SphericalHarmonicsL2::kCount; ++i) {
+        uniforms.ambient_sh[i] = math::Vec4(ambient.coefficients[i], 0.0f);
+    }
+    uniforms.light_diffuse_rgb = math::Vec4(lighting.diffuse, 0.0f);
+    uniforms.camera_position_world = math::Vec4(camera_position_world, 0.0f);
+    uniforms.specular_rgb_shininess =
+        math::Vec4(lighting.specular, lighting.shininess);
+    device.update_uniform_buffer(uniform_buffer, &uniforms, sizeof(SceneDrawUniforms));
+    device.bind_pipeline(material.pipeline);
+    device.bind_uniform_buffer(uniform_buffer, 1);
+    if (material.texture) {
+        material.texture->bind(0);
+    }
+}
+
 Mesh* Scene::add_mesh(std::unique_ptr<Mesh> mesh) {
     Mesh* ptr = mesh.get();
     m_mesh_storage.push_back(std::move(mesh));
+    ++m_structure_version;
     return ptr;
 }
 
@@ -15,29 +43,182 @@ void Scene::add_object(std::unique_ptr<Mesh> mesh, Material material) {
     m_objects.push_back(SceneObject{ptr, material, math::Mat4::identity()});
 }
 
+uint32_t Scene::remove_meshes(const std::vector<const Mesh*>& meshes) {
+    std::unordered_set<const Mesh*> doomed(meshes.begin(), meshes.end());
+    for (const SceneObject& obj : m_static_objects) {
+        doomed.erase(obj.mesh);
+    }
+    if (doomed.empty()) {
+        return 0;
+    }
+    std::erase_if(m_objects, [&](const SceneObject& obj) { return doomed.count(obj.mesh) != 0; });
+    ++m_structure_version;
+    const size_t before = m_mesh_storage.size();
+    std::erase_if(m_mesh_storage, [&](const std::unique_ptr<Mesh>& m) { return doomed.count(m.get()) != 0; });
+    return static_cast<uint32_t>(before - m_mesh_storage.size());
+}
+
+void Scene::add_static_object(std::unique_ptr<Mesh> mesh, Material material, const math::Mat4& model_matrix) {
+    Mesh* ptr = add_mesh(std::move(mesh));
+    m_objects.push_back(SceneObject{ptr, material, model_matrix, true});
+}
+
+uint32_t Scene::build_static_batches(GraphicsDevice& device, const StaticBatchSettings& settings) {
+    const size_t static_before = m_static_objects.size();
+    std::vector<SceneObject> dynamic_objects;
+    dynamic_objects.reserve(m_objects.size());
+    for (SceneObject& obj : m_objects) {
+        if (obj.is_static) {
+            m_static_objects.push_back(obj);
+        } else {
+            dynamic_objects.push_back(obj);
+        }
+    }
+    m_objects = std::move(dynamic_objects);
+    if (m_static_objects.size() != static_before) {
+        // Baked for the old static object list (see `set_pvs`).
+        m_pvs = PotentiallyVisibleSet();
+    }
+    m_static_batches = maya::build_static_batches(device, m_static_objects, settings);
+    // Rebuilds start again from the source meshes, so the merged copies are never read back.
+    for (StaticBatch& batch : m_static_batches) {
+        batch.mesh->release_cpu_data();
+    }
+    ++m_structure_version;
+    return static_cast<uint32_t>(m_static_batches.size());
+}
+
+void Scene::build_hlod(GraphicsDevice& device, const HlodSettings& settings) {
+    m_hlod.build(device, m_static_objects, settings);
+    ++m_structure_version;
+}
+
+bool Scene::set_pvs(PotentiallyVisibleSet pvs) {
+    if (!pvs.empty() && pvs.object_count() != m_static_objects.size()) {
+        return false;
+    }
+    m_pvs = std::move(pvs);
+    ++m_structure_version;
+    return true;
+}
+
+void Scene::release_cpu_geometry() {
+    // Static sources are re-merged by every `build_static_batches` call.
+    std::unordered_set<const Mesh*> keep;
+    for (const SceneObject& obj : m_static_objects) {
+        keep.insert(obj.mesh);
+    }
+    for (const SceneObject& obj : m_objects) {
+        if (obj.is_static || (m_dynamic_batcher && DynamicBatcher::is_eligible(obj, m_dynamic_batcher->settings()))) {
+            keep.insert(obj.mesh);
+        }
+    }
+    for (const std::unique_ptr<Mesh>& mesh : m_mesh_storage) {
+        if (keep.count(mesh.get()) == 0) {
+            mesh->release_cpu_data();
+        }
+    }
+}
+
+void Scene::enable_dynamic_batching(GraphicsDevice& device, const DynamicBatchSettings& settings) {
+    m_dynamic_batcher = std::make_unique<DynamicBatcher>(device, settings);
+}
+
+void Scene::build_dynamic_batches(JobSystem& jobs) {
+    if (!m_dynamic_batcher) {
+        return;
+    }
+    m_dynamic_batcher->build(m_objects, jobs);
+    m_dynamic_batcher->upload();
+}
+
+uint32_t Scene::drawable_count() const {
+    uint32_t count = static_cast<uint32_t>(m_static_batches.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_objects.size()); ++i) {
+        if (m_objects[i].mesh && !(m_dynamic_batcher && m_dynamic_batcher->is_batched(i))) {
+            ++count;
+        }
+    }
+    if (m_dynamic_batcher) {
+        count += static_cast<uint32_t>(m_dynamic_batcher->groups().size());
+    }
+    return count;
+}
+
 void Scene::render(GraphicsDevice& device, UniformBufferHandle uniform_buffer,
     const math::Mat4& view_projection, const DirectionalLighting& lighting,
     const math::Vec3& camera_position_world) const {
-    for (const SceneObject& obj : m_objects) {
-        if (!obj.mesh) {
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_objects.size()); ++i) {
+        draw_object(device, uniform_buffer, i, view_projection, lighting, camera_position_world);
+    }
+    draw_batches(device, uniform_buffer, view_projection, lighting, camera_position_world,
+        [](uint32_t, uint32_t) { return true; });
+}
+
+void Scene::render(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const ViewSet& views,
+    uint32_t view_index, const DirectionalLighting& lighting) const {
+    const CullView& view = views.view(view_index);
+    for (const VisibleObject& visible : views.visible_objects(view_index)) {
+        draw_object(device, uniform_buffer, visible.object_index, view.view_projection, lighting, view.position);
+    }
+    draw_batches(device, uniform_buffer, view.view_projection, lighting, view.position,
+        [&views, view_index](uint32_t batch, uint32_t range) {
+            return views.is_static_range_visible(view_index, batch, range);
+        });
+    for (uint32_t c : views.hlod_proxies(view_index)) {
+        for (const HlodProxy& proxy : m_hlod.clusters()[c].proxies) {
+            apply_draw_state(device, uniform_buffer, proxy.material, math::Mat4::identity(), view.view_projection,
+                lighting, view.position);
+            proxy.mesh->draw();
+        }
+    }
+}
+
+void Scene::draw_object(GraphicsDevice& device, UniformBufferHandle uniform_buffer, uint32_t object_index,
+    const math::Mat4& view_projection, const DirectionalLighting& lighting,
+    const math::Vec3& camera_position_world) const {
+    const SceneObject& obj = m_objects[object_index];
+    if (!obj.mesh || (m_dynamic_batcher && m_dynamic_batcher->is_batched(object_index))) {
+        return;
+    }
+    const math::Vec3 position(obj.model_matrix.at(0, 3), obj.model_matrix.at(1, 3), obj.model_matrix.at(2, 3));
+    apply_draw_state(device, uniform_buffer, obj.material, obj.model_matrix, view_projection,
+        lighting_at(lighting, position), camera_position_world);
+    obj.mesh->draw();
+}
+
+DirectionalLighting Scene::lighting_at(const DirectionalLighting& lighting, const math::Vec3& position) const {
+    DirectionalLighting result = lighting;
+    if (!m_light_probes.empty()) {
+        result.ambient = m_light_probes.sample(position);
+    }
+    return result;
+}
+
+void Scene::draw_batches(GraphicsDevice& device, UniformBufferHandle uniform_buffer,
+    const math::Mat4& view_projection, const DirectionalLighting& lighting, const math::Vec3& camera_position_world,
+    const std::function<bool(uint32_t, uint32_t)>& is_range_visible) const {
+    // Batched vertices are already in world space.
+    if (m_dynamic_batcher) {
+        const auto& groups = m_dynamic_batcher->groups();
+        for (uint32_t g = 0; g < static_cast<uint32_t>(groups.size()); ++g) {
+            apply_draw_state(device, uniform_buffer, groups[g].material, math::Mat4::identity(), view_projection,
+                lighting, camera_position_world);
+            m_dynamic_batcher->draw_group(g);
+        }
+    }
+    for (uint32_t b = 0; b < static_cast<uint32_t>(m_static_batches.size()); ++b) {
+        const StaticBatch& batch = m_static_batches[b];
+        bool any_visible = false;
+        for (uint32_t r = 0; r < static_cast<uint32_t>(batch.ranges.size()) && !any_visible; ++r) {
+            any_visible = is_range_visible(b, r);
+        }
+        if (!any_visible) {
             continue;
         }
-        SceneDrawUniforms uniforms{};
-        uniforms.model_matrix = obj.model_matrix;
-        uniforms.view_projection_matrix = view_projection;
-        uniforms.light_dir_world = math::Vec4(lighting.direction_to_light, 0.0f);
-        uniforms.ambient_rgb = math::Vec4(lighting.ambient, 0.0f);
-        uniforms.light_diffuse_rgb = math::Vec4(lighting.diffuse, 0.0f);
-        uniforms.camera_position_world = math::Vec4(camera_position_world, 0.0f);
-        uniforms.specular_rgb_shininess =
-            math::Vec4(lighting.specular, lighting.shininess);
-        device.update_uniform_buffer(uniform_buffer, &uniforms, sizeof(SceneDrawUniforms));
-        device.bind_pipeline(obj.material.pipeline);
-        device.bind_uniform_buffer(uniform_buffer, 1);
-        if (obj.material.texture) {
-            obj.material.texture->bind(0);
-        }
-        obj.mesh->draw();
+        apply_draw_state(device, uniform_buffer, batch.material, math::Mat4::identity(), view_projection,
+            lighting_at(lighting, batch.world_bounds.center()), camera_position_world);
+        batch.draw_ranges([&is_range_visible, b](uint32_t r) { return is_range_visible(b, r); });
     }
 }
 
@@ -0,0 +1,264 @@
+#include "maya/core/skinning.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace maya {
+
+namespace {
+
+using math::simd::Float4;
+
+/// Vertices per skinning job.
+constexpr uint32_t kVerticesPerChunk = 4096;
+/// Instances per palette job.
+constexpr uint32_t kInstancesPerChunk = 16;
+
+/// `a * b` one result column at a time: column j is `a`'s columns weighted by `b`'s column j.
+void multiply(const math::Mat4& a, const math::Mat4& b, math::Mat4& out) {
+    const Float4 c0 = Float4::load(&a.elements[0]);
+    const Float4 c1 = Float4::load(&a.elements[4]);
+    const Float4 c2 = Float4::load(&a.elements[8]);
+    const Float4 c3 = Float4::load(&a.elements[12]);
+    float result[16];
+    for (int col = 0; col < 4; ++col) {
+        const float* bc = &b.elements[col * 4];
+        Float4 r = c0 * Float4::splat(bc[0]);
+        r = Float4::madd(c1, Float4::splat(bc[1]), r);
+        r = Float4::madd(c2, Float4::splat(bc[2]), r);
+        r = Float4::madd(c3, Float4::splat(bc[3]), r);
+        r.store(&result[col * 4]);
+    }
+    std::copy(result, result + 16, out.elements);
+}
+
+} // namespace
+
+math::Mat4 JointTransform::to_mat4() const {
+    // T * R * S without the full products: scale R's columns, then set the translation.
+    math::Mat4 m = rotation.to_mat4();
+    const float s[3] = {scale.x, scale.y, scale.z};
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            m.at(row, col) *= s[col];
+        }
+    }
+    m.at(0, 3) = translation.x;
+    m.at(1, 3) = translation.y;
+    m.at(2, 3) = translation.z;
+    return m;
+}
+
+void compute_joint_palette(const Skeleton& skeleton, const JointTransform* local_pose, const math::Mat4& model,
+    math::Mat4* joint_model, math::Mat4* palette) {
+    const uint32_t count = skeleton.joint_count();
+    for (uint32_t j = 0; j < count; ++j) {
+        const int32_t parent = skeleton.joints[j].parent;
+        const math::Mat4 local = local_pose[j].to_mat4();
+        if (parent < 0) {
+            joint_model[j] = local;
+        } else {
+            multiply(joint_model[parent], local, joint_model[j]);
+        }
+    }
+    for (uint32_t j = 0; j < count; ++j) {
+        math::Mat4 world;
+        multiply(model, joint_model[j], world);
+        multiply(world, skeleton.joints[j].inverse_bind, palette[j]);
+    }
+}
+
+void skin_vertices(const Vertex* bind, const SkinInfluence* influences, size_t count, const math::Mat4* palette,
+    Vertex* out) {
+    for (size_t v = 0; v < count; ++v) {
+        const SkinInfluence& influence = influences[v];
+        // Blend the palette columns first, then transform once.
+        Float4 c0 = Float4::zero();
+        Float4 c1 = Float4::zero();
+        Float4 c2 = Float4::zero();
+        Float4 c3 = Float4::zero();
+        for (uint32_t k = 0; k < kMaxSkinInfluences; ++k) {
+            const float weight = influence.weights[k];
+            if (weight == 0.0f) {
+                continue;
+            }
+            const float* m = palette[influence.joints[k]].elements;
+            const Float4 w = Float4::splat(weight);
+            c0 = Float4::madd(Float4::load(m), w, c0);
+            c1 = Float4::madd(Float4::load(m + 4), w, c1);
+            c2 = Float4::madd(Float4::load(m + 8), w, c2);
+            c3 = Float4::madd(Float4::load(m + 12), w, c3);
+        }
+
+        const Vertex& in = bind[v];
+        const Float4 p = Float4::madd(c0, Float4::splat(in.position.x),
+            Float4::madd(c1, Float4::splat(in.position.y), Float4::madd(c2, Float4::splat(in.position.z), c3)));
+        Float4 n = Float4::madd(c0, Float4::splat(in.normal.x),
+            Float4::madd(c1, Float4::splat(in.normal.y), c2 * Float4::splat(in.normal.z)));
+        const float n2 = Float4::dot(n, n).lane(0);
+        if (n2 > 0.0f) {
+            n = n * Float4::splat(1.0f / std::sqrt(n2));
+        }
+        out[v] = Vertex(math::Vec3(p.lane(0), p.lane(1), p.lane(2)), math::Vec3(n.lane(0), n.lane(1), n.lane(2)),
+            in.color, in.uv);
+    }
+}
+
+Skeleton make_chain_skeleton(uint32_t joint_count, float segment_length) {
+    Skeleton skeleton;
+    skeleton.joints.resize(joint_count);
+    for (uint32_t j = 0; j < joint_count; ++j) {
+        Joint& joint = skeleton.joints[j];
+        joint.name = "joint" + std::to_string(j);
+        joint.parent = static_cast<int32_t>(j) - 1;
+        joint.bind_local.translation = math::Vec3(0.0f, j == 0 ? 0.0f : segment_length, 0.0f);
+        joint.inverse_bind = math::Mat4::translate(math::Vec3(0.0f, -segment_length * static_cast<float>(j), 0.0f));
+    }
+    return skeleton;
+}
+
+SkinnedMeshData make_skinned_cylinder(float radius, uint32_t joint_count, float segment_length, uint32_t sides,
+    uint32_t rings, const math::Vec4& color) {
+    SkinnedMeshData mesh;
+    const float height = segment_length * static_cast<float>(joint_count);
+    const uint32_t stride = sides + 1;
+    for (uint32_t r = 0; r <= rings; ++r) {
+        const float v = static_cast<float>(r) / static_cast<float>(rings);
+        const float y = v * height;
+        // Weight moves linearly from one joint to the next along each segment.
+        const float t = y / segment_length;
+        const uint32_t j0 = std::min(static_cast<uint32_t>(t), joint_count - 1);
+        const uint32_t j1 = std::min(j0 + 1, joint_count - 1);
+        const float blend = j0 == j1 ? 0.0f : t - static_cast<float>(j0);
+        SkinInfluence influence;
+        influence.joints[0] = static_cast<uint16_t>(j0);
+        influence.joints[1] = static_cast<uint16_t>(j1);
+        influence.weights[0] = 1.0f - blend;
+        influence.weights[1] = blend;
+
+        for (uint32_t s = 0; s <= sides; ++s) {
+            const float u = static_cast<float>(s) / static_cast<float>(sides);
+            const float angle = u * 6.28318530718f;
+            const math::Vec3 normal(std::cos(angle), 0.0f, std::sin(angle));
+            mesh.vertices.emplace_back(math::Vec3(normal.x * radius, y, normal.z * radius), normal, color,
+                math::Vec2(u, v));
+            mesh.influences.push_back(influence);
+        }
+    }
+    for (uint32_t r = 0; r < rings; ++r) {
+        for (uint32_t s = 0; s < sides; ++s) {
+            const uint32_t a = r * stride + s;
+            const uint32_t b = a + 1;
+            const uint32_t c = a + stride;
+            const uint32_t d = c + 1;
+            // Counter-clockwise seen from outside.
+            mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    return mesh;
+}
+
+SkinningSystem::SkinningSystem(GraphicsDevice& device, uint32_t max_vertices, uint32_t max_indices)
+    : m_buffer(device, max_vertices, max_indices) {}
+
+uint32_t SkinningSystem::add_instance(const SkinnedMeshData* mesh, const Skeleton* skeleton,
+    const Material& material) {
+    const uint32_t first_vertex = m_vertex_offsets.back();
+    const uint32_t vertex_count = static_cast<uint32_t>(mesh->vertices.size());
+    const uint32_t first_index = static_cast<uint32_t>(m_indices.size());
+    if (first_vertex + vertex_count > m_buffer.max_vertices()
+        || first_index + mesh->indices.size() > m_buffer.max_indices()) {
+        return ~0u;
+    }
+    // `skin_vertices` reads one influence per vertex and the palette at every influence slot.
+    if (mesh->influences.size() != mesh->vertices.size()) {
+        return ~0u;
+    }
+    for (const SkinInfluence& influence : mesh->influences) {
+        for (uint32_t k = 0; k < kMaxSkinInfluences; ++k) {
+            if (influence.joints[k] >= skeleton->joint_count()) {
+                return ~0u;
+            }
+        }
+    }
+    for (uint32_t index : mesh->indices) {
+        if (index >= vertex_count) {
+            return ~0u;
+        }
+    }
+
+    Instance instance;
+    instance.mesh = mesh;
+    instance.skeleton = skeleton;
+    instance.material = material;
+    instance.pose.reserve(skeleton->joint_count());
+    for (const Joint& joint : skeleton->joints) {
+        instance.pose.push_back(joint.bind_local);
+    }
+    instance.first_vertex = first_vertex;
+    instance.first_index = first_index;
+    instance.first_joint = static_cast<uint32_t>(m_palettes.size());
+    m_instances.push_back(std::move(instance));
+
+    m_vertex_offsets.push_back(first_vertex + vertex_count);
+    m_palettes.resize(m_palettes.size() + skeleton->joint_count(), math::Mat4::identity());
+    m_joint_model.resize(m_palettes.size(), math::Mat4::identity());
+    m_vertices.insert(m_vertices.end(), mesh->vertices.begin(), mesh->vertices.end());
+    for (uint32_t index : mesh->indices) {
+        m_indices.push_back(first_vertex + index);
+    }
+    m_buffer.set_indices(m_indices.data(), static_cast<uint32_t>(m_indices.size()));
+    return static_cast<uint32_t>(m_instances.size() - 1);
+}
+
+void SkinningSystem::update(JobSystem& jobs) {
+    const uint32_t instance_count = this->instance_count();
+    jobs.parallel_for(instance_count, kInstancesPerChunk, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const Instance& instance = m_instances[i];
+            compute_joint_palette(*instance.skeleton, instance.pose.data(), instance.model_matrix,
+                &m_joint_model[instance.first_joint], &m_palettes[instance.first_joint]);
+        }
+    });
+
+    // Chunks cut across instance boundaries so one large mesh still spreads over all workers.
+    const uint32_t total = m_vertex_offsets.back();
+    const uint32_t chunks = (total + kVerticesPerChunk - 1) / kVerticesPerChunk;
+    jobs.parallel_for(chunks, 1, [&](uint32_t begin, uint32_t end) {
+        uint32_t v = begin * kVerticesPerChunk;
+        const uint32_t last = std::min(total, end * kVerticesPerChunk);
+        uint32_t i = static_cast<uint32_t>(
+            std::upper_bound(m_vertex_offsets.begin(), m_vertex_offsets.end(), v) - m_vertex_offsets.begin() - 1);
+        while (v < last) {
+            const Instance& instance = m_instances[i];
+            const uint32_t local = v - instance.first_vertex;
+            const uint32_t count = std::min(last, m_vertex_offsets[i + 1]) - v;
+            skin_vertices(instance.mesh->vertices.data() + local, instance.mesh->influences.data() + local, count,
+                &m_palettes[instance.first_joint], &m_vertices[v]);
+            v += count;
+            ++i;
+        }
+    });
+
+    m_buffer.upload_vertices(m_vertices.data(), total);
+}
+
+void SkinningSystem::render(GraphicsDevice& device, UniformBufferHandle uniform_buffer,
+    const math::Mat4& view_projection, const DirectionalLighting& lighting,
+    const math::Vec3& camera_position_world) const {
+    if (m_buffer.uploaded_index_count() == 0) {
+        return;
+    }
+    // Vertices are already in world space (the model matrix is folded into each palette).
+    const math::Mat4 identity = math::Mat4::identity();
+    for (const Instance& instance : m_instances) {
+        apply_draw_state(device, uniform_buffer, instance.material, identity, view_projection, lighting,
+            camera_position_world);
+        m_buffer.bind();
+        m_buffer.draw_range(instance.first_index, static_cast<uint32_t>(instance.mesh->indices.size()));
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,372 @@
+#include "maya/core/spatial_hash.hpp"
+#include "maya/core/job_system.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace maya {
+
+namespace {
+
+constexpr uint32_t kNoBucket = ~0u;
+/// Pairs per histogram chunk of the counting sort; smaller rebuilds stay on one thread.
+constexpr uint32_t kPairsPerSortChunk = 16384;
+
+int32_t to_cell(float v, float inv_cell_size) {
+    // Clamped so far-away coordinates cannot overflow the integer cell space.
+    return static_cast<int32_t>(std::clamp(std::floor(v * inv_cell_size), -1.0e9f, 1.0e9f));
+}
+
+float distance_squared(const math::Vec3& p, const math::Aabb& box) {
+    const float dx = std::max({box.min.x - p.x, 0.0f, p.x - box.max.x});
+    const float dy = std::max({box.min.y - p.y, 0.0f, p.y - box.max.y});
+    const float dz = std::max({box.min.z - p.z, 0.0f, p.z - box.max.z});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+} // namespace
+
+SpatialHashGrid::SpatialHashGrid(const SpatialHashSettings& settings)
+    : m_settings(settings),
+      m_inv_cell_size(1.0f / settings.cell_size) {}
+
+SpatialHashGrid::CellRange SpatialHashGrid::cell_range(const math::Aabb& box) const {
+    CellRange range;
+    range.min[0] = to_cell(box.min.x, m_inv_cell_size);
+    range.min[1] = to_cell(box.min.y, m_inv_cell_size);
+    range.min[2] = to_cell(box.min.z, m_inv_cell_size);
+    range.max[0] = to_cell(box.max.x, m_inv_cell_size);
+    range.max[1] = to_cell(box.max.y, m_inv_cell_size);
+    range.max[2] = to_cell(box.max.z, m_inv_cell_size);
+    return range;
+}
+
+uint64_t SpatialHashGrid::cell_count(const CellRange& range) const {
+    uint64_t count = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (range.max[axis] < range.min[axis]) {
+            return 0;
+        }
+        count *= static_cast<uint64_t>(range.max[axis] - range.min[axis]) + 1;
+    }
+    return count;
+}
+
+uint32_t SpatialHashGrid::bucket_of(int32_t x, int32_t y, int32_t z) const {
+    uint32_t h = static_cast<uint32_t>(x) * 73856093u
+               ^ static_cast<uint32_t>(y) * 19349663u
+               ^ static_cast<uint32_t>(z) * 83492791u;
+    // Mix high bits down; the table is indexed by the low bits.
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    return h & m_bucket_mask;
+}
+
+void SpatialHashGrid::grow(uint32_t id) {
+    if (id < m_state.size()) {
+        return;
+    }
+    const size_t size = static_cast<size_t>(id) + 1;
+    m_bounds.resize(size);
+    m_cells.resize(size);
+    m_state.resize(size, State::Absent);
+    m_loose_slot.resize(size, 0);
+}
+
+void SpatialHashGrid::make_loose(uint32_t id, State state) {
+    const State previous = m_state[id];
+    if (previous == State::Pending) {
+        --m_pending;
+    }
+    if (previous != State::Pending && previous != State::Oversized) {
+        m_loose_slot[id] = static_cast<uint32_t>(m_loose.size());
+        m_loose.push_back(id);
+    }
+    if (previous == State::Grid) {
+        ++m_tombstones;
+    }
+    m_state[id] = state;
+    if (state == State::Pending) {
+        ++m_pending;
+    }
+}
+
+void SpatialHashGrid::drop_loose(uint32_t id) {
+    if (m_state[id] == State::Pending) {
+        --m_pending;
+    }
+    const uint32_t slot = m_loose_slot[id];
+    const uint32_t last = m_loose.back();
+    m_loose[slot] = last;
+    m_loose_slot[last] = slot;
+    m_loose.pop_back();
+}
+
+void SpatialHashGrid::insert(uint32_t id, const math::Aabb& bounds) {
+    grow(id);
+    if (m_state[id] != State::Absent) {
+        move(id, bounds);
+        return;
+    }
+    m_bounds[id] = bounds;
+    m_cells[id] = cell_range(bounds);
+    ++m_size;
+    make_loose(id, cell_count(m_cells[id]) > m_settings.max_cells_per_object ? State::Oversized : State::Pending);
+}
+
+void SpatialHashGrid::move(uint32_t id, const math::Aabb& bounds) {
+    if (!contains(id)) {
+        insert(id, bounds);
+        return;
+    }
+    m_bounds[id] = bounds;
+    const CellRange range = cell_range(bounds);
+    const CellRange& old = m_cells[id];
+    const bool same_cells = std::equal(range.min, range.min + 3, old.min)
+        && std::equal(range.max, range.max + 3, old.max);
+    if (same_cells) {
+        return;
+    }
+    m_cells[id] = range;
+    if (cell_count(range) > m_settings.max_cells_per_object) {
+        make_loose(id, State::Oversized);
+    } else if (m_state[id] != State::Pending) {
+        make_loose(id, State::Pending);
+    }
+}
+
+void SpatialHashGrid::remove(uint32_t id) {
+    if (!contains(id)) {
+        return;
+    }
+    if (m_state[id] == State::Grid) {
+        ++m_tombstones;
+    } else {
+        drop_loose(id);
+    }
+    m_state[id] = State::Absent;
+    --m_size;
+}
+
+void SpatialHashGrid::clear() {
+    m_bounds.clear();
+    m_cells.clear();
+    m_state.clear();
+    m_loose_slot.clear();
+    m_loose.clear();
+    m_size = 0;
+    m_pending = 0;
+    m_tombstones = 0;
+    m_bucket_start.clear();
+    m_entries.clear();
+    m_bucket_mask = 0;
+}
+
+void SpatialHashGrid::assign(const std::vector<math::Aabb>& bounds, JobSystem& jobs) {
+    const uint32_t count = static_cast<uint32_t>(bounds.size());
+    clear();
+    m_bounds = bounds;
+    m_cells.resize(count);
+    m_state.resize(count);
+    m_loose_slot.resize(count, 0);
+    jobs.parallel_for(count, 1024, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            m_cells[i] = cell_range(m_bounds[i]);
+            m_state[i] = cell_count(m_cells[i]) > m_settings.max_cells_per_object ? State::Oversized : State::Grid;
+        }
+    });
+
+    std::vector<uint32_t> ids;
+    ids.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_state[i] == State::Grid) {
+            ids.push_back(i);
+        } else {
+            m_loose_slot[i] = static_cast<uint32_t>(m_loose.size());
+            m_loose.push_back(i);
+        }
+    }
+    m_size = count;
+    build_table(ids, jobs);
+}
+
+void SpatialHashGrid::rebuild(JobSystem& jobs) {
+    std::vector<uint32_t> ids;
+    ids.reserve(m_size);
+    for (uint32_t id = 0; id < static_cast<uint32_t>(m_state.size()); ++id) {
+        if (m_state[id] == State::Pending) {
+            drop_loose(id);
+            m_state[id] = State::Grid;
+        }
+        if (m_state[id] == State::Grid) {
+            ids.push_back(id);
+        }
+    }
+    m_tombstones = 0;
+    build_table(ids, jobs);
+}
+
+bool SpatialHashGrid::commit(JobSystem& jobs) {
+    const uint32_t churn = m_pending + m_tombstones;
+    if (churn == 0 || static_cast<float>(churn) < m_settings.rebuild_fraction * static_cast<float>(m_size)) {
+        return false;
+    }
+    rebuild(jobs);
+    return true;
+}
+
+void SpatialHashGrid::build_table(const std::vector<uint32_t>& ids, JobSystem& jobs) {
+    const uint32_t id_count = static_cast<uint32_t>(ids.size());
+    m_pair_offsets.resize(static_cast<size_t>(id_count) + 1);
+    uint32_t pair_count = 0;
+    for (uint32_t k = 0; k < id_count; ++k) {
+        m_pair_offsets[k] = pair_count;
+        pair_count += static_cast<uint32_t>(cell_count(m_cells[ids[k]]));
+    }
+    m_pair_offsets[id_count] = pair_count;
+
+    // About one bucket per entry keeps chains short without hashing empty space.
+    const uint32_t bucket_count = std::max<uint32_t>(64, std::bit_ceil(pair_count));
+    m_bucket_mask = bucket_count - 1;
+
+    // Emit one (bucket, id) pair per covered cell, dropping repeats of a bucket within an
+    // object so it appears in each bucket at most once.
+    m_pair_buckets.resize(pair_count);
+    m_pair_ids.resize(pair_count);
+    jobs.parallel_for(id_count, 512, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t k = begin; k < end; ++k) {
+            const uint32_t id = ids[k];
+            const CellRange& range = m_cells[id];
+            const uint32_t first = m_pair_offsets[k];
+            uint32_t write = first;
+            for (int32_t z = range.min[2]; z <= range.max[2]; ++z) {
+                for (int32_t y = range.min[1]; y <= range.max[1]; ++y) {
+                    for (int32_t x = range.min[0]; x <= range.max[0]; ++x) {
+                        const uint32_t bucket = bucket_of(x, y, z);
+                        if (std::find(m_pair_buckets.begin() + first, m_pair_buckets.begin() + write, bucket)
+                            != m_pair_buckets.begin() + write) {
+                            continue;
+                        }
+                        m_pair_buckets[write] = bucket;
+                        m_pair_ids[write] = id;
+                        ++write;
+                    }
+                }
+            }
+            std::fill(m_pair_buckets.begin() + write, m_pair_buckets.begin() + m_pair_offsets[k + 1], kNoBucket);
+        }
+    });
+
+    // Parallel counting sort: per-chunk bucket histograms, one exclusive scan over
+    // (bucket, chunk), then every chunk scatters its pairs to its own slots (stable).
+    const uint32_t chunk_count = std::clamp<uint32_t>(pair_count / kPairsPerSortChunk, 1, jobs.worker_count() + 1);
+    const uint32_t chunk_size = (pair_count + chunk_count - 1) / chunk_count;
+    m_histograms.assign(static_cast<size_t>(chunk_count) * bucket_count, 0);
+    jobs.parallel_for(chunk_count, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t c = begin; c < end; ++c) {
+            uint32_t* histogram = m_histograms.data() + static_cast<size_t>(c) * bucket_count;
+            const uint32_t last = std::min(pair_count, (c + 1) * chunk_size);
+            for (uint32_t p = c * chunk_size; p < last; ++p) {
+                if (m_pair_buckets[p] != kNoBucket) {
+                    ++histogram[m_pair_buckets[p]];
+                }
+            }
+        }
+    });
+
+    m_bucket_start.resize(static_cast<size_t>(bucket_count) + 1);
+    uint32_t running = 0;
+    for (uint32_t b = 0; b < bucket_count; ++b) {
+        m_bucket_start[b] = running;
+        for (uint32_t c = 0; c < chunk_count; ++c) {
+            uint32_t& slot = m_histograms[static_cast<size_t>(c) * bucket_count + b];
+            const uint32_t n = slot;
+            slot = running;
+            running += n;
+        }
+    }
+    m_bucket_start[bucket_count] = running;
+
+    m_entries.resize(running);
+    jobs.parallel_for(chunk_count, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t c = begin; c < end; ++c) {
+            uint32_t* cursor = m_histograms.data() + static_cast<size_t>(c) * bucket_count;
+            const uint32_t last = std::min(pair_count, (c + 1) * chunk_size);
+            for (uint32_t p = c * chunk_size; p < last; ++p) {
+                if (m_pair_buckets[p] != kNoBucket) {
+                    m_entries[cursor[m_pair_buckets[p]]++] = m_pair_ids[p];
+                }
+            }
+        }
+    });
+}
+
+template <typename Fn>
+void SpatialHashGrid::for_each_overlapping(const math::Aabb& box, Fn&& fn) const {
+    if (m_size == 0 || box.empty()) {
+        return;
+    }
+    const CellRange q = cell_range(box);
+
+    // A query spanning more cells than there are objects is cheaper as a straight scan.
+    if (cell_count(q) > m_state.size()) {
+        for (uint32_t id = 0; id < static_cast<uint32_t>(m_state.size()); ++id) {
+            if (m_state[id] != State::Absent && m_bounds[id].overlaps(box)) {
+                fn(id);
+            }
+        }
+        return;
+    }
+
+    if (!m_bucket_start.empty()) {
+        for (int32_t z = q.min[2]; z <= q.max[2]; ++z) {
+            for (int32_t y = q.min[1]; y <= q.max[1]; ++y) {
+                for (int32_t x = q.min[0]; x <= q.max[0]; ++x) {
+                    const uint32_t bucket = bucket_of(x, y, z);
+                    for (uint32_t e = m_bucket_start[bucket]; e < m_bucket_start[bucket + 1]; ++e) {
+                        const uint32_t id = m_entries[e];
+                        if (m_state[id] != State::Grid) {
+                            continue; // Tombstone: removed or pending since the last rebuild.
+                        }
+                        // Report each object only from the first cell it shares with the query;
+                        // this also rejects other cells that hash to the same bucket.
+                        const CellRange& c = m_cells[id];
+                        if (x != std::max(c.min[0], q.min[0]) || y != std::max(c.min[1], q.min[1])
+                            || z != std::max(c.min[2], q.min[2])
+                            || x > c.max[0] || y > c.max[1] || z > c.max[2]) {
+                            continue;
+                        }
+                        if (m_bounds[id].overlaps(box)) {
+                            fn(id);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (uint32_t id : m_loose) {
+        if (m_bounds[id].overlaps(box)) {
+            fn(id);
+        }
+    }
+}
+
+void SpatialHashGrid::query_box(const math::Aabb& box, std::vector<uint32_t>& out) const {
+    out.clear();
+    for_each_overlapping(box, [&](uint32_t id) { out.push_back(id); });
+}
+
+void SpatialHashGrid::query_radius(const math::Vec3& center, float radius, std::vector<uint32_t>& out) const {
+    out.clear();
+    const math::Vec3 r(radius);
+    const float radius_squared = radius * radius;
+    for_each_overlapping(math::Aabb(center - r, center + r), [&](uint32_t id) {
+        if (distance_squared(center, m_bounds[id]) <= radius_squared) {
+            out.push_back(id);
+        }
+    });
+}
+
+} // namespace maya
@@ -0,0 +1,92 @@
+#include "maya/core/static_batch.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/vertex_transform.hpp"
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+
+namespace maya {
+
+namespace {
+
+/// CPU staging for one batch before its buffers are created.
+struct PendingBatch {
+    Material material{};
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<StaticBatchRange> ranges;
+    math::Aabb world_bounds;
+};
+
+void append_object(PendingBatch& batch, const SceneObject& obj, uint32_t object_index) {
+    const Mesh& mesh = *obj.mesh;
+    const uint32_t base_vertex = static_cast<uint32_t>(batch.vertices.size());
+
+    StaticBatchRange range;
+    range.first_index = static_cast<uint32_t>(batch.indices.size());
+    range.index_count = mesh.index_count();
+    range.source_object = object_index;
+
+    batch.vertices.insert(batch.vertices.end(), mesh.vertices().begin(), mesh.vertices().end());
+    Vertex* world = batch.vertices.data() + base_vertex;
+    transform_vertices(world, world, mesh.vertex_count(), obj.model_matrix, obj.model_matrix.normal_matrix());
+    for (uint32_t v = 0; v < mesh.vertex_count(); ++v) {
+        range.world_bounds.expand(world[v].position);
+    }
+    for (uint32_t index : mesh.indices()) {
+        batch.indices.push_back(base_vertex + index);
+    }
+
+    batch.world_bounds.merge(range.world_bounds);
+    batch.ranges.push_back(range);
+}
+
+} // namespace
+
+std::vector<StaticBatch> build_static_batches(GraphicsDevice& device, const std::vector<SceneObject>& objects,
+    const StaticBatchSettings& settings) {
+    std::vector<PendingBatch> pending;
+    // Material -> index of the batch currently being filled for it.
+    std::unordered_map<MaterialKey, size_t, MaterialKeyHash> open_batches;
+
+    uint32_t released = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(objects.size()); ++i) {
+        const SceneObject& obj = objects[i];
+        if (!obj.mesh || obj.mesh->index_count() == 0) {
+            continue;
+        }
+        if (!obj.mesh->has_cpu_data()) {
+            ++released;
+            continue;
+        }
+        const MaterialKey key(obj.material);
+        auto it = open_batches.find(key);
+        if (it == open_batches.end()
+            || (!pending[it->second].vertices.empty()
+                && pending[it->second].vertices.size() + obj.mesh->vertex_count() > settings.max_vertices_per_batch)) {
+            pending.push_back(PendingBatch{});
+            pending.back().material = obj.material;
+            open_batches[key] = pending.size() - 1;
+            it = open_batches.find(key);
+        }
+        append_object(pending[it->second], obj, i);
+    }
+    if (released > 0) {
+        std::cerr << "build_static_batches: skipped " << released
+                  << " object(s) whose mesh CPU data was released\n";
+    }
+
+    std::vector<StaticBatch> batches;
+    batches.reserve(pending.size());
+    for (PendingBatch& p : pending) {
+        StaticBatch batch;
+        batch.material = p.material;
+        batch.mesh = std::make_unique<Mesh>(device, p.vertices, p.indices);
+        batch.ranges = std::move(p.ranges);
+        batch.world_bounds = p.world_bounds;
+        batches.push_back(std::move(batch));
+    }
+    return batches;
+}
+
+} // namespace maya
@@ -0,0 +1,80 @@
+#include "maya/core/stress_scene.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/primitives.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/math/math_utils.hpp"
+#include "maya/math/quaternion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace maya {
+
+namespace {
+
+/// splitmix64 stream of floats in [0, 1).
+class Random {
+public:
+    explicit Random(uint64_t seed) : m_state(seed) {}
+
+    float next() {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+    }
+
+    float range(float lo, float hi) { return lo + (hi - lo) * next(); }
+
+private:
+    uint64_t m_state;
+};
+
+} // namespace
+
+uint32_t add_stress_scene(Scene& scene, GraphicsDevice& device, const Material& material,
+    const StressSceneSettings& settings) {
+    const uint32_t d = std::max(settings.detail, 4u);
+    const uint32_t half = d / 2;
+    const std::vector<MeshData> shapes = {
+        generate_plane(1.0f, 1.0f, half, half, math::Vec4(0.55f, 0.75f, 0.45f, 1.0f)),
+        generate_box(math::Vec3(0.5f, 0.5f, 0.5f), 1, math::Vec4(0.85f, 0.55f, 0.35f, 1.0f)),
+        generate_uv_sphere(0.5f, d, half, math::Vec4(0.4f, 0.6f, 0.9f, 1.0f)),
+        generate_icosphere(0.5f, d >= 16 ? 2u : 1u, math::Vec4(0.9f, 0.85f, 0.4f, 1.0f)),
+        generate_cylinder(0.4f, 1.0f, d, 1, true, math::Vec4(0.7f, 0.4f, 0.8f, 1.0f)),
+        generate_cone(0.5f, 1.0f, d, 1, true, math::Vec4(0.9f, 0.4f, 0.4f, 1.0f)),
+        generate_torus(0.4f, 0.15f, d, half, math::Vec4(0.4f, 0.85f, 0.8f, 1.0f)),
+        generate_capsule(0.3f, 0.5f, d, std::max(half / 2, 2u), math::Vec4(0.8f, 0.8f, 0.8f, 1.0f)),
+    };
+    std::vector<Mesh*> meshes;
+    meshes.reserve(shapes.size());
+    for (const MeshData& shape : shapes) {
+        meshes.push_back(scene.add_mesh(make_mesh(device, shape)));
+    }
+
+    Random random(settings.seed);
+    std::vector<SceneObject>& objects = scene.objects();
+    const uint32_t first = static_cast<uint32_t>(objects.size());
+    objects.reserve(objects.size() + settings.object_count);
+    for (uint32_t i = 0; i < settings.object_count; ++i) {
+        const uint32_t shape = std::min(static_cast<uint32_t>(random.next() * static_cast<float>(meshes.size())),
+            static_cast<uint32_t>(meshes.size() - 1));
+        // Uniform random rotation (Shoemake).
+        const float u1 = random.next();
+        const float a = math::TWO_PI * random.next();
+        const float b = math::TWO_PI * random.next();
+        const float s1 = std::sqrt(1.0f - u1);
+        const float s2 = std::sqrt(u1);
+        const math::Quat rotation(s1 * std::sin(a), s1 * std::cos(a), s2 * std::sin(b), s2 * std::cos(b));
+        const float scale = random.range(settings.min_scale, settings.max_scale);
+        const math::Vec3 position(random.range(-settings.extent, settings.extent),
+            random.range(-settings.extent, settings.extent), random.range(-settings.extent, settings.extent));
+        const math::Mat4 model =
+            math::Mat4::translate(position) * rotation.to_mat4() * math::Mat4::scale(math::Vec3(scale, scale, scale));
+        objects.push_back(SceneObject{meshes[shape], material, model, settings.is_static});
+    }
+    return first;
+}
+
+} // namespace maya
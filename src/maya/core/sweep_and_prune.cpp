@@ -0,0 +1,251 @@
+#include "maya/core/sweep_and_prune.hpp"
+#include "maya/core/job_system.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace maya {
+
+namespace {
+
+uint64_t pair_key(uint32_t a, uint32_t b) {
+    return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+}
+
+SapPair pair_of(uint64_t key) {
+    return SapPair{static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)};
+}
+
+float axis_value(const math::Vec3& v, uint32_t axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+/// `bounds` with each axis ordered min <= max; the sweeps rely on a min endpoint preceding its max.
+math::Aabb normalized(const math::Aabb& bounds) {
+    return math::Aabb(math::Vec3(std::min(bounds.min.x, bounds.max.x), std::min(bounds.min.y, bounds.max.y),
+                          std::min(bounds.min.z, bounds.max.z)),
+        math::Vec3(std::max(bounds.min.x, bounds.max.x), std::max(bounds.min.y, bounds.max.y),
+            std::max(bounds.min.z, bounds.max.z)));
+}
+
+/// Sort order: by value, min before max at equal values so touching intervals overlap.
+template <typename Endpoint>
+bool endpoint_less(const Endpoint& a, const Endpoint& b) {
+    return a.value < b.value || (a.value == b.value && (a.data & 1u) < (b.data & 1u));
+}
+
+} // namespace
+
+SweepAndPrune::SweepAndPrune(const SweepAndPruneSettings& settings)
+    : m_settings(settings) {}
+
+void SweepAndPrune::insert(uint32_t id, const math::Aabb& bounds) {
+    if (id >= m_state.size()) {
+        m_bounds.resize(id + 1);
+        m_state.resize(id + 1, State::Absent);
+        m_in_axes.resize(id + 1, 0);
+    }
+    m_bounds[id] = normalized(bounds);
+    if (m_state[id] != State::Absent) {
+        return;
+    }
+    ++m_size;
+    // Removed and re-inserted before an update: its endpoints are still sorted in place.
+    if (m_in_axes[id]) {
+        m_state[id] = State::Live;
+    } else {
+        m_state[id] = State::Inserted;
+        m_inserted.push_back(id);
+    }
+}
+
+void SweepAndPrune::move(uint32_t id, const math::Aabb& bounds) {
+    m_bounds[id] = normalized(bounds);
+}
+
+void SweepAndPrune::remove(uint32_t id) {
+    if (!contains(id)) {
+        return;
+    }
+    m_state[id] = State::Absent;
+    --m_size;
+    if (m_in_axes[id]) {
+        m_has_removals = true;
+    }
+}
+
+void SweepAndPrune::clear() {
+    m_bounds.clear();
+    m_state.clear();
+    m_in_axes.clear();
+    m_size = 0;
+    m_inserted.clear();
+    m_has_removals = false;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        m_axes[axis].clear();
+        m_candidates[axis].clear();
+    }
+    m_pairs.clear();
+    m_added.clear();
+    m_removed.clear();
+}
+
+bool SweepAndPrune::overlapping(uint32_t a, uint32_t b) const {
+    return a != b && m_pairs.count(pair_key(a, b)) != 0;
+}
+
+void SweepAndPrune::pairs(std::vector<SapPair>& out) const {
+    out.clear();
+    out.reserve(m_pairs.size());
+    for (uint64_t key : m_pairs) {
+        out.push_back(pair_of(key));
+    }
+}
+
+void SweepAndPrune::update(JobSystem& jobs) {
+    m_added.clear();
+    m_removed.clear();
+
+    if (m_has_removals) {
+        jobs.parallel_for(3, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t axis = begin; axis < end; ++axis) {
+                std::erase_if(m_axes[axis], [this](const Endpoint& e) { return m_state[e.data >> 1] == State::Absent; });
+            }
+        });
+        for (uint32_t id = 0; id < static_cast<uint32_t>(m_state.size()); ++id) {
+            if (m_state[id] == State::Absent) {
+                m_in_axes[id] = 0;
+            }
+        }
+        for (auto it = m_pairs.begin(); it != m_pairs.end();) {
+            const SapPair pair = pair_of(*it);
+            if (m_state[pair.a] == State::Absent || m_state[pair.b] == State::Absent) {
+                m_removed.push_back(pair);
+                it = m_pairs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_has_removals = false;
+    }
+
+    // New endpoints go on the end; the sort below carries them to their place, and every
+    // object they come to overlap is crossed on the way.
+    uint32_t inserted = 0;
+    for (uint32_t id : m_inserted) {
+        if (m_state[id] != State::Inserted) {
+            continue;
+        }
+        m_state[id] = State::Live;
+        m_in_axes[id] = 1;
+        ++inserted;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            m_axes[axis].push_back(Endpoint{0.0f, id << 1});
+            m_axes[axis].push_back(Endpoint{0.0f, (id << 1) | 1u});
+        }
+    }
+    m_inserted.clear();
+    if (inserted > 0 && static_cast<float>(inserted) >= m_settings.rebuild_fraction * static_cast<float>(m_size)) {
+        rebuild(jobs);
+        return;
+    }
+
+    jobs.parallel_for(3, 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t axis = begin; axis < end; ++axis) {
+            sort_axis(axis);
+        }
+    });
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        for (uint64_t key : m_candidates[axis]) {
+            const SapPair pair = pair_of(key);
+            report(key, m_bounds[pair.a].overlaps(m_bounds[pair.b]));
+        }
+    }
+}
+
+void SweepAndPrune::sort_axis(uint32_t axis) {
+    std::vector<Endpoint>& endpoints = m_axes[axis];
+    std::vector<uint64_t>& candidates = m_candidates[axis];
+    candidates.clear();
+    for (Endpoint& e : endpoints) {
+        const math::Aabb& box = m_bounds[e.data >> 1];
+        e.value = axis_value((e.data & 1u) ? box.max : box.min, axis);
+    }
+
+    const size_t count = endpoints.size();
+    for (size_t i = 1; i < count; ++i) {
+        const Endpoint e = endpoints[i];
+        size_t j = i;
+        while (j > 0 && endpoint_less(e, endpoints[j - 1])) {
+            const Endpoint& other = endpoints[j - 1];
+            // A min passing a max starts or ends an overlap on this axis; min/min and max/max
+            // swaps never change one.
+            if (((e.data ^ other.data) & 1u) && (e.data >> 1) != (other.data >> 1)) {
+                candidates.push_back(pair_key(e.data >> 1, other.data >> 1));
+            }
+            endpoints[j] = other;
+            --j;
+        }
+        endpoints[j] = e;
+    }
+}
+
+void SweepAndPrune::rebuild(JobSystem& jobs) {
+    jobs.parallel_for(3, 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t axis = begin; axis < end; ++axis) {
+            for (Endpoint& e : m_axes[axis]) {
+                const math::Aabb& box = m_bounds[e.data >> 1];
+                e.value = axis_value((e.data & 1u) ? box.max : box.min, axis);
+            }
+            std::sort(m_axes[axis].begin(), m_axes[axis].end(), endpoint_less<Endpoint>);
+            m_candidates[axis].clear();
+        }
+    });
+
+    // Sweep x with the set of open intervals; full boxes are tested against each opened one.
+    std::unordered_set<uint64_t> pairs;
+    pairs.reserve(m_pairs.size());
+    std::vector<uint32_t> active;
+    std::vector<uint32_t> active_slot(m_bounds.size(), 0);
+    for (const Endpoint& e : m_axes[0]) {
+        const uint32_t id = e.data >> 1;
+        if (e.data & 1u) {
+            const uint32_t slot = active_slot[id];
+            active[slot] = active.back();
+            active_slot[active[slot]] = slot;
+            active.pop_back();
+            continue;
+        }
+        const math::Aabb& box = m_bounds[id];
+        for (uint32_t other : active) {
+            if (box.overlaps(m_bounds[other])) {
+                pairs.insert(pair_key(id, other));
+            }
+        }
+        active_slot[id] = static_cast<uint32_t>(active.size());
+        active.push_back(id);
+    }
+
+    for (uint64_t key : m_pairs) {
+        if (!pairs.count(key)) {
+            m_removed.push_back(pair_of(key));
+        }
+    }
+    for (uint64_t key : pairs) {
+        if (!m_pairs.count(key)) {
+            m_added.push_back(pair_of(key));
+        }
+    }
+    m_pairs = std::move(pairs);
+}
+
+void SweepAndPrune::report(uint64_t key, bool overlap) {
+    if (overlap) {
+        if (m_pairs.insert(key).second) {
+            m_added.push_back(pair_of(key));
+        }
+    } else if (m_pairs.erase(key) != 0) {
+        m_removed.push_back(pair_of(key));
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,343 @@
+#include "maya/core/terrain.hpp"
+#include "maya/core/image_loader.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/scene.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace maya {
+
+namespace {
+
+constexpr float kInvSampleMax = 1.0f / 65535.0f;
+
+/// Whether the sphere around `center` touches `box`.
+bool sphere_overlaps(const math::Vec3& center, float radius, const math::Aabb& box) {
+    const float dx = std::max({box.min.x - center.x, 0.0f, center.x - box.max.x});
+    const float dy = std::max({box.min.y - center.y, 0.0f, center.y - box.max.y});
+    const float dz = std::max({box.min.z - center.z, 0.0f, center.z - box.max.z});
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+} // namespace
+
+Heightfield Heightfield::from_image(const HeightImageData& image, float spacing, float height_scale,
+    float height_offset) {
+    Heightfield field;
+    if (image.pixels.size() != static_cast<size_t>(image.width) * image.height) {
+        std::cerr << "Heightfield::from_image: " << image.pixels.size() << " pixels for a " << image.width << "x"
+                  << image.height << " image\n";
+        return field;
+    }
+    field.width = image.width;
+    field.depth = image.height;
+    field.samples = image.pixels;
+    field.spacing = spacing;
+    field.height_scale = height_scale;
+    field.height_offset = height_offset;
+    return field;
+}
+
+float Heightfield::sample_height(int32_t x, int32_t z) const {
+    x = std::clamp(x, 0, static_cast<int32_t>(width) - 1);
+    z = std::clamp(z, 0, static_cast<int32_t>(depth) - 1);
+    const uint16_t s = samples[static_cast<size_t>(z) * width + static_cast<size_t>(x)];
+    return height_offset + height_scale * kInvSampleMax * static_cast<float>(s);
+}
+
+float Heightfield::height(float x, float z) const {
+    x = std::clamp(x, 0.0f, static_cast<float>(width - 1));
+    z = std::clamp(z, 0.0f, static_cast<float>(depth - 1));
+    const int32_t x0 = static_cast<int32_t>(x);
+    const int32_t z0 = static_cast<int32_t>(z);
+    const float fx = x - static_cast<float>(x0);
+    const float fz = z - static_cast<float>(z0);
+    if (fx == 0.0f && fz == 0.0f) {
+        // Grid vertices that are not morphing land exactly on samples.
+        return sample_height(x0, z0);
+    }
+    const float h00 = sample_height(x0, z0);
+    const float h10 = sample_height(x0 + 1, z0);
+    const float h01 = sample_height(x0, z0 + 1);
+    const float h11 = sample_height(x0 + 1, z0 + 1);
+    const float top = h00 + (h10 - h00) * fx;
+    const float bottom = h01 + (h11 - h01) * fx;
+    return top + (bottom - top) * fz;
+}
+
+math::Vec3 Heightfield::normal(float x, float z, float step) const {
+    const float dx = height(x + step, z) - height(x - step, z);
+    const float dz = height(x, z + step) - height(x, z - step);
+    return math::Vec3(-dx, 2.0f * step * spacing, -dz).normalized();
+}
+
+bool load_heightfield(const std::string& path, float spacing, float height_scale, Heightfield& out) {
+    HeightImageData image;
+    if (!ImageLoader::read_gray16(path, image)) {
+        return false;
+    }
+    out = Heightfield::from_image(image, spacing, height_scale);
+    return !out.empty();
+}
+
+Terrain::Terrain(GraphicsDevice& device, Heightfield heightfield, const TerrainSettings& settings)
+    : m_device(device), m_heightfield(std::move(heightfield)), m_settings(settings), m_vertex_buffer(device) {
+    m_settings.chunk_quads = std::max(2u, std::bit_ceil(m_settings.chunk_quads));
+    m_settings.lod_count = std::max(1u, m_settings.lod_count);
+    m_vertices_per_chunk = (m_settings.chunk_quads + 1) * (m_settings.chunk_quads + 1);
+    for (uint32_t lod = 0; lod < m_settings.lod_count; ++lod) {
+        m_ranges.push_back(m_settings.lod0_range * static_cast<float>(1u << lod));
+    }
+    // Nothing is coarser than the top LOD; it covers whatever lies beyond.
+    m_ranges.back() = std::numeric_limits<float>::max();
+    build_mips();
+    build_indices(device);
+}
+
+Terrain::~Terrain() {
+    if (m_indices.handle != INVALID_HANDLE) {
+        m_device.destroy_index_buffer(m_indices);
+    }
+}
+
+void Terrain::build_mips() {
+    m_mips.resize(m_settings.lod_count);
+    const uint32_t quads_x = std::max(1u, m_heightfield.width - 1);
+    const uint32_t quads_z = std::max(1u, m_heightfield.depth - 1);
+    for (uint32_t lod = 0; lod < m_settings.lod_count; ++lod) {
+        const uint32_t node_samples = m_settings.chunk_quads << lod;
+        MipLevel& mip = m_mips[lod];
+        mip.nodes_x = (quads_x + node_samples - 1) / node_samples;
+        mip.nodes_z = (quads_z + node_samples - 1) / node_samples;
+        mip.heights.assign(static_cast<size_t>(mip.nodes_x) * mip.nodes_z,
+            MinMax{std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()});
+    }
+    if (m_heightfield.empty()) {
+        return;
+    }
+
+    // Level 0 from the samples (edges shared with neighbors), then each level from its children.
+    MipLevel& leaves = m_mips[0];
+    const int32_t n = static_cast<int32_t>(m_settings.chunk_quads);
+    for (uint32_t z = 0; z < leaves.nodes_z; ++z) {
+        for (uint32_t x = 0; x < leaves.nodes_x; ++x) {
+            MinMax& range = leaves.heights[z * leaves.nodes_x + x];
+            for (int32_t sz = 0; sz <= n; ++sz) {
+                for (int32_t sx = 0; sx <= n; ++sx) {
+                    const float h = m_heightfield.sample_height(static_cast<int32_t>(x) * n + sx,
+                        static_cast<int32_t>(z) * n + sz);
+                    range.min = std::min(range.min, h);
+                    range.max = std::max(range.max, h);
+                }
+            }
+        }
+    }
+    for (uint32_t lod = 1; lod < m_settings.lod_count; ++lod) {
+        const MipLevel& below = m_mips[lod - 1];
+        MipLevel& mip = m_mips[lod];
+        for (uint32_t z = 0; z < mip.nodes_z; ++z) {
+            for (uint32_t x = 0; x < mip.nodes_x; ++x) {
+                MinMax& range = mip.heights[z * mip.nodes_x + x];
+                for (uint32_t q = 0; q < 4; ++q) {
+                    const uint32_t cx = x * 2 + (q & 1);
+                    const uint32_t cz = z * 2 + (q >> 1);
+                    if (cx < below.nodes_x && cz < below.nodes_z) {
+                        const MinMax& child = below.heights[cz * below.nodes_x + cx];
+                        range.min = std::min(range.min, child.min);
+                        range.max = std::max(range.max, child.max);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Terrain::build_indices(GraphicsDevice& device) {
+    const uint32_t n = m_settings.chunk_quads;
+    const uint32_t half = n / 2;
+    const uint32_t stride = n + 1;
+    std::vector<uint32_t> grid;
+    grid.reserve(static_cast<size_t>(n) * n * 6);
+    for (uint32_t q = 0; q < 4; ++q) {
+        const uint32_t x0 = (q & 1) * half;
+        const uint32_t z0 = (q >> 1) * half;
+        for (uint32_t z = z0; z < z0 + half; ++z) {
+            for (uint32_t x = x0; x < x0 + half; ++x) {
+                const uint32_t a = z * stride + x;
+                // Counter-clockwise seen from above.
+                grid.insert(grid.end(), {a, a + stride, a + 1, a + 1, a + stride, a + stride + 1});
+            }
+        }
+    }
+    m_indices_per_quadrant = half * half * 6;
+
+    std::vector<uint32_t> indices;
+    indices.reserve(grid.size() * m_settings.max_chunks);
+    for (uint32_t slot = 0; slot < m_settings.max_chunks; ++slot) {
+        const uint32_t base = slot * m_vertices_per_chunk;
+        for (uint32_t index : grid) {
+            indices.push_back(base + index);
+        }
+    }
+    m_indices = device.create_index_buffer(indices.data(), indices.size() * sizeof(uint32_t));
+}
+
+bool Terrain::node_exists(uint32_t lod, uint32_t x, uint32_t z) const {
+    return x < m_mips[lod].nodes_x && z < m_mips[lod].nodes_z;
+}
+
+math::Aabb Terrain::node_bounds(uint32_t lod, uint32_t x, uint32_t z) const {
+    const MipLevel& mip = m_mips[lod];
+    const MinMax& range = mip.heights[z * mip.nodes_x + x];
+    const float size = static_cast<float>(m_settings.chunk_quads << lod) * m_heightfield.spacing;
+    const float max_x = static_cast<float>(std::max(1u, m_heightfield.width) - 1) * m_heightfield.spacing;
+    const float max_z = static_cast<float>(std::max(1u, m_heightfield.depth) - 1) * m_heightfield.spacing;
+    const float x0 = static_cast<float>(x) * size;
+    const float z0 = static_cast<float>(z) * size;
+    return math::Aabb(math::Vec3(x0, range.min, z0),
+        math::Vec3(std::min(x0 + size, max_x), range.max, std::min(z0 + size, max_z)));
+}
+
+void Terrain::select(uint32_t lod, uint32_t x, uint32_t z, const math::Vec3& camera, const math::Frustum& frustum) {
+    const math::Aabb bounds = node_bounds(lod, x, z);
+    if (!frustum.intersects(bounds)) {
+        return;
+    }
+    if (lod == 0 || !sphere_overlaps(camera, m_ranges[lod - 1], bounds)) {
+        m_chunks.push_back(TerrainChunk{lod, x, z, 0xF, bounds});
+        return;
+    }
+
+    // Children within the finer range recurse; the rest are drawn from this node's grid.
+    uint32_t mask = 0;
+    for (uint32_t q = 0; q < 4; ++q) {
+        const uint32_t cx = x * 2 + (q & 1);
+        const uint32_t cz = z * 2 + (q >> 1);
+        if (!node_exists(lod - 1, cx, cz)) {
+            continue;
+        }
+        const math::Aabb child = node_bounds(lod - 1, cx, cz);
+        if (sphere_overlaps(camera, m_ranges[lod - 1], child)) {
+            select(lod - 1, cx, cz, camera, frustum);
+        } else if (frustum.intersects(child)) {
+            mask |= 1u << q;
+        }
+    }
+    if (mask != 0) {
+        m_chunks.push_back(TerrainChunk{lod, x, z, mask, bounds});
+    }
+}
+
+void Terrain::write_chunk(const TerrainChunk& chunk, const math::Vec3& camera, Vertex* out) const {
+    const Heightfield& field = m_heightfield;
+    const uint32_t n = m_settings.chunk_quads;
+    const float step = static_cast<float>(1u << chunk.lod);
+    const float origin_x = static_cast<float>(chunk.x * (n << chunk.lod));
+    const float origin_z = static_cast<float>(chunk.z * (n << chunk.lod));
+    const float uv_x = 1.0f / static_cast<float>(std::max(1u, field.width - 1));
+    const float uv_z = 1.0f / static_cast<float>(std::max(1u, field.depth - 1));
+
+    // Morph band at the far end of this LOD's range.
+    const float end = m_ranges[chunk.lod];
+    const float start_of_band = chunk.lod == 0 ? 0.0f : m_ranges[chunk.lod - 1];
+    const float begin = end - (end - start_of_band) * m_settings.morph_fraction;
+    const bool morphs = chunk.lod + 1 < m_settings.lod_count;
+    const float inv_band = 1.0f / std::max(end - begin, 1e-6f);
+
+    for (uint32_t j = 0; j <= n; ++j) {
+        for (uint32_t i = 0; i <= n; ++i) {
+            float gx = static_cast<float>(i);
+            float gz = static_cast<float>(j);
+            if (morphs) {
+                const float sx = origin_x + gx * step;
+                const float sz = origin_z + gz * step;
+                const math::Vec3 p(sx * field.spacing, field.height(sx, sz), sz * field.spacing);
+                const float k = std::clamp(((p - camera).length() - begin) * inv_band, 0.0f, 1.0f);
+                // Odd grid vertices slide onto their even neighbor, i.e. onto the coarser grid.
+                gx -= static_cast<float>(i & 1) * k;
+                gz -= static_cast<float>(j & 1) * k;
+            }
+            const float sx = std::min(origin_x + gx * step, static_cast<float>(field.width - 1));
+            const float sz = std::min(origin_z + gz * step, static_cast<float>(field.depth - 1));
+            *out++ = Vertex(math::Vec3(sx * field.spacing, field.height(sx, sz), sz * field.spacing),
+                field.normal(sx, sz, step), math::Vec4(1.0f, 1.0f, 1.0f, 1.0f), math::Vec2(sx * uv_x, sz * uv_z));
+        }
+    }
+}
+
+void Terrain::update(const math::Vec3& camera_position, const math::Frustum& frustum, JobSystem& jobs) {
+    m_chunks.clear();
+    m_overflowed = false;
+    if (m_heightfield.empty()) {
+        return;
+    }
+    const uint32_t top = m_settings.lod_count - 1;
+    for (uint32_t z = 0; z < m_mips[top].nodes_z; ++z) {
+        for (uint32_t x = 0; x < m_mips[top].nodes_x; ++x) {
+            select(top, x, z, camera_position, frustum);
+        }
+    }
+    if (m_chunks.size() > m_settings.max_chunks) {
+        m_overflowed = true;
+        auto distance = [&camera_position](const TerrainChunk& c) {
+            return (c.bounds.center() - camera_position).length_squared();
+        };
+        std::nth_element(m_chunks.begin(), m_chunks.begin() + m_settings.max_chunks, m_chunks.end(),
+            [&distance](const TerrainChunk& a, const TerrainChunk& b) { return distance(a) < distance(b); });
+        m_chunks.resize(m_settings.max_chunks);
+    }
+
+    m_vertices.resize(static_cast<size_t>(m_chunks.size()) * m_vertices_per_chunk,
+        Vertex(math::Vec3(), math::Vec3(), math::Vec4()));
+    jobs.parallel_for(static_cast<uint32_t>(m_chunks.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t c = begin; c < end; ++c) {
+            write_chunk(m_chunks[c], camera_position, &m_vertices[static_cast<size_t>(c) * m_vertices_per_chunk]);
+        }
+    });
+    if (!m_vertices.empty()) {
+        m_uploaded = m_vertex_buffer.upload(m_vertices.data(), m_vertices.size() * sizeof(Vertex));
+    }
+}
+
+uint32_t Terrain::triangle_count() const {
+    uint32_t quadrants = 0;
+    for (const TerrainChunk& chunk : m_chunks) {
+        quadrants += static_cast<uint32_t>(std::popcount(chunk.quadrant_mask));
+    }
+    return quadrants * m_indices_per_quadrant / 3;
+}
+
+void Terrain::render(GraphicsDevice& device, UniformBufferHandle uniform_buffer, const Material& material,
+    const math::Mat4& view_projection, const DirectionalLighting& lighting,
+    const math::Vec3& camera_position_world) const {
+    if (m_chunks.empty()) {
+        return;
+    }
+    apply_draw_state(device, uniform_buffer, material, math::Mat4::identity(), view_projection, lighting,
+        camera_position_world);
+    device.bind_vertex_buffer(m_uploaded, 0);
+    const uint32_t chunk_indices = m_indices_per_quadrant * 4;
+    for (uint32_t c = 0; c < static_cast<uint32_t>(m_chunks.size()); ++c) {
+        // Adjacent quadrants are adjacent index ranges, so runs of set bits draw as one.
+        const uint32_t mask = m_chunks[c].quadrant_mask;
+        uint32_t q = 0;
+        while (q < 4) {
+            if ((mask & (1u << q)) == 0) {
+                ++q;
+                continue;
+            }
+            uint32_t run_end = q + 1;
+            while (run_end < 4 && (mask & (1u << run_end)) != 0) {
+                ++run_end;
+            }
+            device.draw_indexed_range(m_indices, c * chunk_indices + q * m_indices_per_quadrant,
+                (run_end - q) * m_indices_per_quadrant);
+            q = run_end;
+        }
+    }
+}
+
+} // namespace maya
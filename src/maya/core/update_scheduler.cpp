@@ -0,0 +1,117 @@
+#include "maya/core/update_scheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <utility>
+
+namespace maya {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Updates between clock reads while spending a budget.
+constexpr uint32_t kUpdatesPerClockCheck = 16;
+
+Clock::duration to_duration(double ms) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+}
+
+float period_of(float hz) {
+    return hz > 0.0f ? 1.0f / hz : std::numeric_limits<float>::max();
+}
+
+} // namespace
+
+float UpdateRate::hz(float distance, bool visible) const {
+    const float span = far_distance - near_distance;
+    const float t = span > 0.0f ? std::clamp((distance - near_distance) / span, 0.0f, 1.0f)
+                                : (distance > near_distance ? 1.0f : 0.0f);
+    const float rate = near_hz + (far_hz - near_hz) * t;
+    return visible ? rate : rate * hidden_scale;
+}
+
+UpdateScheduler::UpdateScheduler(float frame_budget_ms)
+    : m_frame_budget_ms(frame_budget_ms) {}
+
+uint32_t UpdateScheduler::add_system(const UpdateSystemSettings& settings, UpdateFunction update) {
+    const uint32_t id = static_cast<uint32_t>(m_systems.size());
+    m_systems.push_back(System{settings, std::move(update), {}, {}, 0, {}});
+    m_order.push_back(id);
+    std::stable_sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+        return m_systems[a].settings.priority > m_systems[b].settings.priority;
+    });
+    return id;
+}
+
+void UpdateScheduler::set_item_count(uint32_t system, uint32_t count) {
+    System& sys = m_systems[system];
+    sys.last.resize(count, m_time);
+    sys.period.resize(count, period_of(sys.settings.rate.near_hz));
+    if (sys.cursor >= count) {
+        sys.cursor = 0;
+    }
+}
+
+void UpdateScheduler::set_item_state(uint32_t system, uint32_t item, float distance, bool visible) {
+    System& sys = m_systems[system];
+    sys.period[item] = period_of(sys.settings.rate.hz(distance, visible) * m_rate_scale);
+}
+
+void UpdateScheduler::set_item_period(uint32_t system, uint32_t item, float seconds) {
+    m_systems[system].period[item] = seconds;
+}
+
+void UpdateScheduler::run(float delta_time) {
+    m_time += delta_time;
+    // Items due within half a frame run now, so a 60 Hz item is not skipped on a 60 Hz frame
+    // that arrives a hair early.
+    const double slack = 0.5 * delta_time;
+    const Clock::time_point frame_deadline = Clock::now() + to_duration(m_frame_budget_ms);
+
+    for (uint32_t id : m_order) {
+        System& sys = m_systems[id];
+        sys.stats = UpdateSystemStats{};
+        const uint32_t count = static_cast<uint32_t>(sys.last.size());
+        if (count == 0) {
+            continue;
+        }
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point deadline = sys.settings.budget_ms > 0.0f
+            ? std::min(frame_deadline, start + to_duration(sys.settings.budget_ms))
+            : frame_deadline;
+
+        bool out_of_time = false;
+        uint32_t resume = sys.cursor;
+        uint32_t item = sys.cursor;
+        for (uint32_t scanned = 0; scanned < count; ++scanned, item = item + 1 == count ? 0 : item + 1) {
+            const double elapsed = m_time - sys.last[item];
+            if (elapsed + slack < sys.period[item]) {
+                continue;
+            }
+            ++sys.stats.due;
+            if (out_of_time) {
+                continue;
+            }
+            if (sys.stats.updated % kUpdatesPerClockCheck == 0 && Clock::now() >= deadline) {
+                out_of_time = true;
+                resume = item;
+                continue;
+            }
+            sys.update(item, static_cast<float>(elapsed));
+            sys.last[item] = m_time;
+            ++sys.stats.updated;
+            sys.stats.max_elapsed = std::max(sys.stats.max_elapsed, static_cast<float>(elapsed));
+        }
+        // Round-robin: the first due item that did not fit starts the next run.
+        if (out_of_time) {
+            sys.cursor = resume;
+        }
+
+        sys.stats.time_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const float budget = sys.settings.budget_ms > 0.0f ? sys.settings.budget_ms : m_frame_budget_ms;
+        sys.stats.utilization = budget > 0.0f ? static_cast<float>(sys.stats.time_ms / budget) : 0.0f;
+    }
+}
+
+} // namespace maya
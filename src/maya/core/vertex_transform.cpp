@@ -0,0 +1,43 @@
+#include "maya/core/vertex_transform.hpp"
+#include "maya/math/simd.hpp"
+
+namespace maya {
+
+using math::simd::Float4;
+
+void transform_vertices(const Vertex* in, Vertex* out, size_t count, const math::Mat4& model,
+    const math::Mat4& normal_matrix) {
+    // Column-major storage: each matrix column is four contiguous floats.
+    const Float4 m0 = Float4::load(&model.elements[0]);
+    const Float4 m1 = Float4::load(&model.elements[4]);
+    const Float4 m2 = Float4::load(&model.elements[8]);
+    const Float4 m3 = Float4::load(&model.elements[12]);
+    const Float4 n0 = Float4::load(&normal_matrix.elements[0]);
+    const Float4 n1 = Float4::load(&normal_matrix.elements[4]);
+    const Float4 n2 = Float4::load(&normal_matrix.elements[8]);
+    const Float4 xyz_mask = Float4::set(1.0f, 1.0f, 1.0f, 0.0f);
+    const Float4 tiny = Float4::splat(1e-24f);
+
+    alignas(16) float p[4];
+    alignas(16) float n[4];
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex& src = in[i];
+        const Float4 wp = Float4::madd(m0, Float4::splat(src.position.x),
+            Float4::madd(m1, Float4::splat(src.position.y), Float4::madd(m2, Float4::splat(src.position.z), m3)));
+        Float4 wn = Float4::madd(n0, Float4::splat(src.normal.x),
+            Float4::madd(n1, Float4::splat(src.normal.y), n2 * Float4::splat(src.normal.z))) * xyz_mask;
+        const Float4 len_sq = Float4::dot(wn, wn);
+        wn = Float4::select(Float4::greater(len_sq, tiny), wn / Float4::sqrt(len_sq), wn);
+        wp.store(p);
+        wn.store(n);
+
+        Vertex& dst = out[i];
+        if (&dst != &src) {
+            dst = src;
+        }
+        dst.position = math::Vec3(p[0], p[1], p[2]);
+        dst.normal = math::Vec3(n[0], n[1], n[2]);
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,394 @@
+#include "maya/core/view_culling.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/math/simd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace maya {
+
+using math::simd::Float4;
+
+namespace {
+
+constexpr uint32_t kPlanesPerView = 8;
+constexpr uint32_t kFloatsPerView = kPlanesPerView * 4;
+constexpr float kPaddingPlaneOffset = 1.0e30f;
+
+} // namespace
+
+uint32_t ViewSet::add_view(const CullView& view) {
+    if (m_views.size() >= kMaxCullViews) {
+        return kMaxCullViews;
+    }
+    ViewState state;
+    state.view = view;
+    state.frustum = math::Frustum::from_view_projection(view.view_projection);
+    m_views.push_back(std::move(state));
+    m_temporal_valid = false;
+    pack_planes();
+    return static_cast<uint32_t>(m_views.size() - 1);
+}
+
+void ViewSet::set_view(uint32_t index, const CullView& view) {
+    // Frustum motion is tracked; a new distance limit invalidates the stored margins.
+    m_temporal_valid = m_temporal_valid && m_views[index].view.max_distance == view.max_distance;
+    m_views[index].view = view;
+    m_views[index].frustum = math::Frustum::from_view_projection(view.view_projection);
+    pack_planes();
+}
+
+void ViewSet::set_view(uint32_t index, const CullView& view, const math::Frustum& frustum) {
+    m_temporal_valid = m_temporal_valid && m_views[index].view.max_distance == view.max_distance;
+    m_views[index].view = view;
+    m_views[index].frustum = frustum;
+    pack_planes();
+}
+
+void ViewSet::clear() {
+    m_views.clear();
+    m_packed_planes.clear();
+    m_temporal_valid = false;
+}
+
+void ViewSet::enable_temporal_coherence(const TemporalCullingSettings& settings) {
+    m_temporal_enabled = true;
+    m_temporal = settings;
+    m_temporal.refresh_period = std::max<uint32_t>(settings.refresh_period, 1);
+    m_temporal_valid = false;
+}
+
+void ViewSet::disable_temporal_coherence() {
+    m_temporal_enabled = false;
+    m_temporal_valid = false;
+    m_tested_frame.clear();
+    m_margins.clear();
+    m_cached_models.clear();
+    m_cached_meshes.clear();
+}
+
+void ViewSet::pack_planes() {
+    m_packed_planes.assign(m_views.size() * kFloatsPerView, 0.0f);
+    for (size_t v = 0; v < m_views.size(); ++v) {
+        float* dst = m_packed_planes.data() + v * kFloatsPerView;
+        for (uint32_t p = 0; p < kPlanesPerView; ++p) {
+            if (p < 6) {
+                const math::Plane& plane = m_views[v].frustum.planes[p];
+                dst[p] = plane.normal.x;
+                dst[kPlanesPerView + p] = plane.normal.y;
+                dst[2 * kPlanesPerView + p] = plane.normal.z;
+                dst[3 * kPlanesPerView + p] = plane.d;
+            } else {
+                // Padding plane: zero normal, large offset, never rejects or limits margins.
+                dst[3 * kPlanesPerView + p] = kPaddingPlaneOffset;
+            }
+        }
+    }
+}
+
+uint32_t ViewSet::test_views(const math::Aabb& box, float* margins) const {
+    const math::Vec3 c = box.center();
+    const math::Vec3 e = box.extents();
+    const Float4 cx = Float4::splat(c.x);
+    const Float4 cy = Float4::splat(c.y);
+    const Float4 cz = Float4::splat(c.z);
+    const Float4 ex = Float4::splat(e.x);
+    const Float4 ey = Float4::splat(e.y);
+    const Float4 ez = Float4::splat(e.z);
+    const float radius = e.length();
+    const Float4 zero = Float4::zero();
+
+    uint32_t mask = 0;
+    for (uint32_t v = 0; v < static_cast<uint32_t>(m_views.size()); ++v) {
+        const CullView& view = m_views[v].view;
+        float margin = std::numeric_limits<float>::max();
+        if (view.max_distance < std::numeric_limits<float>::max()) {
+            const float beyond = (c - view.position).length() - radius - view.max_distance;
+            if (beyond > 0.0f) {
+                if (margins) {
+                    margins[v] = beyond;
+                }
+                continue;
+            }
+            margin = -beyond;
+        }
+        const float* planes = m_packed_planes.data() + v * kFloatsPerView;
+        int outside = 0;
+        Float4 nearest = Float4::splat(kPaddingPlaneOffset);
+        for (uint32_t half = 0; half < kPlanesPerView; half += 4) {
+            const Float4 nx = Float4::load(planes + half);
+            const Float4 ny = Float4::load(planes + kPlanesPerView + half);
+            const Float4 nz = Float4::load(planes + 2 * kPlanesPerView + half);
+            const Float4 d = Float4::load(planes + 3 * kPlanesPerView + half);
+            // Distance of the box corner furthest along each plane normal.
+            const Float4 dist = Float4::madd(nx, cx, Float4::madd(ny, cy, Float4::madd(nz, cz, d)))
+                + Float4::madd(Float4::abs(nx), ex, Float4::madd(Float4::abs(ny), ey, Float4::abs(nz) * ez));
+            outside |= Float4::less(dist, zero).move_mask();
+            nearest = Float4::min(nearest, dist);
+        }
+        if (outside == 0) {
+            mask |= 1u << v;
+        }
+        if (margins) {
+            // Inside: the closest plane bounds how far the box may move and stay visible.
+            // Outside: the most negative plane bounds how far it may move and stay culled.
+            const float closest = std::min(std::min(nearest.lane(0), nearest.lane(1)),
+                                           std::min(nearest.lane(2), nearest.lane(3)));
+            margins[v] = std::min(margin, std::fabs(closest));
+        }
+    }
+    return mask;
+}
+
+void ViewSet::track_view_motion(bool reset) {
+    const uint32_t period = m_temporal.refresh_period;
+    for (ViewState& state : m_views) {
+        if (reset || state.history.size() != period) {
+            state.motion = ViewMotion{};
+            state.history.assign(period, ViewMotion{});
+        } else {
+            // For a point x, each plane's distance changes by
+            // (n1 - n0) . camera + (d1 - d0) + (n1 - n0) . (x - camera).
+            float shift = 0.0f;
+            float turn = 0.0f;
+            for (size_t p = 0; p < state.frustum.planes.size(); ++p) {
+                const math::Plane& now = state.frustum.planes[p];
+                const math::Plane& before = state.culled_frustum.planes[p];
+                const math::Vec3 dn = now.normal - before.normal;
+                shift = std::max(shift, std::fabs(math::Vec3::dot(dn, state.view.position) + now.d - before.d));
+                turn = std::max(turn, dn.length());
+            }
+            state.motion.shift += shift;
+            state.motion.turn += turn;
+            state.motion.travel += (state.view.position - state.culled_position).length();
+        }
+        state.history[m_frame % period] = state.motion;
+        state.culled_frustum = state.frustum;
+        state.culled_position = state.view.position;
+    }
+}
+
+bool ViewSet::is_stale(uint32_t item, const math::Aabb& box) const {
+    const uint32_t views = static_cast<uint32_t>(m_views.size());
+    const float* margins = m_margins.data() + static_cast<size_t>(item) * views;
+    const uint32_t slot = m_tested_frame[item] % m_temporal.refresh_period;
+    const math::Vec3 c = box.center();
+    const float radius = box.extents().length();
+    for (uint32_t v = 0; v < views; ++v) {
+        const ViewState& state = m_views[v];
+        const ViewMotion& then = state.history[slot];
+        const double travel = state.motion.travel - then.travel;
+        const double reach = (c - state.view.position).length() + radius + travel;
+        const double drift = (state.motion.shift - then.shift) + travel + (state.motion.turn - then.turn) * reach;
+        if (drift >= margins[v]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ViewSet::update_pvs_rows(const Scene& scene) {
+    const PotentiallyVisibleSet* pvs = scene.pvs();
+    const bool current = m_pvs_scene == &scene && m_pvs_version == scene.structure_version();
+    m_pvs_views = 0;
+    for (uint32_t v = 0; v < static_cast<uint32_t>(m_views.size()); ++v) {
+        ViewState& state = m_views[v];
+        if (!pvs || !state.view.use_pvs) {
+            continue;
+        }
+        m_pvs_views |= 1u << v;
+        // Rows only change when the view crosses into another cell.
+        const uint32_t cell = pvs->cell_at(state.view.position);
+        if (!current || cell != state.pvs_cell || state.pvs_bits.empty()) {
+            pvs->decompress(cell, state.pvs_bits);
+            state.pvs_cell = cell;
+        }
+    }
+    m_pvs_scene = &scene;
+    m_pvs_version = scene.structure_version();
+}
+
+void ViewSet::select_hlod(const Scene& scene) {
+    for (ViewState& state : m_views) {
+        state.hlod_proxies.clear();
+    }
+    const HlodTree* hlod = scene.hlod();
+    if (!hlod) {
+        m_hlod_leaf_masks.clear();
+        return;
+    }
+    const std::vector<HlodCluster>& clusters = hlod->clusters();
+    m_hlod_leaf_masks.assign(hlod->leaf_count(), 0);
+    m_cluster_masks.resize(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        m_cluster_masks[c] = test_views(clusters[c].bounds);
+    }
+    const float threshold = hlod->settings().switch_screen_size;
+    for (uint32_t v = 0; v < static_cast<uint32_t>(m_views.size()); ++v) {
+        const uint32_t bit = 1u << v;
+        const CullView& view = m_views[v].view;
+        m_hlod_stack.clear();
+        for (uint32_t r = 0; r < hlod->root_count(); ++r) {
+            m_hlod_stack.push_back(hlod->first_root() + r);
+        }
+        while (!m_hlod_stack.empty()) {
+            const uint32_t c = m_hlod_stack.back();
+            m_hlod_stack.pop_back();
+            // Outside the view: the covered ranges are culled on their own.
+            if (!(m_cluster_masks[c] & bit)) {
+                continue;
+            }
+            const HlodCluster& cluster = clusters[c];
+            const float distance = std::max((cluster.bounds.center() - view.position).length(), 1e-4f);
+            if (view.lod_scale * cluster.bounds.extents().length() / distance < threshold) {
+                m_views[v].hlod_proxies.push_back(c);
+                for (uint32_t leaf = cluster.first_leaf; leaf < cluster.first_leaf + cluster.leaf_count; ++leaf) {
+                    m_hlod_leaf_masks[leaf] |= bit;
+                }
+                continue;
+            }
+            // Level 0 clusters too large on screen draw their objects.
+            for (uint32_t child = 0; child < cluster.child_count; ++child) {
+                m_hlod_stack.push_back(cluster.first_child + child);
+            }
+        }
+    }
+}
+
+void ViewSet::cull(const Scene& scene, JobSystem& jobs) {
+    const std::vector<SceneObject>& objects = scene.objects();
+    const uint32_t object_count = static_cast<uint32_t>(objects.size());
+    const std::vector<StaticBatch>& batches = scene.static_batches();
+    m_batch_range_offsets.resize(batches.size());
+    uint32_t range_total = 0;
+    for (size_t b = 0; b < batches.size(); ++b) {
+        m_batch_range_offsets[b] = range_total;
+        range_total += static_cast<uint32_t>(batches[b].ranges.size());
+    }
+
+    const uint32_t views = static_cast<uint32_t>(m_views.size());
+    const size_t item_count = static_cast<size_t>(object_count) + range_total;
+    const bool temporal = m_temporal_enabled;
+    const bool reuse = temporal && m_temporal_valid && m_scene == &scene
+        && m_scene_version == scene.structure_version()
+        && m_object_masks.size() == object_count && m_range_masks.size() == range_total
+        && m_margins.size() == item_count * views;
+    if (temporal) {
+        track_view_motion(!reuse);
+    }
+    if (!reuse) {
+        m_object_masks.assign(object_count, 0);
+        m_world_bounds.assign(object_count, math::Aabb{});
+        m_range_masks.assign(range_total, 0);
+        if (temporal) {
+            m_tested_frame.assign(item_count, m_frame);
+            m_margins.assign(item_count * views, 0.0f);
+            m_cached_models.resize(object_count);
+            m_cached_meshes.assign(object_count, nullptr);
+        }
+    }
+    if (!reuse) {
+        const HlodTree* hlod = scene.hlod();
+        m_range_sources.resize(range_total);
+        m_range_leaves.resize(range_total);
+        for (size_t b = 0; b < batches.size(); ++b) {
+            for (size_t r = 0; r < batches[b].ranges.size(); ++r) {
+                const uint32_t source = batches[b].ranges[r].source_object;
+                m_range_sources[m_batch_range_offsets[b] + r] = source;
+                m_range_leaves[m_batch_range_offsets[b] + r] = hlod ? hlod->leaf_of(source) : kNoHlodCluster;
+            }
+        }
+    }
+    update_pvs_rows(scene);
+    const uint32_t period = m_temporal.refresh_period;
+    // Staggered so each frame refreshes about 1/period of the items.
+    auto due = [&](uint32_t item) { return (m_frame + item) % period == 0; };
+    std::atomic<uint32_t> retested{0};
+
+    jobs.parallel_for(object_count, 256, [&](uint32_t begin, uint32_t end) {
+        uint32_t tested = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            const SceneObject& obj = objects[i];
+            if (!obj.mesh) {
+                m_object_masks[i] = 0;
+                continue;
+            }
+            const bool moved = !reuse || m_cached_meshes[i] != obj.mesh
+                || std::memcmp(&m_cached_models[i], &obj.model_matrix, sizeof(math::Mat4)) != 0;
+            if (!moved && !due(i) && !is_stale(i, m_world_bounds[i])) {
+                continue;
+            }
+            if (moved) {
+                m_world_bounds[i] = obj.mesh->local_bounds().transformed(obj.model_matrix);
+            }
+            if (temporal) {
+                m_cached_meshes[i] = obj.mesh;
+                m_cached_models[i] = obj.model_matrix;
+                m_tested_frame[i] = m_frame;
+                m_object_masks[i] = test_views(m_world_bounds[i], m_margins.data() + static_cast<size_t>(i) * views);
+            } else {
+                m_object_masks[i] = test_views(m_world_bounds[i]);
+            }
+            ++tested;
+        }
+        retested.fetch_add(tested, std::memory_order_relaxed);
+    });
+
+    jobs.parallel_for(static_cast<uint32_t>(batches.size()), 1, [&](uint32_t begin, uint32_t end) {
+        uint32_t tested = 0;
+        for (uint32_t b = begin; b < end; ++b) {
+            const std::vector<StaticBatchRange>& ranges = batches[b].ranges;
+            for (size_t r = 0; r < ranges.size(); ++r) {
+                const uint32_t slot = m_batch_range_offsets[b] + static_cast<uint32_t>(r);
+                const uint32_t item = object_count + slot;
+                if (reuse && !due(item) && !is_stale(item, ranges[r].world_bounds)) {
+                    continue;
+                }
+                if (temporal) {
+                    m_tested_frame[item] = m_frame;
+                    m_range_masks[slot] = test_views(ranges[r].world_bounds, m_margins.data() + static_cast<size_t>(item) * views);
+                } else {
+                    m_range_masks[slot] = test_views(ranges[r].world_bounds);
+                }
+                ++tested;
+            }
+        }
+        retested.fetch_add(tested, std::memory_order_relaxed);
+    });
+    m_retested = retested.load();
+    select_hlod(scene);
+    if (temporal) {
+        m_temporal_valid = true;
+        m_scene = &scene;
+        m_scene_version = scene.structure_version();
+        ++m_frame;
+    }
+
+    for (ViewState& state : m_views) {
+        state.visible.clear();
+    }
+    for (uint32_t i = 0; i < object_count; ++i) {
+        uint32_t mask = m_object_masks[i];
+        if (mask == 0) {
+            continue;
+        }
+        const math::Aabb& box = m_world_bounds[i];
+        const math::Vec3 c = box.center();
+        const float radius = box.extents().length();
+        while (mask != 0) {
+            const uint32_t v = static_cast<uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+            const CullView& view = m_views[v].view;
+            const float distance = std::max((c - view.position).length(), 1e-4f);
+            m_views[v].visible.push_back({i, view.lod_scale * radius / distance});
+        }
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,442 @@
+#include "maya/core/world_streamer.hpp"
+#include "maya/core/file_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/texture.hpp"
+#include "maya/math/math_utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+// Cell manifest (`<directory>/cell_<x>_<z>.txt`), one entry per line, paths relative to the
+// manifest directory, `#` starts a comment:
+//
+//   mesh <file.obj>                        -> mesh index 0, 1, ...
+//   texture <image file>                   -> texture index 0, 1, ...
+//   object <mesh> <texture|-1> <x> <y> <z> [<yaw degrees> [<uniform scale>]]
+
+namespace maya {
+
+namespace {
+
+float distance_xz(const math::Vec3& a, const math::Vec3& b) {
+    const float dx = a.x - b.x;
+    const float dz = a.z - b.z;
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+bool parse_manifest(const std::string& text, const std::string& directory, const std::string& name,
+    WorldCellContent& out) {
+    std::stringstream ss(text);
+    std::string line;
+    while (std::getline(ss, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::stringstream ls(line);
+        std::string type;
+        if (!(ls >> type)) continue;
+
+        if (type == "mesh") {
+            std::string path;
+            ls >> path;
+            MeshData data;
+            if (!ModelLoader::read_obj(directory + "/" + path, data)) {
+                return false;
+            }
+            out.meshes.push_back(std::move(data));
+        } else if (type == "texture") {
+            std::string path;
+            ls >> path;
+            ImageData image;
+            if (!ImageLoader::read(directory + "/" + path, image)) {
+                return false;
+            }
+            out.textures.push_back(std::move(image));
+        } else if (type == "object") {
+            WorldCellObject object;
+            math::Vec3 position;
+            float yaw = 0.0f;
+            float scale = 1.0f;
+            if (!(ls >> object.mesh >> object.texture >> position.x >> position.y >> position.z)
+                || object.mesh >= out.meshes.size()
+                || object.texture >= static_cast<int32_t>(out.textures.size())) {
+                std::cerr << "Invalid object line in world cell " << name << ": " << line << std::endl;
+                return false;
+            }
+            ls >> yaw >> scale;
+            object.model_matrix = math::Mat4::translate(position)
+                * math::Mat4::rotate_y(math::to_radians(yaw))
+                * math::Mat4::scale(math::Vec3(scale));
+            out.objects.push_back(object);
+        } else {
+            std::cerr << "Unknown entry in world cell " << name << ": " << type << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+size_t WorldCellContent::byte_size() const {
+    size_t bytes = 0;
+    for (const MeshData& mesh : meshes) {
+        bytes += mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(uint32_t);
+    }
+    for (const ImageData& image : textures) {
+        bytes += image.pixels.size();
+    }
+    return bytes;
+}
+
+WorldStreamer::WorldStreamer(const WorldStreamingSettings& settings, WorldCellLoader loader)
+    : m_settings(settings), m_loader(std::move(loader)) {
+    m_threads.reserve(settings.loader_threads);
+    for (uint32_t i = 0; i < settings.loader_threads; ++i) {
+        m_threads.emplace_back([this] { loader_loop(); });
+    }
+}
+
+WorldStreamer::~WorldStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_work_available.notify_all();
+    for (std::thread& t : m_threads) {
+        t.join();
+    }
+}
+
+WorldCellLoader WorldStreamer::manifest_loader(const std::string& directory) {
+    // Sets up the FileSystem search roots on this thread; loader threads only read them.
+    FileSystem::resolve(directory);
+    return [directory](const WorldCell& cell, WorldCellContent& out) {
+        const std::string manifest = directory + "/cell_" + std::to_string(cell.x) + "_" + std::to_string(cell.z) + ".txt";
+        if (!FileSystem::resolve(manifest)) {
+            return true;
+        }
+        return parse_manifest(FileSystem::read_text(manifest), directory, manifest, out);
+    };
+}
+
+WorldCell WorldStreamer::cell_at(const math::Vec3& position) const {
+    return WorldCell{static_cast<int32_t>(std::floor(position.x / m_settings.cell_size)),
+                     static_cast<int32_t>(std::floor(position.z / m_settings.cell_size))};
+}
+
+math::Vec3 WorldStreamer::cell_center(const WorldCell& cell) const {
+    return math::Vec3((static_cast<float>(cell.x) + 0.5f) * m_settings.cell_size, 0.0f,
+                      (static_cast<float>(cell.z) + 0.5f) * m_settings.cell_size);
+}
+
+bool WorldStreamer::is_resident(const WorldCell& cell) const {
+    auto it = m_cells.find(cell);
+    return it != m_cells.end() && it->second.state == CellState::Resident;
+}
+
+uint32_t WorldStreamer::resident_cell_count() const {
+    return static_cast<uint32_t>(std::count_if(m_cells.begin(), m_cells.end(),
+        [](const auto& entry) { return entry.second.state == CellState::Resident; }));
+}
+
+uint32_t WorldStreamer::in_flight_count() const {
+    return static_cast<uint32_t>(std::count_if(m_cells.begin(), m_cells.end(),
+        [](const auto& entry) { return entry.second.state == CellState::Requested; }));
+}
+
+float WorldStreamer::priority_of(const WorldCell& cell) const {
+    const math::Vec3 center = cell_center(cell);
+    return std::min(distance_xz(center, m_camera_position), distance_xz(center, m_predicted_position));
+}
+
+void WorldStreamer::update(Scene& scene, GraphicsDevice& device, const math::Vec3& camera_position, float delta_time) {
+    if (!m_has_camera) {
+        m_has_camera = true;
+    } else if ((camera_position - m_camera_position).length() > m_settings.unload_radius) {
+        m_velocity = math::Vec3(); // Teleport: no motion to extrapolate.
+    } else if (delta_time > 0.0f) {
+        const math::Vec3 instant = (camera_position - m_camera_position) * (1.0f / delta_time);
+        const float alpha = std::min(1.0f, delta_time * 4.0f);
+        m_velocity = m_velocity + (instant - m_velocity) * alpha;
+    }
+    m_camera_position = camera_position;
+    math::Vec3 ahead = m_velocity * m_settings.velocity_lookahead;
+    // Never predict past the load ring, so prefetch cannot starve the cells around the camera.
+    const float ahead_length = ahead.length();
+    if (ahead_length > m_settings.load_radius) {
+        ahead = ahead * (m_settings.load_radius / ahead_length);
+    }
+    m_predicted_position = camera_position + ahead;
+
+    collect_completed();
+
+    std::vector<WorldCell> out_of_range;
+    for (auto& [cell, record] : m_cells) {
+        record.priority = priority_of(cell);
+        const float limit = record.state == CellState::Requested ? m_settings.load_radius : m_settings.unload_radius;
+        if (record.priority > limit) {
+            out_of_range.push_back(cell);
+        }
+    }
+    for (const WorldCell& cell : out_of_range) {
+        evict(scene, cell);
+    }
+
+    request_cells();
+    if (m_threads.empty()) {
+        while (load_next()) {}
+        collect_completed();
+    }
+    integrate(scene, device);
+}
+
+void WorldStreamer::unload_all(Scene& scene) {
+    std::vector<WorldCell> cells;
+    cells.reserve(m_cells.size());
+    for (const auto& entry : m_cells) {
+        cells.push_back(entry.first);
+    }
+    for (const WorldCell& cell : cells) {
+        evict(scene, cell);
+    }
+}
+
+void WorldStreamer::request_cells() {
+    const float radius = m_settings.load_radius;
+    const float cs = m_settings.cell_size;
+    const int32_t min_x = static_cast<int32_t>(std::floor((std::min(m_camera_position.x, m_predicted_position.x) - radius) / cs));
+    const int32_t max_x = static_cast<int32_t>(std::floor((std::max(m_camera_position.x, m_predicted_position.x) + radius) / cs));
+    const int32_t min_z = static_cast<int32_t>(std::floor((std::min(m_camera_position.z, m_predicted_position.z) - radius) / cs));
+    const int32_t max_z = static_cast<int32_t>(std::floor((std::max(m_camera_position.z, m_predicted_position.z) + radius) / cs));
+
+    std::vector<std::pair<float, WorldCell>> candidates;
+    for (int32_t z = min_z; z <= max_z; ++z) {
+        for (int32_t x = min_x; x <= max_x; ++x) {
+            const WorldCell cell{x, z};
+            if (m_cells.count(cell) != 0) {
+                continue;
+            }
+            const float priority = priority_of(cell);
+            if (priority <= radius) {
+                candidates.emplace_back(priority, cell);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    uint32_t in_flight = in_flight_count();
+    float farthest_resident = -1.0f;
+    for (const auto& [cell, record] : m_cells) {
+        if (record.state == CellState::Integrating || record.state == CellState::Resident) {
+            farthest_resident = std::max(farthest_resident, record.priority);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [priority, cell] : candidates) {
+        if (in_flight >= m_settings.max_in_flight) {
+            break;
+        }
+        // Cells known not to fit are only worth loading if something farther can make room.
+        auto known = m_known_bytes.find(cell);
+        const size_t estimate = known != m_known_bytes.end() ? known->second : 0;
+        if (m_resident_bytes + estimate > m_settings.memory_budget_bytes && farthest_resident <= priority) {
+            continue;
+        }
+        CellRecord& record = m_cells[cell];
+        record.request = m_next_request++;
+        record.priority = priority;
+        m_queue.push_back({cell, record.request, priority});
+        ++in_flight;
+    }
+    for (Request& request : m_queue) {
+        auto it = m_cells.find(request.cell);
+        if (it != m_cells.end()) {
+            request.priority = it->second.priority;
+        }
+    }
+    if (!m_queue.empty()) {
+        m_work_available.notify_all();
+    }
+}
+
+void WorldStreamer::loader_loop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_work_available.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+        }
+        load_next();
+    }
+}
+
+bool WorldStreamer::load_next() {
+    Request request;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.empty()) {
+            return false;
+        }
+        auto nearest = std::min_element(m_queue.begin(), m_queue.end(),
+            [](const Request& a, const Request& b) { return a.priority < b.priority; });
+        request = *nearest;
+        *nearest = m_queue.back();
+        m_queue.pop_back();
+    }
+
+    auto content = std::make_unique<WorldCellContent>();
+    const bool ok = m_loader(request.cell, *content);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_completed.push_back({request.cell, request.id, ok, std::move(content)});
+    return true;
+}
+
+void WorldStreamer::collect_completed() {
+    std::vector<Completed> done;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        done.swap(m_completed);
+    }
+    for (Completed& completed : done) {
+        auto it = m_cells.find(completed.cell);
+        if (it == m_cells.end() || it->second.request != completed.id || it->second.state != CellState::Requested) {
+            continue; // Cancelled while loading.
+        }
+        if (!completed.ok) {
+            std::cerr << "World cell (" << completed.cell.x << ", " << completed.cell.z
+                      << ") failed to load; leaving it empty." << std::endl;
+            completed.content = std::make_unique<WorldCellContent>();
+        }
+        m_known_bytes[completed.cell] = completed.content->byte_size();
+        it->second.content = std::move(completed.content);
+        it->second.state = CellState::Loaded;
+    }
+}
+
+void WorldStreamer::integrate(Scene& scene, GraphicsDevice& device) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now()
+        + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(m_settings.integration_budget_ms));
+
+    for (;;) {
+        // Finish the cell in progress before starting the nearest loaded one.
+        CellRecord* next = nullptr;
+        WorldCell next_cell;
+        for (auto& [cell, record] : m_cells) {
+            if (record.state == CellState::Integrating) {
+                next = &record;
+                next_cell = cell;
+                break;
+            }
+            if (record.state == CellState::Loaded && (!next || record.priority < next->priority)) {
+                next = &record;
+                next_cell = cell;
+            }
+        }
+        if (!next) {
+            return;
+        }
+
+        if (next->state == CellState::Loaded) {
+            const size_t bytes = next->content->byte_size();
+            if (!make_room(scene, bytes, next->priority)) {
+                m_cells.erase(next_cell);
+                continue;
+            }
+            next->bytes = bytes;
+            m_resident_bytes += bytes;
+            next->textures.resize(next->content->textures.size());
+            next->meshes.assign(next->content->meshes.size(), nullptr);
+            next->state = CellState::Integrating;
+        }
+
+        if (integrate_step(scene, device, *next)) {
+            next->content.reset();
+            next->state = CellState::Resident;
+        }
+        if (Clock::now() >= deadline) {
+            return;
+        }
+    }
+}
+
+bool WorldStreamer::integrate_step(Scene& scene, GraphicsDevice& device, CellRecord& record) {
+    const WorldCellContent& content = *record.content;
+    if (record.next_texture < content.textures.size()) {
+        const ImageData& image = content.textures[record.next_texture];
+        if (!image.pixels.empty()) {
+            record.textures[record.next_texture] = std::make_unique<Texture>(device, image.pixels.data(), image.width, image.height);
+        }
+        ++record.next_texture;
+        return false;
+    }
+    if (record.next_object < content.objects.size()) {
+        const WorldCellObject& object = content.objects[record.next_object++];
+        if (object.mesh >= content.meshes.size()) {
+            return record.next_object >= content.objects.size();
+        }
+        Mesh*& mesh = record.meshes[object.mesh];
+        if (!mesh) {
+            const MeshData& data = content.meshes[object.mesh];
+            mesh = scene.add_mesh(std::make_unique<Mesh>(device, data.vertices, data.indices));
+        }
+        Texture* texture = object.texture >= 0 && static_cast<size_t>(object.texture) < record.textures.size()
+            ? record.textures[object.texture].get() : nullptr;
+        const Material material{texture ? m_settings.textured_pipeline : m_settings.untextured_pipeline, texture};
+        scene.objects().push_back(SceneObject{mesh, material, object.model_matrix});
+    }
+    return record.next_object >= content.objects.size();
+}
+
+bool WorldStreamer::make_room(Scene& scene, size_t bytes, float priority) {
+    while (m_resident_bytes + bytes > m_settings.memory_budget_bytes) {
+        const WorldCell* farthest = nullptr;
+        float farthest_priority = priority;
+        for (const auto& [cell, record] : m_cells) {
+            if ((record.state == CellState::Resident || record.state == CellState::Integrating)
+                && record.priority > farthest_priority) {
+                farthest = &cell;
+                farthest_priority = record.priority;
+            }
+        }
+        if (!farthest) {
+            return false;
+        }
+        evict(scene, WorldCell(*farthest));
+    }
+    return true;
+}
+
+void WorldStreamer::evict(Scene& scene, const WorldCell& cell) {
+    auto it = m_cells.find(cell);
+    if (it == m_cells.end()) {
+        return;
+    }
+    CellRecord& record = it->second;
+    if (record.state == CellState::Requested) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::erase_if(m_queue, [&](const Request& r) { return r.id == record.request; });
+    } else if (record.state == CellState::Integrating || record.state == CellState::Resident) {
+        std::vector<const Mesh*> meshes;
+        for (Mesh* mesh : record.meshes) {
+            if (mesh) {
+                meshes.push_back(mesh);
+            }
+        }
+        scene.remove_meshes(meshes);
+        m_resident_bytes -= record.bytes;
+    }
+    // Textures are released here, after the objects that referenced them are gone.
+    m_cells.erase(it);
+}
+
+} // namespace maya
@@ -2,8 +2,10 @@
 #include "maya/platform/input.hpp"
 #include <GLFW/glfw3.h>
 
+#if defined(__APPLE__)
 #define GLFW_EXPOSE_NATIVE_COCOA
 #include <GLFW/glfw3native.h>
+#endif
 
 namespace maya {
 
@@ -63,7 +65,7 @@ Window::~Window() {
 }
 
 bool Window::should_close() const {
-    return glfwWindowShouldClose(m_window);
+    return !m_window || glfwWindowShouldClose(m_window);
 }
 
 void Window::poll_events() {
@@ -71,7 +73,12 @@ void Window::poll_events() {
 }
 
 void* Window::get_native_handle() const {
+#if defined(__APPLE__)
     return glfwGetCocoaWindow(m_window);
+#else
+    // Non-Metal backends only need a non-null token (or the GLFW window itself).
+    return m_window;
+#endif
 }
 
 } // namespace maya
@@ -0,0 +1,29 @@
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/rhi/null/null_device.hpp"
+#include "maya/rhi/software/software_device.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__APPLE__)
+#include "maya/rhi/metal/metal_device.hpp"
+#endif
+
+namespace maya {
+
+std::unique_ptr<GraphicsDevice> GraphicsDevice::create_default() {
+    const char* backend = std::getenv("MAYA_RHI");
+    if (backend && std::strcmp(backend, "null") == 0) {
+        return std::make_unique<NullDevice>();
+    }
+    if (backend && std::strcmp(backend, "software") == 0) {
+        return std::make_unique<SoftwareDevice>(JobSystem::instance());
+    }
+#if defined(__APPLE__)
+    return std::make_unique<MetalDevice>();
+#else
+    return std::make_unique<NullDevice>();
+#endif
+}
+
+} // namespace maya
@@ -4,10 +4,6 @@
 
 namespace maya {
 
-std::unique_ptr<GraphicsDevice> GraphicsDevice::create_default() {
-    return std::make_unique<MetalDevice>();
-}
-
 MetalDevice::MetalDevice() 
     : m_device(nil)
     , m_command_queue(nil)
@@ -146,7 +142,9 @@ namespace {
     template<typename HandleType>
     HandleType create_buffer_helper(id<MTLDevice> device, std::map<uint32_t, id<MTLBuffer>>& buffers, 
                                     uint32_t& next_handle, const void* data, size_t size) {
-        id<MTLBuffer> buffer = [device newBufferWithBytes:data length:size options:MTLResourceStorageModeShared];
+        id<MTLBuffer> buffer = data
+            ? [device newBufferWithBytes:data length:size options:MTLResourceStorageModeShared]
+            : [device newBufferWithLength:size options:MTLResourceStorageModeShared];
         if (buffer) {
             uint32_t handle = next_handle++;
             buffers[handle] = buffer;
@@ -164,6 +162,30 @@ IndexBufferHandle MetalDevice::create_index_buffer(const void* data, size_t size
     return create_buffer_helper<IndexBufferHandle>(m_device, m_buffers, m_next_handle, data, size);
 }
 
+void MetalDevice::update_vertex_buffer(VertexBufferHandle handle, const void* data, size_t size) {
+    auto it = m_buffers.find(handle.handle);
+    if (it != m_buffers.end() && size <= it->second.length) {
+        memcpy(it->second.contents, data, size);
+    }
+}
+
+void MetalDevice::update_index_buffer(IndexBufferHandle handle, const void* data, size_t size) {
+    auto it = m_buffers.find(handle.handle);
+    if (it != m_buffers.end() && size <= it->second.length) {
+        memcpy(it->second.contents, data, size);
+    }
+}
+
+// Command buffers retain the resources they reference, so erasing (releasing) here is safe
+// even while a frame that uses the buffer is still in flight.
+void MetalDevice::destroy_vertex_buffer(VertexBufferHandle handle) {
+    m_buffers.erase(handle.handle);
+}
+
+void MetalDevice::destroy_index_buffer(IndexBufferHandle handle) {
+    m_buffers.erase(handle.handle);
+}
+
 UniformBufferHandle MetalDevice::create_uniform_buffer(size_t size) {
     id<MTLBuffer> buffer = [m_device newBufferWithLength:size options:MTLResourceStorageModeShared];
     if (buffer) {
@@ -208,6 +230,10 @@ TextureHandle MetalDevice::create_texture(const void* data, uint32_t width, uint
     return {handle};
 }
 
+void MetalDevice::destroy_texture(TextureHandle handle) {
+    m_textures.erase(handle.handle);
+}
+
 void MetalDevice::begin_frame() {
     m_current_command_buffer = [m_command_queue commandBuffer];
     
@@ -273,6 +299,30 @@ void MetalDevice::draw_indexed(IndexBufferHandle handle, uint32_t index_count) {
     }
 }
 
+void MetalDevice::draw_indexed_range(IndexBufferHandle handle, uint32_t first_index, uint32_t index_count) {
+    auto it = m_buffers.find(handle.handle);
+    if (it != m_buffers.end()) {
+        [m_current_encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle 
+                           indexCount:index_count 
+                            indexType:MTLIndexTypeUInt32 
+                          indexBuffer:it->second 
+                    indexBufferOffset:static_cast<NSUInteger>(first_index) * sizeof(uint32_t)];
+    }
+}
+
+void MetalDevice::draw(PrimitiveTopology topology, uint32_t first_vertex, uint32_t vertex_count) {
+    if (!m_current_encoder) {
+        return;
+    }
+    MTLPrimitiveType type = MTLPrimitiveTypeTriangle;
+    if (topology == PrimitiveTopology::Lines) {
+        type = MTLPrimitiveTypeLine;
+    } else if (topology == PrimitiveTopology::Points) {
+        type = MTLPrimitiveTypePoint;
+    }
+    [m_current_encoder drawPrimitives:type vertexStart:first_vertex vertexCount:vertex_count];
+}
+
 void MetalDevice::end_frame() {
     if (m_current_encoder) {
         [m_current_encoder endEncoding];
@@ -0,0 +1,390 @@
+#include "maya/rhi/null/null_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+namespace maya {
+
+namespace {
+
+bool is_identifier_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+/// True if `name` appears in `source` as a whole identifier followed by `(`: a function
+/// declaration or definition, which is all the null backend can check without a compiler.
+bool defines_function(const std::string& source, const std::string& name) {
+    if (name.empty()) {
+        return false;
+    }
+    for (size_t pos = source.find(name); pos != std::string::npos; pos = source.find(name, pos + 1)) {
+        if (pos > 0 && is_identifier_char(source[pos - 1])) {
+            continue;
+        }
+        size_t end = pos + name.size();
+        while (end < source.size() && std::isspace(static_cast<unsigned char>(source[end]))) {
+            ++end;
+        }
+        if (end < source.size() && source[end] == '(') {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* kind_name(uint8_t kind) {
+    static const char* const kNames[] = {"vertex", "index", "uniform"};
+    return kNames[kind];
+}
+
+} // namespace
+
+NullDevice::NullDevice(bool validate_indices) : m_validate_indices(validate_indices) {}
+
+NullDevice::~NullDevice() {
+    shutdown();
+}
+
+bool NullDevice::initialize(void* native_window_handle) {
+    (void)native_window_handle;
+    m_initialized = true;
+    return true;
+}
+
+void NullDevice::shutdown() {
+    m_buffers.clear();
+    m_textures.clear();
+    m_pipelines.clear();
+    m_bound_pipeline = INVALID_HANDLE;
+    m_bound_buffers.fill(INVALID_HANDLE);
+    m_bound_textures.fill(INVALID_HANDLE);
+    m_in_frame = false;
+    m_initialized = false;
+}
+
+void NullDevice::resize(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+    m_width = width;
+    m_height = height;
+}
+
+void NullDevice::begin_frame() {
+    if (m_in_frame) {
+        report("begin_frame", "previous frame was not ended");
+    }
+    m_in_frame = true;
+    // Like a fresh render encoder, a frame starts with nothing bound.
+    m_bound_pipeline = INVALID_HANDLE;
+    m_bound_buffers.fill(INVALID_HANDLE);
+    m_bound_textures.fill(INVALID_HANDLE);
+    const uint64_t uploaded = m_frame_stats.bytes_uploaded;
+    m_frame_stats = FrameStats{};
+    m_frame_stats.bytes_uploaded = uploaded;
+}
+
+void NullDevice::end_frame() {
+    if (!m_in_frame) {
+        report("end_frame", "no frame in progress");
+        return;
+    }
+    m_in_frame = false;
+    m_last_frame_stats = m_frame_stats;
+    m_frame_stats = FrameStats{};
+}
+
+PipelineHandle NullDevice::create_pipeline(const std::string& shader_source,
+    const std::string& vertex_entry,
+    const std::string& fragment_entry) {
+    if (!m_initialized) {
+        report("create_pipeline", "device not initialized");
+        return {INVALID_HANDLE};
+    }
+    if (!defines_function(shader_source, vertex_entry) || !defines_function(shader_source, fragment_entry)) {
+        report("create_pipeline", "missing vertex function '" + vertex_entry + "' or fragment function '" +
+            fragment_entry + "'");
+        return {INVALID_HANDLE};
+    }
+    const ResourceHandle handle = m_next_handle++;
+    m_pipelines[handle] = Pipeline{vertex_entry, fragment_entry};
+    return {handle};
+}
+
+void NullDevice::bind_pipeline(PipelineHandle handle) {
+    if (!m_in_frame) {
+        report("bind_pipeline", "called outside begin_frame/end_frame");
+        return;
+    }
+    if (m_pipelines.find(handle.handle) == m_pipelines.end()) {
+        report("bind_pipeline", "unknown pipeline " + std::to_string(handle.handle));
+        return;
+    }
+    m_bound_pipeline = handle.handle;
+    ++m_frame_stats.pipeline_binds;
+}
+
+ResourceHandle NullDevice::create_buffer(BufferKind kind, const void* data, size_t size, const char* call) {
+    if (!m_initialized) {
+        report(call, "device not initialized");
+        return INVALID_HANDLE;
+    }
+    if (size == 0) {
+        report(call, "zero-sized buffer");
+        return INVALID_HANDLE;
+    }
+    Buffer buffer{kind, std::vector<uint8_t>(size)};
+    if (data) {
+        std::memcpy(buffer.data.data(), data, size);
+        m_frame_stats.bytes_uploaded += size;
+    }
+    const ResourceHandle handle = m_next_handle++;
+    m_buffers.emplace(handle, std::move(buffer));
+    return handle;
+}
+
+NullDevice::Buffer* NullDevice::find_buffer(BufferKind kind, ResourceHandle handle, const char* call) {
+    auto it = m_buffers.find(handle);
+    if (it == m_buffers.end()) {
+        report(call, "unknown or destroyed buffer " + std::to_string(handle));
+        return nullptr;
+    }
+    if (it->second.kind != kind) {
+        report(call, std::string("buffer ") + std::to_string(handle) + " is a " +
+            kind_name(static_cast<uint8_t>(it->second.kind)) + " buffer, expected " +
+            kind_name(static_cast<uint8_t>(kind)));
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void NullDevice::update_buffer(BufferKind kind, ResourceHandle handle, const void* data, size_t size,
+    const char* call) {
+    Buffer* buffer = find_buffer(kind, handle, call);
+    if (!buffer) {
+        return;
+    }
+    if (size > buffer->data.size()) {
+        report(call, std::to_string(size) + " bytes written to a " + std::to_string(buffer->data.size()) +
+            "-byte buffer");
+        return;
+    }
+    if (size > 0) {
+        std::memcpy(buffer->data.data(), data, size);
+    }
+    m_frame_stats.bytes_uploaded += size;
+}
+
+void NullDevice::destroy_buffer(BufferKind kind, ResourceHandle handle, const char* call) {
+    if (find_buffer(kind, handle, call)) {
+        m_buffers.erase(handle);
+    }
+}
+
+VertexBufferHandle NullDevice::create_vertex_buffer(const void* data, size_t size) {
+    return {create_buffer(BufferKind::Vertex, data, size, "create_vertex_buffer")};
+}
+
+IndexBufferHandle NullDevice::create_index_buffer(const void* data, size_t size) {
+    return {create_buffer(BufferKind::Index, data, size, "create_index_buffer")};
+}
+
+void NullDevice::update_vertex_buffer(VertexBufferHandle handle, const void* data, size_t size) {
+    update_buffer(BufferKind::Vertex, handle.handle, data, size, "update_vertex_buffer");
+}
+
+void NullDevice::update_index_buffer(IndexBufferHandle handle, const void* data, size_t size) {
+    update_buffer(BufferKind::Index, handle.handle, data, size, "update_index_buffer");
+}
+
+void NullDevice::destroy_vertex_buffer(VertexBufferHandle handle) {
+    destroy_buffer(BufferKind::Vertex, handle.handle, "destroy_vertex_buffer");
+}
+
+void NullDevice::destroy_index_buffer(IndexBufferHandle handle) {
+    destroy_buffer(BufferKind::Index, handle.handle, "destroy_index_buffer");
+}
+
+UniformBufferHandle NullDevice::create_uniform_buffer(size_t size) {
+    return {create_buffer(BufferKind::Uniform, nullptr, size, "create_uniform_buffer")};
+}
+
+void NullDevice::update_uniform_buffer(UniformBufferHandle handle, const void* data, size_t size) {
+    update_buffer(BufferKind::Uniform, handle.handle, data, size, "update_uniform_buffer");
+}
+
+TextureHandle NullDevice::create_texture(const void* data, uint32_t width, uint32_t height) {
+    if (!m_initialized) {
+        report("create_texture", "device not initialized");
+        return {INVALID_HANDLE};
+    }
+    if (width == 0 || height == 0 || !data) {
+        report("create_texture", "empty texture or missing pixel data");
+        return {INVALID_HANDLE};
+    }
+    const size_t size = static_cast<size_t>(width) * height * 4;
+    Texture texture{width, height, std::vector<uint8_t>(size)};
+    std::memcpy(texture.pixels.data(), data, size);
+    m_frame_stats.bytes_uploaded += size;
+    const ResourceHandle handle = m_next_handle++;
+    m_textures.emplace(handle, std::move(texture));
+    return {handle};
+}
+
+void NullDevice::destroy_texture(TextureHandle handle) {
+    if (m_textures.erase(handle.handle) == 0) {
+        report("destroy_texture", "unknown or destroyed texture " + std::to_string(handle.handle));
+    }
+}
+
+void NullDevice::bind_vertex_buffer(VertexBufferHandle handle, uint32_t slot) {
+    if (!m_in_frame) {
+        report("bind_vertex_buffer", "called outside begin_frame/end_frame");
+        return;
+    }
+    if (slot >= kMaxBufferSlots) {
+        report("bind_vertex_buffer", "slot " + std::to_string(slot) + " out of range");
+        return;
+    }
+    if (find_buffer(BufferKind::Vertex, handle.handle, "bind_vertex_buffer")) {
+        m_bound_buffers[slot] = handle.handle;
+    }
+}
+
+void NullDevice::bind_uniform_buffer(UniformBufferHandle handle, uint32_t slot) {
+    if (!m_in_frame) {
+        report("bind_uniform_buffer", "called outside begin_frame/end_frame");
+        return;
+    }
+    if (slot >= kMaxBufferSlots) {
+        report("bind_uniform_buffer", "slot " + std::to_string(slot) + " out of range");
+        return;
+    }
+    if (find_buffer(BufferKind::Uniform, handle.handle, "bind_uniform_buffer")) {
+        m_bound_buffers[slot] = handle.handle;
+    }
+}
+
+void NullDevice::bind_texture(TextureHandle handle, uint32_t slot) {
+    if (!m_in_frame) {
+        report("bind_texture", "called outside begin_frame/end_frame");
+        return;
+    }
+    if (slot >= kMaxTextureSlots) {
+        report("bind_texture", "slot " + std::to_string(slot) + " out of range");
+        return;
+    }
+    if (m_textures.find(handle.handle) == m_textures.end()) {
+        report("bind_texture", "unknown or destroyed texture " + std::to_string(handle.handle));
+        return;
+    }
+    m_bound_textures[slot] = handle.handle;
+}
+
+bool NullDevice::validate_draw(const char* call) {
+    if (!m_in_frame) {
+        report(call, "called outside begin_frame/end_frame");
+        return false;
+    }
+    if (m_bound_pipeline == INVALID_HANDLE) {
+        report(call, "no pipeline bound");
+        return false;
+    }
+    if (m_bound_buffers[0] == INVALID_HANDLE) {
+        report(call, "no vertex buffer bound at slot 0");
+        return false;
+    }
+    return find_buffer(BufferKind::Vertex, m_bound_buffers[0], call) != nullptr;
+}
+
+void NullDevice::draw_indexed(IndexBufferHandle handle, uint32_t index_count) {
+    draw_indexed_range(handle, 0, index_count);
+}
+
+void NullDevice::draw_indexed_range(IndexBufferHandle handle, uint32_t first_index, uint32_t index_count) {
+    const char* call = "draw_indexed";
+    if (!validate_draw(call)) {
+        return;
+    }
+    const Buffer* indices = find_buffer(BufferKind::Index, handle.handle, call);
+    if (!indices) {
+        return;
+    }
+    const size_t available = indices->data.size() / sizeof(uint32_t);
+    if (static_cast<size_t>(first_index) + index_count > available) {
+        report(call, "indices [" + std::to_string(first_index) + ", " + std::to_string(first_index + index_count) +
+            ") exceed the " + std::to_string(available) + "-index buffer");
+        return;
+    }
+    if (m_validate_indices) {
+        // Indexed geometry always uses the engine `Vertex` layout.
+        const uint32_t vertex_count = static_cast<uint32_t>(m_buffers.at(m_bound_buffers[0]).data.size() / sizeof(Vertex));
+        const uint32_t* data = reinterpret_cast<const uint32_t*>(indices->data.data()) + first_index;
+        for (uint32_t i = 0; i < index_count; ++i) {
+            if (data[i] >= vertex_count) {
+                report(call, "index " + std::to_string(data[i]) + " at " + std::to_string(first_index + i) +
+                    " exceeds the " + std::to_string(vertex_count) + "-vertex buffer");
+                return;
+            }
+        }
+    }
+    ++m_frame_stats.draw_calls;
+    m_frame_stats.indices += index_count;
+    execute(DrawCall{PrimitiveTopology::Triangles, &m_pipelines.at(m_bound_pipeline),
+        &m_buffers.at(m_bound_buffers[0]).data,
+        reinterpret_cast<const uint32_t*>(indices->data.data()), first_index, index_count});
+}
+
+void NullDevice::draw(PrimitiveTopology topology, uint32_t first_vertex, uint32_t vertex_count) {
+    // The vertex stride depends on the pipeline (debug lines use 16 bytes), so ranges are left
+    // to backends that run the vertex function.
+    if (!validate_draw("draw")) {
+        return;
+    }
+    ++m_frame_stats.draw_calls;
+    m_frame_stats.vertices += vertex_count;
+    execute(DrawCall{topology, &m_pipelines.at(m_bound_pipeline), &m_buffers.at(m_bound_buffers[0]).data, nullptr,
+        first_vertex, vertex_count});
+}
+
+const std::vector<uint8_t>* NullDevice::buffer_data(ResourceHandle handle) const {
+    auto it = m_buffers.find(handle);
+    return it != m_buffers.end() ? &it->second.data : nullptr;
+}
+
+const std::vector<uint8_t>* NullDevice::texture_data(TextureHandle handle) const {
+    auto it = m_textures.find(handle.handle);
+    return it != m_textures.end() ? &it->second.pixels : nullptr;
+}
+
+const std::vector<uint8_t>* NullDevice::bound_buffer(uint32_t slot) const {
+    if (slot >= kMaxBufferSlots) {
+        return nullptr;
+    }
+    auto it = m_buffers.find(m_bound_buffers[slot]);
+    return it != m_buffers.end() ? &it->second.data : nullptr;
+}
+
+const NullDevice::Texture* NullDevice::bound_texture(uint32_t slot) const {
+    if (slot >= kMaxTextureSlots) {
+        return nullptr;
+    }
+    auto it = m_textures.find(m_bound_textures[slot]);
+    return it != m_textures.end() ? &it->second : nullptr;
+}
+
+const NullDevice::Pipeline* NullDevice::find_pipeline(PipelineHandle handle) const {
+    auto it = m_pipelines.find(handle.handle);
+    return it != m_pipelines.end() ? &it->second : nullptr;
+}
+
+void NullDevice::report(const char* call, const std::string& message) {
+    ++m_validation_errors;
+    m_last_validation_error = std::string(call) + ": " + message;
+    if (m_log_validation_errors) {
+        std::cerr << "NullDevice: " << m_last_validation_error << std::endl;
+    }
+}
+
+} // namespace maya
@@ -0,0 +1,642 @@
+#include "maya/rhi/software/software_device.hpp"
+#include "maya/core/debug_draw.hpp"
+#include "maya/core/image_writer.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/math/simd.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace maya {
+
+namespace {
+
+using math::simd::Float4;
+
+// `VertexOut` varying offsets.
+constexpr uint32_t kWorldPosition = 0;
+constexpr uint32_t kWorldNormal = 3;
+constexpr uint32_t kColor = 6;
+constexpr uint32_t kUv = 10;
+
+constexpr uint32_t kPlaneCount = 6;
+/// Clip-space x/y limit in units of w. Triangles inside it skip clipping; the rasterizer only
+/// visits pixels on screen, so the band just bounds coordinate magnitudes.
+constexpr float kGuardBand = 4.0f;
+/// Vertex positions snap to 1/256 pixel so edge setup is reproducible.
+constexpr float kSubpixels = 256.0f;
+constexpr uint32_t kVertexChunk = 1024;
+constexpr uint32_t kNoVertex = std::numeric_limits<uint32_t>::max();
+
+math::Vec3 multiply(const math::Vec3& a, const math::Vec3& b) {
+    return {a.x * b.x, a.y * b.y, a.z * b.z};
+}
+
+float saturate(float x) {
+    return std::clamp(x, 0.0f, 1.0f);
+}
+
+math::Vec3 xyz(const math::Vec4& v) {
+    return {v.x, v.y, v.z};
+}
+
+math::Vec4 texel(const uint8_t* pixels, uint32_t width, uint32_t x, uint32_t y) {
+    const uint8_t* p = pixels + (static_cast<size_t>(y) * width + x) * 4;
+    constexpr float kScale = 1.0f / 255.0f;
+    return {p[0] * kScale, p[1] * kScale, p[2] * kScale, p[3] * kScale};
+}
+
+/// Linear filtering with repeat addressing, as the `MetalDevice` sampler (texel centers at +0.5).
+math::Vec4 sample_bilinear(const uint8_t* pixels, uint32_t width, uint32_t height, float u, float v) {
+    const float x = u * static_cast<float>(width) - 0.5f;
+    const float y = v * static_cast<float>(height) - 0.5f;
+    const float fx = std::floor(x);
+    const float fy = std::floor(y);
+    const float tx = x - fx;
+    const float ty = y - fy;
+    auto wrap = [](float i, uint32_t n) {
+        const int64_t m = static_cast<int64_t>(i) % static_cast<int64_t>(n);
+        return static_cast<uint32_t>(m < 0 ? m + n : m);
+    };
+    const uint32_t x0 = wrap(fx, width);
+    const uint32_t x1 = wrap(fx + 1.0f, width);
+    const uint32_t y0 = wrap(fy, height);
+    const uint32_t y1 = wrap(fy + 1.0f, height);
+    const math::Vec4 top = texel(pixels, width, x0, y0) * (1.0f - tx) + texel(pixels, width, x1, y0) * tx;
+    const math::Vec4 bottom = texel(pixels, width, x0, y1) * (1.0f - tx) + texel(pixels, width, x1, y1) * tx;
+    return top * (1.0f - ty) + bottom * ty;
+}
+
+/// `sh_ambient` in triangle.metal.
+math::Vec3 sh_ambient(const math::Vec4* sh, const math::Vec3& n) {
+    math::Vec3 result = xyz(sh[0]) * 0.282095f;
+    result += (xyz(sh[1]) * n.y + xyz(sh[2]) * n.z + xyz(sh[3]) * n.x) * 0.488603f;
+    result += (xyz(sh[4]) * (n.x * n.y) + xyz(sh[5]) * (n.y * n.z) + xyz(sh[7]) * (n.x * n.z)) * 1.092548f;
+    result += xyz(sh[6]) * (0.315392f * (3.0f * n.z * n.z - 1.0f));
+    result += xyz(sh[8]) * (0.546274f * (n.x * n.x - n.y * n.y));
+    return {std::max(result.x, 0.0f), std::max(result.y, 0.0f), std::max(result.z, 0.0f)};
+}
+
+/// `fragmentMain` in triangle.metal; `pixels` may be null for an unbound texture.
+math::Vec4 fragment_main(const SceneDrawUniforms& uniforms, const float* in, const uint8_t* pixels,
+    uint32_t width, uint32_t height) {
+    const math::Vec4 tex_color = pixels ? sample_bilinear(pixels, width, height, in[kUv], in[kUv + 1])
+                                        : math::Vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    const math::Vec3 world_position(in[kWorldPosition], in[kWorldPosition + 1], in[kWorldPosition + 2]);
+    const math::Vec3 n = math::Vec3(in[kWorldNormal], in[kWorldNormal + 1], in[kWorldNormal + 2]).normalized();
+    const math::Vec3 l = xyz(uniforms.light_dir_world).normalized();
+    const float ndotl = saturate(math::Vec3::dot(n, l));
+
+    const math::Vec3 v = (xyz(uniforms.camera_position_world) - world_position).normalized();
+    const math::Vec3 h = (l + v).normalized();
+    const float shininess = std::max(uniforms.specular_rgb_shininess.w, 1.0f);
+    const float spec_mask = std::pow(saturate(math::Vec3::dot(n, h)), shininess);
+
+    const math::Vec3 albedo = multiply(xyz(tex_color), math::Vec3(in[kColor], in[kColor + 1], in[kColor + 2]));
+    const math::Vec3 light = xyz(uniforms.light_diffuse_rgb);
+    const math::Vec3 rgb = multiply(sh_ambient(uniforms.ambient_sh, n), albedo) + multiply(light, albedo) * ndotl +
+        multiply(xyz(uniforms.specular_rgb_shininess), light) * spec_mask;
+    return math::Vec4(rgb, tex_color.w * in[kColor + 3]);
+}
+
+/// Unorm conversion of the color attachment (NaN writes 0).
+uint32_t pack_unorm8(const math::Vec4& c) {
+    auto channel = [](float x) {
+        x = x > 0.0f ? (x < 1.0f ? x : 1.0f) : 0.0f;
+        return static_cast<uint32_t>(x * 255.0f + 0.5f);
+    };
+    return channel(c.x) | channel(c.y) << 8 | channel(c.z) << 16 | channel(c.w) << 24;
+}
+
+} // namespace
+
+SoftwareDevice::SoftwareDevice(JobSystem& jobs, uint32_t width, uint32_t height)
+    : NullDevice(false)
+    , m_jobs(jobs)
+    , m_pending_width(width)
+    , m_pending_height(height) {
+    NullDevice::resize(width, height);
+    apply_size();
+}
+
+PipelineHandle SoftwareDevice::create_pipeline(const std::string& shader_source,
+    const std::string& vertex_entry,
+    const std::string& fragment_entry) {
+    if ((vertex_entry != "vertexMain" && vertex_entry != "vertexDebug") ||
+        (fragment_entry != "fragmentMain" && fragment_entry != "fragmentUnlit")) {
+        report("create_pipeline", "no software implementation of '" + vertex_entry + "' / '" + fragment_entry + "'");
+        return {INVALID_HANDLE};
+    }
+    return NullDevice::create_pipeline(shader_source, vertex_entry, fragment_entry);
+}
+
+void SoftwareDevice::resize(uint32_t width, uint32_t height) {
+    NullDevice::resize(width, height);
+    if (width != 0 && height != 0) {
+        m_pending_width = width;
+        m_pending_height = height;
+    }
+}
+
+void SoftwareDevice::apply_size() {
+    if (m_pending_width == m_width && m_pending_height == m_height) {
+        return;
+    }
+    m_width = m_pending_width;
+    m_height = m_pending_height;
+    m_stride = (m_width + 3) & ~3u;
+    m_tiles_x = (m_width + kTileSize - 1) / kTileSize;
+    m_tiles_y = (m_height + kTileSize - 1) / kTileSize;
+    m_color.assign(static_cast<size_t>(m_stride) * m_height, pack_unorm8(m_clear_color));
+    m_depth.assign(static_cast<size_t>(m_stride) * m_height, 1.0f);
+    m_bins.resize(static_cast<size_t>(m_tiles_x) * m_tiles_y);
+    m_image.width = m_width;
+    m_image.height = m_height;
+    m_image.pixels.assign(static_cast<size_t>(m_width) * m_height * 4, 0);
+}
+
+void SoftwareDevice::begin_frame() {
+    NullDevice::begin_frame();
+    apply_size();
+    m_vertices.clear();
+    m_triangles.clear();
+    m_states.clear();
+    for (std::vector<uint32_t>& bin : m_bins) {
+        bin.clear();
+    }
+    m_frame_stats = RasterStats{};
+}
+
+void SoftwareDevice::end_frame() {
+    if (!in_frame()) {
+        NullDevice::end_frame();
+        return;
+    }
+    NullDevice::end_frame();
+
+    const uint32_t tile_count = m_tiles_x * m_tiles_y;
+    m_tile_fragments.assign(tile_count, 0);
+    m_jobs.parallel_for(tile_count, 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t tile = begin; tile < end; ++tile) {
+            rasterize_tile(tile);
+        }
+    });
+    for (uint64_t fragments : m_tile_fragments) {
+        m_frame_stats.fragments += fragments;
+    }
+    m_stats = m_frame_stats;
+
+    for (uint32_t y = 0; y < m_height; ++y) {
+        const uint32_t* src = m_color.data() + static_cast<size_t>(y) * m_stride;
+        uint8_t* dst = m_image.pixels.data() + static_cast<size_t>(y) * m_width * 4;
+        for (uint32_t x = 0; x < m_width; ++x) {
+            dst[x * 4 + 0] = static_cast<uint8_t>(src[x]);
+            dst[x * 4 + 1] = static_cast<uint8_t>(src[x] >> 8);
+            dst[x * 4 + 2] = static_cast<uint8_t>(src[x] >> 16);
+            dst[x * 4 + 3] = static_cast<uint8_t>(src[x] >> 24);
+        }
+    }
+}
+
+bool SoftwareDevice::write_png(const std::string& path) const {
+    return ImageWriter::write_png(path, m_image);
+}
+
+void SoftwareDevice::execute(const DrawCall& draw) {
+    const char* call = draw.indices ? "draw_indexed" : "draw";
+    if (draw.count == 0) {
+        return;
+    }
+    const std::vector<uint8_t>* uniform_buffer = bound_buffer(1);
+    if (!uniform_buffer) {
+        report(call, "no uniform buffer bound at slot 1");
+        return;
+    }
+
+    const VertexFunction vertex_function =
+        draw.pipeline->vertex_entry == "vertexDebug" ? VertexFunction::Debug : VertexFunction::Main;
+    const size_t stride = vertex_function == VertexFunction::Debug ? sizeof(DebugVertex) : sizeof(Vertex);
+    const uint64_t vertex_count = draw.vertices->size() / stride;
+
+    // Only the referenced vertex range is shaded.
+    uint64_t lo = draw.first;
+    uint64_t hi = static_cast<uint64_t>(draw.first) + draw.count;
+    if (draw.indices) {
+        const uint32_t* indices = draw.indices + draw.first;
+        const auto [min_it, max_it] = std::minmax_element(indices, indices + draw.count);
+        lo = *min_it;
+        hi = static_cast<uint64_t>(*max_it) + 1;
+    }
+    if (hi > vertex_count) {
+        report(call, "vertex " + std::to_string(hi - 1) + " exceeds the " + std::to_string(vertex_count) +
+            "-vertex buffer");
+        return;
+    }
+
+    DrawState state{};
+    std::memcpy(&state.uniforms, uniform_buffer->data(), std::min(uniform_buffer->size(), sizeof(SceneDrawUniforms)));
+    state.texture = bound_texture(0);
+    state.fragment = draw.pipeline->fragment_entry == "fragmentUnlit" ? FragmentFunction::Unlit : FragmentFunction::Main;
+    const uint32_t state_index = static_cast<uint32_t>(m_states.size());
+    m_states.push_back(state);
+    const SceneDrawUniforms& uniforms = m_states.back().uniforms;
+
+    const uint32_t shaded_count = static_cast<uint32_t>(hi - lo);
+    m_shaded.resize(shaded_count);
+    m_outcodes.resize(shaded_count);
+    const uint8_t* source = draw.vertices->data() + lo * stride;
+    m_jobs.parallel_for(shaded_count, kVertexChunk, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            ClipVertex& out = m_shaded[i];
+            math::Vec4 world;
+            if (vertex_function == VertexFunction::Main) {
+                // vertexMain
+                const Vertex& in = reinterpret_cast<const Vertex*>(source)[i];
+                world = uniforms.model_matrix * math::Vec4(in.position, 1.0f);
+                const math::Mat4& m = uniforms.model_matrix;
+                const math::Vec3 normal = math::Vec3(
+                    m.at(0, 0) * in.normal.x + m.at(0, 1) * in.normal.y + m.at(0, 2) * in.normal.z,
+                    m.at(1, 0) * in.normal.x + m.at(1, 1) * in.normal.y + m.at(1, 2) * in.normal.z,
+                    m.at(2, 0) * in.normal.x + m.at(2, 1) * in.normal.y + m.at(2, 2) * in.normal.z).normalized();
+                const float attributes[kVaryingCount - 3] = {normal.x, normal.y, normal.z, in.color.x, in.color.y,
+                    in.color.z, in.color.w, in.uv.x, in.uv.y};
+                std::memcpy(out.varyings + kWorldNormal, attributes, sizeof(attributes));
+            } else {
+                // vertexDebug
+                const DebugVertex& in = reinterpret_cast<const DebugVertex*>(source)[i];
+                world = math::Vec4(in.position, 1.0f);
+                constexpr float kScale = 1.0f / 255.0f;
+                const float attributes[kVaryingCount - 3] = {0.0f, 1.0f, 0.0f,
+                    static_cast<float>(in.color & 0xFF) * kScale, static_cast<float>((in.color >> 8) & 0xFF) * kScale,
+                    static_cast<float>((in.color >> 16) & 0xFF) * kScale, static_cast<float>(in.color >> 24) * kScale,
+                    0.0f, 0.0f};
+                std::memcpy(out.varyings + kWorldNormal, attributes, sizeof(attributes));
+            }
+            out.varyings[kWorldPosition] = world.x;
+            out.varyings[kWorldPosition + 1] = world.y;
+            out.varyings[kWorldPosition + 2] = world.z;
+            const math::Vec4 clip = uniforms.view_projection_matrix * world;
+            out.position[0] = clip.x;
+            out.position[1] = clip.y;
+            out.position[2] = clip.z;
+            out.position[3] = clip.w;
+            m_outcodes[i] = static_cast<uint8_t>(outcode(out));
+        }
+    });
+
+    auto vertex_at = [&](uint32_t k) {
+        return static_cast<uint32_t>((draw.indices ? draw.indices[draw.first + k] : draw.first + k) - lo);
+    };
+
+    if (draw.topology == PrimitiveTopology::Triangles) {
+        // Unclipped vertices go through the viewport transform once and are shared by their triangles.
+        m_raster_index.assign(shaded_count, kNoVertex);
+        auto raster_vertex = [&](uint32_t i) {
+            if (m_raster_index[i] == kNoVertex) {
+                m_raster_index[i] = push_vertex(m_shaded[i]);
+            }
+            return m_raster_index[i];
+        };
+        for (uint32_t k = 0; k + 2 < draw.count; k += 3) {
+            const uint32_t a = vertex_at(k);
+            const uint32_t b = vertex_at(k + 1);
+            const uint32_t c = vertex_at(k + 2);
+            ++m_frame_stats.primitives;
+            const uint32_t outside = m_outcodes[a] | m_outcodes[b] | m_outcodes[c];
+            if (outside == 0) {
+                add_triangle(raster_vertex(a), raster_vertex(b), raster_vertex(c), state_index, true);
+            } else if (m_outcodes[a] & m_outcodes[b] & m_outcodes[c]) {
+                ++m_frame_stats.culled;
+            } else {
+                ++m_frame_stats.clipped;
+                add_clipped_triangle(m_shaded[a], m_shaded[b], m_shaded[c], outside, state_index);
+            }
+        }
+    } else if (draw.topology == PrimitiveTopology::Lines) {
+        for (uint32_t k = 0; k + 1 < draw.count; k += 2) {
+            ++m_frame_stats.primitives;
+            add_line(m_shaded[vertex_at(k)], m_shaded[vertex_at(k + 1)], state_index);
+        }
+    } else {
+        for (uint32_t k = 0; k < draw.count; ++k) {
+            ++m_frame_stats.primitives;
+            const uint32_t i = vertex_at(k);
+            if (m_outcodes[i] != 0) {
+                ++m_frame_stats.culled;
+                continue;
+            }
+            const RasterVertex p = m_vertices[push_vertex(m_shaded[i])];
+            add_quad(p, p, math::Vec2(0.5f, 0.0f), math::Vec2(0.0f, 0.5f), state_index);
+        }
+    }
+}
+
+float SoftwareDevice::plane_distance(const ClipVertex& v, uint32_t plane) {
+    const float* p = v.position;
+    switch (plane) {
+    case 0: return p[2];                         // near: z >= 0
+    case 1: return p[3] - p[2];                  // far: z <= w
+    case 2: return p[0] + kGuardBand * p[3];
+    case 3: return kGuardBand * p[3] - p[0];
+    case 4: return p[1] + kGuardBand * p[3];
+    default: return kGuardBand * p[3] - p[1];
+    }
+}
+
+uint32_t SoftwareDevice::outcode(const ClipVertex& v) {
+    uint32_t code = 0;
+    for (uint32_t plane = 0; plane < kPlaneCount; ++plane) {
+        if (plane_distance(v, plane) < 0.0f) {
+            code |= 1u << plane;
+        }
+    }
+    return code;
+}
+
+SoftwareDevice::ClipVertex SoftwareDevice::lerp(const ClipVertex& a, const ClipVertex& b, float t) {
+    ClipVertex out;
+    for (uint32_t i = 0; i < 4; ++i) {
+        out.position[i] = a.position[i] + (b.position[i] - a.position[i]) * t;
+    }
+    for (uint32_t i = 0; i < kVaryingCount; ++i) {
+        out.varyings[i] = a.varyings[i] + (b.varyings[i] - a.varyings[i]) * t;
+    }
+    return out;
+}
+
+uint32_t SoftwareDevice::clip_polygon(ClipVertex* polygon, uint32_t count, uint32_t outcodes) {
+    ClipVertex scratch[3 + kPlaneCount];
+    ClipVertex* in = polygon;
+    ClipVertex* out = scratch;
+    for (uint32_t plane = 0; plane < kPlaneCount && count >= 3; ++plane) {
+        if (!(outcodes & (1u << plane))) {
+            continue;
+        }
+        uint32_t written = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const ClipVertex& current = in[i];
+            const ClipVertex& next = in[(i + 1) % count];
+            const float dc = plane_distance(current, plane);
+            const float dn = plane_distance(next, plane);
+            if (dc >= 0.0f) {
+                out[written++] = current;
+            }
+            if ((dc >= 0.0f) != (dn >= 0.0f)) {
+                out[written++] = lerp(current, next, dc / (dc - dn));
+            }
+        }
+        count = written;
+        std::swap(in, out);
+    }
+    if (in != polygon) {
+        std::copy(in, in + count, polygon);
+    }
+    return count;
+}
+
+uint32_t SoftwareDevice::push_vertex(const ClipVertex& clip) {
+    RasterVertex v;
+    v.inv_w = 1.0f / clip.position[3];
+    const float ndc_x = clip.position[0] * v.inv_w;
+    const float ndc_y = clip.position[1] * v.inv_w;
+    v.x = std::round((ndc_x * 0.5f + 0.5f) * static_cast<float>(m_width) * kSubpixels) / kSubpixels;
+    v.y = std::round((0.5f - ndc_y * 0.5f) * static_cast<float>(m_height) * kSubpixels) / kSubpixels;
+    v.z = clip.position[2] * v.inv_w;
+    std::memcpy(v.varyings, clip.varyings, sizeof(v.varyings));
+    m_vertices.push_back(v);
+    return static_cast<uint32_t>(m_vertices.size() - 1);
+}
+
+void SoftwareDevice::add_triangle(uint32_t a, uint32_t b, uint32_t c, uint32_t state, bool cull_back_faces) {
+    const RasterVertex& v0 = m_vertices[a];
+    const RasterVertex& v1 = m_vertices[b];
+    const RasterVertex& v2 = m_vertices[c];
+    // Positive for triangles clockwise on screen (y down), i.e. counter-clockwise in NDC: front faces.
+    const float area = (v2.x - v0.x) * (v1.y - v0.y) - (v1.x - v0.x) * (v2.y - v0.y);
+    if (area == 0.0f || (cull_back_faces && area < 0.0f)) {
+        ++m_frame_stats.culled;
+        return;
+    }
+    // The rasterizer expects counter-clockwise on screen.
+    if (area > 0.0f) {
+        std::swap(b, c);
+    }
+
+    // Pixels whose centers fall inside the bounds.
+    const float min_x = std::min({v0.x, v1.x, v2.x});
+    const float max_x = std::max({v0.x, v1.x, v2.x});
+    const float min_y = std::min({v0.y, v1.y, v2.y});
+    const float max_y = std::max({v0.y, v1.y, v2.y});
+    const int32_t x0 = std::max(0, static_cast<int32_t>(std::ceil(min_x - 0.5f)));
+    const int32_t x1 = std::min(static_cast<int32_t>(m_width) - 1, static_cast<int32_t>(std::floor(max_x - 0.5f)));
+    const int32_t y0 = std::max(0, static_cast<int32_t>(std::ceil(min_y - 0.5f)));
+    const int32_t y1 = std::min(static_cast<int32_t>(m_height) - 1, static_cast<int32_t>(std::floor(max_y - 0.5f)));
+    if (x0 > x1 || y0 > y1) {
+        ++m_frame_stats.culled;
+        return;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(m_triangles.size());
+    m_triangles.push_back(Triangle{{a, b, c}, state});
+    for (int32_t ty = y0 / static_cast<int32_t>(kTileSize); ty <= y1 / static_cast<int32_t>(kTileSize); ++ty) {
+        for (int32_t tx = x0 / static_cast<int32_t>(kTileSize); tx <= x1 / static_cast<int32_t>(kTileSize); ++tx) {
+            m_bins[static_cast<size_t>(ty) * m_tiles_x + tx].push_back(id);
+            ++m_frame_stats.tile_entries;
+        }
+    }
+}
+
+void SoftwareDevice::add_clipped_triangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c,
+    uint32_t outcodes, uint32_t state) {
+    ClipVertex polygon[3 + kPlaneCount] = {a, b, c};
+    const uint32_t count = clip_polygon(polygon, 3, outcodes);
+    if (count < 3) {
+        ++m_frame_stats.culled;
+        return;
+    }
+    const uint32_t first = push_vertex(polygon[0]);
+    uint32_t previous = push_vertex(polygon[1]);
+    for (uint32_t i = 2; i < count; ++i) {
+        const uint32_t current = push_vertex(polygon[i]);
+        add_triangle(first, previous, current, state, true);
+        previous = current;
+    }
+}
+
+void SoftwareDevice::add_line(const ClipVertex& a, const ClipVertex& b, uint32_t state) {
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    for (uint32_t plane = 0; plane < kPlaneCount; ++plane) {
+        const float da = plane_distance(a, plane);
+        const float db = plane_distance(b, plane);
+        if (da < 0.0f && db < 0.0f) {
+            ++m_frame_stats.culled;
+            return;
+        }
+        if (da < 0.0f) {
+            t0 = std::max(t0, da / (da - db));
+        } else if (db < 0.0f) {
+            t1 = std::min(t1, da / (da - db));
+        }
+    }
+    if (t0 > t1) {
+        ++m_frame_stats.culled;
+        return;
+    }
+    if (t0 > 0.0f || t1 < 1.0f) {
+        ++m_frame_stats.clipped;
+    }
+    const RasterVertex start = m_vertices[push_vertex(t0 > 0.0f ? lerp(a, b, t0) : a)];
+    const RasterVertex end = m_vertices[push_vertex(t1 < 1.0f ? lerp(a, b, t1) : b)];
+    math::Vec2 direction(end.x - start.x, end.y - start.y);
+    const float length = direction.length();
+    direction = length > 1e-6f ? direction / length : math::Vec2(1.0f, 0.0f);
+    add_quad(start, end, math::Vec2(0.0f, 0.0f), math::Vec2(-direction.y, direction.x) * 0.5f, state);
+}
+
+void SoftwareDevice::add_quad(const RasterVertex& a, const RasterVertex& b, const math::Vec2& along,
+    const math::Vec2& across, uint32_t state) {
+    auto corner = [&](const RasterVertex& v, float x, float y) {
+        RasterVertex out = v;
+        out.x = v.x + x;
+        out.y = v.y + y;
+        m_vertices.push_back(out);
+        return static_cast<uint32_t>(m_vertices.size() - 1);
+    };
+    const uint32_t c0 = corner(a, -along.x + across.x, -along.y + across.y);
+    const uint32_t c1 = corner(a, -along.x - across.x, -along.y - across.y);
+    const uint32_t c2 = corner(b, along.x - across.x, along.y - across.y);
+    const uint32_t c3 = corner(b, along.x + across.x, along.y + across.y);
+    add_triangle(c0, c1, c2, state, false);
+    add_triangle(c0, c2, c3, state, false);
+}
+
+void SoftwareDevice::rasterize_tile(uint32_t tile) {
+    const int32_t tile_x0 = static_cast<int32_t>((tile % m_tiles_x) * kTileSize);
+    const int32_t tile_y0 = static_cast<int32_t>((tile / m_tiles_x) * kTileSize);
+    const int32_t tile_x1 = std::min(tile_x0 + static_cast<int32_t>(kTileSize), static_cast<int32_t>(m_width)) - 1;
+    const int32_t tile_y1 = std::min(tile_y0 + static_cast<int32_t>(kTileSize), static_cast<int32_t>(m_height)) - 1;
+
+    // Tiles start on multiples of four, so the four-wide spans below never leave the tile's columns.
+    const uint32_t clear = pack_unorm8(m_clear_color);
+    const uint32_t clear_end = std::min(static_cast<uint32_t>(tile_x0) + kTileSize, m_stride);
+    for (int32_t y = tile_y0; y <= tile_y1; ++y) {
+        const size_t row = static_cast<size_t>(y) * m_stride;
+        std::fill(m_color.begin() + row + tile_x0, m_color.begin() + row + clear_end, clear);
+        std::fill(m_depth.begin() + row + tile_x0, m_depth.begin() + row + clear_end, 1.0f);
+    }
+
+    const Float4 zero = Float4::zero();
+    const Float4 lane_offsets = Float4::set(0.5f, 1.5f, 2.5f, 3.5f);
+    uint64_t fragments = 0;
+    float varyings[kVaryingCount];
+
+    for (uint32_t id : m_bins[tile]) {
+        const Triangle& triangle = m_triangles[id];
+        const RasterVertex* v[3] = {&m_vertices[triangle.vertices[0]], &m_vertices[triangle.vertices[1]],
+            &m_vertices[triangle.vertices[2]]};
+        const int32_t x0 = std::max(tile_x0,
+            static_cast<int32_t>(std::ceil(std::min({v[0]->x, v[1]->x, v[2]->x}) - 0.5f)));
+        const int32_t x1 = std::min(tile_x1,
+            static_cast<int32_t>(std::floor(std::max({v[0]->x, v[1]->x, v[2]->x}) - 0.5f)));
+        const int32_t y0 = std::max(tile_y0,
+            static_cast<int32_t>(std::ceil(std::min({v[0]->y, v[1]->y, v[2]->y}) - 0.5f)));
+        const int32_t y1 = std::min(tile_y1,
+            static_cast<int32_t>(std::floor(std::max({v[0]->y, v[1]->y, v[2]->y}) - 0.5f)));
+        if (x0 > x1 || y0 > y1) {
+            continue;
+        }
+
+        // Edge e is opposite vertex e, so its value weights vertex e. Each edge is evaluated from
+        // its lexicographically smaller endpoint; a shared edge then yields bit-identical values
+        // of opposite sign in both triangles, and the top-left rule settles exact zeros.
+        float edge_x[3];
+        float edge_y[3];
+        float edge_dx[3];
+        float edge_dy[3];
+        float edge_sign[3];
+        bool top_left[3];
+        for (int e = 0; e < 3; ++e) {
+            const RasterVertex* from = v[(e + 1) % 3];
+            const RasterVertex* to = v[(e + 2) % 3];
+            const float dx = to->x - from->x;
+            const float dy = to->y - from->y;
+            top_left[e] = dy < 0.0f || (dy == 0.0f && dx > 0.0f);
+            edge_sign[e] = 1.0f;
+            if (from->x > to->x || (from->x == to->x && from->y > to->y)) {
+                std::swap(from, to);
+                edge_sign[e] = -1.0f;
+            }
+            edge_x[e] = from->x;
+            edge_y[e] = from->y;
+            edge_dx[e] = to->x - from->x;
+            edge_dy[e] = to->y - from->y;
+        }
+        const float inv_area = 1.0f /
+            ((v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) - (v[2]->x - v[0]->x) * (v[1]->y - v[0]->y));
+
+        const DrawState& state = m_states[triangle.state];
+        const Texture* texture = state.texture;
+
+        for (int32_t y = y0; y <= y1; ++y) {
+            const float py = static_cast<float>(y) + 0.5f;
+            float row_term[3];
+            for (int e = 0; e < 3; ++e) {
+                row_term[e] = edge_dx[e] * (py - edge_y[e]);
+            }
+            const size_t row = static_cast<size_t>(y) * m_stride;
+            for (int32_t x = x0 & ~3; x <= x1; x += 4) {
+                const Float4 px = static_cast<float>(x) + lane_offsets;
+                Float4 mask = Float4::greater(px, Float4::splat(static_cast<float>(x0))) &
+                    Float4::less(px, Float4::splat(static_cast<float>(x1 + 1)));
+                Float4 weight[3];
+                for (int e = 0; e < 3; ++e) {
+                    const Float4 value = (row_term[e] - edge_dy[e] * (px - edge_x[e])) * edge_sign[e];
+                    mask = mask & (top_left[e] ? Float4::greater_equal(value, zero) : Float4::greater(value, zero));
+                    weight[e] = value * inv_area;
+                }
+                if (mask.move_mask() == 0) {
+                    continue;
+                }
+                float* depth = m_depth.data() + row + x;
+                const Float4 z = weight[0] * v[0]->z + weight[1] * v[1]->z + weight[2] * v[2]->z;
+                mask = mask & Float4::less(z, Float4::load(depth));
+                const int bits = mask.move_mask();
+                if (bits == 0) {
+                    continue;
+                }
+                // Perspective-correct weights: screen weights scaled by 1/w and renormalized.
+                const Float4 p0 = weight[0] * v[0]->inv_w;
+                const Float4 p1 = weight[1] * v[1]->inv_w;
+                const Float4 p2 = weight[2] * v[2]->inv_w;
+                const Float4 w = Float4::splat(1.0f) / (p0 + p1 + p2);
+                const Float4 q0 = p0 * w;
+                const Float4 q1 = p1 * w;
+                const Float4 q2 = p2 * w;
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (!(bits & (1 << lane))) {
+                        continue;
+                    }
+                    const float b0 = q0.lane(lane);
+                    const float b1 = q1.lane(lane);
+                    const float b2 = q2.lane(lane);
+                    for (uint32_t i = 0; i < kVaryingCount; ++i) {
+                        varyings[i] = b0 * v[0]->varyings[i] + b1 * v[1]->varyings[i] + b2 * v[2]->varyings[i];
+                    }
+                    const math::Vec4 color = state.fragment == FragmentFunction::Unlit
+                        ? math::Vec4(varyings[kColor], varyings[kColor + 1], varyings[kColor + 2], varyings[kColor + 3])
+                        : fragment_main(state.uniforms, varyings, texture ? texture->pixels.data() : nullptr,
+                              texture ? texture->width : 0, texture ? texture->height : 0);
+                    m_color[row + x + lane] = pack_unorm8(color);
+                    depth[lane] = z.lane(lane);
+                    ++fragments;
+                }
+            }
+        }
+    }
+    m_tile_fragments[tile] = fragments;
+}
+
+} // namespace maya
@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/animation.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+namespace {
+
+/// Joints swinging about z with per-joint phase, a bobbing root and a constant scale.
+RawAnimationClip make_swing_clip(uint32_t joint_count, uint32_t frame_count, float sample_rate = 30.0f) {
+    RawAnimationClip raw;
+    raw.sample_rate = sample_rate;
+    raw.joint_count = joint_count;
+    raw.samples.resize(static_cast<size_t>(joint_count) * frame_count);
+    for (uint32_t f = 0; f < frame_count; ++f) {
+        const float time = static_cast<float>(f) / sample_rate;
+        for (uint32_t j = 0; j < joint_count; ++j) {
+            JointTransform& sample = raw.samples[f * joint_count + j];
+            sample.rotation = Quat::from_axis_angle(Vec3(0, 0, 1), 0.8f * std::sin(2.0f * time + 0.3f * j));
+            sample.translation = Vec3(0.0f, j == 0 ? 0.25f * std::sin(4.0f * time) : 0.5f, 0.0f);
+            sample.scale = Vec3(1.0f, 1.0f, 1.0f);
+        }
+    }
+    return raw;
+}
+
+float quat_distance(const Quat& a, const Quat& b) {
+    const float dot = std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+    return 1.0f - std::min(dot, 1.0f);
+}
+
+} // namespace
+
+// =============================================================================
+// Quantization Tests
+// =============================================================================
+TEST_CASE("QuantizedQuat round-trips within quantization error", "[core][animation]") {
+    const Quat inputs[] = {
+        Quat::identity(),
+        Quat::from_axis_angle(Vec3(1, 0, 0), 2.5f),
+        Quat::from_axis_angle(Vec3(0, 1, 0), -1.0f),
+        Quat(-0.5f, 0.5f, -0.5f, 0.5f),
+        Quat(0.1f, -0.9f, 0.2f, -0.3f),
+    };
+    for (const Quat& input : inputs) {
+        Quat q = input;
+        q.normalize();
+        const Quat decoded = QuantizedQuat::encode(q).decode();
+        // Same rotation up to sign.
+        const float sign = q.x * decoded.x + q.y * decoded.y + q.z * decoded.z + q.w * decoded.w < 0.0f ? -1.0f : 1.0f;
+        CHECK_THAT(decoded.x * sign, Catch::Matchers::WithinAbs(q.x, 1e-4f));
+        CHECK_THAT(decoded.y * sign, Catch::Matchers::WithinAbs(q.y, 1e-4f));
+        CHECK_THAT(decoded.z * sign, Catch::Matchers::WithinAbs(q.z, 1e-4f));
+        CHECK_THAT(decoded.w * sign, Catch::Matchers::WithinAbs(q.w, 1e-4f));
+    }
+}
+
+// =============================================================================
+// Compression Tests
+// =============================================================================
+TEST_CASE("compress_clip reduces keys within tolerance", "[core][animation]") {
+    const RawAnimationClip raw = make_swing_clip(10, 91);
+    const AnimationClip clip = compress_clip(raw);
+    REQUIRE(clip.joint_count() == 10);
+    CHECK_THAT(clip.duration(), Catch::Matchers::WithinAbs(3.0f, 1e-5f));
+
+    SECTION("Constant tracks keep one key and the clip shrinks") {
+        // Constant scale (10 tracks) and child translations (9 tracks) collapse to one key each.
+        CHECK(clip.key_count() < 10 * 91 + 1 * 91 + 19);
+        CHECK(clip.memory_bytes() * 4 < raw.memory_bytes());
+    }
+
+    SECTION("Every raw frame is reproduced within tolerance") {
+        std::vector<JointTransform> pose(10);
+        for (uint32_t f = 0; f < raw.frame_count(); ++f) {
+            clip.sample(static_cast<float>(f) / raw.sample_rate, pose.data());
+            for (uint32_t j = 0; j < 10; ++j) {
+                const JointTransform& expected = raw.samples[f * 10 + j];
+                CHECK(quat_distance(pose[j].rotation, expected.rotation) < 1e-5f);
+                CHECK((pose[j].translation - expected.translation).length() < 1e-3f);
+                CHECK((pose[j].scale - expected.scale).length() < 1e-3f);
+            }
+        }
+    }
+
+    SECTION("Looser tolerance keeps fewer keys") {
+        AnimationCompressionSettings loose;
+        loose.rotation_tolerance = 0.01f;
+        loose.translation_tolerance = 0.01f;
+        CHECK(compress_clip(raw, loose).key_count() < clip.key_count());
+    }
+}
+
+TEST_CASE("AnimationClip samples between and beyond keys", "[core][animation]") {
+    RawAnimationClip raw;
+    raw.sample_rate = 1.0f;
+    raw.joint_count = 1;
+    raw.samples.resize(3);
+    raw.samples[0].translation = Vec3(0, 0, 0);
+    raw.samples[1].translation = Vec3(1, 0, 0);
+    raw.samples[2].translation = Vec3(1, 2, 0);
+    raw.samples[1].rotation = Quat::from_axis_angle(Vec3(0, 1, 0), 1.0f);
+    raw.samples[2].rotation = Quat::from_axis_angle(Vec3(0, 1, 0), 1.0f);
+    const AnimationClip clip = compress_clip(raw);
+
+    JointTransform out;
+    clip.sample(0.5f, &out);
+    CHECK_THAT(out.translation.x, Catch::Matchers::WithinAbs(0.5f, 1e-4f));
+    CHECK_THAT(out.translation.y, Catch::Matchers::WithinAbs(0.0f, 1e-4f));
+    CHECK(quat_distance(out.rotation, Quat::from_axis_angle(Vec3(0, 1, 0), 0.5f)) < 1e-3f);
+
+    clip.sample(1.5f, &out);
+    CHECK_THAT(out.translation.y, Catch::Matchers::WithinAbs(1.0f, 1e-4f));
+
+    clip.sample(10.0f, &out);
+    CHECK_THAT(out.translation.y, Catch::Matchers::WithinAbs(2.0f, 1e-4f));
+    clip.sample(-1.0f, &out);
+    CHECK_THAT(out.translation.x, Catch::Matchers::WithinAbs(0.0f, 1e-4f));
+}
+
+// =============================================================================
+// Blending Tests
+// =============================================================================
+TEST_CASE("blend_poses interpolates every joint", "[core][animation]") {
+    std::vector<JointTransform> a(5);
+    std::vector<JointTransform> b(5);
+    for (uint32_t j = 0; j < 5; ++j) {
+        a[j].translation = Vec3(static_cast<float>(j), 0, 0);
+        b[j].translation = Vec3(static_cast<float>(j), 4, 0);
+        b[j].scale = Vec3(3, 3, 3);
+        // Opposite hemisphere: the blend must take the short way round.
+        const Quat q = Quat::from_axis_angle(Vec3(1, 0, 0), 0.8f);
+        b[j].rotation = Quat(-q.x, -q.y, -q.z, -q.w);
+    }
+    std::vector<JointTransform> out(5);
+    blend_poses(a.data(), b.data(), 0.5f, 5, out.data());
+    for (uint32_t j = 0; j < 5; ++j) {
+        CHECK_THAT(out[j].translation.x, Catch::Matchers::WithinAbs(static_cast<float>(j), 1e-5f));
+        CHECK_THAT(out[j].translation.y, Catch::Matchers::WithinAbs(2.0f, 1e-5f));
+        CHECK_THAT(out[j].scale.z, Catch::Matchers::WithinAbs(2.0f, 1e-5f));
+        CHECK(quat_distance(out[j].rotation, Quat::from_axis_angle(Vec3(1, 0, 0), 0.4f)) < 1e-5f);
+    }
+
+    blend_poses(a.data(), b.data(), 1.0f, 5, a.data());
+    CHECK_THAT(a[4].translation.y, Catch::Matchers::WithinAbs(4.0f, 1e-5f));
+}
+
+TEST_CASE("AnimationPlayer loops and cross-fades", "[core][animation]") {
+    RawAnimationClip idle_raw;
+    idle_raw.sample_rate = 10.0f;
+    idle_raw.joint_count = 2;
+    idle_raw.samples.resize(2 * 11);
+    RawAnimationClip walk_raw = idle_raw;
+    for (JointTransform& sample : walk_raw.samples) {
+        sample.translation = Vec3(0, 0, 2);
+    }
+    const AnimationClip idle = compress_clip(idle_raw);
+    const AnimationClip walk = compress_clip(walk_raw);
+
+    AnimationPlayer player(2);
+    std::vector<JointTransform> pose(2);
+    CHECK(player.play(&idle));
+    player.advance(1.25f);
+    CHECK_THAT(player.time(), Catch::Matchers::WithinAbs(0.25f, 1e-5f));
+
+    player.play(&walk, 0.5f);
+    player.advance(0.25f);
+    CHECK_THAT(player.blend_weight(), Catch::Matchers::WithinAbs(0.5f, 1e-5f));
+    player.evaluate(pose.data());
+    CHECK_THAT(pose[1].translation.z, Catch::Matchers::WithinAbs(1.0f, 1e-4f));
+
+    player.advance(0.5f);
+    CHECK(player.blend_weight() == 1.0f);
+    player.evaluate(pose.data());
+    CHECK_THAT(pose[0].translation.z, Catch::Matchers::WithinAbs(2.0f, 1e-4f));
+
+    SECTION("Clips for another skeleton are rejected") {
+        const AnimationClip large = compress_clip(make_swing_clip(5, 4));
+        CHECK_FALSE(player.play(&large, 0.5f));
+        CHECK_FALSE(player.play(&large));
+        CHECK(player.blend_weight() == 1.0f);
+        player.evaluate(pose.data());
+        CHECK_THAT(pose[0].translation.z, Catch::Matchers::WithinAbs(2.0f, 1e-4f));
+    }
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("AnimationClip benchmarks", "[.][benchmark][animation]") {
+    // 334 joints = ~1000 tracks (rotation, translation, scale), 10 seconds at 30 Hz.
+    const RawAnimationClip raw = make_swing_clip(334, 301);
+    const AnimationClip clip = compress_clip(raw);
+    std::vector<JointTransform> a(334);
+    std::vector<JointTransform> b(334);
+    // Raw vs compressed size is the memory figure of interest; fail loudly if it regresses.
+    CHECK(clip.memory_bytes() * 4 < raw.memory_bytes());
+
+    float time = 0.0f;
+    BENCHMARK("Sample 1000 tracks") {
+        time = std::fmod(time + 0.016f, clip.duration());
+        clip.sample(time, a.data());
+        return a[0].rotation.w;
+    };
+
+    BENCHMARK("Blend 334 joints") {
+        blend_poses(a.data(), b.data(), 0.3f, 334, b.data());
+        return b[0].rotation.w;
+    };
+
+    BENCHMARK("Compress 10 s, 334 joints") {
+        return compress_clip(raw).key_count();
+    };
+}
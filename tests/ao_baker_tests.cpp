@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/ao_baker.hpp"
+#include "maya/core/job_system.hpp"
+#include <cmath>
+
+using namespace maya;
+using namespace maya::math;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/// `cells` x `cells` grid in the xz plane over `[-half, half]^2` at height `y`, facing +y (or -y).
+MeshData make_floor(uint32_t cells, float half, float y, bool facing_down = false) {
+    MeshData mesh;
+    const uint32_t size = cells + 1;
+    for (uint32_t z = 0; z < size; ++z) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const float fx = -half + 2.0f * half * static_cast<float>(x) / static_cast<float>(cells);
+            const float fz = -half + 2.0f * half * static_cast<float>(z) / static_cast<float>(cells);
+            mesh.vertices.emplace_back(Vec3(fx, y, fz), Vec3(0, facing_down ? -1.0f : 1.0f, 0), Vec4(1, 1, 1, 1));
+        }
+    }
+    for (uint32_t z = 0; z < cells; ++z) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            const uint32_t a = z * size + x;
+            mesh.indices.insert(mesh.indices.end(), {a, a + size, a + 1, a + 1, a + size, a + size + 1});
+        }
+    }
+    return mesh;
+}
+
+/// Wall in the plane x = `x` spanning y in [0, 4] and z in [-4, 4], facing -x.
+MeshData make_wall(float x) {
+    MeshData mesh;
+    const Vec3 n(-1, 0, 0);
+    mesh.vertices = {Vertex(Vec3(x, 0, -4), n, Vec4(1, 1, 1, 1)), Vertex(Vec3(x, 0, 4), n, Vec4(1, 1, 1, 1)),
+        Vertex(Vec3(x, 4, -4), n, Vec4(1, 1, 1, 1)), Vertex(Vec3(x, 4, 4), n, Vec4(1, 1, 1, 1))};
+    mesh.indices = {0, 1, 2, 2, 1, 3};
+    return mesh;
+}
+
+/// Index of the floor vertex nearest to (x, z).
+uint32_t nearest_vertex(const MeshData& mesh, float x, float z) {
+    uint32_t best = 0;
+    float best_d = 1e30f;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mesh.vertices.size()); ++i) {
+        const float dx = mesh.vertices[i].position.x - x;
+        const float dz = mesh.vertices[i].position.z - z;
+        if (dx * dx + dz * dz < best_d) {
+            best_d = dx * dx + dz * dz;
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+// =============================================================================
+// Occlusion Tests
+// =============================================================================
+TEST_CASE("bake_vertex_ao darkens vertices covered by nearby geometry", "[core][ao]") {
+    JobSystem jobs(2);
+    MeshData floor = make_floor(8, 2.0f, 0.0f);
+    MeshData ceiling = make_floor(4, 100.0f, 1.0f, true);
+    AoBakeSettings settings;
+
+    SECTION("An open plane is unoccluded") {
+        bake_vertex_ao({{&floor, Mat4::identity()}}, settings, jobs);
+        for (const Vertex& v : floor.vertices) {
+            CHECK(v.color.x == 1.0f);
+            CHECK(v.color.w == 1.0f);
+        }
+    }
+
+    SECTION("A low ceiling blocks every ray within range") {
+        settings.max_distance = 1000.0f;
+        bake_vertex_ao({{&floor, Mat4::identity()}, {&ceiling, Mat4::identity()}}, settings, jobs);
+        CHECK(floor.vertices[nearest_vertex(floor, 0, 0)].color.x < 0.05f);
+        // Color is modulated, alpha untouched.
+        CHECK(floor.vertices[0].color.w == 1.0f);
+    }
+
+    SECTION("Occluders beyond max_distance are ignored") {
+        settings.max_distance = 0.5f;
+        bake_vertex_ao({{&floor, Mat4::identity()}, {&ceiling, Mat4::identity()}}, settings, jobs);
+        for (const Vertex& v : floor.vertices) {
+            CHECK(v.color.x == 1.0f);
+        }
+    }
+
+    SECTION("Model matrices place targets in the world") {
+        settings.max_distance = 1000.0f;
+        bake_vertex_ao({{&floor, Mat4::translate({0, 5, 0})}, {&ceiling, Mat4::identity()}}, settings, jobs);
+        CHECK(floor.vertices[nearest_vertex(floor, 0, 0)].color.x == 1.0f);
+    }
+}
+
+TEST_CASE("bake_vertex_ao writes bent normals and AO", "[core][ao]") {
+    JobSystem jobs(2);
+    AoBakeSettings settings;
+    settings.bent_normals = true;
+    settings.max_distance = 10.0f;
+    settings.rays_per_vertex = 62;
+
+    MeshData floor = make_floor(20, 2.0f, 0.0f);
+    MeshData wall = make_wall(2.25f);
+    bake_vertex_ao({{&floor, Mat4::identity()}, {&wall, Mat4::identity()}}, settings, jobs);
+
+    const Vertex& near_wall = floor.vertices[nearest_vertex(floor, 2.0f, 0.0f)];
+    const Vertex& far_side = floor.vertices[nearest_vertex(floor, -2.0f, 0.0f)];
+    CHECK(near_wall.color.w < 0.75f);
+    CHECK(far_side.color.w > near_wall.color.w);
+    // Bent normals lean away from the wall (-x) and decode to unit vectors.
+    const Vec3 bent(near_wall.color.x * 2.0f - 1.0f, near_wall.color.y * 2.0f - 1.0f, near_wall.color.z * 2.0f - 1.0f);
+    CHECK(bent.x < -0.2f);
+    CHECK_THAT(bent.length(), WithinAbs(1.0f, 1e-4f));
+    CHECK_THAT(bent.z, WithinAbs(0.0f, 0.05f));
+
+    SECTION("Bent normals are stored in object space") {
+        MeshData rotated = make_floor(2, 1.0f, 0.0f);
+        bake_vertex_ao({{&rotated, Mat4::rotate_z(1.2f)}}, settings, jobs);
+        for (const Vertex& v : rotated.vertices) {
+            CHECK(v.color.w == 1.0f);
+            CHECK_THAT(v.color.x, WithinAbs(0.5f, 0.02f));
+            CHECK_THAT(v.color.y, WithinAbs(1.0f, 1e-3f));
+        }
+    }
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("AO bake benchmarks", "[.][benchmark][ao]") {
+    // Rolling 256x256-cell terrain (66k vertices) with 64 rays each.
+    MeshData terrain = make_floor(256, 64.0f, 0.0f);
+    for (Vertex& v : terrain.vertices) {
+        v.position.y = 2.0f * std::sin(v.position.x * 0.4f) * std::cos(v.position.z * 0.3f);
+    }
+    AoBakeSettings settings;
+    BENCHMARK("Bake 66k vertices at 64 rays") {
+        bake_vertex_ao({{&terrain, Mat4::identity()}}, settings, JobSystem::instance());
+        return terrain.vertices[0].color.x;
+    };
+}
@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/bvh.hpp"
+#include <limits>
+#include <random>
+
+using namespace maya;
+using namespace maya::math;
+
+namespace {
+
+/// Closest hit by testing every triangle (Möller-Trumbore, double-sided).
+bool brute_force_hit(const std::vector<BvhTriangle>& triangles, const Vec3& origin, const Vec3& direction,
+    float& best_t, uint32_t& best_id) {
+    bool found = false;
+    best_t = std::numeric_limits<float>::max();
+    for (const BvhTriangle& tri : triangles) {
+        const Vec3 e1 = tri.v1 - tri.v0;
+        const Vec3 e2 = tri.v2 - tri.v0;
+        const Vec3 p = Vec3::cross(direction, e2);
+        const float det = Vec3::dot(e1, p);
+        if (std::fabs(det) < 1e-12f) {
+            continue;
+        }
+        const Vec3 s = origin - tri.v0;
+        const float u = Vec3::dot(s, p) / det;
+        const Vec3 q = Vec3::cross(s, e1);
+        const float v = Vec3::dot(direction, q) / det;
+        const float t = Vec3::dot(e2, q) / det;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < best_t) {
+            best_t = t;
+            best_id = tri.id;
+            found = true;
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+// =============================================================================
+// TriangleBvh Tests
+// =============================================================================
+TEST_CASE("TriangleBvh matches brute-force ray casts", "[core][bvh]") {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> offset(-1.5f, 1.5f);
+    std::vector<BvhTriangle> triangles;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const Vec3 c(pos(rng), pos(rng), pos(rng));
+        triangles.push_back(BvhTriangle{c + Vec3(offset(rng), offset(rng), offset(rng)),
+            c + Vec3(offset(rng), offset(rng), offset(rng)), c + Vec3(offset(rng), offset(rng), offset(rng)), i});
+    }
+    TriangleBvh bvh;
+    bvh.build(triangles);
+    REQUIRE(bvh.triangles().size() == triangles.size());
+    CHECK(bvh.node_count() > 1);
+    CHECK(bvh.bounds().contains(triangles[0].v0));
+
+    bool hits_match = true;
+    bool occlusion_matches = true;
+    for (int r = 0; r < 500; ++r) {
+        const Vec3 origin(pos(rng), pos(rng), pos(rng));
+        const Vec3 direction = Vec3(pos(rng), pos(rng), pos(rng)).normalized();
+        float expected_t = 0.0f;
+        uint32_t expected_id = 0;
+        const bool expected = brute_force_hit(triangles, origin, direction, expected_t, expected_id);
+        RayHit hit;
+        const bool found = bvh.intersect(origin, direction, 0.0f, std::numeric_limits<float>::max(), hit);
+        hits_match = hits_match && found == expected
+            && (!found || (bvh.triangles()[hit.triangle].id == expected_id && std::fabs(hit.t - expected_t) < 1e-4f));
+        occlusion_matches = occlusion_matches
+            && bvh.occluded(origin, direction, 0.0f, std::numeric_limits<float>::max()) == expected;
+    }
+    CHECK(hits_match);
+    CHECK(occlusion_matches);
+}
+
+TEST_CASE("TriangleBvh respects the ray interval", "[core][bvh]") {
+    TriangleBvh bvh;
+    bvh.build({BvhTriangle{Vec3(-1, -1, 5), Vec3(1, -1, 5), Vec3(0, 1, 5), 3}});
+    RayHit hit;
+
+    REQUIRE(bvh.intersect(Vec3(0, 0, 0), Vec3(0, 0, 1), 0.0f, 10.0f, hit));
+    CHECK_THAT(hit.t, Catch::Matchers::WithinAbs(5.0f, 0.0001f));
+    CHECK(bvh.triangles()[hit.triangle].id == 3);
+    // Double-sided: hit from behind too.
+    CHECK(bvh.intersect(Vec3(0, 0, 10), Vec3(0, 0, -1), 0.0f, 10.0f, hit));
+    CHECK_FALSE(bvh.intersect(Vec3(0, 0, 0), Vec3(0, 0, 1), 0.0f, 4.0f, hit));
+    CHECK_FALSE(bvh.occluded(Vec3(0, 0, 0), Vec3(0, 0, 2), 0.0f, 1.0f));
+    CHECK(bvh.occluded(Vec3(0, 0, 0), Vec3(0, 0, 2), 0.0f, 3.0f));
+
+    TriangleBvh empty;
+    empty.build({});
+    CHECK(empty.empty());
+    CHECK_FALSE(empty.occluded(Vec3(0, 0, 0), Vec3(0, 0, 1), 0.0f, 10.0f));
+}
+
+TEST_CASE("TriangleBvh packet occlusion matches single rays", "[core][bvh]") {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::vector<BvhTriangle> triangles;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const Vec3 c(pos(rng), pos(rng), pos(rng));
+        triangles.push_back(BvhTriangle{c + Vec3(offset(rng), offset(rng), offset(rng)),
+            c + Vec3(offset(rng), offset(rng), offset(rng)), c + Vec3(offset(rng), offset(rng), offset(rng)), i});
+    }
+    TriangleBvh bvh;
+    bvh.build(triangles);
+
+    bool matches = true;
+    for (int p = 0; p < 300; ++p) {
+        // Rays from a shared origin like an occlusion bake; lane 3 is switched off every other packet.
+        const Vec3 origin(pos(rng), pos(rng), pos(rng));
+        RayPacket4 packet;
+        uint32_t expected = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            const Vec3 direction = Vec3(offset(rng), offset(rng), offset(rng)).normalized();
+            const float t_max = (lane == 3 && p % 2 == 0) ? -1.0f : 2.0f + 4.0f * static_cast<float>(lane);
+            packet.origin[0][lane] = origin.x;
+            packet.origin[1][lane] = origin.y;
+            packet.origin[2][lane] = origin.z;
+            packet.direction[0][lane] = direction.x;
+            packet.direction[1][lane] = direction.y;
+            packet.direction[2][lane] = direction.z;
+            packet.t_max[lane] = t_max;
+            if (t_max >= 0.0f && bvh.occluded(origin, direction, 0.0f, t_max)) {
+                expected |= 1u << lane;
+            }
+        }
+        matches = matches && bvh.occluded4(packet) == expected;
+    }
+    CHECK(matches);
+
+    TriangleBvh empty;
+    CHECK(empty.occluded4(RayPacket4{}) == 0);
+}
+
+TEST_CASE("TriangleBvh packet intersection matches single rays", "[core][bvh]") {
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::vector<BvhTriangle> triangles;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const Vec3 c(pos(rng), pos(rng), pos(rng));
+        triangles.push_back(BvhTriangle{c + Vec3(offset(rng), offset(rng), offset(rng)),
+            c + Vec3(offset(rng), offset(rng), offset(rng)), c + Vec3(offset(rng), offset(rng), offset(rng)), i});
+    }
+    TriangleBvh bvh;
+    bvh.build(triangles);
+
+    bool matches = true;
+    for (int p = 0; p < 300; ++p) {
+        // Independent origins per lane, like the bounces of four paths; lane 1 is off every third packet.
+        RayPacket4 packet;
+        Vec3 origins[4];
+        Vec3 directions[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            origins[lane] = Vec3(pos(rng), pos(rng), pos(rng));
+            directions[lane] = Vec3(offset(rng), offset(rng), offset(rng)).normalized();
+            packet.origin[0][lane] = origins[lane].x;
+            packet.origin[1][lane] = origins[lane].y;
+            packet.origin[2][lane] = origins[lane].z;
+            packet.direction[0][lane] = directions[lane].x;
+            packet.direction[1][lane] = directions[lane].y;
+            packet.direction[2][lane] = directions[lane].z;
+            packet.t_max[lane] = (lane == 1 && p % 3 == 0) ? -1.0f : 40.0f;
+        }
+        RayHit hits[4];
+        const uint32_t mask = bvh.intersect4(packet, hits);
+        for (int lane = 0; lane < 4; ++lane) {
+            RayHit expected;
+            const bool hit = packet.t_max[lane] >= 0.0f
+                && bvh.intersect(origins[lane], directions[lane], 0.0f, 40.0f, expected);
+            matches = matches && ((mask >> lane) & 1u) == (hit ? 1u : 0u);
+            if (hit) {
+                matches = matches && hits[lane].triangle == expected.triangle
+                    && std::fabs(hits[lane].t - expected.t) < 1e-4f && std::fabs(hits[lane].u - expected.u) < 1e-4f;
+            }
+        }
+    }
+    CHECK(matches);
+}
@@ -319,3 +319,61 @@ TEST_CASE("Camera multiple instances", "[core][camera]") {
         CHECK(!same);
     }
 }
+
+// =============================================================================
+// Camera Cache Tests
+// =============================================================================
+TEST_CASE("Camera cached matrices", "[core][camera]") {
+    Camera cam(60.0f, 16.0f/9.0f, 0.1f, 100.0f);
+
+    SECTION("Version only advances on real changes") {
+        const uint64_t v0 = cam.version();
+        cam.set_position(cam.get_position());
+        cam.set_fov(cam.get_fov());
+        CHECK(cam.version() == v0);
+
+        cam.set_position(Vec3(1.0f, 2.0f, 3.0f));
+        CHECK(cam.version() == v0 + 1);
+        cam.set_fov(75.0f);
+        CHECK(cam.version() == v0 + 2);
+        cam.set_aspect_ratio(1.0f);
+        CHECK(cam.version() == v0 + 3);
+    }
+
+    SECTION("Getters return the same cached storage") {
+        const Mat4* view = &cam.get_view_matrix();
+        cam.get_projection_matrix();
+        CHECK(&cam.get_view_matrix() == view);
+    }
+
+    SECTION("Cache follows changes") {
+        const float before = cam.get_projection_matrix().at(1, 1);
+        cam.set_fov(90.0f);
+        CHECK_THAT(cam.get_projection_matrix().at(1, 1), Catch::Matchers::WithinAbs(1.0f, 0.0001f));
+        CHECK(cam.get_projection_matrix().at(1, 1) != before);
+
+        cam.set_position(Vec3(0.0f, 0.0f, 10.0f));
+        CHECK_THAT(cam.get_view_matrix().at(2, 3), Catch::Matchers::WithinAbs(-10.0f, 0.0001f));
+    }
+
+    SECTION("Inverses undo the forward matrices") {
+        cam.set_position(Vec3(3.0f, -2.0f, 7.0f));
+        const Mat4 product = cam.get_view_projection_matrix() * cam.get_inverse_view_projection_matrix();
+        const Mat4 view_product = cam.get_inverse_view_matrix() * cam.get_view_matrix();
+        for (int row = 0; row < 4; ++row) {
+            for (int col = 0; col < 4; ++col) {
+                const float expected = row == col ? 1.0f : 0.0f;
+                CHECK_THAT(product.at(row, col), Catch::Matchers::WithinAbs(expected, 0.001f));
+                CHECK_THAT(view_product.at(row, col), Catch::Matchers::WithinAbs(expected, 0.001f));
+            }
+        }
+    }
+
+    SECTION("Frustum matches the camera") {
+        cam.set_position(Vec3(0.0f, 0.0f, 0.0f));
+        CHECK(cam.get_frustum().contains(Vec3(0.0f, 0.0f, -5.0f)));
+        CHECK_FALSE(cam.get_frustum().contains(Vec3(0.0f, 0.0f, 5.0f)));
+        cam.set_position(Vec3(0.0f, 0.0f, -20.0f));
+        CHECK_FALSE(cam.get_frustum().contains(Vec3(0.0f, 0.0f, -5.0f)));
+    }
+}
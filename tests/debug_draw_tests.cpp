@@ -0,0 +1,237 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/debug_draw.hpp"
+#include "maya/core/job_system.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+class MockGraphicsDeviceForDebugDraw : public GraphicsDevice {
+public:
+    struct Draw {
+        PrimitiveTopology topology;
+        uint32_t first_vertex;
+        uint32_t vertex_count;
+    };
+
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override {
+        ++vertex_buffers_created;
+        return {next_handle++};
+    }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t size) override { last_vertex_upload = size; }
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    void destroy_vertex_buffer(VertexBufferHandle) override { ++vertex_buffers_destroyed; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
+    void draw(PrimitiveTopology topology, uint32_t first_vertex, uint32_t vertex_count) override {
+        draws.push_back(Draw{topology, first_vertex, vertex_count});
+    }
+
+    std::vector<Draw> draws;
+    size_t last_vertex_upload = 0;
+    uint32_t vertex_buffers_created = 0;
+    uint32_t vertex_buffers_destroyed = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+bool on_box_corner(const Vec3& p, const Aabb& box) {
+    auto either = [](float v, float a, float b) { return std::abs(v - a) < 1e-4f || std::abs(v - b) < 1e-4f; };
+    return either(p.x, box.min.x, box.max.x) && either(p.y, box.min.y, box.max.y) && either(p.z, box.min.z, box.max.z);
+}
+
+} // namespace
+
+// =============================================================================
+// Recording and Expansion Tests
+// =============================================================================
+TEST_CASE("DebugDraw expands shapes into line and triangle vertices", "[core][debug_draw]") {
+    DebugDraw debug;
+    DebugGeometry geometry;
+
+    SECTION("Lines and boxes") {
+        debug.line(Vec3(0, 0, 0), Vec3(1, 2, 3), kDebugRed);
+        const Aabb box(Vec3(-1, -2, -3), Vec3(1, 2, 3));
+        debug.box(box, kDebugGreen);
+        debug.box(Aabb(), kDebugGreen);
+        CHECK(debug.shape_count() == 2);
+
+        debug.expand(geometry);
+        REQUIRE(geometry.lines.size() == 2 + 24);
+        CHECK(geometry.triangles.empty());
+        CHECK(geometry.lines[0].color == kDebugRed);
+        CHECK(geometry.lines[1].position.z == 3.0f);
+        for (size_t i = 2; i < geometry.lines.size(); ++i) {
+            CHECK(geometry.lines[i].color == kDebugGreen);
+            CHECK(on_box_corner(geometry.lines[i].position, box));
+        }
+        CHECK(debug.shape_count() == 0);
+    }
+
+    SECTION("Oriented boxes follow their transform") {
+        const Aabb local(Vec3(0, 0, 0), Vec3(2, 1, 1));
+        debug.box(local, Mat4::translate(Vec3(10, 0, 0)));
+        debug.expand(geometry);
+        REQUIRE(geometry.lines.size() == 24);
+        for (const DebugVertex& v : geometry.lines) {
+            CHECK(on_box_corner(v.position, Aabb(Vec3(10, 0, 0), Vec3(12, 1, 1))));
+        }
+    }
+
+    SECTION("Spheres are three circles on the surface") {
+        debug.sphere(Vec3(1, 1, 1), 2.0f);
+        debug.expand(geometry);
+        REQUIRE(geometry.lines.size() == 3 * DebugDraw::kSphereSegments * 2);
+        for (const DebugVertex& v : geometry.lines) {
+            CHECK_THAT((v.position - Vec3(1, 1, 1)).length(), Catch::Matchers::WithinAbs(2.0f, 1e-4f));
+        }
+    }
+
+    SECTION("Frusta span the near and far planes") {
+        const Mat4 vp = Mat4::perspective(1.0f, 1.0f, 1.0f, 10.0f)
+            * Mat4::look_at(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0));
+        debug.frustum(vp, kDebugYellow);
+        debug.expand(geometry);
+        REQUIRE(geometry.lines.size() == 24);
+        for (const DebugVertex& v : geometry.lines) {
+            const float depth = -v.position.z;
+            CHECK((std::abs(depth - 1.0f) < 1e-3f || std::abs(depth - 10.0f) < 1e-2f));
+        }
+    }
+
+    SECTION("Triangles are emitted with both windings") {
+        debug.triangle(Vec3(0, 0, 0), Vec3(1, 0, 0), Vec3(0, 1, 0), kDebugBlue);
+        debug.expand(geometry);
+        CHECK(geometry.lines.empty());
+        CHECK(geometry.triangles.size() == 6);
+    }
+
+    SECTION("Disabled recording and clear drop shapes") {
+        debug.set_enabled(false);
+        debug.line(Vec3(0, 0, 0), Vec3(1, 0, 0));
+        CHECK(debug.shape_count() == 0);
+        debug.set_enabled(true);
+        debug.sphere(Vec3(0, 0, 0), 1.0f);
+        debug.clear();
+        debug.expand(geometry);
+        CHECK(geometry.lines.empty());
+    }
+}
+
+TEST_CASE("DebugDraw records from many threads", "[core][debug_draw]") {
+    JobSystem jobs(3);
+    DebugDraw debug;
+    const uint32_t count = 20000;
+    for (uint32_t frame = 0; frame < 2; ++frame) {
+        jobs.parallel_for(count, 64, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                debug.line(Vec3(static_cast<float>(i), 0, 0), Vec3(static_cast<float>(i), 1, 0));
+            }
+        });
+        DebugGeometry geometry;
+        debug.expand(geometry);
+        REQUIRE(geometry.lines.size() == count * 2);
+        std::vector<bool> seen(count, false);
+        for (size_t v = 0; v < geometry.lines.size(); v += 2) {
+            seen[static_cast<uint32_t>(geometry.lines[v].position.x)] = true;
+        }
+        CHECK(std::count(seen.begin(), seen.end(), true) == static_cast<long>(count));
+    }
+    CHECK(debug.dropped() == 0);
+}
+
+TEST_CASE("DebugDraw drops shapes from threads beyond kMaxThreads", "[core][debug_draw]") {
+    DebugDraw debug;
+    debug.line(Vec3(0, 0, 0), Vec3(1, 0, 0));
+    const uint32_t extra = 4;
+    for (uint32_t t = 1; t < DebugDraw::kMaxThreads + extra; ++t) {
+        std::thread([&] {
+            debug.line(Vec3(0, 0, 0), Vec3(1, 0, 0));
+            debug.line(Vec3(0, 1, 0), Vec3(1, 1, 0));
+        }).join();
+    }
+    CHECK(debug.shape_count() == 1 + (DebugDraw::kMaxThreads - 1) * 2);
+    CHECK(debug.dropped() == extra * 2);
+
+    // Later threads still find no slot, while the first thread keeps its own.
+    debug.clear();
+    std::thread([&] { debug.line(Vec3(0, 0, 0), Vec3(1, 0, 0)); }).join();
+    debug.line(Vec3(0, 0, 0), Vec3(1, 0, 0));
+    CHECK(debug.shape_count() == 1);
+    CHECK(debug.dropped() == extra * 2 + 1);
+}
+
+// =============================================================================
+// Renderer Tests
+// =============================================================================
+TEST_CASE("DebugDrawRenderer draws once per primitive type", "[core][debug_draw]") {
+    MockGraphicsDeviceForDebugDraw device;
+    DebugDraw debug;
+    {
+        DebugDrawRenderer renderer(device, PipelineHandle{1});
+
+        renderer.render(debug, UniformBufferHandle{2}, Mat4::identity());
+        CHECK(device.draws.empty());
+
+        debug.box(Aabb(Vec3(0, 0, 0), Vec3(1, 1, 1)));
+        debug.line(Vec3(0, 0, 0), Vec3(1, 1, 1));
+        debug.triangle(Vec3(0, 0, 0), Vec3(1, 0, 0), Vec3(0, 1, 0));
+        renderer.render(debug, UniformBufferHandle{2}, Mat4::identity());
+        REQUIRE(device.draws.size() == 2);
+        CHECK(device.draws[0].topology == PrimitiveTopology::Lines);
+        CHECK(device.draws[0].first_vertex == 0);
+        CHECK(device.draws[0].vertex_count == 26);
+        CHECK(device.draws[1].topology == PrimitiveTopology::Triangles);
+        CHECK(device.draws[1].first_vertex == 26);
+        CHECK(device.draws[1].vertex_count == 6);
+        CHECK(device.last_vertex_upload == 32 * sizeof(DebugVertex));
+        CHECK(renderer.last_vertex_count() == 32);
+
+        // Each frame in flight gets its own buffer, reused while it is large enough.
+        for (uint32_t frame = 0; frame < 6; ++frame) {
+            debug.line(Vec3(0, 0, 0), Vec3(1, 1, 1));
+            renderer.render(debug, UniformBufferHandle{2}, Mat4::identity());
+        }
+        CHECK(device.vertex_buffers_created == StreamingVertexBuffer::kFramesInFlight);
+    }
+    CHECK(device.vertex_buffers_destroyed == StreamingVertexBuffer::kFramesInFlight);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("DebugDraw benchmarks", "[.][benchmark][debug_draw]") {
+    DebugDraw debug;
+    DebugGeometry geometry;
+    BENCHMARK("Record and expand 10k boxes") {
+        for (uint32_t i = 0; i < 10000; ++i) {
+            const float x = static_cast<float>(i);
+            debug.box(Aabb(Vec3(x, 0, 0), Vec3(x + 1, 1, 1)), kDebugGreen);
+        }
+        geometry.lines.clear();
+        debug.expand(geometry);
+        return geometry.lines.size();
+    };
+}
@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/dynamic_batch.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/vertex_transform.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include "maya/rhi/null/null_device.hpp"
+
+using namespace maya;
+using Catch::Matchers::WithinAbs;
+
+// Mock GraphicsDevice counting streamed uploads and draws
+class MockGraphicsDeviceForDynamicBatch : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t size) override {
+        last_vertex_upload = size;
+    }
+    void update_index_buffer(IndexBufferHandle, const void*, size_t size) override { last_index_upload = size; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override { ++uniform_updates; }
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override { ++draws; }
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t count) override {
+        ++draws;
+        last_range_count = count;
+    }
+
+    size_t last_vertex_upload = 0;
+    size_t last_index_upload = 0;
+    uint32_t uniform_updates = 0;
+    uint32_t draws = 0;
+    uint32_t last_range_count = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+std::unique_ptr<Mesh> make_quad(GraphicsDevice& device) {
+    std::vector<Vertex> vertices = {
+        Vertex(math::Vec3(0, 0, 0), math::Vec3(0, 0, 1), math::Vec4(1, 1, 1, 1)),
+        Vertex(math::Vec3(1, 0, 0), math::Vec3(0, 0, 1), math::Vec4(1, 1, 1, 1)),
+        Vertex(math::Vec3(1, 1, 0), math::Vec3(0, 0, 1), math::Vec4(1, 1, 1, 1)),
+        Vertex(math::Vec3(0, 1, 0), math::Vec3(0, 0, 1), math::Vec4(1, 1, 1, 1))
+    };
+    return std::make_unique<Mesh>(device, vertices, std::vector<uint32_t>{0, 1, 2, 0, 2, 3});
+}
+
+} // namespace
+
+// =============================================================================
+// Vertex Transform Tests
+// =============================================================================
+TEST_CASE("transform_vertices matches scalar math", "[core][dynamic_batch]") {
+    const math::Mat4 model = math::Mat4::translate({1, 2, 3}) * math::Mat4::rotate_z(0.7f)
+        * math::Mat4::scale({2, 2, 2});
+    std::vector<Vertex> in = {Vertex(math::Vec3(0.5f, -1.0f, 2.0f), math::Vec3(0, 1, 0), math::Vec4(0.2f, 0.4f, 0.6f, 1),
+        math::Vec2(0.25f, 0.75f))};
+    std::vector<Vertex> out = in;
+
+    transform_vertices(in.data(), out.data(), in.size(), model, model.normal_matrix());
+
+    const math::Vec4 expected = model * math::Vec4(in[0].position, 1.0f);
+    CHECK_THAT(out[0].position.x, WithinAbs(expected.x, 0.0001f));
+    CHECK_THAT(out[0].position.y, WithinAbs(expected.y, 0.0001f));
+    CHECK_THAT(out[0].position.z, WithinAbs(expected.z, 0.0001f));
+    CHECK_THAT(out[0].normal.length(), WithinAbs(1.0f, 0.0001f));
+    CHECK_THAT(out[0].normal.x, WithinAbs(-std::sin(0.7f), 0.0001f));
+    CHECK(out[0].color.y == 0.4f);
+    CHECK(out[0].uv.y == 0.75f);
+}
+
+// =============================================================================
+// Dynamic Batcher Tests
+// =============================================================================
+TEST_CASE("DynamicBatcher groups small meshes by material", "[core][dynamic_batch]") {
+    MockGraphicsDeviceForDynamicBatch device;
+    JobSystem jobs(2);
+    auto quad = make_quad(device);
+
+    std::vector<SceneObject> objects;
+    for (int i = 0; i < 4; ++i) {
+        objects.push_back(SceneObject{quad.get(), Material{{1}, nullptr},
+            math::Mat4::translate({static_cast<float>(i) * 10.0f, 0, 0})});
+    }
+    objects.push_back(SceneObject{quad.get(), Material{{2}, nullptr}, math::Mat4::identity()});
+
+    DynamicBatcher batcher(device);
+    batcher.build(objects, jobs);
+
+    REQUIRE(batcher.groups().size() == 1);
+    CHECK(batcher.groups()[0].object_count == 4);
+    CHECK(batcher.groups()[0].index_count == 24);
+    CHECK(batcher.is_batched(0));
+    CHECK(batcher.is_batched(3));
+    CHECK_FALSE(batcher.is_batched(4));
+
+    SECTION("Staged vertices are in world space with rebased indices") {
+        const auto& verts = batcher.staged_vertices();
+        REQUIRE(verts.size() == 16);
+        CHECK_THAT(verts[12].position.x, WithinAbs(30.0f, 0.0001f));
+        CHECK(batcher.staged_indices()[6] == 4);
+    }
+
+    SECTION("Upload streams the staged data") {
+        batcher.upload();
+        CHECK(device.last_vertex_upload == 16 * sizeof(Vertex));
+        CHECK(device.last_index_upload == 24 * sizeof(uint32_t));
+    }
+}
+
+TEST_CASE("DynamicBatcher eligibility", "[core][dynamic_batch]") {
+    MockGraphicsDeviceForDynamicBatch device;
+    auto quad = make_quad(device);
+    DynamicBatchSettings settings;
+
+    SECTION("Vertex count threshold") {
+        SceneObject obj{quad.get(), Material{{1}, nullptr}, math::Mat4::identity()};
+        settings.max_vertices_per_object = 4;
+        CHECK(DynamicBatcher::is_eligible(obj, settings));
+        settings.max_vertices_per_object = 3;
+        CHECK_FALSE(DynamicBatcher::is_eligible(obj, settings));
+    }
+
+    SECTION("Static objects and missing meshes are excluded") {
+        CHECK_FALSE(DynamicBatcher::is_eligible(SceneObject{quad.get(), Material{}, math::Mat4::identity(), true},
+            settings));
+        CHECK_FALSE(DynamicBatcher::is_eligible(SceneObject{}, settings));
+    }
+
+    SECTION("Frame capacity leaves the remainder to per-draw") {
+        JobSystem jobs(0);
+        settings.max_vertices_per_frame = 8;
+        std::vector<SceneObject> objects(3, SceneObject{quad.get(), Material{{1}, nullptr}, math::Mat4::identity()});
+        DynamicBatcher batcher(device, settings);
+        batcher.build(objects, jobs);
+        REQUIRE(batcher.groups().size() == 1);
+        CHECK(batcher.groups()[0].object_count == 2);
+        CHECK_FALSE(batcher.is_batched(2));
+    }
+}
+
+TEST_CASE("Scene renders dynamic batches with one draw per material", "[core][dynamic_batch]") {
+    MockGraphicsDeviceForDynamicBatch device;
+    JobSystem jobs(2);
+    Scene scene;
+    for (int i = 0; i < 10; ++i) {
+        scene.add_object(make_quad(device), Material{{1}, nullptr});
+    }
+    scene.enable_dynamic_batching(device);
+    scene.build_dynamic_batches(jobs);
+
+    CHECK(scene.drawable_count() == 1);
+    UniformBufferHandle ub = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+    scene.render(device, ub, math::Mat4::identity(), DirectionalLighting::default_sun(), math::Vec3(0.0f));
+    CHECK(device.draws == 1);
+    CHECK(device.uniform_updates == 1);
+    CHECK(device.last_range_count == 60);
+}
+
+// =============================================================================
+// Benchmarks (hidden; run with "[benchmark]")
+// =============================================================================
+TEST_CASE("DynamicBatcher frees its streaming buffers", "[core][dynamic_batch]") {
+    NullDevice device;
+    device.initialize(nullptr);
+    {
+        DynamicBatcher batcher(device);
+        CHECK(device.live_buffer_count() == 2 * StreamingGeometryBuffer::kFramesInFlight);
+    }
+    CHECK(device.live_buffer_count() == 0);
+    CHECK(device.validation_error_count() == 0);
+}
+
+TEST_CASE("Dynamic batching vs per-draw CPU cost", "[.][benchmark][dynamic_batch]") {
+    MockGraphicsDeviceForDynamicBatch device;
+    Scene per_draw;
+    Scene batched;
+    for (int i = 0; i < 4000; ++i) {
+        const math::Mat4 m = math::Mat4::translate({static_cast<float>(i % 64), static_cast<float>(i / 64), 0});
+        per_draw.add_object(make_quad(device), Material{{1}, nullptr});
+        per_draw.objects().back().model_matrix = m;
+        batched.add_object(make_quad(device), Material{{1}, nullptr});
+        batched.objects().back().model_matrix = m;
+    }
+    DynamicBatchSettings settings;
+    settings.max_vertices_per_frame = 1u << 15;
+    batched.enable_dynamic_batching(device, settings);
+    UniformBufferHandle ub = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+    const DirectionalLighting light = DirectionalLighting::default_sun();
+
+    BENCHMARK("per-draw render, 4000 quads") {
+        per_draw.render(device, ub, math::Mat4::identity(), light, math::Vec3(0.0f));
+        return device.draws;
+    };
+    BENCHMARK("batched build + render, 4000 quads") {
+        batched.build_dynamic_batches(JobSystem::instance());
+        batched.render(device, ub, math::Mat4::identity(), light, math::Vec3(0.0f));
+        return device.draws;
+    };
+}
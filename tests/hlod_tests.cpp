@@ -0,0 +1,187 @@
+#include <catch2/catch_test_macros.hpp>
+#include "maya/core/hlod.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/view_culling.hpp"
+#include "maya/rhi/graphics_device.hpp"
+
+using namespace maya;
+using namespace maya::math;
+
+// Mock GraphicsDevice counting draws
+class MockGraphicsDeviceForHlod : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override { ++draws; }
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override { ++draws; }
+
+    uint32_t draws = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Flat 8x8 tile of 1x1 quads (128 triangles) in the XZ plane, corner at the origin.
+std::unique_ptr<Mesh> make_tile(GraphicsDevice& device) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (int z = 0; z <= 8; ++z) {
+        for (int x = 0; x <= 8; ++x) {
+            vertices.emplace_back(Vec3(static_cast<float>(x), 0.0f, static_cast<float>(z)), Vec3(0, 1, 0), Vec4(1));
+        }
+    }
+    for (uint32_t z = 0; z < 8; ++z) {
+        for (uint32_t x = 0; x < 8; ++x) {
+            const uint32_t i = z * 9 + x;
+            indices.insert(indices.end(), {i, i + 9, i + 1, i + 1, i + 9, i + 10});
+        }
+    }
+    return std::make_unique<Mesh>(device, vertices, indices);
+}
+
+/// A 16x16 grid of tiles 10 units apart on the XZ plane, alternating two materials.
+void add_town(Scene& scene, GraphicsDevice& device) {
+    for (int x = 0; x < 16; ++x) {
+        for (int z = 0; z < 16; ++z) {
+            scene.add_static_object(make_tile(device), Material{{(x + z) % 2 == 0 ? 1u : 2u}, nullptr},
+                Mat4::translate(Vec3(1.0f + 10.0f * static_cast<float>(x), 0.0f, 1.0f + 10.0f * static_cast<float>(z))));
+        }
+    }
+    scene.build_static_batches(device);
+}
+
+HlodSettings town_settings() {
+    HlodSettings settings;
+    settings.cluster_size = 20.0f;
+    settings.levels = 3;
+    settings.simplify_cell_fraction = 1.0f / 64.0f;
+    settings.switch_screen_size = 0.05f;
+    return settings;
+}
+
+CullView view_from(const Vec3& eye) {
+    CullView view;
+    view.position = eye;
+    view.view_projection = Mat4::perspective(to_radians(60.0f), 1.0f, 0.1f, 10000.0f)
+        * Mat4::look_at(eye, Vec3(80, 0, 80), Vec3(0, 1, 0));
+    return view;
+}
+
+} // namespace
+
+// =============================================================================
+// Build Tests
+// =============================================================================
+TEST_CASE("HlodTree clusters static objects spatially", "[core][hlod]") {
+    MockGraphicsDeviceForHlod device;
+    Scene scene;
+    add_town(scene, device);
+    HlodTree tree;
+    tree.build(device, scene.static_objects(), town_settings());
+
+    // 20-unit cells hold 2x2 boxes; three levels up an 8x8 leaf grid becomes one root.
+    CHECK(tree.leaf_count() == 64);
+    CHECK(tree.root_count() == 1);
+    CHECK(tree.clusters().size() == 64 + 16 + 4 + 1);
+
+    bool every_object_placed = true;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(scene.static_objects().size()); ++i) {
+        every_object_placed = every_object_placed && tree.leaf_of(i) < tree.leaf_count();
+    }
+    CHECK(every_object_placed);
+
+    bool ranges_nest = true;
+    for (const HlodCluster& cluster : tree.clusters()) {
+        uint32_t next_leaf = cluster.first_leaf;
+        for (uint32_t c = cluster.first_child; c < cluster.first_child + cluster.child_count; ++c) {
+            const HlodCluster& child = tree.clusters()[c];
+            ranges_nest = ranges_nest && child.first_leaf == next_leaf && child.level + 1 == cluster.level;
+            next_leaf += child.leaf_count;
+        }
+        ranges_nest = ranges_nest && (cluster.child_count == 0 || next_leaf == cluster.first_leaf + cluster.leaf_count);
+    }
+    CHECK(ranges_nest);
+
+    const HlodCluster& root = tree.clusters()[tree.first_root()];
+    CHECK(root.leaf_count == 64);
+    CHECK(root.proxies.size() == 2);
+    uint32_t root_triangles = 0;
+    for (const HlodProxy& proxy : root.proxies) {
+        root_triangles += proxy.mesh->index_count() / 3;
+    }
+    CHECK(root_triangles > 0);
+    CHECK(root_triangles < 256 * 128 / 4);
+    CHECK(root.bounds.contains(Vec3(159, 0, 159)));
+}
+
+TEST_CASE("HlodTree handles scenes without geometry", "[core][hlod]") {
+    MockGraphicsDeviceForHlod device;
+    HlodTree tree;
+    tree.build(device, {}, town_settings());
+    CHECK(tree.empty());
+    CHECK(tree.leaf_of(0) == kNoHlodCluster);
+}
+
+// =============================================================================
+// Runtime Tests
+// =============================================================================
+TEST_CASE("Distant clusters draw as proxies", "[core][hlod]") {
+    MockGraphicsDeviceForHlod device;
+    JobSystem jobs(0);
+    Scene scene;
+    add_town(scene, device);
+    scene.build_hlod(device, town_settings());
+    REQUIRE(scene.hlod() != nullptr);
+    UniformBufferHandle ub = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+
+    auto draws_from = [&](const Vec3& eye) {
+        ViewSet views;
+        views.add_view(view_from(eye));
+        views.cull(scene, jobs);
+        device.draws = 0;
+        scene.render(device, ub, views, 0, DirectionalLighting::default_sun());
+        return device.draws;
+    };
+
+    SECTION("Far away the whole town is the root proxy") {
+        CHECK(draws_from(Vec3(80, 400, -3000)) == 2);
+        CHECK(draws_from(Vec3(80, 800, -6000)) == 2);
+    }
+
+    SECTION("Close up the nearby objects draw themselves") {
+        ViewSet views;
+        views.add_view(view_from(Vec3(80, 5, -5)));
+        views.cull(scene, jobs);
+        bool any_range_visible = false;
+        for (uint32_t b = 0; b < static_cast<uint32_t>(scene.static_batches().size()); ++b) {
+            for (uint32_t r = 0; r < static_cast<uint32_t>(scene.static_batches()[b].ranges.size()); ++r) {
+                any_range_visible = any_range_visible || views.is_static_range_visible(0, b, r);
+            }
+        }
+        CHECK(any_range_visible);
+        bool proxies_are_coarse_or_far = true;
+        for (uint32_t c : views.hlod_proxies(0)) {
+            const HlodCluster& cluster = scene.hlod()->clusters()[c];
+            proxies_are_coarse_or_far = proxies_are_coarse_or_far && cluster.bounds.center().z > 20.0f;
+        }
+        CHECK(proxies_are_coarse_or_far);
+    }
+}
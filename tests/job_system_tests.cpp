@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include "maya/core/job_system.hpp"
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+using namespace maya;
+
+// =============================================================================
+// Parallel For Tests
+// =============================================================================
+TEST_CASE("JobSystem parallel_for covers every index once", "[core][jobs]") {
+    JobSystem jobs(3);
+    std::vector<std::atomic<int>> hits(10000);
+
+    jobs.parallel_for(static_cast<uint32_t>(hits.size()), 16, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            hits[i].fetch_add(1);
+        }
+    });
+
+    bool all_once = true;
+    for (auto& h : hits) {
+        all_once = all_once && h.load() == 1;
+    }
+    CHECK(all_once);
+}
+
+TEST_CASE("JobSystem edge cases", "[core][jobs]") {
+    SECTION("Zero items never calls the function") {
+        JobSystem jobs(2);
+        bool called = false;
+        jobs.parallel_for(0, 1, [&](uint32_t, uint32_t) { called = true; });
+        CHECK_FALSE(called);
+    }
+
+    SECTION("No workers runs inline") {
+        JobSystem jobs(0);
+        CHECK(jobs.worker_count() == 0);
+        uint32_t total = 0;
+        jobs.parallel_for(100, 1, [&](uint32_t begin, uint32_t end) { total += end - begin; });
+        CHECK(total == 100);
+    }
+
+    SECTION("Nested parallel_for completes") {
+        JobSystem jobs(2);
+        std::atomic<uint32_t> total{0};
+        jobs.parallel_for(8, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                jobs.parallel_for(100, 10, [&](uint32_t b, uint32_t e) { total.fetch_add(e - b); });
+            }
+        });
+        CHECK(total.load() == 800);
+    }
+}
+
+TEST_CASE("JobSystem submit and wait_idle", "[core][jobs]") {
+    JobSystem jobs(2);
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 50; ++i) {
+        jobs.submit([&] { counter.fetch_add(1); });
+    }
+    jobs.wait_idle();
+    CHECK(counter.load() == 50);
+}
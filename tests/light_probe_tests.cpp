@@ -0,0 +1,277 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/image_loader.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/light_probes.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+using Catch::Matchers::WithinAbs;
+
+class MockGraphicsDeviceForProbes : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void* data, size_t size) override {
+        SceneDrawUniforms uniforms{};
+        std::memcpy(&uniforms, data, std::min(size, sizeof(uniforms)));
+        uploads.push_back(uniforms);
+    }
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
+
+    std::vector<SceneDrawUniforms> uploads;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Smooth test environment made only of bands 0-2, so L2 projection reproduces it exactly.
+Vec3 environment(const Vec3& d) {
+    return Vec3(1.0f + 0.5f * d.y, 0.8f + 0.4f * d.x * d.z, 0.6f + 0.3f * (d.x * d.x - d.y * d.y));
+}
+
+HdrImageData make_equirect(uint32_t width, uint32_t height) {
+    HdrImageData image;
+    image.width = width;
+    image.height = height;
+    image.pixels.reserve(static_cast<size_t>(width) * height * 3);
+    for (uint32_t y = 0; y < height; ++y) {
+        const float theta = PI * (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+        for (uint32_t x = 0; x < width; ++x) {
+            const float phi = TWO_PI * (static_cast<float>(x) + 0.5f) / static_cast<float>(width);
+            const Vec3 c = environment(
+                Vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)));
+            image.pixels.insert(image.pixels.end(), {c.x, c.y, c.z});
+        }
+    }
+    return image;
+}
+
+std::array<HdrImageData, 6> make_cubemap(uint32_t size) {
+    std::array<HdrImageData, 6> faces;
+    for (uint32_t f = 0; f < 6; ++f) {
+        faces[f].width = size;
+        faces[f].height = size;
+        for (uint32_t y = 0; y < size; ++y) {
+            const float v = 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(size) - 1.0f;
+            for (uint32_t x = 0; x < size; ++x) {
+                const float u = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(size) - 1.0f;
+                const Vec3 directions[6] = {Vec3(1, -v, -u), Vec3(-1, -v, u), Vec3(u, 1, v), Vec3(u, -1, -v),
+                    Vec3(u, -v, 1), Vec3(-u, -v, -1)};
+                const Vec3 c = environment(directions[f].normalized());
+                faces[f].pixels.insert(faces[f].pixels.end(), {c.x, c.y, c.z});
+            }
+        }
+    }
+    return faces;
+}
+
+void check_reconstructs_environment(const SphericalHarmonicsL2& sh, float tolerance) {
+    const Vec3 directions[] = {Vec3(0, 1, 0), Vec3(0, -1, 0), Vec3(1, 0, 0), Vec3(0, 0, -1),
+        Vec3(1, 1, 1).normalized(), Vec3(-1, 0.5f, 2).normalized()};
+    for (const Vec3& d : directions) {
+        const Vec3 expected = environment(d);
+        const Vec3 actual = sh.evaluate(d);
+        CHECK_THAT(actual.x, WithinAbs(expected.x, tolerance));
+        CHECK_THAT(actual.y, WithinAbs(expected.y, tolerance));
+        CHECK_THAT(actual.z, WithinAbs(expected.z, tolerance));
+    }
+}
+
+std::unique_ptr<Mesh> make_triangle(GraphicsDevice& device) {
+    std::vector<Vertex> vertices = {Vertex(Vec3(0, 0, 0), Vec3(0, 0, 1), Vec4(1, 1, 1, 1)),
+        Vertex(Vec3(1, 0, 0), Vec3(0, 0, 1), Vec4(1, 1, 1, 1)), Vertex(Vec3(0, 1, 0), Vec3(0, 0, 1), Vec4(1, 1, 1, 1))};
+    return std::make_unique<Mesh>(device, vertices, std::vector<uint32_t>{0, 1, 2});
+}
+
+} // namespace
+
+// =============================================================================
+// Spherical Harmonics Tests
+// =============================================================================
+TEST_CASE("SphericalHarmonicsL2 constant and diffuse lighting", "[core][light_probe]") {
+    const SphericalHarmonicsL2 sh = SphericalHarmonicsL2::constant(Vec3(0.5f, 1.0f, 2.0f));
+    for (const Vec3& d : {Vec3(0, 1, 0), Vec3(1, 0, 0), Vec3(0, -0.6f, 0.8f)}) {
+        CHECK_THAT(sh.evaluate(d).y, WithinAbs(1.0f, 1e-5f));
+        // A white Lambertian surface under uniform radiance L reflects L.
+        CHECK_THAT(sh.diffuse(d).z, WithinAbs(2.0f, 1e-5f));
+    }
+
+    SphericalHarmonicsL2 sky;
+    sky.add(Vec3(0, 1, 0), Vec3(1, 1, 1), 1.0f);
+    CHECK(sky.diffuse(Vec3(0, 1, 0)).x > sky.diffuse(Vec3(1, 0, 0)).x);
+    CHECK(sky.diffuse(Vec3(1, 0, 0)).x > sky.diffuse(Vec3(0, -1, 0)).x);
+}
+
+// =============================================================================
+// Projection Tests
+// =============================================================================
+TEST_CASE("Equirectangular projection reconstructs a low-frequency environment", "[core][light_probe]") {
+    JobSystem jobs(2);
+
+    SECTION("Uniform environment") {
+        HdrImageData image;
+        image.width = 64;
+        image.height = 32;
+        image.pixels.assign(64 * 32 * 3, 0.25f);
+        const SphericalHarmonicsL2 sh = project_equirect_sh(image, jobs);
+        CHECK_THAT(sh.coefficients[0].x, WithinAbs(0.25f * 3.544908f, 2e-3f));
+        for (int i = 1; i < SphericalHarmonicsL2::kCount; ++i) {
+            CHECK_THAT(sh.coefficients[i].y, WithinAbs(0.0f, 2e-3f));
+        }
+    }
+
+    SECTION("Widths that are not a multiple of four") {
+        check_reconstructs_environment(project_equirect_sh(make_equirect(126, 63), jobs), 5e-3f);
+    }
+
+    SECTION("Result does not depend on the worker count") {
+        const HdrImageData image = make_equirect(64, 32);
+        JobSystem inline_jobs(0);
+        const SphericalHarmonicsL2 a = project_equirect_sh(image, jobs);
+        const SphericalHarmonicsL2 b = project_equirect_sh(image, inline_jobs);
+        for (int i = 0; i < SphericalHarmonicsL2::kCount; ++i) {
+            CHECK(a.coefficients[i].x == b.coefficients[i].x);
+        }
+    }
+
+    SECTION("Empty images project to zero") {
+        CHECK(project_equirect_sh(HdrImageData{}, jobs).coefficients[0].x == 0.0f);
+    }
+}
+
+TEST_CASE("Cube map and equirectangular projections agree", "[core][light_probe]") {
+    JobSystem jobs(2);
+    const SphericalHarmonicsL2 cube = project_cubemap_sh(make_cubemap(30), jobs);
+    const SphericalHarmonicsL2 equirect = project_equirect_sh(make_equirect(128, 64), jobs);
+    check_reconstructs_environment(cube, 5e-3f);
+    for (int i = 0; i < SphericalHarmonicsL2::kCount; ++i) {
+        CHECK_THAT(cube.coefficients[i].x, WithinAbs(equirect.coefficients[i].x, 5e-3f));
+        CHECK_THAT(cube.coefficients[i].y, WithinAbs(equirect.coefficients[i].y, 5e-3f));
+        CHECK_THAT(cube.coefficients[i].z, WithinAbs(equirect.coefficients[i].z, 5e-3f));
+    }
+
+    std::array<HdrImageData, 6> mismatched = make_cubemap(8);
+    mismatched[3] = make_equirect(16, 8);
+    CHECK(project_cubemap_sh(mismatched, jobs).coefficients[0].x == 0.0f);
+}
+
+TEST_CASE("ImageLoader decodes Radiance HDR to linear floats", "[core][light_probe]") {
+    std::string file = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y 1 +X 2\n";
+    // RGBE: mantissas scaled by 2^(exponent - 136).
+    const unsigned char texels[] = {128, 0, 0, 129, 64, 128, 32, 130};
+    file.append(reinterpret_cast<const char*>(texels), sizeof(texels));
+
+    HdrImageData image;
+    REQUIRE(ImageLoader::decode_hdr(file.data(), file.size(), image));
+    CHECK(image.width == 2);
+    CHECK(image.height == 1);
+    REQUIRE(image.pixels.size() == 6);
+    CHECK(image.pixels[0] == 1.0f);
+    CHECK(image.pixels[1] == 0.0f);
+    CHECK(image.pixels[3] == 1.0f);
+    CHECK(image.pixels[4] == 2.0f);
+    CHECK(image.pixels[5] == 0.5f);
+
+    CHECK_FALSE(ImageLoader::decode_hdr(texels, sizeof(texels), image));
+}
+
+// =============================================================================
+// Light Probe Grid Tests
+// =============================================================================
+TEST_CASE("LightProbeGrid interpolates trilinearly", "[core][light_probe]") {
+    LightProbeGrid grid(Aabb(Vec3(0, 0, 0), Vec3(10, 4, 10)), 3, 2, 3);
+    CHECK(grid.probe_count() == 18);
+    CHECK(grid.probe_position(1, 1, 2).x == 5.0f);
+    CHECK(grid.probe_position(1, 1, 2).y == 4.0f);
+    CHECK(grid.probe_position(1, 1, 2).z == 10.0f);
+
+    for (uint32_t z = 0; z < 3; ++z) {
+        for (uint32_t y = 0; y < 2; ++y) {
+            for (uint32_t x = 0; x < 3; ++x) {
+                // Ambient grows linearly with x and y so trilinear blending is exact.
+                const Vec3 p = grid.probe_position(x, y, z);
+                grid.probe(x, y, z) = SphericalHarmonicsL2::constant(Vec3(p.x, p.y, 1.0f));
+            }
+        }
+    }
+
+    const Vec3 up(0, 1, 0);
+    CHECK_THAT(grid.sample(Vec3(2.5f, 1.0f, 7.0f)).evaluate(up).x, WithinAbs(2.5f, 1e-5f));
+    CHECK_THAT(grid.sample(Vec3(2.5f, 1.0f, 7.0f)).evaluate(up).y, WithinAbs(1.0f, 1e-5f));
+    CHECK_THAT(grid.sample(Vec3(10.0f, 4.0f, 10.0f)).evaluate(up).x, WithinAbs(10.0f, 1e-5f));
+    // Outside the grid the nearest face is used.
+    CHECK_THAT(grid.sample(Vec3(-5.0f, 9.0f, 3.0f)).evaluate(up).x, WithinAbs(0.0f, 1e-5f));
+    CHECK_THAT(grid.sample(Vec3(-5.0f, 9.0f, 3.0f)).evaluate(up).y, WithinAbs(4.0f, 1e-5f));
+
+    const LightProbeGrid single(Aabb(Vec3(0, 0, 0), Vec3(1, 1, 1)), 1, 1, 1,
+        SphericalHarmonicsL2::constant(Vec3(3, 3, 3)));
+    CHECK_THAT(single.sample(Vec3(7, -2, 0.5f)).evaluate(up).z, WithinAbs(3.0f, 1e-5f));
+}
+
+TEST_CASE("Scene draws use SH ambient from light probes", "[core][light_probe]") {
+    MockGraphicsDeviceForProbes device;
+    Scene scene;
+    scene.add_object(make_triangle(device), Material{{1}, nullptr});
+    scene.objects()[0].model_matrix = Mat4::translate({8, 0, 0});
+    const DirectionalLighting lighting = DirectionalLighting::default_sun();
+    const UniformBufferHandle ub = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+
+    scene.render(device, ub, Mat4::identity(), lighting, Vec3(0.0f));
+    REQUIRE(device.uploads.size() == 1);
+    const SphericalHarmonicsL2 global = lighting.ambient.diffuse_convolved();
+    for (int i = 0; i < SphericalHarmonicsL2::kCount; ++i) {
+        CHECK(device.uploads[0].ambient_sh[i].x == global.coefficients[i].x);
+    }
+
+    LightProbeGrid probes(Aabb(Vec3(0, 0, 0), Vec3(10, 0, 0)), 2, 1, 1);
+    probes.probe(1, 0, 0) = SphericalHarmonicsL2::constant(Vec3(1, 1, 1));
+    scene.set_light_probes(std::move(probes));
+    REQUIRE(scene.light_probes() != nullptr);
+    scene.render(device, ub, Mat4::identity(), lighting, Vec3(0.0f));
+    REQUIRE(device.uploads.size() == 2);
+    // Shaders evaluate Y00 (0.282095) times the convolved coefficient: 0.8 of the second probe.
+    CHECK_THAT(device.uploads[1].ambient_sh[0].x * 0.282095f, WithinAbs(0.8f, 1e-4f));
+
+    scene.set_light_probes(LightProbeGrid{});
+    CHECK(scene.light_probes() == nullptr);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("Environment SH projection benchmarks", "[.][benchmark][light_probe]") {
+    const HdrImageData image = make_equirect(4096, 2048);
+    BENCHMARK("Project a 4K equirectangular map") {
+        return project_equirect_sh(image, JobSystem::instance()).coefficients[0].x;
+    };
+
+    const std::array<HdrImageData, 6> faces = make_cubemap(1024);
+    BENCHMARK("Project a 1024^2 cube map") {
+        return project_cubemap_sh(faces, JobSystem::instance()).coefficients[0].x;
+    };
+}
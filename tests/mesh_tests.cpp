@@ -26,6 +26,8 @@ public:
     }
     
     UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
     void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
     TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
     void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
@@ -34,6 +36,9 @@ public:
     void draw_indexed(IndexBufferHandle, uint32_t count) override {
         last_draw_count = count;
     }
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t count) override {
+        last_draw_count = count;
+    }
     
     size_t last_vertex_buffer_size = 0;
     size_t last_index_buffer_size = 0;
@@ -166,6 +171,26 @@ TEST_CASE("Mesh edge cases", "[core][mesh]") {
         CHECK(device.last_draw_count == 0);
     }
 
+    SECTION("Releasing the CPU copy keeps counts, bounds and drawing") {
+        std::vector<Vertex> vertices = {
+            Vertex(math::Vec3(0, 0, 0), math::Vec3(0, 1, 0), math::Vec4(1, 0, 0, 1)),
+            Vertex(math::Vec3(2, 0, 0), math::Vec3(0, 1, 0), math::Vec4(0, 1, 0, 1)),
+            Vertex(math::Vec3(0, 3, 0), math::Vec3(0, 1, 0), math::Vec4(0, 0, 1, 1))
+        };
+        Mesh mesh(device, vertices, {0, 1, 2});
+        CHECK(mesh.has_cpu_data());
+
+        mesh.release_cpu_data();
+        CHECK_FALSE(mesh.has_cpu_data());
+        CHECK(mesh.vertices().empty());
+        CHECK(mesh.indices().empty());
+        CHECK(mesh.vertex_count() == 3);
+        CHECK(mesh.index_count() == 3);
+        CHECK(mesh.local_bounds().max.y == 3.0f);
+        mesh.draw();
+        CHECK(device.last_draw_count == 3);
+    }
+
     SECTION("Single vertex") {
         std::vector<Vertex> vertices = {
             Vertex(math::Vec3(0, 0, 0), math::Vec3(0, 1, 0), math::Vec4(1, 0, 0, 1))
@@ -20,12 +20,15 @@ public:
     VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {1}; }
     IndexBufferHandle create_index_buffer(const void*, size_t) override { return {2}; }
     UniformBufferHandle create_uniform_buffer(size_t) override { return {3}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
     void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
     TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {4}; }
     void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
     void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
     void bind_texture(TextureHandle, uint32_t) override {}
     void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
 
 private:
     uint32_t next_pipeline = 1;
@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/morph_targets.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+class MockGraphicsDeviceForMorphing : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t size) override { last_vertex_upload = size; }
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override { ++index_uploads; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override { ++range_draws; }
+
+    uint32_t range_draws = 0;
+    uint32_t index_uploads = 0;
+    size_t last_vertex_upload = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Flat `size` x `size` vertex grid in the xz plane facing +y.
+MorphedMeshData make_grid(uint32_t size) {
+    MorphedMeshData mesh;
+    for (uint32_t z = 0; z < size; ++z) {
+        for (uint32_t x = 0; x < size; ++x) {
+            mesh.vertices.emplace_back(Vec3(static_cast<float>(x), 0, static_cast<float>(z)), Vec3(0, 1, 0),
+                Vec4(1, 1, 1, 1), Vec2(static_cast<float>(x), static_cast<float>(z)));
+        }
+    }
+    for (uint32_t z = 0; z + 1 < size; ++z) {
+        for (uint32_t x = 0; x + 1 < size; ++x) {
+            const uint32_t a = z * size + x;
+            mesh.indices.insert(mesh.indices.end(), {a, a + size, a + 1, a + 1, a + size, a + size + 1});
+        }
+    }
+    return mesh;
+}
+
+/// Raises vertices whose x lies in `[x0, x1)` by `height` and tilts their normals toward +x.
+MorphTarget make_bump(const MorphedMeshData& mesh, float x0, float x1, float height) {
+    std::vector<Vertex> shape = mesh.vertices;
+    for (Vertex& v : shape) {
+        if (v.position.x >= x0 && v.position.x < x1) {
+            v.position.y += height;
+            v.normal = Vec3(0.5f, 1.0f, 0.0f).normalized();
+        }
+    }
+    return make_morph_target("bump", mesh.vertices, shape);
+}
+
+} // namespace
+
+// =============================================================================
+// Target Construction Tests
+// =============================================================================
+TEST_CASE("make_morph_target keeps only moved vertices", "[core][morph]") {
+    const MorphedMeshData mesh = make_grid(8);
+    const MorphTarget target = make_bump(mesh, 2.0f, 4.0f, 1.0f);
+    REQUIRE(target.delta_count() == 16);
+    CHECK(target.has_normals);
+    CHECK(target.deltas.size() == 16 * 8);
+    CHECK(std::is_sorted(target.vertices.begin(), target.vertices.end()));
+    CHECK(target.deltas[1] == 1.0f);
+    CHECK(target.deltas[3] == 0.0f);
+
+    std::vector<Vertex> moved = mesh.vertices;
+    moved[5].position.z += 0.25f;
+    const MorphTarget position_only = make_morph_target("slide", mesh.vertices, moved);
+    REQUIRE(position_only.delta_count() == 1);
+    CHECK(position_only.vertices[0] == 5);
+    CHECK_FALSE(position_only.has_normals);
+}
+
+// =============================================================================
+// Evaluation Tests
+// =============================================================================
+TEST_CASE("apply_morph_targets accumulates weighted deltas", "[core][morph]") {
+    MorphedMeshData mesh = make_grid(8);
+    mesh.targets.push_back(make_bump(mesh, 0.0f, 4.0f, 1.0f));
+    mesh.targets.push_back(make_bump(mesh, 2.0f, 8.0f, 2.0f));
+    std::vector<Vertex> out(mesh.vertices.begin(), mesh.vertices.end());
+
+    SECTION("Zero weights leave the base mesh") {
+        const float weights[] = {0.0f, 0.0f};
+        apply_morph_targets(mesh, weights, 1e-3f, 0, 64, out.data());
+        for (uint32_t v = 0; v < 64; ++v) {
+            CHECK(out[v].position.y == 0.0f);
+            CHECK(out[v].normal.y == 1.0f);
+        }
+    }
+
+    SECTION("Overlapping targets add up") {
+        const float weights[] = {0.5f, 0.25f};
+        apply_morph_targets(mesh, weights, 1e-3f, 0, 64, out.data());
+        for (uint32_t v = 0; v < 64; ++v) {
+            const float x = mesh.vertices[v].position.x;
+            const float expected = (x < 4.0f ? 0.5f : 0.0f) + (x >= 2.0f ? 0.5f : 0.0f);
+            CHECK_THAT(out[v].position.y, Catch::Matchers::WithinAbs(expected, 1e-6f));
+            CHECK_THAT(out[v].normal.length(), Catch::Matchers::WithinAbs(1.0f, 1e-5f));
+            CHECK(out[v].uv.x == mesh.vertices[v].uv.x);
+        }
+    }
+
+    SECTION("Weights below epsilon are skipped") {
+        const float weights[] = {1e-4f, 1.0f};
+        apply_morph_targets(mesh, weights, 1e-3f, 0, 64, out.data());
+        CHECK(out[0].position.y == 0.0f);
+        CHECK_THAT(out[7].position.y, Catch::Matchers::WithinAbs(2.0f, 1e-6f));
+    }
+
+    SECTION("Sub-ranges match the full evaluation") {
+        const float weights[] = {0.7f, -0.4f};
+        apply_morph_targets(mesh, weights, 1e-3f, 0, 64, out.data());
+        std::vector<Vertex> part(mesh.vertices.begin(), mesh.vertices.begin() + 20);
+        apply_morph_targets(mesh, weights, 1e-3f, 21, 20, part.data());
+        for (uint32_t v = 0; v < 20; ++v) {
+            CHECK(part[v].position.y == out[21 + v].position.y);
+            CHECK(part[v].normal.x == out[21 + v].normal.x);
+        }
+    }
+}
+
+// =============================================================================
+// MorphTargetSystem Tests
+// =============================================================================
+TEST_CASE("MorphTargetSystem evaluates, uploads and draws every instance", "[core][morph]") {
+    MockGraphicsDeviceForMorphing device;
+    JobSystem jobs(2);
+    MorphedMeshData mesh = make_grid(100);
+    mesh.targets.push_back(make_bump(mesh, 10.0f, 60.0f, 1.0f));
+    const uint32_t vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+    const uint32_t index_count = static_cast<uint32_t>(mesh.indices.size());
+    MorphTargetSystem morphs(device, vertex_count * 2, index_count * 2);
+
+    const uint32_t a = morphs.add_instance(&mesh, Material{});
+    const uint32_t b = morphs.add_instance(&mesh, Material{});
+    CHECK(morphs.add_instance(&mesh, Material{}) == ~0u);
+    REQUIRE(morphs.weights(b).size() == 1);
+    CHECK(morphs.first_vertex(b) == vertex_count);
+
+    morphs.weights(a)[0] = 0.0f;
+    morphs.weights(b)[0] = 0.5f;
+    morphs.update(jobs);
+    const std::vector<Vertex>& out = morphs.morphed_vertices();
+    for (uint32_t v = 0; v < vertex_count; v += 7) {
+        const float x = mesh.vertices[v].position.x;
+        CHECK(out[v].position.y == 0.0f);
+        CHECK(out[vertex_count + v].position.y == (x >= 10.0f && x < 60.0f ? 0.5f : 0.0f));
+    }
+    CHECK(device.last_vertex_upload == sizeof(Vertex) * vertex_count * 2);
+
+    morphs.render(device, UniformBufferHandle{1}, Mat4::identity(), DirectionalLighting::default_sun(),
+        Vec3(0, 0, 0));
+    CHECK(device.range_draws == 2);
+
+    // Indices only change with instances, so each frame's buffer receives them once.
+    for (int frame = 0; frame < 5; ++frame) {
+        morphs.update(jobs);
+    }
+    CHECK(device.index_uploads == StreamingGeometryBuffer::kFramesInFlight);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("MorphTargetSystem benchmarks", "[.][benchmark][morph]") {
+    MockGraphicsDeviceForMorphing device;
+    // A face-sized mesh (~20k vertices) with 60 targets, each touching a 10% region.
+    MorphedMeshData mesh = make_grid(142);
+    for (uint32_t t = 0; t < 60; ++t) {
+        const float x0 = static_cast<float>((t * 37) % 128);
+        mesh.targets.push_back(make_bump(mesh, x0, x0 + 14.0f, 0.01f * static_cast<float>(t + 1)));
+    }
+    MorphTargetSystem morphs(device, static_cast<uint32_t>(mesh.vertices.size()),
+        static_cast<uint32_t>(mesh.indices.size()));
+    const uint32_t id = morphs.add_instance(&mesh, Material{});
+    for (uint32_t t = 0; t < 60; ++t) {
+        morphs.weights(id)[t] = 0.3f + 0.01f * static_cast<float>(t);
+    }
+
+    BENCHMARK("Evaluate 60 targets on a 20k-vertex mesh") {
+        morphs.update(JobSystem::instance());
+        return morphs.morphed_vertices()[0].position.y;
+    };
+
+    for (uint32_t t = 0; t < 60; t += 2) {
+        morphs.weights(id)[t] = 0.0f;
+    }
+    BENCHMARK("Evaluate with half the targets at zero weight") {
+        morphs.update(JobSystem::instance());
+        return morphs.morphed_vertices()[0].position.y;
+    };
+}
@@ -0,0 +1,261 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/procedural_noise.hpp"
+#include "maya/core/terrain.hpp"
+#include "maya/math/noise.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+using Catch::Matchers::WithinAbs;
+using simd::Float4;
+
+namespace {
+
+/// Deterministic scattered coordinates in [-range, range), including negative lattice cells.
+std::vector<float> scatter(size_t count, float range, uint32_t seed) {
+    std::vector<float> values(count);
+    uint32_t state = seed;
+    for (float& v : values) {
+        state = state * 1664525u + 1013904223u;
+        v = (static_cast<float>(state >> 8) * (1.0f / 16777216.0f) * 2.0f - 1.0f) * range;
+    }
+    return values;
+}
+
+} // namespace
+
+// =============================================================================
+// Basis Tests
+// =============================================================================
+TEST_CASE("Float4 noise matches the scalar templates", "[math][noise]") {
+    const std::vector<float> x = scatter(256, 40.0f, 1);
+    const std::vector<float> y = scatter(256, 40.0f, 2);
+    const std::vector<float> z = scatter(256, 40.0f, 3);
+    const std::vector<float> w = scatter(256, 40.0f, 4);
+    float max_error = 0.0f;
+    for (size_t i = 0; i < x.size(); i += 4) {
+        const Float4 vx = Float4::load(&x[i]), vy = Float4::load(&y[i]), vz = Float4::load(&z[i]);
+        const Float4 vw = Float4::load(&w[i]);
+        const Float4 results[5] = {noise::simplex(vx, vy), noise::simplex(vx, vy, vz), noise::simplex(vx, vy, vz, vw),
+            noise::perlin(vx, vy), noise::perlin(vx, vy, vz)};
+        for (int lane = 0; lane < 4; ++lane) {
+            const size_t j = i + static_cast<size_t>(lane);
+            const float expected[5] = {noise::simplex(x[j], y[j]), noise::simplex(x[j], y[j], z[j]),
+                noise::simplex(x[j], y[j], z[j], w[j]), noise::perlin(x[j], y[j]), noise::perlin(x[j], y[j], z[j])};
+            for (int f = 0; f < 5; ++f) {
+                max_error = std::max(max_error, std::fabs(results[f].lane(lane) - expected[f]));
+            }
+        }
+    }
+    CHECK(max_error < 1e-5f);
+}
+
+TEST_CASE("Noise bases stay in range and vary smoothly", "[math][noise]") {
+    const std::vector<float> x = scatter(4096, 100.0f, 5);
+    const std::vector<float> y = scatter(4096, 100.0f, 6);
+    const std::vector<float> z = scatter(4096, 100.0f, 7);
+    const std::vector<float> w = scatter(4096, 100.0f, 8);
+    float peak[5] = {};
+    float max_step = 0.0f;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const float values[5] = {noise::simplex(x[i], y[i]), noise::simplex(x[i], y[i], z[i]),
+            noise::simplex(x[i], y[i], z[i], w[i]), noise::perlin(x[i], y[i]), noise::perlin(x[i], y[i], z[i])};
+        for (int f = 0; f < 5; ++f) {
+            peak[f] = std::max(peak[f], std::fabs(values[f]));
+        }
+        max_step = std::max(max_step, std::fabs(noise::simplex(x[i] + 1e-3f, y[i], z[i]) - values[1]));
+    }
+    for (float p : peak) {
+        CHECK(p < 1.1f);
+        CHECK(p > 0.5f);
+    }
+    // Gradients are bounded, so tiny steps give tiny changes.
+    CHECK(max_step < 0.02f);
+
+    // Classic Perlin noise is zero on the integer lattice.
+    CHECK_THAT(noise::perlin(3.0f, -7.0f), WithinAbs(0.0f, 1e-6f));
+    CHECK_THAT(noise::perlin(-2.0f, 5.0f, 11.0f), WithinAbs(0.0f, 1e-6f));
+}
+
+TEST_CASE("Fractal variants combine octaves", "[math][noise]") {
+    noise::Fractal fractal;
+    fractal.frequency = 0.1f;
+    const std::vector<float> x = scatter(2048, 200.0f, 9);
+    const std::vector<float> y = scatter(2048, 200.0f, 10);
+    float fbm_peak = 0.0f;
+    float ridged_min = 1.0f;
+    float ridged_max = -1.0f;
+    float warped_peak = 0.0f;
+    for (size_t i = 0; i < x.size(); ++i) {
+        fbm_peak = std::max(fbm_peak, std::fabs(noise::fbm(fractal, x[i], y[i])));
+        const float r = noise::ridged(fractal, x[i], y[i]);
+        ridged_min = std::min(ridged_min, r);
+        ridged_max = std::max(ridged_max, r);
+        warped_peak = std::max(warped_peak, std::fabs(noise::warped(fractal, x[i], y[i], 0.5f)));
+    }
+    CHECK(fbm_peak < 1.0f);
+    CHECK(ridged_min >= -1.0f);
+    CHECK(ridged_max <= 1.0f);
+    CHECK(ridged_max - ridged_min > 0.5f);
+    CHECK(warped_peak < 1.0f);
+
+    // One octave is the basis itself at the first frequency.
+    fractal.octaves = 1;
+    fractal.basis = noise::Basis::Perlin;
+    CHECK_THAT(noise::fbm(fractal, 13.0f, 4.0f), WithinAbs(noise::perlin(1.3f, 0.4f), 1e-5f));
+}
+
+// =============================================================================
+// Batch Tests
+// =============================================================================
+TEST_CASE("evaluate_noise handles full batches and the scalar tail alike", "[core][noise]") {
+    NoiseSettings settings;
+    settings.offset = Vec3(3.0f, -2.0f, 1.0f);
+    const std::vector<float> x = scatter(13, 10.0f, 11);
+    const std::vector<float> y = scatter(13, 10.0f, 12);
+    const std::vector<float> z = scatter(13, 10.0f, 13);
+
+    for (NoiseVariant variant : {NoiseVariant::Single, NoiseVariant::Fbm, NoiseVariant::Ridged, NoiseVariant::Warped}) {
+        settings.variant = variant;
+        std::vector<float> batch2(13), batch3(13);
+        evaluate_noise(settings, x.data(), y.data(), nullptr, batch2.data(), 13);
+        evaluate_noise(settings, x.data(), y.data(), z.data(), batch3.data(), 13);
+        for (size_t i = 0; i < 13; ++i) {
+            // Lane i % 8 of the first batch against a one-sample (scalar) call.
+            float single2 = 0.0f, single3 = 0.0f;
+            evaluate_noise(settings, &x[i], &y[i], nullptr, &single2, 1);
+            evaluate_noise(settings, &x[i], &y[i], &z[i], &single3, 1);
+            CHECK_THAT(batch2[i], WithinAbs(single2, 1e-5f));
+            CHECK_THAT(batch3[i], WithinAbs(single3, 1e-5f));
+        }
+    }
+}
+
+TEST_CASE("Noise grids do not depend on the worker count", "[core][noise]") {
+    NoiseSettings settings;
+    settings.fractal.frequency = 0.05f;
+    JobSystem pool(2);
+    JobSystem inline_jobs(0);
+
+    std::vector<float> a, b;
+    fill_noise_grid(settings, 37, 21, Vec2(-5.0f, 2.0f), 0.5f, a, pool);
+    fill_noise_grid(settings, 37, 21, Vec2(-5.0f, 2.0f), 0.5f, b, inline_jobs);
+    REQUIRE(a.size() == 37u * 21u);
+    CHECK(a == b);
+    float x = -5.0f + 10 * 0.5f, y = 2.0f + 4 * 0.5f, expected = 0.0f;
+    evaluate_noise(settings, &x, &y, nullptr, &expected, 1);
+    CHECK_THAT(a[4 * 37 + 10], WithinAbs(expected, 1e-5f));
+
+    std::vector<float> volume;
+    fill_noise_volume(settings, 9, 5, 3, Vec3(1.0f, 2.0f, 3.0f), 2.0f, volume, pool);
+    REQUIRE(volume.size() == 9u * 5u * 3u);
+    float vx = 1.0f + 8 * 2.0f, vy = 2.0f + 3 * 2.0f, vz = 3.0f + 2 * 2.0f;
+    evaluate_noise(settings, &vx, &vy, &vz, &expected, 1);
+    CHECK_THAT(volume[(2 * 5 + 3) * 9 + 8], WithinAbs(expected, 1e-5f));
+}
+
+// =============================================================================
+// Content Tests
+// =============================================================================
+TEST_CASE("Noise heightmaps and textures", "[core][noise]") {
+    NoiseSettings settings;
+    settings.variant = NoiseVariant::Ridged;
+    settings.fractal.frequency = 1.0f / 32.0f;
+    JobSystem jobs(2);
+
+    const HeightImageData heights = make_noise_heightmap(settings, 65, 33, jobs);
+    REQUIRE(heights.pixels.size() == 65u * 33u);
+    const auto [lo, hi] = std::minmax_element(heights.pixels.begin(), heights.pixels.end());
+    CHECK(*hi - *lo > 10000);
+    const Heightfield field = Heightfield::from_image(heights, 2.0f, 100.0f);
+    CHECK(field.width == 65);
+    CHECK(field.depth == 33);
+
+    const ImageData texture = make_noise_texture(settings, 16, 8, Vec4(0, 0, 0, 1), Vec4(1, 0.5f, 0, 1), jobs);
+    REQUIRE(texture.pixels.size() == 16u * 8u * 4u);
+    bool in_gradient = true;
+    for (size_t i = 0; i < texture.pixels.size(); i += 4) {
+        in_gradient = in_gradient && texture.pixels[i + 2] == 0 && texture.pixels[i + 3] == 255
+            && std::abs(texture.pixels[i] / 2 - texture.pixels[i + 1]) <= 1;
+    }
+    CHECK(in_gradient);
+}
+
+TEST_CASE("displace_mesh moves vertices along their normals", "[core][noise]") {
+    // 9x9 vertex grid in the xy plane facing +z, plus one vertex without a normal.
+    MeshData mesh;
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 9; ++x) {
+            mesh.vertices.emplace_back(Vec3(static_cast<float>(x), static_cast<float>(y), 0.0f), Vec3(0, 0, 1),
+                Vec4(1, 1, 1, 1));
+        }
+    }
+    for (uint32_t y = 0; y < 8; ++y) {
+        for (uint32_t x = 0; x < 8; ++x) {
+            const uint32_t i = y * 9 + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + 1, i + 9, i + 9, i + 1, i + 10});
+        }
+    }
+    mesh.vertices.emplace_back(Vec3(4.5f, 4.5f, 0.0f), Vec3(0, 0, 0), Vec4(1, 1, 1, 1));
+
+    NoiseSettings settings;
+    settings.fractal.frequency = 0.3f;
+    JobSystem jobs(2);
+    displace_mesh(mesh, settings, 0.5f, jobs);
+
+    const Vertex& v = mesh.vertices[4 * 9 + 3];
+    float px = 3.0f, py = 4.0f, pz = 0.0f, value = 0.0f;
+    evaluate_noise(settings, &px, &py, &pz, &value, 1);
+    CHECK_THAT(v.position.z, WithinAbs(value * 0.5f, 1e-5f));
+    CHECK(v.position.x == 3.0f);
+    CHECK_THAT(v.normal.length(), WithinAbs(1.0f, 1e-5f));
+    CHECK(v.normal.z > 0.5f);
+
+    bool bent = false;
+    for (size_t i = 0; i + 1 < mesh.vertices.size(); ++i) {
+        bent = bent || std::fabs(mesh.vertices[i].normal.z) < 0.999f;
+    }
+    CHECK(bent);
+    CHECK(mesh.vertices.back().position.z == 0.0f);
+    CHECK(mesh.vertices.back().normal.length_squared() == 0.0f);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("Noise benchmarks", "[.][benchmark][noise]") {
+    NoiseSettings settings;
+    settings.fractal.frequency = 1.0f / 64.0f;
+    constexpr uint32_t kSize = 512;
+    std::vector<float> out;
+
+    // Throughput of one 5-octave fBm grid, in samples per second.
+    const auto start = std::chrono::steady_clock::now();
+    fill_noise_grid(settings, kSize, kSize, Vec2(0.0f, 0.0f), 1.0f, out, JobSystem::instance());
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    WARN("5-octave 2D simplex fBm: " << static_cast<double>(kSize * kSize * settings.fractal.octaves) / seconds
+                                     << " basis samples/s");
+
+    BENCHMARK("Fill 512x512 simplex fBm grid, 5 octaves") {
+        fill_noise_grid(settings, kSize, kSize, Vec2(0.0f, 0.0f), 1.0f, out, JobSystem::instance());
+        return out[0];
+    };
+
+    settings.fractal.basis = noise::Basis::Perlin;
+    BENCHMARK("Fill 512x512 Perlin fBm grid, 5 octaves") {
+        fill_noise_grid(settings, kSize, kSize, Vec2(0.0f, 0.0f), 1.0f, out, JobSystem::instance());
+        return out[0];
+    };
+
+    settings.fractal.basis = noise::Basis::Simplex;
+    BENCHMARK("Fill 64^3 simplex fBm volume, 5 octaves") {
+        fill_noise_volume(settings, 64, 64, 64, Vec3(0.0f, 0.0f, 0.0f), 1.0f, out, JobSystem::instance());
+        return out[0];
+    };
+}
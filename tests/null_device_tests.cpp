@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "maya/core/scene.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/core/stress_scene.hpp"
+#include "maya/rhi/null/null_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <cstring>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+namespace {
+
+const char* const kShader = R"(
+    vertex VertexOut vertexMain(VertexIn in [[stage_in]]) { return {}; }
+    fragment float4 fragmentMain(VertexOut in [[stage_in]]) { return float4(1); }
+)";
+
+std::vector<Vertex> triangle_vertices() {
+    return {
+        Vertex(Vec3(0, 0, 0), Vec3(0, 0, 1), Vec4(1, 1, 1, 1)),
+        Vertex(Vec3(1, 0, 0), Vec3(0, 0, 1), Vec4(1, 1, 1, 1)),
+        Vertex(Vec3(0, 1, 0), Vec3(0, 0, 1), Vec4(1, 1, 1, 1)),
+    };
+}
+
+} // namespace
+
+TEST_CASE("NullDevice stores buffer and texture contents", "[rhi][null]") {
+    NullDevice device;
+    REQUIRE(device.initialize(nullptr));
+
+    const uint32_t indices[] = {0, 1, 2};
+    IndexBufferHandle ib = device.create_index_buffer(indices, sizeof(indices));
+    REQUIRE(ib.handle != INVALID_HANDLE);
+    REQUIRE(device.buffer_data(ib.handle) != nullptr);
+    CHECK(std::memcmp(device.buffer_data(ib.handle)->data(), indices, sizeof(indices)) == 0);
+
+    const uint32_t replacement[] = {2, 1};
+    device.update_index_buffer(ib, replacement, sizeof(replacement));
+    const uint32_t* stored = reinterpret_cast<const uint32_t*>(device.buffer_data(ib.handle)->data());
+    CHECK(stored[0] == 2);
+    CHECK(stored[1] == 1);
+    CHECK(stored[2] == 2);
+
+    const uint8_t pixels[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    TextureHandle texture = device.create_texture(pixels, 2, 1);
+    REQUIRE(device.texture_data(texture) != nullptr);
+    CHECK(device.texture_data(texture)->size() == 8);
+    CHECK((*device.texture_data(texture))[7] == 8);
+    CHECK(device.frame_stats().bytes_uploaded == sizeof(indices) + sizeof(replacement) + sizeof(pixels));
+
+    device.destroy_index_buffer(ib);
+    device.destroy_texture(texture);
+    CHECK(device.live_buffer_count() == 0);
+    CHECK(device.live_texture_count() == 0);
+    CHECK(device.validation_error_count() == 0);
+}
+
+TEST_CASE("NullDevice validates pipelines by entry point", "[rhi][null]") {
+    NullDevice device;
+    device.set_log_validation_errors(false);
+    device.initialize(nullptr);
+
+    CHECK(device.create_pipeline(kShader).handle != INVALID_HANDLE);
+    CHECK(device.create_pipeline(kShader, "vertexMain", "fragmentUnlit").handle == INVALID_HANDLE);
+    // Prefixes of longer identifiers do not count.
+    CHECK(device.create_pipeline(kShader, "Main", "fragmentMain").handle == INVALID_HANDLE);
+    CHECK(device.create_pipeline("this is not a shader").handle == INVALID_HANDLE);
+    CHECK(device.validation_error_count() == 3);
+    CHECK(device.live_pipeline_count() == 1);
+}
+
+TEST_CASE("NullDevice reports misuse instead of crashing", "[rhi][null]") {
+    NullDevice device;
+    device.set_log_validation_errors(false);
+    device.initialize(nullptr);
+    const std::vector<Vertex> vertices = triangle_vertices();
+    VertexBufferHandle vb = device.create_vertex_buffer(vertices.data(), vertices.size() * sizeof(Vertex));
+    const uint32_t indices[] = {0, 1, 2, 0, 2, 3};
+    IndexBufferHandle ib = device.create_index_buffer(indices, sizeof(indices));
+    UniformBufferHandle ub = device.create_uniform_buffer(64);
+    PipelineHandle pipeline = device.create_pipeline(kShader);
+
+    SECTION("Draw outside a frame") {
+        device.draw_indexed(ib, 3);
+        CHECK(device.validation_error_count() == 1);
+        CHECK(device.last_validation_error().find("outside") != std::string::npos);
+    }
+
+    SECTION("Draw without a pipeline or vertex buffer") {
+        device.begin_frame();
+        device.bind_vertex_buffer(vb, 0);
+        device.draw_indexed(ib, 3);
+        CHECK(device.last_validation_error().find("no pipeline") != std::string::npos);
+        device.end_frame();
+
+        device.begin_frame();  // bindings do not survive the frame
+        device.bind_pipeline(pipeline);
+        device.draw_indexed(ib, 3);
+        CHECK(device.last_validation_error().find("no vertex buffer") != std::string::npos);
+        device.end_frame();
+        CHECK(device.validation_error_count() == 2);
+        CHECK(device.last_frame_stats().draw_calls == 0);
+    }
+
+    SECTION("Index range and index values") {
+        device.begin_frame();
+        device.bind_pipeline(pipeline);
+        device.bind_vertex_buffer(vb, 0);
+        device.draw_indexed_range(ib, 3, 6);
+        CHECK(device.last_validation_error().find("exceed the 6-index buffer") != std::string::npos);
+        device.draw_indexed_range(ib, 3, 3);  // index 3 is past the three vertices
+        CHECK(device.last_validation_error().find("exceeds the 3-vertex buffer") != std::string::npos);
+        device.draw_indexed(ib, 3);
+        device.end_frame();
+        CHECK(device.validation_error_count() == 2);
+        CHECK(device.last_frame_stats().draw_calls == 1);
+        CHECK(device.last_frame_stats().indices == 3);
+    }
+
+    SECTION("Wrong handle kinds, overflows and stale handles") {
+        device.update_uniform_buffer({vb.handle}, indices, 4);
+        CHECK(device.last_validation_error().find("is a vertex buffer, expected uniform") != std::string::npos);
+        std::vector<uint8_t> big(65);
+        device.update_uniform_buffer(ub, big.data(), big.size());
+        CHECK(device.last_validation_error().find("65 bytes") != std::string::npos);
+        device.destroy_vertex_buffer(vb);
+        device.destroy_vertex_buffer(vb);
+        CHECK(device.last_validation_error().find("destroyed") != std::string::npos);
+        CHECK(device.validation_error_count() == 3);
+    }
+}
+
+TEST_CASE("NullDevice renders a scene end to end", "[rhi][null]") {
+    NullDevice device;
+    device.initialize(nullptr);
+    device.resize(640, 480);
+    CHECK(device.width() == 640);
+
+    Scene scene;
+    StressSceneSettings settings;
+    settings.object_count = 50;
+    settings.detail = 8;
+    const Material material{device.create_pipeline(kShader), nullptr};
+    add_stress_scene(scene, device, material, settings);
+    UniformBufferHandle uniforms = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+
+    device.begin_frame();
+    scene.render(device, uniforms, Mat4::identity(), DirectionalLighting{}, Vec3(0, 0, 0));
+    device.end_frame();
+
+    CHECK(device.validation_error_count() == 0);
+    CHECK(device.last_frame_stats().draw_calls == scene.drawable_count());
+    CHECK(device.last_frame_stats().indices > 0);
+    CHECK(device.last_frame_stats().bytes_uploaded >= 50 * sizeof(SceneDrawUniforms));
+}
+
+TEST_CASE("NullDevice scene submission benchmark", "[.][benchmark][null]") {
+    NullDevice device(false);
+    device.initialize(nullptr);
+    Scene scene;
+    const Material material{device.create_pipeline(kShader), nullptr};
+    add_stress_scene(scene, device, material, StressSceneSettings{});
+    UniformBufferHandle uniforms = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+
+    BENCHMARK("Render 1000 objects") {
+        device.begin_frame();
+        scene.render(device, uniforms, Mat4::identity(), DirectionalLighting{}, Vec3(0, 0, 0));
+        device.end_frame();
+        return device.last_frame_stats().draw_calls;
+    };
+}
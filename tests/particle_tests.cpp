@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/particles.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+namespace {
+
+ParticleEmitterSettings still_emitter(const Vec3& position, float lifetime) {
+    ParticleEmitterSettings settings;
+    settings.position = position;
+    settings.speed_min = 0.0f;
+    settings.speed_max = 0.0f;
+    settings.lifetime_min = lifetime;
+    settings.lifetime_max = lifetime;
+    return settings;
+}
+
+} // namespace
+
+// =============================================================================
+// Emission Tests
+// =============================================================================
+TEST_CASE("ParticleSystem spawns within its emitter and capacity", "[core][particles]") {
+    ParticleSystem particles(10);
+    ParticleEmitterSettings settings;
+    settings.position = Vec3(1, 2, 3);
+    settings.spawn_radius = 0.5f;
+    const uint32_t emitter = particles.add_emitter(settings);
+
+    CHECK(particles.burst(emitter, 6) == 6);
+    CHECK(particles.burst(emitter, 6) == 4);
+    CHECK(particles.size() == 10);
+    for (uint32_t i = 0; i < particles.size(); ++i) {
+        CHECK((particles.position(i) - Vec3(1, 2, 3)).length() <= 0.5f + 1e-5f);
+        CHECK(particles.life(i) >= settings.lifetime_min);
+        CHECK(particles.life(i) <= settings.lifetime_max);
+    }
+}
+
+TEST_CASE("ParticleSystem emits continuously at the emitter rate", "[core][particles]") {
+    JobSystem jobs(0);
+    ParticleSystem particles(1000);
+    ParticleEmitterSettings settings = still_emitter(Vec3(0, 0, 0), 10.0f);
+    settings.rate = 100.0f;
+    particles.add_emitter(settings);
+    for (int frame = 0; frame < 64; ++frame) {
+        particles.update(1.0f / 64.0f, jobs);
+    }
+    CHECK(particles.size() >= 99);
+    CHECK(particles.size() <= 100);
+}
+
+// =============================================================================
+// Simulation Tests
+// =============================================================================
+TEST_CASE("ParticleSystem integrates gravity and drag", "[core][particles]") {
+    JobSystem jobs(0);
+    ParticleSystem particles(8);
+    particles.add_emitter(still_emitter(Vec3(0, 10, 0), 100.0f));
+    particles.burst(0, 5);
+    particles.simulation().drag = 0.0f;
+
+    const float dt = 0.01f;
+    const int steps = 50;
+    for (int i = 0; i < steps; ++i) {
+        particles.update(dt, jobs);
+    }
+    // Semi-implicit Euler: v_n = g n dt, p_n = p_0 + g dt^2 n (n + 1) / 2.
+    const float expected_y = 10.0f - 9.81f * dt * dt * steps * (steps + 1) * 0.5f;
+    for (uint32_t i = 0; i < particles.size(); ++i) {
+        CHECK_THAT(particles.position(i).y, Catch::Matchers::WithinAbs(expected_y, 1e-3f));
+        CHECK_THAT(particles.velocity(i).y, Catch::Matchers::WithinAbs(-9.81f * dt * steps, 1e-3f));
+    }
+
+    SECTION("Drag slows particles down") {
+        particles.simulation().gravity = Vec3(0, 0, 0);
+        particles.simulation().drag = 1.0f;
+        const float before = particles.velocity(0).length();
+        particles.update(0.1f, jobs);
+        CHECK_THAT(particles.velocity(0).length(), Catch::Matchers::WithinAbs(before * 0.9f, 1e-4f));
+    }
+}
+
+TEST_CASE("ParticleSystem collides with planes", "[core][particles]") {
+    JobSystem jobs(0);
+    ParticleSystem particles(64);
+    ParticleEmitterSettings settings = still_emitter(Vec3(0, 1, 0), 100.0f);
+    settings.spawn_radius = 0.5f;
+    particles.add_emitter(settings);
+    particles.burst(0, 64);
+    particles.simulation().colliders.push_back(Plane{Vec3(0, 1, 0), 0.0f});
+    particles.simulation().restitution = 0.5f;
+
+    bool bounced = false;
+    for (int frame = 0; frame < 300; ++frame) {
+        particles.update(1.0f / 60.0f, jobs);
+        for (uint32_t i = 0; i < particles.size(); ++i) {
+            REQUIRE(particles.position(i).y >= 0.0f);
+            bounced = bounced || particles.velocity(i).y > 0.0f;
+        }
+    }
+    CHECK(bounced);
+    CHECK(particles.size() == 64);
+}
+
+TEST_CASE("ParticleSystem attractors pull particles in", "[core][particles]") {
+    JobSystem jobs(0);
+    ParticleSystem particles(4);
+    particles.add_emitter(still_emitter(Vec3(5, 0, 0), 100.0f));
+    particles.burst(0, 1);
+    particles.simulation().gravity = Vec3(0, 0, 0);
+    particles.simulation().attractors.push_back(ParticleAttractor{Vec3(0, 0, 0), 10.0f, 1.0f});
+    particles.update(0.1f, jobs);
+    CHECK(particles.velocity(0).x < 0.0f);
+    CHECK(particles.position(0).x < 5.0f);
+}
+
+TEST_CASE("ParticleSystem removes dead particles and keeps the rest", "[core][particles]") {
+    JobSystem jobs(0);
+    ParticleSystem particles(100);
+    ParticleEmitterSettings short_lived = still_emitter(Vec3(0, 0, 0), 0.05f);
+    short_lived.color = kDebugRed;
+    ParticleEmitterSettings long_lived = still_emitter(Vec3(0, 0, 0), 1.0f);
+    long_lived.color = kDebugGreen;
+    particles.add_emitter(short_lived);
+    particles.add_emitter(long_lived);
+    for (int i = 0; i < 10; ++i) {
+        particles.burst(i % 3 == 0 ? 1 : 0, 7);
+    }
+    REQUIRE(particles.size() == 70);
+
+    particles.update(0.1f, jobs);
+    CHECK(particles.size() == 28);
+    for (uint32_t i = 0; i < particles.size(); ++i) {
+        CHECK(particles.life(i) > 0.0f);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        particles.update(0.1f, jobs);
+    }
+    CHECK(particles.size() == 0);
+}
+
+TEST_CASE("ParticleSystem simulates identically on one or many threads", "[core][particles]") {
+    JobSystem serial(0);
+    JobSystem parallel(3);
+    ParticleEmitterSettings settings;
+    settings.spawn_radius = 5.0f;
+    settings.lifetime_min = 0.1f;
+    settings.lifetime_max = 2.0f;
+    ParticleSystem a(50000, 9);
+    ParticleSystem b(50000, 9);
+    for (ParticleSystem* p : {&a, &b}) {
+        p->add_emitter(settings);
+        p->burst(0, 50000);
+        p->simulation().colliders.push_back(Plane{Vec3(0, 1, 0), 1.0f});
+    }
+    for (int frame = 0; frame < 20; ++frame) {
+        a.update(1.0f / 30.0f, serial);
+        b.update(1.0f / 30.0f, parallel);
+    }
+    REQUIRE(a.size() == b.size());
+    REQUIRE(a.size() > 0);
+    for (uint32_t i = 0; i < a.size(); i += 97) {
+        CHECK(a.position(i).x == b.position(i).x);
+        CHECK(a.velocity(i).y == b.velocity(i).y);
+    }
+}
+
+// =============================================================================
+// Output Tests
+// =============================================================================
+TEST_CASE("ParticleSystem writes camera-facing quads", "[core][particles]") {
+    JobSystem jobs(0);
+    ParticleSystem particles(4);
+    ParticleEmitterSettings settings = still_emitter(Vec3(1, 2, 3), 1.0f);
+    settings.size_min = 2.0f;
+    settings.size_max = 2.0f;
+    settings.color = kDebugYellow;
+    particles.add_emitter(settings);
+    particles.burst(0, 2);
+
+    std::vector<DebugVertex> vertices(particles.size() * 6);
+    particles.write_billboards(Vec3(1, 0, 0), Vec3(0, 1, 0), vertices.data(), jobs);
+    for (const DebugVertex& v : vertices) {
+        CHECK(v.color == kDebugYellow);
+        CHECK(v.position.z == 3.0f);
+        CHECK(std::abs(std::abs(v.position.x - 1.0f) - 1.0f) < 1e-6f);
+        CHECK(std::abs(std::abs(v.position.y - 2.0f) - 1.0f) < 1e-6f);
+    }
+    // First triangle winds counter-clockwise seen from +z (right x up).
+    const Vec3 e1 = vertices[1].position - vertices[0].position;
+    const Vec3 e2 = vertices[2].position - vertices[0].position;
+    CHECK(Vec3::cross(e1, e2).z > 0.0f);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("ParticleSystem benchmarks", "[.][benchmark][particles]") {
+    ParticleEmitterSettings settings;
+    settings.spawn_radius = 50.0f;
+    settings.lifetime_min = 1000.0f;
+    settings.lifetime_max = 1000.0f;
+    ParticleSystem particles(1000000);
+    particles.add_emitter(settings);
+    particles.burst(0, 1000000);
+    particles.simulation().colliders.push_back(Plane{Vec3(0, 1, 0), 50.0f});
+    particles.simulation().attractors.push_back(ParticleAttractor{Vec3(0, 0, 0), 5.0f, 1.0f});
+    std::vector<DebugVertex> vertices(particles.size() * 6);
+
+    BENCHMARK("Simulate 1M particles") {
+        particles.update(1.0f / 60.0f, JobSystem::instance());
+        return particles.size();
+    };
+    BENCHMARK("Write 1M billboards") {
+        particles.write_billboards(Vec3(1, 0, 0), Vec3(0, 1, 0), vertices.data(), JobSystem::instance());
+        return vertices[0].position.x;
+    };
+}
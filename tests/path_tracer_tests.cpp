@@ -0,0 +1,240 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/camera.hpp"
+#include "maya/core/image_loader.hpp"
+#include "maya/core/image_writer.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/path_tracer.hpp"
+#include "maya/core/primitives.hpp"
+#include "maya/core/scene.hpp"
+#include <cstring>
+
+using namespace maya;
+using namespace maya::math;
+using Catch::Matchers::WithinAbs;
+
+class MockGraphicsDeviceForPathTracing : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Square in the z = 0 plane facing +z (toward the default camera), `half` wide, colored `color`.
+std::unique_ptr<Mesh> make_wall(GraphicsDevice& device, float half, const Vec4& color) {
+    const Vec3 n(0, 0, 1);
+    std::vector<Vertex> vertices = {Vertex(Vec3(-half, -half, 0), n, color), Vertex(Vec3(half, -half, 0), n, color),
+        Vertex(Vec3(-half, half, 0), n, color), Vertex(Vec3(half, half, 0), n, color)};
+    return std::make_unique<Mesh>(device, vertices, std::vector<uint32_t>{0, 1, 2, 2, 1, 3});
+}
+
+DirectionalLighting test_lighting() {
+    DirectionalLighting lighting = DirectionalLighting::default_sun();
+    lighting.direction_to_light = Vec3(0.6f, 0.0f, 0.8f);
+    lighting.ambient = SphericalHarmonicsL2::constant(Vec3(0.1f, 0.2f, 0.3f));
+    lighting.diffuse = Vec3(1.0f, 0.5f, 0.25f);
+    return lighting;
+}
+
+} // namespace
+
+// =============================================================================
+// Path Tracer Tests
+// =============================================================================
+TEST_CASE("PathTracer matches the rasterizer's lighting on an open surface", "[core][path_tracer]") {
+    MockGraphicsDeviceForPathTracing device;
+    JobSystem jobs(2);
+    Scene scene;
+    scene.add_object(make_wall(device, 100.0f, Vec4(0.5f, 0.5f, 0.5f, 1.0f)), Material{});
+    Camera camera(60.0f, 1.0f, 0.1f, 100.0f);
+
+    PathTracerSettings settings;
+    settings.width = 17;
+    settings.height = 15;
+    settings.tile_size = 6;
+    PathTracer tracer(settings);
+    tracer.set_scene(scene);
+    CHECK(tracer.triangle_count() == 2);
+    const DirectionalLighting lighting = test_lighting();
+    for (int s = 0; s < 4; ++s) {
+        tracer.render_sample(camera, lighting, jobs);
+    }
+    CHECK(tracer.sample_count() == 4);
+
+    // Constant sky and an unoccluded wall make every path deterministic: ambient plus sun.
+    const Vec3 expected = (Vec3(0.1f, 0.2f, 0.3f) + lighting.diffuse * 0.8f) * 0.5f;
+    for (uint32_t y = 0; y < settings.height; y += 7) {
+        for (uint32_t x = 0; x < settings.width; x += 8) {
+            const Vec3 p = tracer.pixel(x, y);
+            CHECK_THAT(p.x, WithinAbs(expected.x, 1e-4f));
+            CHECK_THAT(p.y, WithinAbs(expected.y, 1e-4f));
+            CHECK_THAT(p.z, WithinAbs(expected.z, 1e-4f));
+        }
+    }
+
+    tracer.reset();
+    CHECK(tracer.sample_count() == 0);
+    CHECK(tracer.pixel(0, 0).x == 0.0f);
+}
+
+TEST_CASE("PathTracer traces shadows, bounces and the sky", "[core][path_tracer]") {
+    MockGraphicsDeviceForPathTracing device;
+    Scene scene;
+    scene.add_object(make_wall(device, 100.0f, Vec4(1, 1, 1, 1)), Material{});
+    // A floating panel between the wall and the sun casts a shadow around the wall's center.
+    scene.add_object(make_wall(device, 0.5f, Vec4(1, 1, 1, 1)), Material{});
+    scene.objects()[1].model_matrix = Mat4::translate({-1.5f, 0.0f, 2.0f});
+    Camera camera(90.0f, 1.0f, 0.1f, 100.0f);
+    camera.set_position(Vec3(0, 0, 5));
+
+    PathTracerSettings settings;
+    settings.width = 64;
+    settings.height = 64;
+    settings.max_bounces = 2;
+    PathTracer tracer(settings);
+    tracer.set_scene(scene);
+    DirectionalLighting lighting = test_lighting();
+    lighting.direction_to_light = Vec3(-0.6f, 0.0f, 0.8f);
+
+    JobSystem jobs(2);
+    for (int s = 0; s < 16; ++s) {
+        tracer.render_sample(camera, lighting, jobs);
+    }
+    // The panel (x in [-2, -1]) shadows wall x in [-0.5, 0.5], columns 29-35 from z = 5.
+    const Vec3 lit = tracer.pixel(48, 32);
+    const Vec3 panel = tracer.pixel(16, 32);
+    CHECK(lit.x > 0.85f);
+    CHECK(panel.x > 0.5f);
+
+    SECTION("The result does not depend on the worker count") {
+        PathTracer single(settings);
+        single.set_scene(scene);
+        JobSystem inline_jobs(0);
+        for (int s = 0; s < 16; ++s) {
+            single.render_sample(camera, lighting, inline_jobs);
+        }
+        bool identical = true;
+        for (uint32_t y = 0; y < settings.height; ++y) {
+            for (uint32_t x = 0; x < settings.width; ++x) {
+                identical = identical && single.pixel(x, y).x == tracer.pixel(x, y).x;
+            }
+        }
+        CHECK(identical);
+    }
+
+    SECTION("Escaped rays see the ambient sky") {
+        Scene empty;
+        PathTracer sky(settings);
+        sky.set_scene(empty);
+        sky.render_sample(camera, lighting, jobs);
+        CHECK_THAT(sky.pixel(5, 60).z, WithinAbs(0.3f, 1e-5f));
+    }
+
+    SECTION("Shadowed wall pixels lose the sun") {
+        for (uint32_t x = 30; x < 34; ++x) {
+            CHECK(tracer.pixel(x, 32).x < 0.5f * lit.x);
+        }
+    }
+}
+
+// =============================================================================
+// Output Tests
+// =============================================================================
+TEST_CASE("ImageWriter PNG round-trips through ImageLoader", "[core][path_tracer]") {
+    ImageData image;
+    image.width = 300;
+    image.height = 260;
+    image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        image.pixels[i] = static_cast<uint8_t>((i * 7) ^ (i >> 9));
+    }
+    // Larger than one 64 KiB stored deflate block.
+    const std::vector<uint8_t> png = ImageWriter::encode_png(image);
+    REQUIRE(png.size() > 65535);
+    ImageData decoded;
+    REQUIRE(ImageLoader::decode(png.data(), png.size(), decoded));
+    CHECK(decoded.width == image.width);
+    CHECK(decoded.height == image.height);
+    CHECK(decoded.pixels == image.pixels);
+    CHECK(ImageWriter::encode_png(ImageData{}).empty());
+}
+
+TEST_CASE("ImageWriter EXR stores float scanlines", "[core][path_tracer]") {
+    HdrImageData image;
+    image.width = 3;
+    image.height = 2;
+    image.pixels = {0.5f, 1.5f, 2.5f, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17};
+    const std::vector<uint8_t> exr = ImageWriter::encode_exr(image);
+    REQUIRE(exr.size() > 8);
+    int32_t magic = 0;
+    std::memcpy(&magic, exr.data(), 4);
+    CHECK(magic == 20000630);
+
+    // The offset table ends right before the first block and points at the last one.
+    const size_t block_size = 8 + 3 * 3 * sizeof(float);
+    const size_t block = exr.size() - block_size;
+    uint64_t last_offset = 0;
+    std::memcpy(&last_offset, exr.data() + block - block_size - 8, 8);
+    CHECK(last_offset == block);
+
+    // Each block holds y, the byte count, then the B, G and R rows.
+    int32_t y = 0;
+    std::memcpy(&y, exr.data() + block, 4);
+    CHECK(y == 1);
+    float rows[9];
+    std::memcpy(rows, exr.data() + block + 8, sizeof(rows));
+    CHECK(rows[0] == 11.0f);
+    CHECK(rows[3] == 10.0f);
+    CHECK(rows[6] == 9.0f);
+    CHECK(rows[8] == 15.0f);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("PathTracer benchmarks", "[.][benchmark][path_tracer]") {
+    MockGraphicsDeviceForPathTracing device;
+    Scene scene;
+    scene.add_object(make_wall(device, 50.0f, Vec4(0.8f, 0.8f, 0.8f, 1.0f)), Material{});
+    for (int i = 0; i < 400; ++i) {
+        scene.add_object(make_color_cube(device, 0.3f, Vec3(0.9f, 0.6f, 0.4f)), Material{});
+        scene.objects().back().model_matrix = Mat4::translate(
+            {static_cast<float>(i % 20) - 9.5f, static_cast<float>(i / 20) - 9.5f, 0.3f + 0.1f * static_cast<float>(i % 7)});
+    }
+    Camera camera(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    camera.set_position(Vec3(0, 0, 18));
+    PathTracerSettings settings;
+    settings.width = 320;
+    settings.height = 180;
+    PathTracer tracer(settings);
+    tracer.set_scene(scene);
+    const DirectionalLighting lighting = DirectionalLighting::default_sun();
+
+    BENCHMARK("Trace one 320x180 sample, 4 bounces") {
+        tracer.render_sample(camera, lighting, JobSystem::instance());
+        return tracer.sample_count();
+    };
+}
@@ -0,0 +1,295 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/mesh_optimizer.hpp"
+#include "maya/core/primitives.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/stress_scene.hpp"
+#include <cmath>
+#include <set>
+#include <tuple>
+#include <string>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+using Catch::Matchers::WithinAbs;
+
+class MockGraphicsDeviceForPrimitives : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Checks invariants every generator promises: valid indices, unit normals, triangles wound
+/// CCW around their normals, and enclosed volume (closed shapes) from the divergence theorem.
+struct MeshReport {
+    bool indices_valid = true;
+    bool normals_unit = true;
+    bool wound_outward = true;
+    float volume = 0.0f;
+    float max_radius = 0.0f;
+};
+
+MeshReport inspect(const MeshData& mesh) {
+    MeshReport report;
+    for (uint32_t i : mesh.indices) {
+        report.indices_valid = report.indices_valid && i < mesh.vertices.size();
+    }
+    if (!report.indices_valid || mesh.indices.size() % 3 != 0) {
+        report.indices_valid = false;
+        return report;
+    }
+    for (const Vertex& v : mesh.vertices) {
+        report.normals_unit = report.normals_unit && std::fabs(v.normal.length() - 1.0f) < 1e-4f;
+        report.max_radius = std::max(report.max_radius, v.position.length());
+    }
+    for (size_t t = 0; t < mesh.indices.size(); t += 3) {
+        const Vertex& a = mesh.vertices[mesh.indices[t]];
+        const Vertex& b = mesh.vertices[mesh.indices[t + 1]];
+        const Vertex& c = mesh.vertices[mesh.indices[t + 2]];
+        const Vec3 face = Vec3::cross(b.position - a.position, c.position - a.position);
+        report.wound_outward = report.wound_outward && Vec3::dot(face, a.normal + b.normal + c.normal) > 0.0f;
+        report.volume += Vec3::dot(a.position, Vec3::cross(b.position, c.position)) / 6.0f;
+    }
+    return report;
+}
+
+void check_valid(const MeshData& mesh) {
+    const MeshReport report = inspect(mesh);
+    CHECK(report.indices_valid);
+    CHECK(report.normals_unit);
+    CHECK(report.wound_outward);
+}
+
+} // namespace
+
+// =============================================================================
+// Generator Tests
+// =============================================================================
+TEST_CASE("make_color_cube has flat face normals", "[core][primitives]") {
+    MockGraphicsDeviceForPrimitives device;
+    const auto cube = make_color_cube(device, 0.5f, Vec3(1.0f, 0.5f, 0.25f));
+    CHECK(cube->vertex_count() == 24);
+    CHECK(cube->index_count() == 36);
+    std::set<std::tuple<float, float, float>> normals;
+    for (const Vertex& v : cube->vertices()) {
+        normals.insert({v.normal.x, v.normal.y, v.normal.z});
+        // Every vertex lies on the face its normal points out of.
+        CHECK_THAT(Vec3::dot(v.position, v.normal), WithinAbs(0.5f, 1e-6f));
+        CHECK(v.color.x >= v.color.y);
+    }
+    CHECK(normals.size() == 6);
+}
+
+TEST_CASE("Procedural shapes are closed, outward-wound and sized as requested", "[core][primitives]") {
+    SECTION("Plane") {
+        const MeshData plane = generate_plane(4.0f, 2.0f, 8, 4);
+        check_valid(plane);
+        CHECK(plane.vertices.size() == 9u * 5u);
+        CHECK(plane.indices.size() == 8u * 4u * 6u);
+        for (const Vertex& v : plane.vertices) {
+            CHECK(v.normal.y == 1.0f);
+            CHECK(std::fabs(v.position.x) <= 2.0f);
+            CHECK(v.uv.x >= 0.0f);
+            CHECK(v.uv.y <= 1.0f);
+        }
+    }
+    SECTION("Box") {
+        const MeshData box = generate_box(Vec3(1.0f, 2.0f, 3.0f), 3);
+        check_valid(box);
+        CHECK(box.vertices.size() == 6u * 16u);
+        CHECK_THAT(inspect(box).volume, WithinAbs(48.0f, 1e-3f));
+    }
+    SECTION("UV sphere") {
+        const MeshData sphere = generate_uv_sphere(2.0f, 24, 12);
+        check_valid(sphere);
+        // Pole quads collapse to single triangles.
+        CHECK(sphere.indices.size() == (24u * 10u * 2u + 24u * 2u) * 3u);
+        CHECK_THAT(inspect(sphere).max_radius, WithinAbs(2.0f, 1e-5f));
+        // The inscribed polyhedron loses a few percent of the ball's volume.
+        const float ball = 4.0f / 3.0f * PI * 8.0f;
+        CHECK(inspect(sphere).volume < ball);
+        CHECK(inspect(sphere).volume > 0.95f * ball);
+    }
+    SECTION("Icosphere") {
+        const MeshData sphere = generate_icosphere(1.0f, 3);
+        check_valid(sphere);
+        CHECK(sphere.indices.size() == 20u * 64u * 3u);
+        // 642 unique positions plus copies along the seam.
+        CHECK(sphere.vertices.size() > 642u);
+        CHECK(sphere.vertices.size() < 700u);
+        CHECK_THAT(inspect(sphere).volume, WithinAbs(4.0f / 3.0f * PI, 0.05f));
+        for (size_t t = 0; t < sphere.indices.size(); t += 3) {
+            const float u0 = sphere.vertices[sphere.indices[t]].uv.x;
+            const float u1 = sphere.vertices[sphere.indices[t + 1]].uv.x;
+            const float u2 = sphere.vertices[sphere.indices[t + 2]].uv.x;
+            CHECK(std::max({u0, u1, u2}) - std::min({u0, u1, u2}) <= 0.5f);
+        }
+    }
+    SECTION("Cylinder") {
+        const MeshData cylinder = generate_cylinder(1.0f, 2.0f, 64, 2);
+        check_valid(cylinder);
+        CHECK_THAT(inspect(cylinder).volume, WithinAbs(2.0f * PI, 0.02f));
+        const MeshData open = generate_cylinder(1.0f, 2.0f, 64, 2, false);
+        CHECK(open.indices.size() == 64u * 2u * 6u);
+    }
+    SECTION("Cone") {
+        const MeshData cone = generate_cone(1.0f, 3.0f, 64, 3);
+        check_valid(cone);
+        CHECK_THAT(inspect(cone).volume, WithinAbs(PI, 0.02f));
+        for (const Vertex& v : cone.vertices) {
+            // Side normals are perpendicular to the slant, up by atan(r / h).
+            if (v.normal.y > 0.0f) {
+                CHECK_THAT(v.normal.y, WithinAbs(1.0f / std::sqrt(10.0f), 1e-5f));
+            }
+        }
+    }
+    SECTION("Torus") {
+        const MeshData torus = generate_torus(2.0f, 0.5f, 96, 48);
+        check_valid(torus);
+        CHECK(torus.vertices.size() == 97u * 49u);
+        // Volume 2 pi^2 R r^2.
+        CHECK_THAT(inspect(torus).volume, WithinAbs(2.0f * PI * PI * 2.0f * 0.25f, 0.05f));
+    }
+    SECTION("Capsule") {
+        const MeshData capsule = generate_capsule(0.5f, 2.0f, 64, 16);
+        check_valid(capsule);
+        CHECK_THAT(inspect(capsule).volume, WithinAbs(PI * 0.25f * 2.0f + 4.0f / 3.0f * PI * 0.125f, 0.02f));
+        float top = 0.0f;
+        for (const Vertex& v : capsule.vertices) {
+            top = std::max(top, v.position.y);
+        }
+        CHECK_THAT(top, WithinAbs(1.5f, 1e-6f));
+    }
+}
+
+// =============================================================================
+// Mesh Optimizer Tests
+// =============================================================================
+TEST_CASE("optimize_vertex_cache lowers the miss ratio and keeps triangles", "[core][primitives]") {
+    // Row-by-row order of a wide grid reloads every vertex once per row.
+    MeshData grid;
+    const uint32_t n = 64;
+    for (uint32_t i = 0; i <= n * n + 2 * n; ++i) {
+        grid.vertices.emplace_back(Vec3(0, 0, 0), Vec3(0, 1, 0), Vec4(1, 1, 1, 1));
+    }
+    for (uint32_t y = 0; y < n; ++y) {
+        for (uint32_t x = 0; x < n; ++x) {
+            const uint32_t a = y * (n + 1) + x;
+            grid.indices.insert(grid.indices.end(), {a, a + n + 1, a + 1, a + 1, a + n + 1, a + n + 2});
+        }
+    }
+    const uint32_t vertex_count = static_cast<uint32_t>(grid.vertices.size());
+    const float before = vertex_cache_miss_ratio(grid.indices, vertex_count);
+    std::vector<uint32_t> optimized = grid.indices;
+    optimize_vertex_cache(optimized, vertex_count);
+    const float after = vertex_cache_miss_ratio(optimized, vertex_count);
+    CHECK(before > 0.95f);
+    CHECK(after < 0.75f);
+
+    // Same triangles, same rotation-independent winding.
+    auto canonical = [](const std::vector<uint32_t>& indices) {
+        std::multiset<std::tuple<uint32_t, uint32_t, uint32_t>> set;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            uint32_t a = indices[t], b = indices[t + 1], c = indices[t + 2];
+            while (a > b || a > c) {
+                const uint32_t tmp = a;
+                a = b;
+                b = c;
+                c = tmp;
+            }
+            set.insert({a, b, c});
+        }
+        return set;
+    };
+    CHECK(canonical(optimized) == canonical(grid.indices));
+    CHECK(vertex_cache_miss_ratio(generate_uv_sphere(1.0f, 64, 32).indices, 65u * 33u) < 0.8f);
+}
+
+TEST_CASE("optimize_vertex_fetch orders vertices by first use", "[core][primitives]") {
+    MeshData mesh;
+    for (int i = 0; i < 5; ++i) {
+        mesh.vertices.emplace_back(Vec3(static_cast<float>(i), 0, 0), Vec3(0, 1, 0), Vec4(1, 1, 1, 1));
+    }
+    mesh.indices = {3, 1, 4, 4, 1, 0};
+    optimize_vertex_fetch(mesh);
+    REQUIRE(mesh.vertices.size() == 4);
+    CHECK(mesh.indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3});
+    CHECK(mesh.vertices[0].position.x == 3.0f);
+    CHECK(mesh.vertices[3].position.x == 0.0f);
+}
+
+// =============================================================================
+// Stress Scene Tests
+// =============================================================================
+TEST_CASE("add_stress_scene shares meshes and is reproducible", "[core][primitives]") {
+    MockGraphicsDeviceForPrimitives device;
+    StressSceneSettings settings;
+    settings.object_count = 200;
+    settings.extent = 10.0f;
+    Scene a;
+    Scene b;
+    CHECK(add_stress_scene(a, device, Material{}, settings) == 0);
+    add_stress_scene(b, device, Material{}, settings);
+    REQUIRE(a.objects().size() == 200);
+
+    std::set<const Mesh*> meshes;
+    bool same = true;
+    for (size_t i = 0; i < a.objects().size(); ++i) {
+        const SceneObject& obj = a.objects()[i];
+        meshes.insert(obj.mesh);
+        const Vec3 t(obj.model_matrix.elements[12], obj.model_matrix.elements[13], obj.model_matrix.elements[14]);
+        CHECK(std::fabs(t.x) <= 10.0f);
+        CHECK(std::fabs(t.z) <= 10.0f);
+        same = same && obj.model_matrix.elements[5] == b.objects()[i].model_matrix.elements[5];
+    }
+    CHECK(same);
+    CHECK(meshes.size() == 8);
+
+    settings.is_static = true;
+    settings.seed = 7;
+    CHECK(add_stress_scene(a, device, Material{}, settings) == 200);
+    CHECK(a.objects().back().is_static);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("Procedural mesh benchmarks", "[.][benchmark][primitives]") {
+    BENCHMARK("UV sphere 256x128 with cache optimization") {
+        return generate_uv_sphere(1.0f, 256, 128).indices.size();
+    };
+    BENCHMARK("Icosphere, 5 subdivisions") {
+        return generate_icosphere(1.0f, 5).indices.size();
+    };
+    MockGraphicsDeviceForPrimitives device;
+    BENCHMARK("Stress scene with 10000 objects") {
+        Scene scene;
+        StressSceneSettings settings;
+        settings.object_count = 10000;
+        return add_stress_scene(scene, device, Material{}, settings);
+    };
+}
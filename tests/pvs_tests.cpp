@@ -0,0 +1,244 @@
+#include <catch2/catch_test_macros.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/primitives.hpp"
+#include "maya/core/pvs.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/view_culling.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cstring>
+#include <limits>
+
+using namespace maya;
+using namespace maya::math;
+
+// Mock GraphicsDevice for static batch creation
+class MockGraphicsDeviceForPvs : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Object 0 and 1 are small boxes on either side of object 2, a wall through x = 0 that is
+/// larger than the baked region.
+void add_walled_rooms(Scene& scene, GraphicsDevice& device, bool with_wall) {
+    scene.add_static_object(make_color_cube(device, 0.5f), Material{{1}, nullptr},
+        Mat4::translate(Vec3(-10, 0, 0)));
+    scene.add_static_object(make_color_cube(device, 0.5f), Material{{1}, nullptr},
+        Mat4::translate(Vec3(10, 0, 0)));
+    if (with_wall) {
+        scene.add_static_object(make_color_cube(device, 0.5f), Material{{1}, nullptr},
+            Mat4::scale(Vec3(0.5f, 20.0f, 20.0f)));
+    }
+    scene.build_static_batches(device);
+}
+
+PvsBakeSettings room_settings() {
+    PvsBakeSettings settings;
+    settings.cell_size = 4.0f;
+    settings.bounds = Aabb(Vec3(-12, -2, -2), Vec3(12, 2, 2));
+    settings.rays_per_object = 16;
+    settings.random_rays = 64;
+    return settings;
+}
+
+std::vector<uint64_t> row_at(const PotentiallyVisibleSet& pvs, const Vec3& position) {
+    std::vector<uint64_t> bits;
+    pvs.decompress(pvs.cell_at(position), bits);
+    return bits;
+}
+
+} // namespace
+
+// =============================================================================
+// Bake Tests
+// =============================================================================
+TEST_CASE("PVS bake hides objects behind a wall", "[core][pvs]") {
+    MockGraphicsDeviceForPvs device;
+    JobSystem jobs(2);
+    Scene scene;
+    add_walled_rooms(scene, device, true);
+    const PotentiallyVisibleSet pvs = PotentiallyVisibleSet::bake(scene.static_objects(), room_settings(), jobs);
+
+    REQUIRE_FALSE(pvs.empty());
+    CHECK(pvs.object_count() == 3);
+    CHECK(pvs.cell_count() == 6);
+    CHECK(pvs.cell_at(Vec3(100, 0, 0)) == kNoPvsCell);
+
+    const std::vector<uint64_t> left = row_at(pvs, Vec3(-6, 0, 0));
+    CHECK(PotentiallyVisibleSet::is_visible(left, 0));
+    CHECK_FALSE(PotentiallyVisibleSet::is_visible(left, 1));
+    CHECK(PotentiallyVisibleSet::is_visible(left, 2));
+    // Objects added after the bake are never culled, including those in the row's last word.
+    CHECK(PotentiallyVisibleSet::is_visible(left, 3));
+    CHECK(PotentiallyVisibleSet::is_visible(left, 64));
+
+    const std::vector<uint64_t> right = row_at(pvs, Vec3(9, 1, 1));
+    CHECK_FALSE(PotentiallyVisibleSet::is_visible(right, 0));
+    CHECK(PotentiallyVisibleSet::is_visible(right, 1));
+
+    SECTION("Outside the region everything is visible") {
+        const std::vector<uint64_t> outside = row_at(pvs, Vec3(0, 50, 0));
+        CHECK(PotentiallyVisibleSet::is_visible(outside, 0));
+        CHECK(PotentiallyVisibleSet::is_visible(outside, 1));
+        CHECK(PotentiallyVisibleSet::is_visible(outside, 2));
+    }
+
+    SECTION("Without the wall both sides see each other") {
+        Scene open;
+        add_walled_rooms(open, device, false);
+        const PotentiallyVisibleSet open_pvs = PotentiallyVisibleSet::bake(open.static_objects(), room_settings(), jobs);
+        for (uint32_t cell = 0; cell < open_pvs.cell_count(); ++cell) {
+            CHECK(open_pvs.visible_count(cell) == 2);
+        }
+    }
+
+    SECTION("Objects without CPU geometry are never hidden") {
+        scene.static_objects()[1].mesh->release_cpu_data();
+        const PotentiallyVisibleSet partial = PotentiallyVisibleSet::bake(scene.static_objects(), room_settings(), jobs);
+        for (uint32_t cell = 0; cell < partial.cell_count(); ++cell) {
+            std::vector<uint64_t> bits;
+            partial.decompress(cell, bits);
+            CHECK(PotentiallyVisibleSet::is_visible(bits, 1));
+        }
+    }
+
+    SECTION("Bakes are deterministic across thread counts") {
+        JobSystem serial(0);
+        const PotentiallyVisibleSet again = PotentiallyVisibleSet::bake(scene.static_objects(), room_settings(), serial);
+        CHECK(again.serialize() == pvs.serialize());
+    }
+
+    SECTION("Serialization round-trips") {
+        PotentiallyVisibleSet loaded;
+        REQUIRE(PotentiallyVisibleSet::deserialize(pvs.serialize(), loaded));
+        CHECK(loaded.cell_count() == pvs.cell_count());
+        CHECK(row_at(loaded, Vec3(-6, 0, 0)) == left);
+        std::vector<uint8_t> corrupt = pvs.serialize();
+        corrupt.resize(corrupt.size() / 2);
+        CHECK_FALSE(PotentiallyVisibleSet::deserialize(corrupt, loaded));
+        CHECK_FALSE(PotentiallyVisibleSet::deserialize({1, 2, 3}, loaded));
+    }
+
+    SECTION("Deserialization rejects grids cell_at cannot index") {
+        // Header: magic, version, bounds min and max, cell size, dims.
+        constexpr size_t kMinOffset = 8;
+        constexpr size_t kMaxOffset = 20;
+        constexpr size_t kCellSizeOffset = 32;
+        constexpr size_t kDimsOffset = 36;
+        auto patched = [&](size_t offset, auto value) {
+            std::vector<uint8_t> data = pvs.serialize();
+            std::memcpy(data.data() + offset, &value, sizeof(value));
+            PotentiallyVisibleSet loaded;
+            return PotentiallyVisibleSet::deserialize(data, loaded);
+        };
+        CHECK(patched(kCellSizeOffset, 4.0f));
+        CHECK_FALSE(patched(kCellSizeOffset, 0.0f));
+        CHECK_FALSE(patched(kCellSizeOffset, -4.0f));
+        CHECK_FALSE(patched(kCellSizeOffset, std::numeric_limits<float>::quiet_NaN()));
+        CHECK_FALSE(patched(kCellSizeOffset, std::numeric_limits<float>::infinity()));
+        CHECK_FALSE(patched(kDimsOffset, 0u));
+        CHECK_FALSE(patched(kMinOffset, 100.0f));
+        CHECK_FALSE(patched(kMaxOffset, std::numeric_limits<float>::infinity()));
+    }
+}
+
+TEST_CASE("PVS rows compress runs of hidden objects", "[core][pvs]") {
+    MockGraphicsDeviceForPvs device;
+    JobSystem jobs(0);
+    Scene scene;
+    // A wall at x = 0 hides a long row of boxes on the far side.
+    scene.add_static_object(make_color_cube(device, 0.5f), Material{{1}, nullptr},
+        Mat4::scale(Vec3(0.5f, 20.0f, 20.0f)));
+    for (int i = 0; i < 200; ++i) {
+        scene.add_static_object(make_color_cube(device, 0.25f), Material{{1}, nullptr},
+            Mat4::translate(Vec3(6.0f + 0.01f * static_cast<float>(i), -1.5f + 0.015f * static_cast<float>(i), 0)));
+    }
+    scene.build_static_batches(device);
+    PvsBakeSettings settings = room_settings();
+    settings.rays_per_object = 4;
+    settings.random_rays = 0;
+    const PotentiallyVisibleSet pvs = PotentiallyVisibleSet::bake(scene.static_objects(), settings, jobs);
+
+    CHECK(pvs.visible_count(pvs.cell_at(Vec3(-10, 0, 0))) == 1);
+    // 201 objects need 26 bytes a row; hidden-from-the-left rows take 3 (wall byte, zero run).
+    CHECK(pvs.compressed_size() < 6 * 26);
+}
+
+// =============================================================================
+// Runtime Tests
+// =============================================================================
+TEST_CASE("ViewSet applies the scene PVS to static ranges", "[core][pvs]") {
+    MockGraphicsDeviceForPvs device;
+    JobSystem jobs(0);
+    Scene scene;
+    add_walled_rooms(scene, device, true);
+    REQUIRE(scene.set_pvs(PotentiallyVisibleSet::bake(scene.static_objects(), room_settings(), jobs)));
+    REQUIRE(scene.pvs() != nullptr);
+
+    uint32_t far_box_range = 0;
+    const std::vector<StaticBatchRange>& ranges = scene.static_batches()[0].ranges;
+    for (uint32_t r = 0; r < static_cast<uint32_t>(ranges.size()); ++r) {
+        if (ranges[r].source_object == 1) {
+            far_box_range = r;
+        }
+    }
+
+    ViewSet views;
+    CullView view;
+    view.position = Vec3(-6, 0, 0);
+    view.view_projection = Mat4::perspective(to_radians(60.0f), 1.0f, 0.1f, 100.0f)
+        * Mat4::look_at(view.position, Vec3(10, 0, 0), Vec3(0, 1, 0));
+    views.add_view(view);
+    view.use_pvs = true;
+    views.add_view(view);
+    views.cull(scene, jobs);
+
+    CHECK(views.is_static_range_visible(0, 0, far_box_range));
+    CHECK_FALSE(views.is_static_range_visible(1, 0, far_box_range));
+
+    SECTION("Crossing into another cell refreshes the row") {
+        view.position = Vec3(9, 0, 0);
+        view.view_projection = Mat4::perspective(to_radians(60.0f), 1.0f, 0.1f, 100.0f)
+            * Mat4::look_at(view.position, Vec3(10, 0, 0), Vec3(0, 1, 0));
+        views.set_view(1, view);
+        views.cull(scene, jobs);
+        CHECK(views.is_static_range_visible(1, 0, far_box_range));
+    }
+
+    SECTION("A PVS baked for other objects is rejected") {
+        Scene other;
+        add_walled_rooms(other, device, false);
+        CHECK_FALSE(other.set_pvs(*scene.pvs()));
+        CHECK(other.pvs() == nullptr);
+    }
+
+    SECTION("Adding static objects drops the baked set") {
+        scene.build_static_batches(device);
+        CHECK(scene.pvs() != nullptr);
+        scene.add_static_object(make_color_cube(device, 0.5f), Material{{1}, nullptr}, Mat4::identity());
+        scene.build_static_batches(device);
+        CHECK(scene.pvs() == nullptr);
+    }
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/quality_governor.hpp"
+#include <vector>
+
+using namespace maya;
+
+namespace {
+
+QualityGovernorSettings test_settings() {
+    QualityGovernorSettings settings;
+    settings.target_frame_ms = 16.6f;
+    settings.window_frames = 10;
+    settings.cooldown_frames = 5;
+    settings.upgrade_windows = 2;
+    return settings;
+}
+
+/// Feeds `frames` frames of `ms` and returns how many changed a knob.
+uint32_t feed(QualityGovernor& governor, float ms, uint32_t frames) {
+    uint32_t changes = 0;
+    for (uint32_t i = 0; i < frames; ++i) {
+        if (governor.record_frame(ms) != QualityGovernor::Decision::None) {
+            ++changes;
+        }
+    }
+    return changes;
+}
+
+} // namespace
+
+// =============================================================================
+// Registry Tests
+// =============================================================================
+TEST_CASE("QualityRegistry applies levels on registration and change", "[core][quality]") {
+    QualityRegistry registry;
+    std::vector<uint32_t> applied;
+    const uint32_t knob = registry.add(QualityKnob{"lod", 3, 7, 0, [&](uint32_t level) { applied.push_back(level); }});
+
+    REQUIRE(applied == std::vector<uint32_t>{2});
+    CHECK(registry.level(knob) == 2);
+    CHECK(registry.find("lod") == knob);
+    CHECK(registry.find("missing") == kNoQualityKnob);
+
+    registry.set_level(knob, 2);
+    CHECK(applied.size() == 1);
+    registry.set_level(knob, 0);
+    registry.set_level(knob, 9);
+    CHECK(applied == std::vector<uint32_t>{2, 0, 2});
+}
+
+// =============================================================================
+// Governor Tests
+// =============================================================================
+TEST_CASE("QualityGovernor lowers the least important knob first under load", "[core][quality]") {
+    QualityRegistry registry;
+    const uint32_t cheap = registry.add(QualityKnob{"updates", 3, 2, 0, {}});
+    const uint32_t precious = registry.add(QualityKnob{"distance", 2, 1, 5, {}});
+    QualityGovernor governor(registry, test_settings());
+
+    // One window, no cooldown yet.
+    CHECK(feed(governor, 30.0f, 10) == 1);
+    CHECK(registry.level(cheap) == 1);
+    CHECK(registry.level(precious) == 1);
+    CHECK_THAT(governor.last_percentile_ms(), Catch::Matchers::WithinAbs(30.0f, 0.001f));
+
+    // Cooldown plus a window per step.
+    CHECK(feed(governor, 30.0f, 15) == 1);
+    CHECK(registry.level(cheap) == 0);
+    CHECK(registry.level(precious) == 1);
+    CHECK(feed(governor, 30.0f, 15) == 1);
+    CHECK(registry.level(precious) == 0);
+
+    // Nothing left to lower.
+    CHECK(feed(governor, 30.0f, 200) == 0);
+    CHECK(governor.degrade_count() == 3);
+}
+
+TEST_CASE("QualityGovernor restores the most important knob first after sustained headroom", "[core][quality]") {
+    QualityRegistry registry;
+    const uint32_t cheap = registry.add(QualityKnob{"updates", 2, 0, 0, {}});
+    const uint32_t precious = registry.add(QualityKnob{"distance", 2, 0, 5, {}});
+    QualityGovernor governor(registry, test_settings());
+
+    // One good window is not enough.
+    CHECK(feed(governor, 8.0f, 10) == 0);
+    CHECK(feed(governor, 8.0f, 10) == 1);
+    CHECK(registry.level(precious) == 1);
+    CHECK(registry.level(cheap) == 0);
+
+    CHECK(feed(governor, 8.0f, 25) == 1);
+    CHECK(registry.level(cheap) == 1);
+    CHECK(governor.upgrade_count() == 2);
+}
+
+TEST_CASE("QualityGovernor holds steady inside the hysteresis band", "[core][quality]") {
+    QualityRegistry registry;
+    const uint32_t knob = registry.add(QualityKnob{"lod", 4, 2, 0, {}});
+    QualityGovernor governor(registry, test_settings());
+
+    // Between target * (1 - upgrade_margin) and target * (1 + degrade_margin).
+    for (uint32_t i = 0; i < 1000; ++i) {
+        governor.record_frame(i % 2 ? 14.0f : 17.0f);
+    }
+    CHECK(registry.level(knob) == 2);
+    CHECK(governor.degrade_count() == 0);
+    CHECK(governor.upgrade_count() == 0);
+}
+
+TEST_CASE("QualityGovernor ignores isolated hitches", "[core][quality]") {
+    QualityRegistry registry;
+    const uint32_t knob = registry.add(QualityKnob{"lod", 2, 1, 0, {}});
+    QualityGovernor governor(registry, test_settings());
+
+    // One 100 ms frame per 10-frame window stays above the 90th percentile.
+    for (uint32_t i = 0; i < 500; ++i) {
+        governor.record_frame(i % 10 == 3 ? 100.0f : 15.0f);
+    }
+    CHECK(registry.level(knob) == 1);
+    CHECK(governor.degrade_count() == 0);
+}
+
+TEST_CASE("QualityGovernor percentile 0 compares the fastest frame", "[core][quality]") {
+    QualityRegistry registry;
+    const uint32_t knob = registry.add(QualityKnob{"lod", 2, 1, 0, {}});
+    QualityGovernorSettings settings = test_settings();
+    settings.percentile = 0.0f;
+    QualityGovernor governor(registry, settings);
+
+    // Nine hitches and one fast frame: the minimum is within budget.
+    for (uint32_t i = 0; i < 10; ++i) {
+        governor.record_frame(i == 4 ? 10.0f : 100.0f);
+    }
+    CHECK_THAT(governor.last_percentile_ms(), Catch::Matchers::WithinAbs(10.0f, 0.001f));
+    CHECK(registry.level(knob) == 1);
+    CHECK(governor.degrade_count() == 0);
+}
+
+TEST_CASE("QualityGovernor settles when frame cost follows the knob", "[core][quality]") {
+    QualityRegistry registry;
+    const uint32_t knob = registry.add(QualityKnob{"lod", 5, 4, 0, {}});
+    QualityGovernor governor(registry, test_settings());
+
+    // Level 4 costs 20 ms (over budget), level 3 costs 17 ms (within the band), level 2 costs
+    // 14 ms (within the band too, so the governor never climbs back and oscillates).
+    for (uint32_t i = 0; i < 2000; ++i) {
+        governor.record_frame(8.0f + 3.0f * static_cast<float>(registry.level(knob)));
+    }
+    CHECK(registry.level(knob) == 3);
+    CHECK(governor.degrade_count() == 1);
+    CHECK(governor.upgrade_count() == 0);
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/math/simd.hpp"
+
+using namespace maya::math::simd;
+using Catch::Matchers::WithinAbs;
+
+// =============================================================================
+// Float4 Arithmetic Tests
+// =============================================================================
+TEST_CASE("Float4 arithmetic", "[math][simd]") {
+    const Float4 a = Float4::set(1.0f, 2.0f, 3.0f, 4.0f);
+    const Float4 b = Float4::splat(2.0f);
+
+    SECTION("Load and store round trip") {
+        float in[4] = {5.0f, 6.0f, 7.0f, 8.0f};
+        float out[4] = {};
+        Float4::load(in).store(out);
+        CHECK(out[0] == 5.0f);
+        CHECK(out[3] == 8.0f);
+    }
+
+    SECTION("Lane-wise operators") {
+        CHECK((a + b).lane(0) == 3.0f);
+        CHECK((a - b).lane(1) == 0.0f);
+        CHECK((a * b).lane(2) == 6.0f);
+        CHECK((a / b).lane(3) == 2.0f);
+        CHECK(Float4::madd(a, b, a).lane(3) == 12.0f);
+    }
+
+    SECTION("Min, max, abs and sqrt") {
+        CHECK(Float4::min(a, b).lane(3) == 2.0f);
+        CHECK(Float4::max(a, b).lane(0) == 2.0f);
+        CHECK(Float4::abs(Float4::splat(-3.0f)).lane(1) == 3.0f);
+        CHECK_THAT(Float4::sqrt(Float4::splat(9.0f)).lane(2), WithinAbs(3.0f, 0.0001f));
+    }
+
+    SECTION("Floor rounds toward negative infinity") {
+        const Float4 f = Float4::floor(Float4::set(1.5f, -1.5f, -2.0f, 3.0f));
+        CHECK(f.lane(0) == 1.0f);
+        CHECK(f.lane(1) == -2.0f);
+        CHECK(f.lane(2) == -2.0f);
+        CHECK(f.lane(3) == 3.0f);
+    }
+
+    SECTION("Dot broadcasts to every lane") {
+        const Float4 d = Float4::dot(a, a);
+        CHECK(d.lane(0) == 30.0f);
+        CHECK(d.lane(3) == 30.0f);
+    }
+}
+
+// =============================================================================
+// Float4 Mask Tests
+// =============================================================================
+TEST_CASE("Float4 comparison masks", "[math][simd]") {
+    const Float4 a = Float4::set(1.0f, 5.0f, 3.0f, 7.0f);
+    const Float4 b = Float4::splat(4.0f);
+
+    const Float4 lt = Float4::less(a, b);
+    CHECK(lt.move_mask() == 0x5);
+    CHECK(lt.any());
+    CHECK_FALSE(lt.all());
+    CHECK(Float4::greater_equal(a, Float4::splat(1.0f)).all());
+
+    const Float4 picked = Float4::select(lt, a, b);
+    CHECK(picked.lane(0) == 1.0f);
+    CHECK(picked.lane(1) == 4.0f);
+    CHECK(picked.lane(2) == 3.0f);
+    CHECK(picked.lane(3) == 4.0f);
+}
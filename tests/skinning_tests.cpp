@@ -0,0 +1,284 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/skinning.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+class MockGraphicsDeviceForSkinning : public GraphicsDevice {
+public:
+    struct DrawRange {
+        uint32_t first_index;
+        uint32_t index_count;
+    };
+
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t size) override { last_vertex_upload = size; }
+    void update_index_buffer(IndexBufferHandle, const void* data, size_t size) override {
+        const uint32_t* indices = static_cast<const uint32_t*>(data);
+        uploaded_indices.assign(indices, indices + size / sizeof(uint32_t));
+        ++index_uploads;
+    }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t first_index, uint32_t index_count) override {
+        draws.push_back(DrawRange{first_index, index_count});
+    }
+
+    std::vector<DrawRange> draws;
+    std::vector<uint32_t> uploaded_indices;
+    uint32_t index_uploads = 0;
+    size_t last_vertex_upload = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+bool matrices_near(const Mat4& a, const Mat4& b, float epsilon = 1e-4f) {
+    for (int i = 0; i < 16; ++i) {
+        if (std::abs(a.elements[i] - b.elements[i]) > epsilon) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool vectors_near(const Vec3& a, const Vec3& b, float epsilon = 1e-4f) {
+    return (a - b).length() <= epsilon;
+}
+
+} // namespace
+
+// =============================================================================
+// Palette Tests
+// =============================================================================
+TEST_CASE("compute_joint_palette is identity in the bind pose", "[core][skinning]") {
+    const Skeleton skeleton = make_chain_skeleton(4, 0.5f);
+    std::vector<JointTransform> pose;
+    for (const Joint& joint : skeleton.joints) {
+        pose.push_back(joint.bind_local);
+    }
+    std::vector<Mat4> joint_model(4);
+    std::vector<Mat4> palette(4);
+    compute_joint_palette(skeleton, pose.data(), Mat4::identity(), joint_model.data(), palette.data());
+    for (uint32_t j = 0; j < 4; ++j) {
+        CHECK(matrices_near(palette[j], Mat4::identity()));
+        CHECK_THAT(joint_model[j].at(1, 3), Catch::Matchers::WithinAbs(0.5f * j, 1e-6f));
+    }
+}
+
+TEST_CASE("compute_joint_palette matches a scalar reference", "[core][skinning]") {
+    Skeleton skeleton = make_chain_skeleton(3, 1.0f);
+    skeleton.joints[2].parent = 0; // a branch, not just a chain
+    std::vector<JointTransform> pose(3);
+    pose[0].translation = Vec3(1, 2, 3);
+    pose[0].rotation = Quat::from_axis_angle(Vec3(0, 0, 1), 0.7f);
+    pose[1].translation = Vec3(0, 1, 0);
+    pose[1].rotation = Quat::from_axis_angle(Vec3(1, 0, 0), -0.3f);
+    pose[1].scale = Vec3(2, 2, 2);
+    pose[2].translation = Vec3(0.5f, 0, 0);
+    pose[2].rotation = Quat::from_axis_angle(Vec3(0, 1, 0), 1.1f);
+    const Mat4 model = Mat4::translate(Vec3(-4, 0, 2)) * Mat4::rotate_y(0.4f);
+
+    std::vector<Mat4> joint_model(3);
+    std::vector<Mat4> palette(3);
+    compute_joint_palette(skeleton, pose.data(), model, joint_model.data(), palette.data());
+
+    std::vector<Mat4> reference(3);
+    for (uint32_t j = 0; j < 3; ++j) {
+        const Mat4 local =
+            Mat4::translate(pose[j].translation) * pose[j].rotation.to_mat4() * Mat4::scale(pose[j].scale);
+        const int32_t parent = skeleton.joints[j].parent;
+        reference[j] = parent < 0 ? local : reference[parent] * local;
+        CHECK(matrices_near(joint_model[j], reference[j]));
+        CHECK(matrices_near(palette[j], model * reference[j] * skeleton.joints[j].inverse_bind));
+    }
+}
+
+// =============================================================================
+// Skinning Tests
+// =============================================================================
+TEST_CASE("skin_vertices blends joints by weight", "[core][skinning]") {
+    const SkinnedMeshData mesh = make_skinned_cylinder(0.25f, 3, 1.0f, 8, 6, Vec4(1, 1, 1, 1));
+    REQUIRE(mesh.vertices.size() == mesh.influences.size());
+    std::vector<Vertex> out(mesh.vertices.begin(), mesh.vertices.end());
+
+    SECTION("Identity palette leaves the bind pose") {
+        const std::vector<Mat4> palette(3, Mat4::identity());
+        skin_vertices(mesh.vertices.data(), mesh.influences.data(), mesh.vertices.size(), palette.data(), out.data());
+        for (size_t v = 0; v < out.size(); ++v) {
+            CHECK(vectors_near(out[v].position, mesh.vertices[v].position));
+            CHECK(vectors_near(out[v].normal, mesh.vertices[v].normal));
+            CHECK(out[v].uv.x == mesh.vertices[v].uv.x);
+        }
+    }
+
+    SECTION("Moving one joint moves only the vertices it influences") {
+        std::vector<Mat4> palette(3, Mat4::identity());
+        palette[2] = Mat4::translate(Vec3(1, 0, 0));
+        skin_vertices(mesh.vertices.data(), mesh.influences.data(), mesh.vertices.size(), palette.data(), out.data());
+        for (size_t v = 0; v < out.size(); ++v) {
+            float weight = 0.0f;
+            for (uint32_t k = 0; k < kMaxSkinInfluences; ++k) {
+                if (mesh.influences[v].joints[k] == 2) {
+                    weight += mesh.influences[v].weights[k];
+                }
+            }
+            CHECK(vectors_near(out[v].position, mesh.vertices[v].position + Vec3(weight, 0, 0)));
+        }
+    }
+
+    SECTION("Rotated normals stay unit length") {
+        std::vector<Mat4> palette(3, Mat4::rotate_z(0.5f));
+        palette[1] = Mat4::rotate_x(1.0f);
+        skin_vertices(mesh.vertices.data(), mesh.influences.data(), mesh.vertices.size(), palette.data(), out.data());
+        for (const Vertex& v : out) {
+            CHECK_THAT(v.normal.length(), Catch::Matchers::WithinAbs(1.0f, 1e-4f));
+        }
+    }
+}
+
+// =============================================================================
+// SkinningSystem Tests
+// =============================================================================
+TEST_CASE("SkinningSystem skins, uploads and draws every instance", "[core][skinning]") {
+    MockGraphicsDeviceForSkinning device;
+    JobSystem jobs(2);
+    const Skeleton skeleton = make_chain_skeleton(4, 0.5f);
+    const SkinnedMeshData mesh = make_skinned_cylinder(0.2f, 4, 0.5f, 6, 8, Vec4(1, 0, 0, 1));
+    const uint32_t vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+    const uint32_t index_count = static_cast<uint32_t>(mesh.indices.size());
+    SkinningSystem skinning(device, vertex_count * 2, index_count * 2);
+
+    const uint32_t a = skinning.add_instance(&mesh, &skeleton, Material{});
+    const uint32_t b = skinning.add_instance(&mesh, &skeleton, Material{});
+    CHECK(skinning.add_instance(&mesh, &skeleton, Material{}) == ~0u);
+    REQUIRE(skinning.instance_count() == 2);
+    CHECK(skinning.first_vertex(b) == vertex_count);
+    CHECK(skinning.joint_offset(b) == 4);
+
+    skinning.model_matrix(b) = Mat4::translate(Vec3(10, 0, 0));
+    skinning.pose(a)[3].rotation = Quat::from_axis_angle(Vec3(0, 0, 1), 1.0f);
+    skinning.update(jobs);
+
+    const std::vector<Vertex>& skinned = skinning.skinned_vertices();
+    REQUIRE(skinned.size() == vertex_count * 2);
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        CHECK(vectors_near(skinned[vertex_count + v].position, mesh.vertices[v].position + Vec3(10, 0, 0)));
+    }
+    // The bottom ring only follows the root, which did not move.
+    CHECK(vectors_near(skinned[0].position, mesh.vertices[0].position));
+    // The top ring follows the rotated last joint.
+    CHECK(!vectors_near(skinned[vertex_count - 1].position, mesh.vertices[vertex_count - 1].position, 1e-2f));
+
+    REQUIRE(skinning.joint_matrices().size() == 8);
+    CHECK(matrices_near(skinning.joint_matrices()[skinning.joint_offset(b)], Mat4::translate(Vec3(10, 0, 0))));
+
+    CHECK(device.last_vertex_upload == sizeof(Vertex) * vertex_count * 2);
+    REQUIRE(device.uploaded_indices.size() == index_count * 2);
+    CHECK(device.uploaded_indices[index_count] == mesh.indices[0] + vertex_count);
+
+    skinning.render(device, UniformBufferHandle{1}, Mat4::identity(), DirectionalLighting::default_sun(),
+        Vec3(0, 0, 0));
+    REQUIRE(device.draws.size() == 2);
+    CHECK(device.draws[1].first_index == index_count);
+    CHECK(device.draws[1].index_count == index_count);
+
+    SECTION("Indices reach each frame's buffer once") {
+        for (int frame = 0; frame < 5; ++frame) {
+            skinning.update(jobs);
+        }
+        CHECK(device.index_uploads == StreamingGeometryBuffer::kFramesInFlight);
+    }
+}
+
+TEST_CASE("SkinningSystem rejects meshes that do not fit the skeleton", "[core][skinning]") {
+    MockGraphicsDeviceForSkinning device;
+    const Skeleton skeleton = make_chain_skeleton(4, 0.5f);
+    SkinnedMeshData mesh = make_skinned_cylinder(0.2f, 4, 0.5f, 6, 8, Vec4(1, 0, 0, 1));
+    SkinningSystem skinning(device, 4096, 4096);
+
+    SECTION("Missing influences") {
+        mesh.influences.pop_back();
+        CHECK(skinning.add_instance(&mesh, &skeleton, Material{}) == ~0u);
+    }
+    SECTION("Joint past the skeleton, even with zero weight") {
+        mesh.influences[3].joints[3] = 4;
+        CHECK(skinning.add_instance(&mesh, &skeleton, Material{}) == ~0u);
+    }
+    SECTION("Index past the vertices") {
+        mesh.indices[5] = static_cast<uint32_t>(mesh.vertices.size());
+        CHECK(skinning.add_instance(&mesh, &skeleton, Material{}) == ~0u);
+    }
+    CHECK(skinning.instance_count() == 0);
+    CHECK(device.index_uploads == 0);
+}
+
+TEST_CASE("SkinningSystem skins identically on one or many threads", "[core][skinning]") {
+    MockGraphicsDeviceForSkinning device;
+    JobSystem serial(0);
+    JobSystem parallel(3);
+    const Skeleton skeleton = make_chain_skeleton(6, 0.3f);
+    const SkinnedMeshData mesh = make_skinned_cylinder(0.1f, 6, 0.3f, 16, 40, Vec4(1, 1, 1, 1));
+    SkinningSystem a(device, 100000, 300000);
+    SkinningSystem b(device, 100000, 300000);
+    for (SkinningSystem* system : {&a, &b}) {
+        for (uint32_t i = 0; i < 20; ++i) {
+            const uint32_t id = system->add_instance(&mesh, &skeleton, Material{});
+            system->model_matrix(id) = Mat4::translate(Vec3(static_cast<float>(i), 0, 0));
+            for (uint32_t j = 1; j < skeleton.joint_count(); ++j) {
+                system->pose(id)[j].rotation = Quat::from_axis_angle(Vec3(0, 0, 1), 0.05f * (i + j));
+            }
+        }
+    }
+    a.update(serial);
+    b.update(parallel);
+    REQUIRE(a.skinned_vertices().size() == b.skinned_vertices().size());
+    for (size_t v = 0; v < a.skinned_vertices().size(); v += 37) {
+        CHECK(a.skinned_vertices()[v].position.x == b.skinned_vertices()[v].position.x);
+        CHECK(a.skinned_vertices()[v].normal.y == b.skinned_vertices()[v].normal.y);
+    }
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("SkinningSystem benchmarks", "[.][benchmark][skinning]") {
+    MockGraphicsDeviceForSkinning device;
+    // Roughly a crowd character: 32 joints, ~2k vertices.
+    const Skeleton skeleton = make_chain_skeleton(32, 0.1f);
+    const SkinnedMeshData mesh = make_skinned_cylinder(0.2f, 32, 0.1f, 31, 63, Vec4(1, 1, 1, 1));
+    const uint32_t characters = 300;
+    SkinningSystem skinning(device, static_cast<uint32_t>(mesh.vertices.size()) * characters,
+        static_cast<uint32_t>(mesh.indices.size()) * characters);
+    for (uint32_t i = 0; i < characters; ++i) {
+        const uint32_t id = skinning.add_instance(&mesh, &skeleton, Material{});
+        for (uint32_t j = 1; j < skeleton.joint_count(); ++j) {
+            skinning.pose(id)[j].rotation = Quat::from_axis_angle(Vec3(0, 0, 1), 0.01f * static_cast<float>(i % 7));
+        }
+    }
+
+    BENCHMARK("Skin 300 characters (32 joints, 2k vertices)") {
+        skinning.update(JobSystem::instance());
+        return skinning.skinned_vertices()[0].position.x;
+    };
+}
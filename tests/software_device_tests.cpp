@@ -0,0 +1,335 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/camera.hpp"
+#include "maya/core/debug_draw.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/primitives.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/scene_draw_uniforms.hpp"
+#include "maya/core/stress_scene.hpp"
+#include "maya/rhi/software/software_device.hpp"
+#include "maya/rhi/vertex.hpp"
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+const char* const kShader = R"(
+    vertex VertexOut vertexMain(uint vertexID [[vertex_id]]) { return {}; }
+    vertex VertexOut vertexDebug(uint vertexID [[vertex_id]]) { return {}; }
+    fragment float4 fragmentMain(VertexOut in [[stage_in]]) { return float4(1); }
+    fragment float4 fragmentUnlit(VertexOut in [[stage_in]]) { return in.color; }
+)";
+
+Vertex make_vertex(float x, float y, float z, const Vec4& color, const Vec2& uv = {0.0f, 0.0f}) {
+    return Vertex(Vec3(x, y, z), Vec3(0.0f, 0.0f, 1.0f), color, uv);
+}
+
+SceneDrawUniforms make_uniforms(const Mat4& view_projection) {
+    SceneDrawUniforms uniforms{};
+    uniforms.model_matrix = Mat4::identity();
+    uniforms.view_projection_matrix = view_projection;
+    return uniforms;
+}
+
+const uint8_t* pixel(const SoftwareDevice& device, uint32_t x, uint32_t y) {
+    return device.image().pixels.data() + (static_cast<size_t>(y) * device.image().width + x) * 4;
+}
+
+/// Device with one pipeline, a uniform buffer of identity matrices (vertices are in NDC) and
+/// helpers to draw vertex lists.
+struct Fixture {
+    JobSystem jobs{0};
+    SoftwareDevice device{jobs, 64, 48};
+    PipelineHandle unlit;
+    PipelineHandle lit;
+    UniformBufferHandle uniforms;
+
+    Fixture() {
+        device.initialize(nullptr);
+        unlit = device.create_pipeline(kShader, "vertexMain", "fragmentUnlit");
+        lit = device.create_pipeline(kShader);
+        uniforms = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+        set_uniforms(make_uniforms(Mat4::identity()));
+    }
+
+    void set_uniforms(const SceneDrawUniforms& values) {
+        device.update_uniform_buffer(uniforms, &values, sizeof(values));
+    }
+
+    void draw(const std::vector<Vertex>& vertices, PipelineHandle pipeline) {
+        std::vector<uint32_t> indices(vertices.size());
+        for (uint32_t i = 0; i < indices.size(); ++i) {
+            indices[i] = i;
+        }
+        VertexBufferHandle vb = device.create_vertex_buffer(vertices.data(), vertices.size() * sizeof(Vertex));
+        IndexBufferHandle ib = device.create_index_buffer(indices.data(), indices.size() * sizeof(uint32_t));
+        device.bind_pipeline(pipeline);
+        device.bind_uniform_buffer(uniforms, 1);
+        device.bind_vertex_buffer(vb, 0);
+        device.draw_indexed(ib, static_cast<uint32_t>(indices.size()));
+    }
+};
+
+} // namespace
+
+TEST_CASE("SoftwareDevice clears and draws front faces only", "[rhi][software]") {
+    Fixture f;
+    const Vec4 red(1.0f, 0.0f, 0.0f, 1.0f);
+    // Counter-clockwise in NDC covering the lower-left half of the screen.
+    const std::vector<Vertex> front = {
+        make_vertex(-1, -1, 0.5f, red), make_vertex(1, -1, 0.5f, red), make_vertex(-1, 1, 0.5f, red)};
+
+    SECTION("Clear color and depth without draws") {
+        f.device.begin_frame();
+        f.device.end_frame();
+        CHECK(pixel(f.device, 0, 0)[0] == 26);
+        CHECK(pixel(f.device, 0, 0)[3] == 255);
+        CHECK(f.device.depth_at(63, 47) == 1.0f);
+    }
+
+    SECTION("Front face is drawn with its depth") {
+        f.device.begin_frame();
+        f.draw(front, f.unlit);
+        f.device.end_frame();
+        // Bottom-left of the screen is the last row.
+        CHECK(pixel(f.device, 2, 45)[0] == 255);
+        CHECK(pixel(f.device, 2, 45)[1] == 0);
+        CHECK_THAT(f.device.depth_at(2, 45), WithinAbs(0.5, 1e-6));
+        CHECK(pixel(f.device, 60, 2)[0] == 26);
+        // Exactly the pixels below the diagonal: the top-left rule keeps centers on it once.
+        CHECK(f.device.raster_stats().fragments == 64 * 48 / 2);
+        CHECK(f.device.raster_stats().culled == 0);
+    }
+
+    SECTION("Back face is culled") {
+        const std::vector<Vertex> back = {front[0], front[2], front[1]};
+        f.device.begin_frame();
+        f.draw(back, f.unlit);
+        f.device.end_frame();
+        CHECK(f.device.raster_stats().culled == 1);
+        CHECK(f.device.raster_stats().fragments == 0);
+        CHECK(pixel(f.device, 2, 45)[0] == 26);
+    }
+    CHECK(f.device.validation_error_count() == 0);
+}
+
+TEST_CASE("SoftwareDevice depth test is Less", "[rhi][software]") {
+    Fixture f;
+    auto quad = [](float z, const Vec4& color) {
+        return std::vector<Vertex>{make_vertex(-1, -1, z, color), make_vertex(1, -1, z, color),
+            make_vertex(1, 1, z, color), make_vertex(-1, -1, z, color), make_vertex(1, 1, z, color),
+            make_vertex(-1, 1, z, color)};
+    };
+    const Vec4 red(1.0f, 0.0f, 0.0f, 1.0f);
+    const Vec4 green(0.0f, 1.0f, 0.0f, 1.0f);
+
+    f.device.begin_frame();
+    f.draw(quad(0.3f, red), f.unlit);
+    f.draw(quad(0.6f, green), f.unlit);  // behind
+    f.device.end_frame();
+    CHECK(pixel(f.device, 32, 24)[0] == 255);
+
+    f.device.begin_frame();
+    f.draw(quad(0.6f, green), f.unlit);
+    f.draw(quad(0.3f, red), f.unlit);  // in front
+    f.draw(quad(0.3f, green), f.unlit);  // equal depth fails Less
+    f.device.end_frame();
+    CHECK(pixel(f.device, 32, 24)[0] == 255);
+    CHECK(pixel(f.device, 32, 24)[1] == 0);
+    CHECK(f.device.raster_stats().fragments == 2 * 64 * 48);
+}
+
+TEST_CASE("SoftwareDevice shared edges cover every pixel exactly once", "[rhi][software]") {
+    // A jittered grid split into triangles, each with its own vertices and drawn nearer than the
+    // previous one: any overlap would shade a pixel twice and any gap would leave it unshaded.
+    Fixture f;
+    constexpr int kCells = 7;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> jitter(-0.08f, 0.08f);
+    Vec2 grid[kCells + 1][kCells + 1];
+    for (int y = 0; y <= kCells; ++y) {
+        for (int x = 0; x <= kCells; ++x) {
+            const bool border_x = x == 0 || x == kCells;
+            const bool border_y = y == 0 || y == kCells;
+            grid[y][x] = Vec2(-1.0f + 2.0f * x / kCells + (border_x ? 0.0f : jitter(rng)),
+                -1.0f + 2.0f * y / kCells + (border_y ? 0.0f : jitter(rng)));
+        }
+    }
+    std::vector<Vertex> vertices;
+    float z = 0.9f;
+    auto triangle = [&](const Vec2& a, const Vec2& b, const Vec2& c) {
+        const Vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+        vertices.push_back(make_vertex(a.x, a.y, z, white));
+        vertices.push_back(make_vertex(b.x, b.y, z, white));
+        vertices.push_back(make_vertex(c.x, c.y, z, white));
+        z -= 0.005f;
+    };
+    for (int y = 0; y < kCells; ++y) {
+        for (int x = 0; x < kCells; ++x) {
+            triangle(grid[y][x], grid[y][x + 1], grid[y + 1][x + 1]);
+            triangle(grid[y][x], grid[y + 1][x + 1], grid[y + 1][x]);
+        }
+    }
+
+    f.device.begin_frame();
+    f.draw(vertices, f.unlit);
+    f.device.end_frame();
+    CHECK(f.device.raster_stats().culled == 0);
+    CHECK(f.device.raster_stats().fragments == 64 * 48);
+}
+
+TEST_CASE("SoftwareDevice clips against the near plane", "[rhi][software]") {
+    Fixture f;
+    f.set_uniforms(make_uniforms(Mat4::perspective(1.2f, 64.0f / 48.0f, 0.1f, 100.0f)));
+    const Vec4 blue(0.0f, 0.0f, 1.0f, 1.0f);
+    // Floor triangle running from behind the camera to far ahead of it.
+    const std::vector<Vertex> floor = {make_vertex(-5, -1, 5, blue), make_vertex(5, -1, 5, blue),
+        make_vertex(0, -1, -50, blue)};
+
+    f.device.begin_frame();
+    f.draw(floor, f.unlit);
+    f.device.end_frame();
+    CHECK(f.device.raster_stats().clipped == 1);
+    CHECK(f.device.raster_stats().fragments > 0);
+    CHECK(pixel(f.device, 32, 47)[2] == 255);  // bottom center: the floor near the camera
+    CHECK(pixel(f.device, 32, 2)[2] == 26);    // top: sky
+    for (uint32_t y = 0; y < 48; ++y) {
+        const float depth = f.device.depth_at(32, y);
+        CHECK((depth >= 0.0f && depth <= 1.0f));
+    }
+}
+
+TEST_CASE("SoftwareDevice samples textures bilinearly", "[rhi][software]") {
+    Fixture f;
+    // Only ambient light, scaled so a white surface shades to exactly its albedo.
+    SceneDrawUniforms uniforms = make_uniforms(Mat4::identity());
+    uniforms.ambient_sh[0] = Vec4(1.0f / 0.282095f, 1.0f / 0.282095f, 1.0f / 0.282095f, 0.0f);
+    f.set_uniforms(uniforms);
+    const uint8_t texels[] = {0, 0, 0, 255, 255, 255, 255, 255};  // black, white
+    TextureHandle texture = f.device.create_texture(texels, 2, 1);
+
+    const Vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+    const std::vector<Vertex> quad = {make_vertex(-1, -1, 0.5f, white, {0, 1}), make_vertex(1, -1, 0.5f, white, {1, 1}),
+        make_vertex(1, 1, 0.5f, white, {1, 0}), make_vertex(-1, -1, 0.5f, white, {0, 1}),
+        make_vertex(1, 1, 0.5f, white, {1, 0}), make_vertex(-1, 1, 0.5f, white, {0, 0})};
+
+    f.device.begin_frame();
+    f.device.bind_texture(texture, 0);
+    f.draw(quad, f.lit);
+    f.device.end_frame();
+    // Pixel centers 31.5 and 32.5 straddle u = 0.5, halfway between the texel centers at 0.25
+    // and 0.75; u near 0 blends with the white texel through the repeat wrap.
+    CHECK(pixel(f.device, 31, 24)[0] + pixel(f.device, 32, 24)[0] == 255);
+    CHECK(pixel(f.device, 16, 24)[0] < 10);
+    CHECK(pixel(f.device, 48, 24)[0] > 245);
+    CHECK(pixel(f.device, 0, 24)[0] > 100);
+}
+
+TEST_CASE("SoftwareDevice draws debug lines", "[rhi][software]") {
+    Fixture f;
+    PipelineHandle debug = f.device.create_pipeline(kShader, "vertexDebug", "fragmentUnlit");
+    const DebugVertex line[] = {{Vec3(-1.0f, 0.01f, 0.5f), 0xFF00FF00u}, {Vec3(1.0f, 0.01f, 0.5f), 0xFF00FF00u}};
+    VertexBufferHandle vb = f.device.create_vertex_buffer(line, sizeof(line));
+
+    f.device.begin_frame();
+    f.device.bind_pipeline(debug);
+    f.device.bind_uniform_buffer(f.uniforms, 1);
+    f.device.bind_vertex_buffer(vb, 0);
+    f.device.draw(PrimitiveTopology::Lines, 0, 2);
+    f.device.end_frame();
+
+    // NDC y = 0.01 is pixel row 23.76, so the one-pixel line covers the centers of row 23 only.
+    for (uint32_t x = 0; x < 64; x += 9) {
+        CHECK(pixel(f.device, x, 23)[1] == 255);
+        CHECK(pixel(f.device, x, 22)[1] == 26);
+        CHECK(pixel(f.device, x, 24)[1] == 26);
+    }
+    CHECK(f.device.raster_stats().fragments == 64);
+}
+
+TEST_CASE("SoftwareDevice rejects what it cannot run", "[rhi][software]") {
+    Fixture f;
+    f.device.set_log_validation_errors(false);
+    CHECK(f.device.create_pipeline(kShader, "vertexSkinned", "fragmentMain").handle == INVALID_HANDLE);
+
+    const Vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+    const std::vector<Vertex> vertices = {make_vertex(-1, -1, 0, white), make_vertex(1, -1, 0, white),
+        make_vertex(-1, 1, 0, white)};
+    const uint32_t indices[] = {0, 1, 7};
+    VertexBufferHandle vb = f.device.create_vertex_buffer(vertices.data(), vertices.size() * sizeof(Vertex));
+    IndexBufferHandle ib = f.device.create_index_buffer(indices, sizeof(indices));
+    f.device.begin_frame();
+    f.device.bind_pipeline(f.unlit);
+    f.device.bind_vertex_buffer(vb, 0);
+    f.device.draw_indexed(ib, 3);
+    CHECK(f.device.last_validation_error().find("no uniform buffer") != std::string::npos);
+    f.device.bind_uniform_buffer(f.uniforms, 1);
+    f.device.draw_indexed(ib, 3);
+    CHECK(f.device.last_validation_error().find("vertex 7 exceeds the 3-vertex buffer") != std::string::npos);
+    f.device.end_frame();
+    CHECK(f.device.validation_error_count() == 3);
+    CHECK(f.device.raster_stats().fragments == 0);
+}
+
+TEST_CASE("SoftwareDevice renders a scene independent of the worker count", "[rhi][software]") {
+    auto render = [](uint32_t workers) {
+        JobSystem jobs(workers);
+        SoftwareDevice device(jobs, 200, 120);
+        device.initialize(nullptr);
+        Scene scene;
+        StressSceneSettings settings;
+        settings.object_count = 60;
+        settings.extent = 8.0f;
+        settings.detail = 8;
+        add_stress_scene(scene, device, Material{device.create_pipeline(kShader), nullptr}, settings);
+        UniformBufferHandle uniforms = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+        Camera camera(60.0f, 200.0f / 120.0f, 0.1f, 100.0f);
+        camera.set_position(Vec3(0.0f, 0.0f, 20.0f));
+
+        device.begin_frame();
+        scene.render(device, uniforms, camera.get_view_projection_matrix(), DirectionalLighting::default_sun(),
+            camera.get_position());
+        device.end_frame();
+        CHECK(device.validation_error_count() == 0);
+        CHECK(device.raster_stats().fragments > 200 * 120 / 10);
+        return device.image().pixels;
+    };
+    CHECK(render(0) == render(3));
+}
+
+TEST_CASE("SoftwareDevice scene benchmark", "[.][benchmark][software]") {
+    JobSystem& jobs = JobSystem::instance();
+    SoftwareDevice device(jobs, 640, 360);
+    device.initialize(nullptr);
+    Scene scene;
+    add_stress_scene(scene, device, Material{device.create_pipeline(kShader), nullptr}, StressSceneSettings{});
+    UniformBufferHandle uniforms = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+    Camera camera(60.0f, 640.0f / 360.0f, 0.1f, 200.0f);
+    camera.set_position(Vec3(0.0f, 0.0f, 60.0f));
+    const DirectionalLighting sun = DirectionalLighting::default_sun();
+    auto frame = [&] {
+        device.begin_frame();
+        scene.render(device, uniforms, camera.get_view_projection_matrix(), sun, camera.get_position());
+        device.end_frame();
+        return device.raster_stats().fragments;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    frame();
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const SoftwareDevice::RasterStats& stats = device.raster_stats();
+    WARN("1000 objects at 640x360: " << ms << " ms, " << stats.primitives << " triangles, " << stats.culled
+         << " culled, " << stats.fragments << " fragments on " << jobs.worker_count() << " workers");
+
+    BENCHMARK("Render 1000 objects at 640x360") {
+        return frame();
+    };
+}
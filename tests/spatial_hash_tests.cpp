@@ -0,0 +1,188 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/spatial_hash.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace maya;
+using namespace maya::math;
+
+namespace {
+
+Aabb box_at(const Vec3& p, float half = 0.5f) {
+    return Aabb(p - Vec3(half), p + Vec3(half));
+}
+
+std::vector<uint32_t> sorted(std::vector<uint32_t> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::vector<uint32_t> brute_force(const std::vector<Aabb>& bounds, const Aabb& query) {
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(bounds.size()); ++i) {
+        if (bounds[i].overlaps(query)) {
+            ids.push_back(i);
+        }
+    }
+    return ids;
+}
+
+std::vector<Aabb> random_bounds(uint32_t count, float extent, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-extent, extent);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    std::vector<Aabb> bounds;
+    bounds.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        bounds.push_back(box_at(Vec3(pos(rng), pos(rng), pos(rng)), size(rng)));
+    }
+    return bounds;
+}
+
+} // namespace
+
+// =============================================================================
+// Incremental API Tests
+// =============================================================================
+TEST_CASE("SpatialHashGrid incremental updates", "[core][spatial_hash]") {
+    JobSystem jobs(0);
+    SpatialHashGrid grid;
+    grid.insert(0, box_at(Vec3(0, 0, 0)));
+    grid.insert(1, box_at(Vec3(10, 0, 0)));
+    grid.insert(7, box_at(Vec3(0, 0, 10)));
+    std::vector<uint32_t> out;
+
+    SECTION("Queries see pending inserts before a rebuild") {
+        CHECK(grid.size() == 3);
+        CHECK(grid.loose_count() == 3);
+        grid.query_radius(Vec3(0, 0, 0), 2.0f, out);
+        CHECK(out == std::vector<uint32_t>{0});
+    }
+
+    SECTION("Rebuild moves pending objects into the table") {
+        grid.rebuild(jobs);
+        CHECK(grid.loose_count() == 0);
+        grid.query_box(Aabb(Vec3(-1, -1, -1), Vec3(11, 1, 11)), out);
+        CHECK(sorted(out) == std::vector<uint32_t>{0, 1, 7});
+    }
+
+    SECTION("Moves within a cell keep the object in the table") {
+        grid.rebuild(jobs);
+        grid.move(0, box_at(Vec3(0.2f, 0.2f, 0.2f), 0.25f));
+        CHECK(grid.loose_count() == 0);
+        grid.query_radius(Vec3(0.2f, 0.2f, 0.2f), 0.1f, out);
+        CHECK(out == std::vector<uint32_t>{0});
+    }
+
+    SECTION("Moves across cells are found at the new position only") {
+        grid.rebuild(jobs);
+        grid.move(1, box_at(Vec3(-20, 0, 0)));
+        CHECK(grid.loose_count() == 1);
+        grid.query_radius(Vec3(10, 0, 0), 2.0f, out);
+        CHECK(out.empty());
+        grid.query_radius(Vec3(-20, 0, 0), 2.0f, out);
+        CHECK(out == std::vector<uint32_t>{1});
+    }
+
+    SECTION("Removed objects disappear") {
+        grid.rebuild(jobs);
+        grid.remove(7);
+        grid.remove(7);
+        CHECK(grid.size() == 2);
+        CHECK_FALSE(grid.contains(7));
+        grid.query_radius(Vec3(0, 0, 10), 2.0f, out);
+        CHECK(out.empty());
+    }
+
+    SECTION("Commit rebuilds once enough objects are pending") {
+        grid.rebuild(jobs);
+        CHECK_FALSE(grid.commit(jobs));
+        grid.move(0, box_at(Vec3(30, 0, 0)));
+        CHECK(grid.commit(jobs));
+        CHECK(grid.loose_count() == 0);
+        grid.query_radius(Vec3(30, 0, 0), 1.0f, out);
+        CHECK(out == std::vector<uint32_t>{0});
+    }
+}
+
+TEST_CASE("SpatialHashGrid reports each object once", "[core][spatial_hash]") {
+    JobSystem jobs(0);
+    SpatialHashSettings settings;
+    settings.cell_size = 1.0f;
+    settings.max_cells_per_object = 8;
+    SpatialHashGrid grid(settings);
+    // Spans 3x3x3 cells, over the limit: kept loose.
+    grid.insert(0, box_at(Vec3(0.5f, 0.5f, 0.5f), 1.2f));
+    // Spans 2x2x2 cells: stored in eight buckets.
+    grid.insert(1, Aabb(Vec3(4.5f, 4.5f, 4.5f), Vec3(5.5f, 5.5f, 5.5f)));
+    // Far-away fillers so small queries walk the bucket table rather than scanning.
+    for (uint32_t i = 2; i < 1000; ++i) {
+        grid.insert(i, box_at(Vec3(1000.0f + 3.0f * static_cast<float>(i), 0, 0)));
+    }
+    grid.rebuild(jobs);
+    CHECK(grid.loose_count() == 1);
+
+    std::vector<uint32_t> out;
+    grid.query_box(Aabb(Vec3(-1, -1, -1), Vec3(6, 6, 6)), out);
+    CHECK(sorted(out) == std::vector<uint32_t>{0, 1});
+    grid.query_box(Aabb(Vec3(5.2f, 5.2f, 5.2f), Vec3(5.3f, 5.3f, 5.3f)), out);
+    CHECK(out == std::vector<uint32_t>{1});
+}
+
+// =============================================================================
+// Bulk Rebuild Tests
+// =============================================================================
+TEST_CASE("SpatialHashGrid bulk assign matches brute force", "[core][spatial_hash]") {
+    JobSystem jobs(3);
+    const std::vector<Aabb> bounds = random_bounds(50000, 200.0f, 7);
+    SpatialHashGrid grid;
+    grid.assign(bounds, jobs);
+    CHECK(grid.size() == bounds.size());
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+    std::vector<uint32_t> out;
+    bool all_match = true;
+    for (int q = 0; q < 200; ++q) {
+        const Aabb query = box_at(Vec3(pos(rng), pos(rng), pos(rng)), 6.0f);
+        grid.query_box(query, out);
+        all_match = all_match && sorted(out) == brute_force(bounds, query);
+    }
+    CHECK(all_match);
+
+    SECTION("Incremental rebuild gives the same answers") {
+        SpatialHashGrid incremental;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(bounds.size()); ++i) {
+            incremental.insert(i, bounds[i]);
+        }
+        incremental.rebuild(jobs);
+        const Aabb query = box_at(Vec3(0, 0, 0), 20.0f);
+        incremental.query_box(query, out);
+        CHECK(sorted(out) == brute_force(bounds, query));
+    }
+}
+
+// =============================================================================
+// Benchmarks (hidden; run with "[benchmark]")
+// =============================================================================
+TEST_CASE("Spatial hash rebuild and query cost", "[.][benchmark][spatial_hash]") {
+    const std::vector<Aabb> bounds = random_bounds(100000, 500.0f, 3);
+    SpatialHashGrid grid;
+    std::vector<uint32_t> out;
+
+    BENCHMARK("assign 100k objects") {
+        grid.assign(bounds, JobSystem::instance());
+        return grid.size();
+    };
+    grid.assign(bounds, JobSystem::instance());
+    BENCHMARK("1000 radius queries, r = 8") {
+        size_t found = 0;
+        for (int q = 0; q < 1000; ++q) {
+            grid.query_radius(bounds[static_cast<size_t>(q) * 97].center(), 8.0f, out);
+            found += out.size();
+        }
+        return found;
+    };
+}
@@ -0,0 +1,273 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/scene.hpp"
+#include "maya/core/static_batch.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cstring>
+
+using namespace maya;
+using Catch::Matchers::WithinAbs;
+
+// Mock GraphicsDevice that keeps buffer contents and records ranged draws
+class MockGraphicsDeviceForBatching : public GraphicsDevice {
+public:
+    struct RangeDraw {
+        uint32_t buffer;
+        uint32_t first_index;
+        uint32_t index_count;
+    };
+
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+
+    VertexBufferHandle create_vertex_buffer(const void* data, size_t size) override {
+        std::vector<Vertex> verts;
+        for (size_t i = 0; data && i < size / sizeof(Vertex); ++i) {
+            verts.push_back(static_cast<const Vertex*>(data)[i]);
+        }
+        vertex_buffers.push_back(verts);
+        return {next_handle++};
+    }
+
+    IndexBufferHandle create_index_buffer(const void* data, size_t size) override {
+        const auto* idx = static_cast<const uint32_t*>(data);
+        index_buffers.emplace_back(idx, idx ? idx + size / sizeof(uint32_t) : idx);
+        return {next_handle++};
+    }
+
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override { ++uniform_updates; }
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override { ++vertex_binds; }
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override { ++full_draws; }
+    void draw_indexed_range(IndexBufferHandle handle, uint32_t first, uint32_t count) override {
+        range_draws.push_back({handle.handle, first, count});
+    }
+
+    std::vector<std::vector<Vertex>> vertex_buffers;
+    std::vector<std::vector<uint32_t>> index_buffers;
+    std::vector<RangeDraw> range_draws;
+    uint32_t uniform_updates = 0;
+    uint32_t vertex_binds = 0;
+    uint32_t full_draws = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+std::unique_ptr<Mesh> make_triangle(GraphicsDevice& device) {
+    std::vector<Vertex> vertices = {
+        Vertex(math::Vec3(0, 0, 0), math::Vec3(0, 0, 1), math::Vec4(1, 0, 0, 1)),
+        Vertex(math::Vec3(1, 0, 0), math::Vec3(0, 0, 1), math::Vec4(0, 1, 0, 1)),
+        Vertex(math::Vec3(0, 1, 0), math::Vec3(0, 0, 1), math::Vec4(0, 0, 1, 1))
+    };
+    return std::make_unique<Mesh>(device, vertices, std::vector<uint32_t>{0, 1, 2});
+}
+
+} // namespace
+
+// =============================================================================
+// Batch Building Tests
+// =============================================================================
+TEST_CASE("Static batches group objects by material", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    auto tri = make_triangle(device);
+
+    std::vector<SceneObject> objects;
+    objects.push_back(SceneObject{tri.get(), Material{{1}, nullptr}, math::Mat4::translate({10, 0, 0}), true});
+    objects.push_back(SceneObject{tri.get(), Material{{2}, nullptr}, math::Mat4::identity(), true});
+    objects.push_back(SceneObject{tri.get(), Material{{1}, nullptr}, math::Mat4::translate({0, 5, 0}), true});
+
+    auto batches = build_static_batches(device, objects);
+
+    REQUIRE(batches.size() == 2);
+    CHECK(batches[0].material.pipeline.handle == 1);
+    CHECK(batches[1].material.pipeline.handle == 2);
+    REQUIRE(batches[0].ranges.size() == 2);
+    CHECK(batches[0].ranges[0].source_object == 0);
+    CHECK(batches[0].ranges[1].source_object == 2);
+    CHECK(batches[0].mesh->vertex_count() == 6);
+    CHECK(batches[0].mesh->index_count() == 6);
+
+    SECTION("Vertices are pre-transformed to world space") {
+        const auto& verts = batches[0].mesh->vertices();
+        CHECK_THAT(verts[0].position.x, WithinAbs(10.0f, 0.0001f));
+        CHECK_THAT(verts[4].position.y, WithinAbs(5.0f, 0.0001f));
+    }
+
+    SECTION("Indices are rebased onto the shared vertex buffer") {
+        const auto& idx = batches[0].mesh->indices();
+        CHECK(idx[3] == 3);
+        CHECK(idx[5] == 5);
+        CHECK(batches[0].ranges[1].first_index == 3);
+    }
+
+    SECTION("Ranges carry world bounds for culling") {
+        const math::Aabb& b = batches[0].ranges[0].world_bounds;
+        CHECK_THAT(b.min.x, WithinAbs(10.0f, 0.0001f));
+        CHECK_THAT(b.max.x, WithinAbs(11.0f, 0.0001f));
+        CHECK_THAT(batches[0].world_bounds.max.y, WithinAbs(6.0f, 0.0001f));
+    }
+}
+
+TEST_CASE("Static batch normals follow the model transform", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    auto tri = make_triangle(device);
+
+    std::vector<SceneObject> objects;
+    const math::Mat4 model = math::Mat4::rotate_y(math::HALF_PI) * math::Mat4::scale({3, 1, 1});
+    objects.push_back(SceneObject{tri.get(), Material{{1}, nullptr}, model, true});
+
+    auto batches = build_static_batches(device, objects);
+    REQUIRE(batches.size() == 1);
+    const math::Vec3& n = batches[0].mesh->vertices()[0].normal;
+    CHECK_THAT(n.length(), WithinAbs(1.0f, 0.0001f));
+    CHECK_THAT(n.x, WithinAbs(1.0f, 0.0001f));
+}
+
+TEST_CASE("Static batches split at the vertex limit", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    auto tri = make_triangle(device);
+
+    std::vector<SceneObject> objects;
+    for (int i = 0; i < 5; ++i) {
+        objects.push_back(SceneObject{tri.get(), Material{{1}, nullptr}, math::Mat4::identity(), true});
+    }
+
+    StaticBatchSettings settings;
+    settings.max_vertices_per_batch = 6;
+    auto batches = build_static_batches(device, objects, settings);
+
+    REQUIRE(batches.size() == 3);
+    CHECK(batches[0].ranges.size() == 2);
+    CHECK(batches[2].ranges.size() == 1);
+    CHECK(batches[2].ranges[0].source_object == 4);
+}
+
+// =============================================================================
+// Ranged Drawing Tests
+// =============================================================================
+TEST_CASE("Static batch ranged drawing", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    auto tri = make_triangle(device);
+
+    std::vector<SceneObject> objects;
+    for (int i = 0; i < 4; ++i) {
+        objects.push_back(SceneObject{tri.get(), Material{{1}, nullptr}, math::Mat4::identity(), true});
+    }
+    auto batches = build_static_batches(device, objects);
+    REQUIRE(batches.size() == 1);
+
+    SECTION("All visible ranges coalesce into one draw") {
+        uint32_t draws = batches[0].draw_ranges([](uint32_t) { return true; });
+        CHECK(draws == 1);
+        REQUIRE(device.range_draws.size() == 1);
+        CHECK(device.range_draws[0].first_index == 0);
+        CHECK(device.range_draws[0].index_count == 12);
+        CHECK(device.vertex_binds == 1);
+    }
+
+    SECTION("Culled ranges split the draw") {
+        uint32_t draws = batches[0].draw_ranges([](uint32_t i) { return i != 1; });
+        CHECK(draws == 2);
+        REQUIRE(device.range_draws.size() == 2);
+        CHECK(device.range_draws[0].index_count == 3);
+        CHECK(device.range_draws[1].first_index == 6);
+        CHECK(device.range_draws[1].index_count == 6);
+    }
+
+    SECTION("Nothing visible issues no binds") {
+        uint32_t draws = batches[0].draw_ranges([](uint32_t) { return false; });
+        CHECK(draws == 0);
+        CHECK(device.vertex_binds == 0);
+    }
+}
+
+// =============================================================================
+// Scene Integration Tests
+// =============================================================================
+TEST_CASE("Scene moves static objects into batches", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    Scene scene;
+
+    for (int i = 0; i < 3; ++i) {
+        scene.add_static_object(make_triangle(device), Material{{7}, nullptr},
+            math::Mat4::translate({static_cast<float>(i), 0, 0}));
+    }
+    scene.add_object(make_triangle(device), Material{{8}, nullptr});
+
+    CHECK(scene.drawable_count() == 4);
+    CHECK(scene.build_static_batches(device) == 1);
+    CHECK(scene.objects().size() == 1);
+    CHECK(scene.static_objects().size() == 3);
+    CHECK(scene.drawable_count() == 2);
+
+    UniformBufferHandle ub = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+    scene.render(device, ub, math::Mat4::identity(), DirectionalLighting::default_sun(), math::Vec3(0.0f));
+    CHECK(device.uniform_updates == 2);
+    CHECK(device.full_draws == 1);
+    CHECK(device.range_draws.size() == 1);
+}
+
+TEST_CASE("Scene releases CPU geometry nothing reads back", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    Scene scene;
+    scene.add_static_object(make_triangle(device), Material{{7}, nullptr}, math::Mat4::identity());
+    scene.add_object(make_triangle(device), Material{{8}, nullptr});
+    scene.add_object(make_triangle(device), Material{{8}, nullptr});
+    scene.build_static_batches(device);
+    // Merged copies are never read back; sources stay for later load-time passes.
+    CHECK_FALSE(scene.static_batches()[0].mesh->has_cpu_data());
+    CHECK(scene.static_objects()[0].mesh->has_cpu_data());
+
+    SECTION("Without dynamic batching only dynamic meshes are released") {
+        scene.release_cpu_geometry();
+        CHECK(scene.static_objects()[0].mesh->has_cpu_data());
+        CHECK_FALSE(scene.objects()[0].mesh->has_cpu_data());
+        CHECK(scene.objects()[0].mesh->index_count() == 3);
+    }
+
+    SECTION("Meshes eligible for dynamic batching are kept") {
+        scene.enable_dynamic_batching(device);
+        scene.release_cpu_geometry();
+        CHECK(scene.objects()[0].mesh->has_cpu_data());
+        CHECK(scene.objects()[1].mesh->has_cpu_data());
+    }
+
+    SECTION("Static objects added after a release are batched with the others") {
+        scene.release_cpu_geometry();
+        scene.add_static_object(make_triangle(device), Material{{7}, nullptr}, math::Mat4::translate({2, 0, 0}));
+        scene.release_cpu_geometry();
+        CHECK(scene.build_static_batches(device) == 1);
+        CHECK(scene.static_batches()[0].ranges.size() == 2);
+        CHECK(scene.static_batches()[0].mesh->index_count() == 6);
+    }
+}
+
+TEST_CASE("build_static_batches skips meshes without CPU data", "[core][static_batch]") {
+    MockGraphicsDeviceForBatching device;
+    auto kept = make_triangle(device);
+    auto released = make_triangle(device);
+    released->release_cpu_data();
+    std::vector<SceneObject> objects = {
+        {released.get(), Material{{7}, nullptr}, math::Mat4::identity(), true},
+        {kept.get(), Material{{7}, nullptr}, math::Mat4::identity(), true},
+    };
+    auto batches = build_static_batches(device, objects);
+    REQUIRE(batches.size() == 1);
+    REQUIRE(batches[0].ranges.size() == 1);
+    CHECK(batches[0].ranges[0].source_object == 1);
+    CHECK(batches[0].mesh->index_count() == 3);
+}
@@ -0,0 +1,208 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/sweep_and_prune.hpp"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+
+using namespace maya;
+using namespace maya::math;
+
+namespace {
+
+using PairSet = std::set<std::pair<uint32_t, uint32_t>>;
+
+Aabb box_at(const Vec3& p, float half = 0.5f) {
+    return Aabb(p - Vec3(half), p + Vec3(half));
+}
+
+PairSet to_set(const std::vector<SapPair>& pairs) {
+    PairSet set;
+    for (const SapPair& pair : pairs) {
+        set.emplace(pair.a, pair.b);
+    }
+    return set;
+}
+
+PairSet current_pairs(const SweepAndPrune& sap) {
+    std::vector<SapPair> pairs;
+    sap.pairs(pairs);
+    return to_set(pairs);
+}
+
+PairSet brute_force(const std::vector<Aabb>& bounds, const std::vector<bool>& live) {
+    PairSet set;
+    for (uint32_t a = 0; a < static_cast<uint32_t>(bounds.size()); ++a) {
+        for (uint32_t b = a + 1; b < static_cast<uint32_t>(bounds.size()); ++b) {
+            if (live[a] && live[b] && bounds[a].overlaps(bounds[b])) {
+                set.emplace(a, b);
+            }
+        }
+    }
+    return set;
+}
+
+} // namespace
+
+// =============================================================================
+// Event Tests
+// =============================================================================
+TEST_CASE("SweepAndPrune reports pairs as they start and stop overlapping", "[core][sweep_and_prune]") {
+    JobSystem jobs(0);
+    SweepAndPrune sap;
+    sap.insert(0, box_at(Vec3(0, 0, 0)));
+    sap.insert(1, box_at(Vec3(5, 0, 0)));
+    sap.insert(2, box_at(Vec3(0.5f, 0.5f, 0.5f)));
+    sap.update(jobs);
+
+    CHECK(sap.size() == 3);
+    CHECK(to_set(sap.added_pairs()) == PairSet{{0, 2}});
+    CHECK(sap.removed_pairs().empty());
+    CHECK(sap.overlapping(2, 0));
+    CHECK_FALSE(sap.overlapping(0, 1));
+
+    SECTION("Nothing moved, nothing reported") {
+        sap.update(jobs);
+        CHECK(sap.added_pairs().empty());
+        CHECK(sap.removed_pairs().empty());
+        CHECK(sap.pair_count() == 1);
+    }
+
+    SECTION("Moving into and out of contact") {
+        sap.move(1, box_at(Vec3(1.0f, 0, 0)));
+        sap.move(2, box_at(Vec3(0, 5, 0)));
+        sap.update(jobs);
+        CHECK(to_set(sap.added_pairs()) == PairSet{{0, 1}});
+        CHECK(to_set(sap.removed_pairs()) == PairSet{{0, 2}});
+        CHECK(current_pairs(sap) == PairSet{{0, 1}});
+    }
+
+    SECTION("Touching boxes overlap") {
+        sap.move(1, box_at(Vec3(1.0f, 0, 0)));
+        sap.move(2, box_at(Vec3(0, 5, 0)));
+        sap.update(jobs);
+        sap.move(1, box_at(Vec3(1.0001f, 0, 0)));
+        sap.update(jobs);
+        CHECK(to_set(sap.removed_pairs()) == PairSet{{0, 1}});
+    }
+
+    SECTION("Removal reports the object's pairs once") {
+        sap.remove(2);
+        CHECK_FALSE(sap.contains(2));
+        sap.update(jobs);
+        CHECK(to_set(sap.removed_pairs()) == PairSet{{0, 2}});
+        CHECK(sap.pair_count() == 0);
+        sap.update(jobs);
+        CHECK(sap.removed_pairs().empty());
+    }
+
+    SECTION("Incremental inserts find their pairs") {
+        sap.insert(9, box_at(Vec3(5.5f, 0, 0)));
+        sap.update(jobs);
+        CHECK(to_set(sap.added_pairs()) == PairSet{{1, 9}});
+        CHECK(current_pairs(sap) == PairSet{{0, 2}, {1, 9}});
+    }
+
+    SECTION("Inverted bounds are normalized") {
+        const Aabb inverted(Vec3(5.5f, 0.5f, 0.5f), Vec3(4.5f, -0.5f, -0.5f));
+        sap.insert(9, inverted);
+        CHECK(sap.bounds(9).min.x == 4.5f);
+        CHECK(sap.bounds(9).max.x == 5.5f);
+        CHECK(sap.bounds(9).min.y == -0.5f);
+        CHECK(sap.bounds(9).max.z == 0.5f);
+        sap.update(jobs);
+        CHECK(current_pairs(sap) == PairSet{{0, 2}, {1, 9}});
+
+        sap.move(9, Aabb(Vec3(0.5f, 0.5f, 0.5f), Vec3(-0.5f, -0.5f, -0.5f)));
+        sap.update(jobs);
+        CHECK(to_set(sap.added_pairs()) == PairSet{{0, 9}, {2, 9}});
+        CHECK(to_set(sap.removed_pairs()) == PairSet{{1, 9}});
+    }
+}
+
+TEST_CASE("SweepAndPrune matches brute force under random motion", "[core][sweep_and_prune]") {
+    JobSystem jobs(3);
+    SweepAndPruneSettings settings;
+    // Keep single inserts on the incremental path.
+    settings.rebuild_fraction = 0.5f;
+    SweepAndPrune sap(settings);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> step(-0.6f, 0.6f);
+    std::uniform_real_distribution<float> size(0.2f, 1.5f);
+    const uint32_t count = 400;
+    std::vector<Vec3> centers(count);
+    std::vector<float> halves(count);
+    std::vector<Aabb> bounds(count);
+    std::vector<bool> live(count, true);
+    for (uint32_t i = 0; i < count; ++i) {
+        centers[i] = Vec3(pos(rng), pos(rng), pos(rng));
+        halves[i] = size(rng);
+        bounds[i] = box_at(centers[i], halves[i]);
+        sap.insert(i, bounds[i]);
+    }
+
+    PairSet expected;
+    for (uint32_t frame = 0; frame < 40; ++frame) {
+        sap.update(jobs);
+        const PairSet now = brute_force(bounds, live);
+        REQUIRE(current_pairs(sap) == now);
+
+        // Events are exactly the difference from the previous frame.
+        PairSet replayed = expected;
+        for (const SapPair& pair : sap.removed_pairs()) {
+            REQUIRE(replayed.erase({pair.a, pair.b}) == 1);
+        }
+        for (const SapPair& pair : sap.added_pairs()) {
+            REQUIRE(replayed.emplace(pair.a, pair.b).second);
+        }
+        REQUIRE(replayed == now);
+        expected = now;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            centers[i] = centers[i] + Vec3(step(rng), step(rng), step(rng));
+            bounds[i] = box_at(centers[i], halves[i]);
+            if (live[i]) {
+                sap.move(i, bounds[i]);
+            }
+        }
+        // Churn a few objects in and out.
+        const uint32_t churn = (frame * 37u) % count;
+        if (live[churn]) {
+            sap.remove(churn);
+        } else {
+            sap.insert(churn, bounds[churn]);
+        }
+        live[churn] = !live[churn];
+    }
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("SweepAndPrune benchmarks", "[.][benchmark][sweep_and_prune]") {
+    JobSystem jobs(0);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+    const uint32_t count = 20000;
+    std::vector<Vec3> centers(count);
+    SweepAndPrune sap;
+    for (uint32_t i = 0; i < count; ++i) {
+        centers[i] = Vec3(pos(rng), pos(rng) * 0.1f, pos(rng));
+        sap.insert(i, box_at(centers[i]));
+    }
+    sap.update(jobs);
+
+    BENCHMARK("20k bodies, small motion") {
+        for (uint32_t i = 0; i < count; ++i) {
+            centers[i] = centers[i] + Vec3(step(rng), step(rng), step(rng));
+            sap.move(i, box_at(centers[i]));
+        }
+        sap.update(jobs);
+        return sap.pair_count();
+    };
+}
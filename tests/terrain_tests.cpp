@@ -0,0 +1,290 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/image_loader.hpp"
+#include "maya/core/job_system.hpp"
+#include "maya/core/terrain.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace maya;
+using namespace maya::math;
+
+class MockGraphicsDeviceForTerrain : public GraphicsDevice {
+public:
+    struct RangeDraw {
+        uint32_t first_index;
+        uint32_t index_count;
+    };
+
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void* data, size_t size) override {
+        const uint32_t* indices = static_cast<const uint32_t*>(data);
+        index_data.assign(indices, indices + size / sizeof(uint32_t));
+        ++index_buffers;
+        return {next_handle++};
+    }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t size) override { last_vertex_upload = size; }
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override { ++index_updates; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t first_index, uint32_t index_count) override {
+        draws.push_back(RangeDraw{first_index, index_count});
+    }
+
+    std::vector<uint32_t> index_data;
+    std::vector<RangeDraw> draws;
+    uint32_t index_buffers = 0;
+    uint32_t index_updates = 0;
+    size_t last_vertex_upload = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+/// Rolling hills on a `size` x `size` grid, 0..100 units high.
+Heightfield make_hills(uint32_t size, float spacing = 1.0f) {
+    Heightfield field;
+    field.width = size;
+    field.depth = size;
+    field.spacing = spacing;
+    field.height_scale = 100.0f;
+    field.samples.resize(static_cast<size_t>(size) * size);
+    for (uint32_t z = 0; z < size; ++z) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const float h = 0.5f + 0.25f * std::sin(x * 0.05f) + 0.25f * std::cos(z * 0.03f);
+            field.samples[z * size + x] = static_cast<uint16_t>(h * 65535.0f);
+        }
+    }
+    return field;
+}
+
+/// Sum of drawn area in samples squared; every quadrant covers a quarter of its node.
+double drawn_area(const Terrain& terrain) {
+    double area = 0.0;
+    for (const TerrainChunk& chunk : terrain.chunks()) {
+        const double side = static_cast<double>(terrain.settings().chunk_quads << chunk.lod);
+        uint32_t quadrants = 0;
+        for (uint32_t q = 0; q < 4; ++q) {
+            quadrants += (chunk.quadrant_mask >> q) & 1u;
+        }
+        area += side * side * quadrants / 4.0;
+    }
+    return area;
+}
+
+float box_distance(const Aabb& box, const Vec3& p) {
+    const float dx = std::max({box.min.x - p.x, 0.0f, p.x - box.max.x});
+    const float dy = std::max({box.min.y - p.y, 0.0f, p.y - box.max.y});
+    const float dz = std::max({box.min.z - p.z, 0.0f, p.z - box.max.z});
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+// =============================================================================
+// Heightfield Tests
+// =============================================================================
+TEST_CASE("Heightfield samples and interpolates heights", "[core][terrain]") {
+    Heightfield field;
+    field.width = 2;
+    field.depth = 2;
+    field.samples = {0, 65535, 0, 65535};
+    field.height_scale = 10.0f;
+    field.height_offset = -1.0f;
+
+    CHECK(field.sample_height(0, 0) == -1.0f);
+    CHECK(field.sample_height(1, 1) == 9.0f);
+    CHECK(field.sample_height(5, -3) == 9.0f);
+    CHECK_THAT(field.height(0.25f, 0.5f), Catch::Matchers::WithinAbs(1.5f, 1e-5f));
+
+    // Rising toward +x: the normal leans toward -x.
+    const Vec3 n = field.normal(0.5f, 0.5f, 0.5f);
+    CHECK(n.x < 0.0f);
+    CHECK(n.y > 0.0f);
+    CHECK_THAT(n.length(), Catch::Matchers::WithinAbs(1.0f, 1e-5f));
+}
+
+TEST_CASE("Heightfield loads from a grayscale image", "[core][terrain]") {
+    // Binary 8-bit PGM, 3x2; 8-bit sources are scaled to the full 16-bit range.
+    std::string pgm = "P5\n3 2\n255\n";
+    const uint8_t values[] = {0, 1, 255, 100, 128, 200};
+    pgm.append(reinterpret_cast<const char*>(values), sizeof(values));
+
+    HeightImageData image;
+    REQUIRE(ImageLoader::decode_gray16(pgm.data(), pgm.size(), image));
+    REQUIRE(image.width == 3);
+    REQUIRE(image.height == 2);
+    CHECK(image.pixels[1] == 257);
+    CHECK(image.pixels[2] == 65535);
+    CHECK(image.pixels[5] == 200 * 257);
+
+    const Heightfield field = Heightfield::from_image(image, 2.0f, 65.535f);
+    CHECK(field.spacing == 2.0f);
+    CHECK_THAT(field.sample_height(1, 0), Catch::Matchers::WithinAbs(0.257f, 1e-4f));
+    CHECK_FALSE(ImageLoader::decode_gray16("nope", 4, image));
+
+    // Images whose pixel count disagrees with their size are rejected.
+    image.width = 4;
+    const Heightfield short_field = Heightfield::from_image(image, 1.0f, 1.0f);
+    CHECK(short_field.empty());
+    CHECK(short_field.width == 0);
+    CHECK(short_field.depth == 0);
+}
+
+// =============================================================================
+// Terrain Tests
+// =============================================================================
+TEST_CASE("Terrain min/max mips bound every sample", "[core][terrain]") {
+    MockGraphicsDeviceForTerrain device;
+    TerrainSettings settings;
+    settings.chunk_quads = 16;
+    settings.lod_count = 4;
+    const Terrain terrain(device, make_hills(129), settings);
+
+    REQUIRE(terrain.nodes_x(0) == 8);
+    REQUIRE(terrain.nodes_x(3) == 1);
+    const Heightfield& field = terrain.heightfield();
+    for (uint32_t lod = 0; lod < 4; ++lod) {
+        for (uint32_t z = 0; z < terrain.nodes_z(lod); ++z) {
+            for (uint32_t x = 0; x < terrain.nodes_x(lod); ++x) {
+                const Aabb bounds = terrain.node_bounds(lod, x, z);
+                const uint32_t side = 16u << lod;
+                for (uint32_t sz = z * side; sz <= (z + 1) * side && sz < 129; sz += 3) {
+                    for (uint32_t sx = x * side; sx <= (x + 1) * side && sx < 129; sx += 3) {
+                        const float h = field.sample_height(static_cast<int32_t>(sx), static_cast<int32_t>(sz));
+                        CHECK(h >= bounds.min.y);
+                        CHECK(h <= bounds.max.y);
+                    }
+                }
+            }
+        }
+    }
+    const Aabb root = terrain.node_bounds(3, 0, 0);
+    CHECK(root.max.x == 128.0f);
+    CHECK(root.max.z == 128.0f);
+}
+
+TEST_CASE("Terrain selection covers the terrain once with bounded triangles", "[core][terrain]") {
+    MockGraphicsDeviceForTerrain device;
+    JobSystem jobs(2);
+    TerrainSettings settings;
+    settings.chunk_quads = 16;
+    settings.lod_count = 5;
+    settings.lod0_range = 24.0f;
+    const Frustum everything{}; // default planes reject nothing
+
+    Terrain small(device, make_hills(257), settings);
+    Terrain large(device, make_hills(1025), settings);
+    const Vec3 camera(100.0f, 60.0f, 100.0f);
+    small.update(camera, everything, jobs);
+    large.update(camera, everything, jobs);
+
+    CHECK(drawn_area(small) == 256.0 * 256.0);
+    CHECK(drawn_area(large) == 1024.0 * 1024.0);
+    CHECK_FALSE(large.overflowed());
+    // Sixteen times the area, but far away it is all coarse chunks.
+    CHECK(large.triangle_count() < small.triangle_count() * 3);
+
+    SECTION("Finer chunks are near the camera") {
+        for (const TerrainChunk& chunk : large.chunks()) {
+            const float distance = box_distance(chunk.bounds, camera);
+            if (chunk.lod == 0) {
+                CHECK(distance <= 24.0f);
+                continue;
+            }
+            // Quadrants drawn coarse lie beyond the finer LOD's range.
+            for (uint32_t q = 0; q < 4; ++q) {
+                if ((chunk.quadrant_mask >> q) & 1u) {
+                    const Aabb quadrant = large.node_bounds(chunk.lod - 1, chunk.x * 2 + (q & 1), chunk.z * 2 + (q >> 1));
+                    CHECK(box_distance(quadrant, camera) > large.lod_range(chunk.lod - 1));
+                }
+            }
+        }
+    }
+
+    SECTION("Vertices follow the heightfield and morph at range ends") {
+        const uint32_t per_chunk = 17 * 17;
+        REQUIRE(large.vertices().size() == large.chunks().size() * per_chunk);
+        CHECK(device.last_vertex_upload == large.vertices().size() * sizeof(Vertex));
+        const Heightfield& field = large.heightfield();
+        for (const Vertex& v : large.vertices()) {
+            CHECK_THAT(v.position.y, Catch::Matchers::WithinAbs(field.height(v.position.x, v.position.z), 1e-3f));
+        }
+        // Odd vertices of a chunk far past its LOD range sit on the coarser grid.
+        for (uint32_t c = 0; c < large.chunks().size(); ++c) {
+            const TerrainChunk& chunk = large.chunks()[c];
+            if (chunk.lod + 1 >= settings.lod_count) {
+                continue;
+            }
+            const Vertex& odd = large.vertices()[c * per_chunk + 1];
+            const Vertex& even = large.vertices()[c * per_chunk];
+            if ((even.position - camera).length() > large.lod_range(chunk.lod) + 1.0f) {
+                CHECK(odd.position.x == even.position.x);
+            }
+        }
+    }
+
+    SECTION("Drawing uses the shared index buffer") {
+        CHECK(device.index_buffers == 2);
+        CHECK(device.index_updates == 0);
+        device.draws.clear();
+        large.render(device, UniformBufferHandle{1}, Material{}, Mat4::identity(), DirectionalLighting::default_sun(),
+            camera);
+        uint32_t indices = 0;
+        for (const auto& draw : device.draws) {
+            indices += draw.index_count;
+            CHECK(draw.first_index + draw.index_count <= device.index_data.size());
+        }
+        CHECK(indices == large.triangle_count() * 3);
+    }
+}
+
+TEST_CASE("Terrain culls chunks outside the frustum", "[core][terrain]") {
+    MockGraphicsDeviceForTerrain device;
+    JobSystem jobs(0);
+    TerrainSettings settings;
+    settings.chunk_quads = 16;
+    settings.lod_count = 4;
+    Terrain terrain(device, make_hills(257), settings);
+
+    Frustum half{};
+    // Keep only x <= 100.
+    half.planes[Frustum::Left] = Plane{Vec3(-1, 0, 0), 100.0f};
+    terrain.update(Vec3(50, 80, 50), half, jobs);
+    REQUIRE_FALSE(terrain.chunks().empty());
+    for (const TerrainChunk& chunk : terrain.chunks()) {
+        CHECK(chunk.bounds.min.x <= 100.0f);
+    }
+    CHECK(drawn_area(terrain) < 256.0 * 256.0);
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+TEST_CASE("Terrain benchmarks", "[.][benchmark][terrain]") {
+    MockGraphicsDeviceForTerrain device;
+    Terrain terrain(device, make_hills(4097), TerrainSettings{});
+    float t = 0.0f;
+    BENCHMARK("Select and stream a 4k x 4k terrain") {
+        t += 1.0f;
+        terrain.update(Vec3(2048.0f + t, 120.0f, 2048.0f), Frustum{}, JobSystem::instance());
+        return terrain.triangle_count();
+    };
+}
@@ -17,6 +17,8 @@ public:
     VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {1}; }
     IndexBufferHandle create_index_buffer(const void*, size_t) override { return {2}; }
     UniformBufferHandle create_uniform_buffer(size_t) override { return {3}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
     void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
     
     TextureHandle create_texture(const void* data, uint32_t w, uint32_t h) override {
@@ -34,6 +36,7 @@ public:
     }
     
     void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
     
     const void* last_texture_data = nullptr;
     uint32_t last_texture_width = 0;
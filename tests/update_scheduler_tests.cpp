@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/update_scheduler.hpp"
+#include <chrono>
+#include <vector>
+
+using namespace maya;
+
+namespace {
+
+void busy_wait_us(int microseconds) {
+    const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(microseconds);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+UpdateSystemSettings fixed_rate(float hz, int32_t priority = 0) {
+    UpdateSystemSettings settings;
+    settings.priority = priority;
+    settings.rate.near_hz = hz;
+    settings.rate.far_hz = hz;
+    return settings;
+}
+
+} // namespace
+
+// =============================================================================
+// Rate Tests
+// =============================================================================
+TEST_CASE("UpdateRate follows distance and visibility", "[core][update_scheduler]") {
+    UpdateRate rate;
+    rate.near_hz = 60.0f;
+    rate.far_hz = 10.0f;
+    rate.near_distance = 10.0f;
+    rate.far_distance = 110.0f;
+    rate.hidden_scale = 0.5f;
+
+    CHECK_THAT(rate.hz(0.0f, true), Catch::Matchers::WithinAbs(60.0f, 0.001f));
+    CHECK_THAT(rate.hz(60.0f, true), Catch::Matchers::WithinAbs(35.0f, 0.001f));
+    CHECK_THAT(rate.hz(500.0f, true), Catch::Matchers::WithinAbs(10.0f, 0.001f));
+    CHECK_THAT(rate.hz(500.0f, false), Catch::Matchers::WithinAbs(5.0f, 0.001f));
+}
+
+TEST_CASE("UpdateScheduler runs items at their desired rates", "[core][update_scheduler]") {
+    UpdateScheduler scheduler(1000.0f);
+    std::vector<int> updates(3, 0);
+    std::vector<float> elapsed_sum(3, 0.0f);
+    const uint32_t system = scheduler.add_system(fixed_rate(60.0f), [&](uint32_t item, float elapsed) {
+        ++updates[item];
+        elapsed_sum[item] += elapsed;
+    });
+    scheduler.set_item_count(system, 3);
+    scheduler.set_item_period(system, 1, 0.1f);
+    scheduler.set_item_state(system, 2, 0.0f, false);
+
+    for (int frame = 0; frame < 60; ++frame) {
+        scheduler.run(1.0f / 60.0f);
+    }
+    CHECK(updates[0] == 60);
+    CHECK(updates[1] == 10);
+    CHECK(updates[2] == 15);
+    // Elapsed times add up to the time covered by the updates.
+    CHECK_THAT(elapsed_sum[0], Catch::Matchers::WithinAbs(1.0f, 0.001f));
+    CHECK_THAT(elapsed_sum[1], Catch::Matchers::WithinAbs(1.0f, 0.001f));
+    // At t = 1 s every period lines up.
+    CHECK(scheduler.stats(system).due == 3);
+    CHECK(scheduler.stats(system).updated == 3);
+}
+
+// =============================================================================
+// Budget Tests
+// =============================================================================
+TEST_CASE("UpdateScheduler stays within its budget", "[core][update_scheduler]") {
+    UpdateScheduler scheduler(2.0f);
+    std::vector<int> updates(400, 0);
+    std::vector<float> last_elapsed(400, 0.0f);
+    const uint32_t system = scheduler.add_system(fixed_rate(60.0f), [&](uint32_t item, float elapsed) {
+        busy_wait_us(50);
+        ++updates[item];
+        last_elapsed[item] = elapsed;
+    });
+    scheduler.set_item_count(system, 400);
+
+    scheduler.run(1.0f / 60.0f);
+    const UpdateSystemStats& first = scheduler.stats(system);
+    CHECK(first.due == 400);
+    CHECK(first.updated < 400);
+    CHECK(first.updated > 0);
+    CHECK(first.utilization > 0.5f);
+
+    SECTION("Round-robin reaches every item and reports real elapsed time") {
+        for (int frame = 0; frame < 40; ++frame) {
+            scheduler.run(1.0f / 60.0f);
+        }
+        bool all_updated = true;
+        bool elapsed_grows = false;
+        for (size_t i = 0; i < updates.size(); ++i) {
+            all_updated = all_updated && updates[i] > 0;
+            elapsed_grows = elapsed_grows || last_elapsed[i] > 1.5f / 60.0f;
+        }
+        CHECK(all_updated);
+        CHECK(elapsed_grows);
+    }
+}
+
+TEST_CASE("UpdateScheduler serves higher priorities first", "[core][update_scheduler]") {
+    UpdateScheduler scheduler(1.0f);
+    uint32_t low_updates = 0;
+    uint32_t high_updates = 0;
+    const uint32_t low = scheduler.add_system(fixed_rate(60.0f, 0), [&](uint32_t, float) {
+        busy_wait_us(50);
+        ++low_updates;
+    });
+    UpdateSystemSettings high_settings = fixed_rate(60.0f, 10);
+    high_settings.budget_ms = 0.5f;
+    const uint32_t high = scheduler.add_system(high_settings, [&](uint32_t, float) {
+        busy_wait_us(50);
+        ++high_updates;
+    });
+    scheduler.set_item_count(low, 1000);
+    scheduler.set_item_count(high, 1000);
+
+    scheduler.run(1.0f / 60.0f);
+    CHECK(high_updates > 0);
+    CHECK(scheduler.stats(high).time_ms < 5.0);
+    CHECK(scheduler.stats(low).due == 1000);
+    CHECK(scheduler.stats(low).updated < 1000);
+    CHECK(low_updates == scheduler.stats(low).updated);
+}
+
+// =============================================================================
+// Benchmarks (hidden; run with "[benchmark]")
+// =============================================================================
+TEST_CASE("Update scheduler with 100k entities", "[.][benchmark][update_scheduler]") {
+    UpdateScheduler scheduler(2.0f);
+    std::vector<float> state(100000, 0.0f);
+    UpdateSystemSettings settings;
+    settings.name = "animation";
+    const uint32_t system = scheduler.add_system(settings, [&](uint32_t item, float elapsed) {
+        state[item] += elapsed;
+    });
+    scheduler.set_item_count(system, 100000);
+    for (uint32_t i = 0; i < 100000; ++i) {
+        scheduler.set_item_state(system, i, static_cast<float>(i % 300), i % 3 != 0);
+    }
+
+    BENCHMARK("run one 60 Hz frame") {
+        scheduler.run(1.0f / 60.0f);
+        return scheduler.stats(system).updated;
+    };
+}
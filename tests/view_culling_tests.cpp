@@ -0,0 +1,306 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/job_system.hpp"
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/view_culling.hpp"
+#include "maya/math/frustum.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <cmath>
+#include <random>
+
+using namespace maya;
+using namespace maya::math;
+
+// Mock GraphicsDevice counting draws
+class MockGraphicsDeviceForCulling : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override { return {next_handle++}; }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override { return {next_handle++}; }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override { return {next_handle++}; }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override { ++draws; }
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t count) override {
+        ++draws;
+        range_indices += count;
+    }
+
+    uint32_t draws = 0;
+    uint32_t range_indices = 0;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+std::unique_ptr<Mesh> make_unit_box(GraphicsDevice& device) {
+    std::vector<Vertex> vertices = {
+        Vertex(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0, 1, 0), Vec4(1)),
+        Vertex(Vec3(0.5f, 0.5f, 0.5f), Vec3(0, 1, 0), Vec4(1)),
+        Vertex(Vec3(0.5f, -0.5f, 0.5f), Vec3(0, 1, 0), Vec4(1))
+    };
+    return std::make_unique<Mesh>(device, vertices, std::vector<uint32_t>{0, 1, 2});
+}
+
+Mat4 camera_vp(const Vec3& eye, const Vec3& target) {
+    return Mat4::perspective(to_radians(60.0f), 1.0f, 0.1f, 100.0f) * Mat4::look_at(eye, target, Vec3(0, 1, 0));
+}
+
+} // namespace
+
+// =============================================================================
+// Frustum Tests
+// =============================================================================
+TEST_CASE("Frustum extraction from view-projection", "[math][frustum]") {
+    const Frustum f = Frustum::from_view_projection(camera_vp(Vec3(0, 0, 0), Vec3(0, 0, -1)));
+
+    SECTION("Points inside and outside") {
+        CHECK(f.contains(Vec3(0, 0, -5)));
+        CHECK_FALSE(f.contains(Vec3(0, 0, 5)));
+        CHECK_FALSE(f.contains(Vec3(0, 0, -150)));
+        CHECK_FALSE(f.contains(Vec3(0, 0, -0.05f)));
+        CHECK_FALSE(f.contains(Vec3(20, 0, -5)));
+    }
+
+    SECTION("Planes are normalized") {
+        for (const Plane& p : f.planes) {
+            CHECK_THAT(p.normal.length(), Catch::Matchers::WithinAbs(1.0f, 0.0001f));
+        }
+    }
+
+    SECTION("Box intersection is conservative") {
+        CHECK(f.intersects(Aabb(Vec3(-1, -1, -6), Vec3(1, 1, -4))));
+        CHECK(f.intersects(Aabb(Vec3(-100, -1, -6), Vec3(100, 1, -4))));
+        CHECK_FALSE(f.intersects(Aabb(Vec3(-1, -1, 4), Vec3(1, 1, 6))));
+        CHECK(f.box_slack(Aabb(Vec3(-1, -1, 4), Vec3(1, 1, 6))) < 0.0f);
+    }
+}
+
+// =============================================================================
+// ViewSet Tests
+// =============================================================================
+TEST_CASE("ViewSet culls several views in one pass", "[core][culling]") {
+    MockGraphicsDeviceForCulling device;
+    JobSystem jobs(2);
+    Scene scene;
+    const Vec3 positions[] = {Vec3(0, 0, -10), Vec3(0, 0, 10), Vec3(50, 0, 0), Vec3(0, 0, -60)};
+    for (const Vec3& p : positions) {
+        scene.add_object(make_unit_box(device), Material{{1}, nullptr});
+        scene.objects().back().model_matrix = Mat4::translate(p);
+    }
+
+    ViewSet views;
+    CullView forward;
+    forward.view_projection = camera_vp(Vec3(0, 0, 0), Vec3(0, 0, -1));
+    CullView backward;
+    backward.view_projection = camera_vp(Vec3(0, 0, 0), Vec3(0, 0, 1));
+    CHECK(views.add_view(forward) == 0);
+    CHECK(views.add_view(backward) == 1);
+
+    views.cull(scene, jobs);
+
+    SECTION("Per-object masks") {
+        const auto& masks = views.object_masks();
+        REQUIRE(masks.size() == 4);
+        CHECK(masks[0] == 0b01);
+        CHECK(masks[1] == 0b10);
+        CHECK(masks[2] == 0);
+        CHECK(masks[3] == 0b01);
+    }
+
+    SECTION("Per-view render lists") {
+        REQUIRE(views.visible_objects(0).size() == 2);
+        CHECK(views.visible_objects(0)[0].object_index == 0);
+        CHECK(views.visible_objects(0)[1].object_index == 3);
+        REQUIRE(views.visible_objects(1).size() == 1);
+        CHECK(views.visible_objects(1)[0].object_index == 1);
+    }
+
+    SECTION("Screen size shrinks with distance") {
+        CHECK(views.visible_objects(0)[0].screen_size > views.visible_objects(0)[1].screen_size);
+    }
+
+    SECTION("Max distance culls far objects") {
+        forward.max_distance = 20.0f;
+        views.set_view(0, forward);
+        views.cull(scene, jobs);
+        CHECK(views.object_masks()[3] == 0);
+        CHECK(views.object_masks()[0] == 0b01);
+    }
+
+    SECTION("World bounds follow model matrices") {
+        CHECK_THAT(views.world_bounds()[2].center().x, Catch::Matchers::WithinAbs(50.0f, 0.0001f));
+    }
+}
+
+TEST_CASE("ViewSet view capacity", "[core][culling]") {
+    ViewSet views;
+    for (uint32_t i = 0; i < kMaxCullViews; ++i) {
+        CHECK(views.add_view(CullView{}) == i);
+    }
+    CHECK(views.add_view(CullView{}) == kMaxCullViews);
+    CHECK(views.view_count() == kMaxCullViews);
+}
+
+TEST_CASE("Scene renders a culled view", "[core][culling]") {
+    MockGraphicsDeviceForCulling device;
+    JobSystem jobs(0);
+    Scene scene;
+    scene.add_object(make_unit_box(device), Material{{1}, nullptr});
+    scene.objects().back().model_matrix = Mat4::translate(Vec3(0, 0, -5));
+    scene.add_object(make_unit_box(device), Material{{1}, nullptr});
+    scene.objects().back().model_matrix = Mat4::translate(Vec3(0, 0, 5));
+    for (int i = 0; i < 3; ++i) {
+        scene.add_static_object(make_unit_box(device), Material{{2}, nullptr},
+            Mat4::translate(Vec3(0, 0, i == 1 ? 5.0f : -5.0f - static_cast<float>(i))));
+    }
+    scene.build_static_batches(device);
+
+    ViewSet views;
+    CullView view;
+    view.view_projection = camera_vp(Vec3(0, 0, 0), Vec3(0, 0, -1));
+    views.add_view(view);
+    views.cull(scene, jobs);
+
+    CHECK(views.is_static_range_visible(0, 0, 0));
+    CHECK_FALSE(views.is_static_range_visible(0, 0, 1));
+    CHECK(views.is_static_range_visible(0, 0, 2));
+
+    UniformBufferHandle ub = device.create_uniform_buffer(sizeof(SceneDrawUniforms));
+    scene.render(device, ub, views, 0, DirectionalLighting::default_sun());
+    // One visible dynamic object, then the static batch split around the culled middle range.
+    CHECK(device.draws == 3);
+    CHECK(device.range_indices == 6);
+}
+
+// =============================================================================
+// Temporal Coherence Tests
+// =============================================================================
+TEST_CASE("Temporal coherence matches full culling", "[core][culling]") {
+    MockGraphicsDeviceForCulling device;
+    JobSystem jobs(2);
+    Scene scene;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> pos(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int i = 0; i < 400; ++i) {
+        scene.add_object(make_unit_box(device), Material{{1}, nullptr});
+        scene.objects().back().model_matrix = Mat4::translate(Vec3(pos(rng), pos(rng), pos(rng)));
+    }
+    for (int i = 0; i < 40; ++i) {
+        scene.add_static_object(make_unit_box(device), Material{{2}, nullptr},
+            Mat4::translate(Vec3(pos(rng), pos(rng), pos(rng))));
+    }
+    scene.build_static_batches(device);
+
+    ViewSet full;
+    ViewSet coherent;
+    TemporalCullingSettings settings;
+    settings.refresh_period = 8;
+    coherent.enable_temporal_coherence(settings);
+    CullView view;
+    view.max_distance = 50.0f;
+    CullView shadow;
+    shadow.view_projection = camera_vp(Vec3(0, 30, 0), Vec3(0, 0, 0));
+    for (ViewSet* views : {&full, &coherent}) {
+        views->add_view(view);
+        views->add_view(shadow);
+    }
+
+    bool masks_match = true;
+    bool ranges_match = true;
+    uint64_t full_tests = 0;
+    uint64_t coherent_tests = 0;
+    Vec3 eye(0, 0, 0);
+    float yaw = 0.0f;
+    for (int frame = 0; frame < 120; ++frame) {
+        eye += Vec3(unit(rng) - 0.5f, 0.0f, unit(rng) - 0.5f);
+        yaw += 0.05f * (unit(rng) - 0.3f);
+        view.position = eye;
+        view.view_projection = camera_vp(eye, eye + Vec3(std::sin(yaw), 0.0f, -std::cos(yaw)));
+        full.set_view(0, view);
+        coherent.set_view(0, view);
+        // A few objects move every frame; the rest stay put.
+        for (int k = 0; k < 5; ++k) {
+            SceneObject& obj = scene.objects()[rng() % scene.objects().size()];
+            obj.model_matrix = Mat4::translate(Vec3(pos(rng), pos(rng), pos(rng)));
+        }
+
+        full.cull(scene, jobs);
+        coherent.cull(scene, jobs);
+        full_tests += full.retested_count();
+        coherent_tests += coherent.retested_count();
+        masks_match = masks_match && full.object_masks() == coherent.object_masks();
+        for (uint32_t r = 0; r < 40; ++r) {
+            for (uint32_t v = 0; v < 2; ++v) {
+                ranges_match = ranges_match
+                    && full.is_static_range_visible(v, 0, r) == coherent.is_static_range_visible(v, 0, r);
+            }
+        }
+    }
+    CHECK(masks_match);
+    CHECK(ranges_match);
+    CHECK(coherent_tests < full_tests);
+}
+
+TEST_CASE("Temporal coherence skips unchanged items", "[core][culling]") {
+    MockGraphicsDeviceForCulling device;
+    JobSystem jobs(0);
+    Scene scene;
+    for (int i = 0; i < 64; ++i) {
+        scene.add_object(make_unit_box(device), Material{{1}, nullptr});
+        scene.objects().back().model_matrix = Mat4::translate(Vec3(static_cast<float>(i % 8) * 3.0f - 12.0f, 0.0f,
+                                                                   -5.0f - static_cast<float>(i / 8) * 3.0f));
+    }
+
+    ViewSet views;
+    TemporalCullingSettings settings;
+    settings.refresh_period = 16;
+    views.enable_temporal_coherence(settings);
+    CullView view;
+    view.view_projection = camera_vp(Vec3(0, 0, 0), Vec3(0, 0, -1));
+    views.add_view(view);
+
+    views.cull(scene, jobs);
+    CHECK(views.retested_count() == 64);
+    const std::vector<uint32_t> first = views.object_masks();
+
+    SECTION("A still camera only refreshes a slice per frame") {
+        views.cull(scene, jobs);
+        CHECK(views.retested_count() == 4);
+        CHECK(views.object_masks() == first);
+    }
+
+    SECTION("Moved objects are retested") {
+        scene.objects()[0].model_matrix = Mat4::translate(Vec3(0, 0, 20));
+        views.cull(scene, jobs);
+        CHECK(views.object_masks()[0] == 0);
+        CHECK(views.retested_count() <= 5);
+    }
+
+    SECTION("Scene changes start over") {
+        scene.add_object(make_unit_box(device), Material{{1}, nullptr});
+        views.cull(scene, jobs);
+        CHECK(views.retested_count() == 65);
+    }
+
+    SECTION("Disabled coherence tests everything") {
+        views.disable_temporal_coherence();
+        views.cull(scene, jobs);
+        CHECK(views.retested_count() == 64);
+    }
+}
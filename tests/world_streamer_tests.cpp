@@ -0,0 +1,258 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "maya/core/mesh.hpp"
+#include "maya/core/scene.hpp"
+#include "maya/core/world_streamer.hpp"
+#include "maya/rhi/graphics_device.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <thread>
+
+using namespace maya;
+using namespace maya::math;
+
+// Mock GraphicsDevice tracking live buffers and textures
+class MockGraphicsDeviceForStreaming : public GraphicsDevice {
+public:
+    bool initialize(void*) override { return true; }
+    void shutdown() override {}
+    void begin_frame() override {}
+    void end_frame() override {}
+    PipelineHandle create_pipeline(const std::string&, const std::string&, const std::string&) override {
+        return {next_handle++};
+    }
+    VertexBufferHandle create_vertex_buffer(const void*, size_t) override {
+        live_buffers.insert(next_handle);
+        return {next_handle++};
+    }
+    IndexBufferHandle create_index_buffer(const void*, size_t) override {
+        live_buffers.insert(next_handle);
+        return {next_handle++};
+    }
+    void destroy_vertex_buffer(VertexBufferHandle handle) override { live_buffers.erase(handle.handle); }
+    void destroy_index_buffer(IndexBufferHandle handle) override { live_buffers.erase(handle.handle); }
+    UniformBufferHandle create_uniform_buffer(size_t) override { return {next_handle++}; }
+    void update_vertex_buffer(VertexBufferHandle, const void*, size_t) override {}
+    void update_index_buffer(IndexBufferHandle, const void*, size_t) override {}
+    void update_uniform_buffer(UniformBufferHandle, const void*, size_t) override {}
+    TextureHandle create_texture(const void*, uint32_t, uint32_t) override {
+        live_textures.insert(next_handle);
+        return {next_handle++};
+    }
+    void destroy_texture(TextureHandle handle) override { live_textures.erase(handle.handle); }
+    void bind_vertex_buffer(VertexBufferHandle, uint32_t) override {}
+    void bind_uniform_buffer(UniformBufferHandle, uint32_t) override {}
+    void bind_texture(TextureHandle, uint32_t) override {}
+    void draw_indexed(IndexBufferHandle, uint32_t) override {}
+    void draw_indexed_range(IndexBufferHandle, uint32_t, uint32_t) override {}
+
+    std::set<uint32_t> live_buffers;
+    std::set<uint32_t> live_textures;
+
+private:
+    uint32_t next_handle = 1;
+};
+
+namespace {
+
+constexpr size_t kTriangleBytes = 3 * sizeof(Vertex) + 3 * sizeof(uint32_t);
+
+/// One triangle per cell at the cell center; cells with even x also get a 2x2 texture.
+WorldCellLoader synthetic_loader(float cell_size, bool textured) {
+    return [cell_size, textured](const WorldCell& cell, WorldCellContent& out) {
+        MeshData mesh;
+        mesh.vertices = {
+            Vertex(Vec3(0, 0, 0), Vec3(0, 1, 0), Vec4(1)),
+            Vertex(Vec3(1, 0, 0), Vec3(0, 1, 0), Vec4(1)),
+            Vertex(Vec3(0, 0, 1), Vec3(0, 1, 0), Vec4(1))
+        };
+        mesh.indices = {0, 1, 2};
+        out.meshes.push_back(std::move(mesh));
+        WorldCellObject object;
+        if (textured && cell.x % 2 == 0) {
+            out.textures.push_back(ImageData{std::vector<uint8_t>(16, 255), 2, 2});
+            object.texture = 0;
+        }
+        object.model_matrix = Mat4::translate(Vec3((static_cast<float>(cell.x) + 0.5f) * cell_size, 0.0f,
+                                                   (static_cast<float>(cell.z) + 0.5f) * cell_size));
+        out.objects.push_back(object);
+        return true;
+    };
+}
+
+WorldStreamingSettings small_world() {
+    WorldStreamingSettings settings;
+    settings.cell_size = 10.0f;
+    settings.load_radius = 15.0f;
+    settings.unload_radius = 25.0f;
+    settings.loader_threads = 0;
+    settings.max_in_flight = 64;
+    settings.integration_budget_ms = 1000.0f;
+    settings.textured_pipeline = {7};
+    settings.untextured_pipeline = {8};
+    return settings;
+}
+
+} // namespace
+
+// =============================================================================
+// Load / Evict Tests
+// =============================================================================
+TEST_CASE("WorldStreamer loads cells around the camera", "[core][streaming]") {
+    MockGraphicsDeviceForStreaming device;
+    Scene scene;
+    WorldStreamer streamer(small_world(), synthetic_loader(10.0f, true));
+
+    streamer.update(scene, device, Vec3(0, 0, 0), 0.016f);
+
+    SECTION("Cells within the load radius become resident") {
+        CHECK(streamer.resident_cell_count() == 4);
+        CHECK(streamer.is_resident(WorldCell{0, 0}));
+        CHECK(streamer.is_resident(WorldCell{-1, -1}));
+        CHECK_FALSE(streamer.is_resident(WorldCell{1, 0}));
+        CHECK(scene.objects().size() == 4);
+        CHECK(streamer.resident_bytes() == 4 * kTriangleBytes + 2 * 16);
+    }
+
+    SECTION("Objects get the cell transform and a material by texture") {
+        for (const SceneObject& obj : scene.objects()) {
+            const float x = obj.model_matrix.at(0, 3);
+            CHECK((x == 5.0f || x == -5.0f));
+            if (x > 0.0f) {
+                CHECK(obj.material.texture != nullptr);
+                CHECK(obj.material.pipeline.handle == 7);
+            } else {
+                CHECK(obj.material.texture == nullptr);
+                CHECK(obj.material.pipeline.handle == 8);
+            }
+        }
+    }
+
+    SECTION("Leaving the area evicts cells and frees their resources") {
+        streamer.update(scene, device, Vec3(100, 0, 100), 0.016f);
+        CHECK_FALSE(streamer.is_resident(WorldCell{0, 0}));
+        CHECK(streamer.is_resident(WorldCell{10, 10}));
+        CHECK(scene.objects().size() == 4);
+        CHECK(device.live_buffers.size() == 8);
+        CHECK(device.live_textures.size() == 2);
+    }
+
+    SECTION("Small moves keep boundary cells (hysteresis)") {
+        streamer.update(scene, device, Vec3(12, 0, 0), 0.016f);
+        CHECK(streamer.is_resident(WorldCell{-1, 0}));
+    }
+
+    SECTION("Unload all empties the scene") {
+        streamer.unload_all(scene);
+        CHECK(streamer.resident_cell_count() == 0);
+        CHECK(streamer.resident_bytes() == 0);
+        CHECK(scene.objects().empty());
+        CHECK(device.live_buffers.empty());
+        CHECK(device.live_textures.empty());
+    }
+}
+
+TEST_CASE("WorldStreamer respects the memory budget", "[core][streaming]") {
+    MockGraphicsDeviceForStreaming device;
+    Scene scene;
+    WorldStreamingSettings settings = small_world();
+    settings.memory_budget_bytes = 2 * kTriangleBytes;
+    WorldStreamer streamer(settings, synthetic_loader(10.0f, false));
+
+    for (int frame = 0; frame < 3; ++frame) {
+        streamer.update(scene, device, Vec3(2, 0, 2), 0.016f);
+    }
+    CHECK(streamer.resident_cell_count() == 2);
+    CHECK(streamer.resident_bytes() <= settings.memory_budget_bytes);
+    CHECK(streamer.is_resident(WorldCell{0, 0}));
+    CHECK_FALSE(streamer.is_resident(WorldCell{-1, -1}));
+    // Cells that did not fit are not requested again while nothing farther can make room.
+    CHECK(streamer.in_flight_count() == 0);
+}
+
+TEST_CASE("WorldStreamer integrates within the frame budget", "[core][streaming]") {
+    MockGraphicsDeviceForStreaming device;
+    Scene scene;
+    WorldStreamingSettings settings = small_world();
+    settings.integration_budget_ms = 0.0f;
+    WorldStreamer streamer(settings, synthetic_loader(10.0f, false));
+
+    streamer.update(scene, device, Vec3(0, 0, 0), 0.016f);
+    CHECK(scene.objects().size() == 1);
+    streamer.update(scene, device, Vec3(0, 0, 0), 0.016f);
+    CHECK(scene.objects().size() == 2);
+    for (int frame = 0; frame < 4; ++frame) {
+        streamer.update(scene, device, Vec3(0, 0, 0), 0.016f);
+    }
+    CHECK(streamer.resident_cell_count() == 4);
+}
+
+TEST_CASE("WorldStreamer prefetches along the camera velocity", "[core][streaming]") {
+    MockGraphicsDeviceForStreaming device;
+    Scene scene;
+    WorldStreamer streamer(small_world(), synthetic_loader(10.0f, false));
+
+    Vec3 position(0, 0, 0);
+    for (int frame = 0; frame < 6; ++frame) {
+        streamer.update(scene, device, position, 0.1f);
+        position.x += 2.0f;
+    }
+    CHECK(streamer.velocity().x > 10.0f);
+    // Cell (3, 0) is beyond the load radius of the camera but not of its predicted position.
+    CHECK(streamer.is_resident(WorldCell{3, 0}));
+    CHECK_FALSE(streamer.is_resident(WorldCell{-3, 0}));
+}
+
+TEST_CASE("WorldStreamer loads on background threads", "[core][streaming]") {
+    MockGraphicsDeviceForStreaming device;
+    Scene scene;
+    WorldStreamingSettings settings = small_world();
+    settings.loader_threads = 2;
+    WorldStreamer streamer(settings, synthetic_loader(10.0f, true));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (streamer.resident_cell_count() < 4 && std::chrono::steady_clock::now() < deadline) {
+        streamer.update(scene, device, Vec3(0, 0, 0), 0.016f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(streamer.resident_cell_count() == 4);
+    CHECK(scene.objects().size() == 4);
+    streamer.unload_all(scene);
+    CHECK(device.live_buffers.empty());
+}
+
+// =============================================================================
+// Manifest Loader Tests
+// =============================================================================
+TEST_CASE("WorldStreamer manifest loader", "[core][streaming]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "maya_world_test";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream obj(dir / "tri.obj");
+        obj << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+        std::ofstream manifest(dir / "cell_0_-1.txt");
+        manifest << "# test cell\nmesh tri.obj\nobject 0 -1 1 2 3\nobject 0 -1 4 5 6 90 2\n";
+        std::ofstream bad(dir / "cell_1_1.txt");
+        bad << "object 3 -1 0 0 0\n";
+    }
+    const WorldCellLoader loader = WorldStreamer::manifest_loader(dir.string());
+
+    WorldCellContent content;
+    REQUIRE(loader(WorldCell{0, -1}, content));
+    REQUIRE(content.meshes.size() == 1);
+    CHECK(content.meshes[0].vertices.size() == 3);
+    REQUIRE(content.objects.size() == 2);
+    CHECK(content.objects[0].model_matrix.at(1, 3) == 2.0f);
+    CHECK_THAT(content.objects[1].model_matrix.at(0, 2), Catch::Matchers::WithinAbs(2.0f, 0.0001f));
+
+    WorldCellContent missing;
+    CHECK(loader(WorldCell{5, 5}, missing));
+    CHECK(missing.objects.empty());
+
+    WorldCellContent invalid;
+    CHECK_FALSE(loader(WorldCell{1, 1}, invalid));
+
+    std::filesystem::remove_all(dir);
+}